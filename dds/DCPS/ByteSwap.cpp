@@ -0,0 +1,222 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "ByteSwap.h"
+
+#include <ace/CDR_Base.h>
+
+#include <cstring>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#  define OPENDDS_BYTE_SWAP_SSE2
+#  include <emmintrin.h>
+// AVX2 is only compiled for a function with the target attribute, so that
+// the library doesn't require AVX2 and uses it when the CPU has it.
+#  if defined __GNUC__ && (defined __clang__ || __GNUC__ >= 5) && !defined __INTEL_COMPILER
+#    define OPENDDS_BYTE_SWAP_AVX2
+#    include <immintrin.h>
+#  endif
+#elif defined __aarch64__ && defined __ARM_NEON
+#  define OPENDDS_BYTE_SWAP_NEON
+#  include <arm_neon.h>
+#endif
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+
+  /// Swap as many whole vectors of elements as fit in 'bytes', returning the
+  /// number of bytes swapped.
+  typedef size_t (*Kernel)(char* to, const char* from, size_t size, size_t bytes);
+
+  struct KernelInfo {
+    Kernel kernel;
+    const char* name;
+  };
+
+#ifdef OPENDDS_BYTE_SWAP_SSE2
+  inline __m128i swap16_sse2(__m128i v)
+  {
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+  }
+
+  inline __m128i swap32_sse2(__m128i v)
+  {
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return swap16_sse2(v);
+  }
+
+  inline __m128i swap64_sse2(__m128i v)
+  {
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return swap16_sse2(v);
+  }
+
+  size_t swap_sse2(char* to, const char* from, size_t size, size_t bytes)
+  {
+    size_t i = 0;
+    switch (size) {
+    case 2:
+      for (; i + 16 <= bytes; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i), swap16_sse2(v));
+      }
+      break;
+    case 4:
+      for (; i + 16 <= bytes; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i), swap32_sse2(v));
+      }
+      break;
+    case 8:
+      for (; i + 16 <= bytes; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i), swap64_sse2(v));
+      }
+      break;
+    }
+    return i;
+  }
+#endif
+
+#ifdef OPENDDS_BYTE_SWAP_AVX2
+  // vpshufb shuffles within each 128-bit lane, which is a multiple of every
+  // element size, so both lanes use the same pattern.
+  const char swap16_pattern[32] = {
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+  const char swap32_pattern[32] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+  const char swap64_pattern[32] = {
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8};
+
+  __attribute__((target("avx2")))
+  size_t swap_avx2(char* to, const char* from, size_t size, size_t bytes)
+  {
+    const char* const pattern = size == 2 ? swap16_pattern : size == 4 ? swap32_pattern : swap64_pattern;
+    const __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+
+    size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+      const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i), _mm256_shuffle_epi8(v, mask));
+    }
+    // Finish with SSE2 so that up to 31 bytes aren't left to the scalar code.
+    return i + swap_sse2(to + i, from + i, size, bytes - i);
+  }
+#endif
+
+#ifdef OPENDDS_BYTE_SWAP_NEON
+  size_t swap_neon(char* to, const char* from, size_t size, size_t bytes)
+  {
+    uint8_t* const dst = reinterpret_cast<uint8_t*>(to);
+    const uint8_t* const src = reinterpret_cast<const uint8_t*>(from);
+    size_t i = 0;
+    switch (size) {
+    case 2:
+      for (; i + 16 <= bytes; i += 16) {
+        vst1q_u8(dst + i, vrev16q_u8(vld1q_u8(src + i)));
+      }
+      break;
+    case 4:
+      for (; i + 16 <= bytes; i += 16) {
+        vst1q_u8(dst + i, vrev32q_u8(vld1q_u8(src + i)));
+      }
+      break;
+    case 8:
+      for (; i + 16 <= bytes; i += 16) {
+        vst1q_u8(dst + i, vrev64q_u8(vld1q_u8(src + i)));
+      }
+      break;
+    }
+    return i;
+  }
+#endif
+
+  KernelInfo select_kernel()
+  {
+    KernelInfo info = {0, "none"};
+#ifdef OPENDDS_BYTE_SWAP_SSE2
+    info.kernel = swap_sse2;
+    info.name = "sse2";
+#endif
+#ifdef OPENDDS_BYTE_SWAP_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      info.kernel = swap_avx2;
+      info.name = "avx2";
+    }
+#endif
+#ifdef OPENDDS_BYTE_SWAP_NEON
+    info.kernel = swap_neon;
+    info.name = "neon";
+#endif
+    return info;
+  }
+
+  const KernelInfo& kernel()
+  {
+    static const KernelInfo info = select_kernel();
+    return info;
+  }
+
+}
+
+void swap_copy_array(char* to, const char* from, size_t size, size_t count)
+{
+  const size_t bytes = size * count;
+  size_t done = 0;
+  if (bytes >= 16 && (size == 2 || size == 4 || size == 8)) {
+    const Kernel k = kernel().kernel;
+    if (k) {
+      done = k(to, from, size, bytes);
+    }
+  }
+
+  const size_t rest = (bytes - done) / size;
+  if (rest == 0) {
+    return;
+  }
+  to += done;
+  from += done;
+  switch (size) {
+  case 1:
+    std::memcpy(to, from, rest);
+    break;
+  case 2:
+    ACE_CDR::swap_2_array(from, to, rest);
+    break;
+  case 4:
+    ACE_CDR::swap_4_array(from, to, rest);
+    break;
+  case 8:
+    ACE_CDR::swap_8_array(from, to, rest);
+    break;
+  default:
+    for (size_t i = 0; i < rest; ++i, to += size, from += size) {
+      for (size_t j = 0; j < size; ++j) {
+        to[j] = from[size - 1 - j];
+      }
+    }
+    break;
+  }
+}
+
+const char* swap_copy_array_kernel()
+{
+  return kernel().name;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,37 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_BYTE_SWAP_H
+#define OPENDDS_DCPS_BYTE_SWAP_H
+
+#include "dds/Versioned_Namespace.h"
+
+#include "dcps_export.h"
+
+#include <cstddef>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Copy 'count' elements of 'size' bytes each from 'from' to 'to', reversing
+ * the bytes of every element. Neither pointer has to be aligned, but the
+ * ranges must not overlap. Elements of 2, 4, and 8 bytes are swapped with
+ * vector instructions when the CPU has them (see swap_copy_array_kernel).
+ */
+OpenDDS_Dcps_Export
+void swap_copy_array(char* to, const char* from, size_t size, size_t count);
+
+/// Name of the vector instruction set used by swap_copy_array on this CPU
+/// ("avx2", "sse2", "neon", or "none").
+OpenDDS_Dcps_Export
+const char* swap_copy_array_kernel();
+
+} // namespace DCPS
+} // namespace OpenDDS
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_DCPS_BYTE_SWAP_H
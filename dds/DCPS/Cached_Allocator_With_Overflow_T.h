@@ -146,6 +146,14 @@ public:
     }
   }
 
+  /// If @a ptr is one of the cached chunks, as opposed to memory from the
+  /// heap.
+  bool owns(const void* ptr) const
+  {
+    const unsigned char* const tmp = static_cast<const unsigned char*>(ptr);
+    return tmp >= begin_ && tmp < end_;
+  }
+
   // -- for debug
 
   /** How many chunks are available at this time.
@@ -0,0 +1,257 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "ContentFilterIndex.h"
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+
+#include "Sample.h"
+#include "Util.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  /// NaN isn't ordered, so it can't be a key of the index or searched for.
+  bool is_nan(const Value& value)
+  {
+    switch (value.type_) {
+    case Value::VAL_FLOAT:
+      return !(value.f_ == value.f_);
+    case Value::VAL_LNGDUB:
+      return !(value.ld_ == value.ld_);
+    default:
+      return false;
+    }
+  }
+}
+
+void
+ContentFilterIndex::insert(const GUID_t& reader, const RcHandle<FilterEvaluator>& eval,
+                           const DDS::StringSeq& params)
+{
+  erase(reader);
+  Groups::iterator group = groups_.find(eval.in());
+  if (group == groups_.end()) {
+    group = groups_.insert(std::make_pair(eval.in(), Group(eval))).first;
+  }
+  group->second.add(reader, params);
+  reader_groups_[reader] = eval.in();
+}
+
+void
+ContentFilterIndex::update_params(const GUID_t& reader, const DDS::StringSeq& params)
+{
+  const ReaderGroups::iterator rg = reader_groups_.find(reader);
+  if (rg == reader_groups_.end()) {
+    return;
+  }
+  Group& group = groups_.find(rg->second)->second;
+  const ReaderParams::iterator rp = group.readers_.find(reader);
+  group.remove(reader, rp->second);
+  group.add(reader, params);
+}
+
+void
+ContentFilterIndex::erase(const GUID_t& reader)
+{
+  const ReaderGroups::iterator rg = reader_groups_.find(reader);
+  if (rg == reader_groups_.end()) {
+    return;
+  }
+  const Groups::iterator group = groups_.find(rg->second);
+  const ReaderParams::iterator rp = group->second.readers_.find(reader);
+  group->second.remove(reader, rp->second);
+  if (group->second.readers_.empty()) {
+    groups_.erase(group);
+  }
+  reader_groups_.erase(rg);
+}
+
+void
+ContentFilterIndex::filter(const Sample& sample, GuidSet& pass)
+{
+  for (Groups::iterator iter = groups_.begin(); iter != groups_.end(); ++iter) {
+    iter->second.filter(sample, pass);
+  }
+}
+
+void
+ContentFilterIndex::exclude(const GuidSet& pass, GUIDSeq& filter_out) const
+{
+  for (ReaderGroups::const_iterator iter = reader_groups_.begin();
+       iter != reader_groups_.end(); ++iter) {
+    if (!pass.count(iter->first)) {
+      push_back(filter_out, iter->first);
+    }
+  }
+}
+
+ContentFilterIndex::Group::Group(const RcHandle<FilterEvaluator>& eval)
+  : eval_(eval)
+  , simple_(eval->simple_comparison(field_, cmp_, param_))
+  , indexed_(false)
+  , index_type_(Value::VAL_BOOL)
+{
+}
+
+void
+ContentFilterIndex::Group::add(const GUID_t& reader, const DDS::StringSeq& params)
+{
+  readers_[reader] = params;
+  if (!indexed_) {
+    return;
+  }
+  Value key(false);
+  if (index_key(params, key)) {
+    index_.insert(std::make_pair(key, reader));
+  } else {
+    unindexed_.insert(reader);
+  }
+}
+
+void
+ContentFilterIndex::Group::remove(const GUID_t& reader, const DDS::StringSeq& params)
+{
+  if (indexed_ && unindexed_.erase(reader) == 0) {
+    Value key(false);
+    if (index_key(params, key)) {
+      std::pair<ParamIndex::iterator, ParamIndex::iterator> range = index_.equal_range(key);
+      for (ParamIndex::iterator iter = range.first; iter != range.second; ++iter) {
+        if (iter->second == reader) {
+          index_.erase(iter);
+          break;
+        }
+      }
+    }
+  }
+  readers_.erase(reader);
+}
+
+bool
+ContentFilterIndex::Group::index_key(const DDS::StringSeq& params, Value& key) const
+{
+  if (params.length() <= param_) {
+    return false;
+  }
+  // Same conversion the FilterEvaluator does when comparing a field to a
+  // parameter: the parameter is converted to the type of the field.
+  Value param(params[param_].in(), true);
+  if ((param.type_ != index_type_ && !param.convert(index_type_)) || is_nan(param)) {
+    return false;
+  }
+  key.swap(param);
+  return true;
+}
+
+void
+ContentFilterIndex::Group::rebuild(Value::Type type)
+{
+  index_.clear();
+  unindexed_.clear();
+  index_type_ = type;
+  indexed_ = true;
+  for (ReaderParams::const_iterator iter = readers_.begin(); iter != readers_.end(); ++iter) {
+    Value key(false);
+    if (index_key(iter->second, key)) {
+      index_.insert(std::make_pair(key, iter->first));
+    } else {
+      unindexed_.insert(iter->first);
+    }
+  }
+}
+
+void
+ContentFilterIndex::Group::eval(const Sample& sample, const GUID_t& reader,
+                                const DDS::StringSeq& params, GuidSet& pass) const
+{
+  if (sample.eval(*eval_, params)) {
+    pass.insert(reader);
+  }
+}
+
+void
+ContentFilterIndex::Group::filter(const Sample& sample, GuidSet& pass)
+{
+  if (!simple_) {
+    for (ReaderParams::const_iterator iter = readers_.begin(); iter != readers_.end(); ++iter) {
+      eval(sample, iter->first, iter->second, pass);
+    }
+    return;
+  }
+
+  const Value value = sample.get_field_value(field_.c_str());
+  if (!indexed_ || value.type_ != index_type_) {
+    rebuild(value.type_);
+  }
+
+  for (GuidSet::const_iterator iter = unindexed_.begin(); iter != unindexed_.end(); ++iter) {
+    eval(sample, *iter, readers_.find(*iter)->second, pass);
+  }
+
+  // The readers that pass are the range [first, last) of the index, or
+  // everything but that range for CMP_NEQ.
+  ParamIndex::iterator first = index_.begin();
+  ParamIndex::iterator last = index_.end();
+  bool pass_in_range = true;
+  if (is_nan(value)) {
+    // Like FilterEvaluator, NaN is neither equal to, less than, nor greater
+    // than any parameter, so <>, <=, and >= pass and the rest don't.
+    if (cmp_ == FilterEvaluator::CMP_EQ || cmp_ == FilterEvaluator::CMP_LT ||
+        cmp_ == FilterEvaluator::CMP_GT) {
+      last = first;
+    }
+  } else {
+    switch (cmp_) {
+    case FilterEvaluator::CMP_EQ:
+      first = index_.lower_bound(value);
+      last = index_.upper_bound(value);
+      break;
+    case FilterEvaluator::CMP_NEQ:
+      first = index_.lower_bound(value);
+      last = index_.upper_bound(value);
+      pass_in_range = false;
+      break;
+    case FilterEvaluator::CMP_LT:
+      first = index_.upper_bound(value);
+      break;
+    case FilterEvaluator::CMP_LTEQ:
+      first = index_.lower_bound(value);
+      break;
+    case FilterEvaluator::CMP_GT:
+      last = index_.lower_bound(value);
+      break;
+    case FilterEvaluator::CMP_GTEQ:
+      last = index_.upper_bound(value);
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (pass_in_range) {
+    for (ParamIndex::const_iterator iter = first; iter != last; ++iter) {
+      pass.insert(iter->second);
+    }
+  } else {
+    for (ParamIndex::const_iterator iter = index_.begin(); iter != first; ++iter) {
+      pass.insert(iter->second);
+    }
+    for (ParamIndex::const_iterator iter = last; iter != index_.end(); ++iter) {
+      pass.insert(iter->second);
+    }
+  }
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_NO_CONTENT_FILTERED_TOPIC */
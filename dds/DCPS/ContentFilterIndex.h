@@ -0,0 +1,111 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_CONTENTFILTERINDEX_H
+#define OPENDDS_DCPS_CONTENTFILTERINDEX_H
+
+#include "Definitions.h"
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+
+#include "dcps_export.h"
+#include "FilterEvaluator.h"
+#include "GuidUtils.h"
+#include "PoolAllocator.h"
+#include "RcHandle_T.h"
+
+#include <dds/DdsDcpsGuidC.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class Sample;
+
+/**
+ * The content-filtered readers of a DataWriter, grouped by filter.  Readers
+ * with the same filter expression share a FilterEvaluator, which is cached
+ * by the participant.  When that filter compares a single field to a
+ * parameter ("symbol = %0", "price > %1") the readers are kept in an ordered
+ * index of their parameter values, converted to the type of the field.  A
+ * sample is then matched against all of them with one field lookup and a
+ * search of the index instead of evaluating the filter once per reader, and
+ * only the readers that pass are visited.  Other filters are evaluated per
+ * reader.
+ */
+class OpenDDS_Dcps_Export ContentFilterIndex {
+public:
+  void insert(const GUID_t& reader, const RcHandle<FilterEvaluator>& eval,
+              const DDS::StringSeq& params);
+
+  void update_params(const GUID_t& reader, const DDS::StringSeq& params);
+
+  void erase(const GUID_t& reader);
+
+  bool empty() const { return reader_groups_.empty(); }
+
+  size_t size() const { return reader_groups_.size(); }
+
+  /// Insert the readers whose filter matches the sample into pass.
+  void filter(const Sample& sample, GuidSet& pass);
+
+  /// Append the readers that aren't in pass to filter_out.
+  void exclude(const GuidSet& pass, GUIDSeq& filter_out) const;
+
+private:
+  typedef OPENDDS_MAP_CMP(GUID_t, DDS::StringSeq, GUID_tKeyLessThan) ReaderParams;
+
+  struct ValueLess {
+    bool operator()(const Value& lhs, const Value& rhs) const
+    {
+      return lhs < rhs;
+    }
+  };
+  typedef OPENDDS_MULTIMAP_CMP(Value, GUID_t, ValueLess) ParamIndex;
+
+  struct Group {
+    explicit Group(const RcHandle<FilterEvaluator>& eval);
+
+    void add(const GUID_t& reader, const DDS::StringSeq& params);
+    void remove(const GUID_t& reader, const DDS::StringSeq& params);
+    bool index_key(const DDS::StringSeq& params, Value& key) const;
+    void rebuild(Value::Type type);
+    void filter(const Sample& sample, GuidSet& pass);
+    void eval(const Sample& sample, const GUID_t& reader,
+              const DDS::StringSeq& params, GuidSet& pass) const;
+
+    RcHandle<FilterEvaluator> eval_;
+    ReaderParams readers_;
+    /// True if eval_ is a single comparison of field_ to parameter param_
+    bool simple_;
+    OPENDDS_STRING field_;
+    FilterEvaluator::Comparison cmp_;
+    unsigned int param_;
+    /// The index is built for the type of the field in the first sample
+    bool indexed_;
+    Value::Type index_type_;
+    ParamIndex index_;
+    /// Readers whose parameter can't be converted to index_type_ or is NaN
+    GuidSet unindexed_;
+  };
+
+  typedef OPENDDS_MAP(FilterEvaluator*, Group) Groups;
+  Groups groups_;
+  typedef OPENDDS_MAP_CMP(GUID_t, FilterEvaluator*, GUID_tKeyLessThan) ReaderGroups;
+  ReaderGroups reader_groups_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_NO_CONTENT_FILTERED_TOPIC */
+#endif /* OPENDDS_DCPS_CONTENTFILTERINDEX_H */
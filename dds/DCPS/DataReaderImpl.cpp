@@ -74,10 +74,10 @@ DataReaderImpl::DataReaderImpl()
   , end_historic_sweeper_(make_rch<EndHistoricSamplesMissedSweeper>(TheServiceParticipant->reactor(), TheServiceParticipant->reactor_owner(), this))
   , n_chunks_(TheServiceParticipant->n_chunks())
   , reactor_(0)
-  , liveliness_timer_(make_rch<LivelinessTimer>(TheServiceParticipant->reactor(), TheServiceParticipant->reactor_owner(), this))
+  , liveliness_timer_(make_rch<LivelinessTimer>(this))
   , last_deadline_missed_total_count_(0)
   , deadline_queue_enabled_(false)
-  , deadline_task_(make_rch<DRISporadicTask>(TheServiceParticipant->time_source(), TheServiceParticipant->interceptor(), rchandle_from(this), &DataReaderImpl::deadline_task))
+  , timer_dispatcher_(TheServiceParticipant->timer_dispatcher())
   , is_bit_(false)
   , always_get_history_(false)
   , statistics_enabled_(false)
@@ -124,6 +124,11 @@ DataReaderImpl::DataReaderImpl()
   this->budget_exceeded_status_.total_count_change = 0;
   this->budget_exceeded_status_.last_instance_handle = DDS::HANDLE_NIL;
 
+  const size_t instance_shards = TheServiceParticipant->reader_instance_shards();
+  if (instance_shards) {
+    instance_shards_.reset(new ShardedInstanceMap(instance_shards));
+  }
+
   monitor_.reset(TheServiceParticipant->monitor_factory_->create_data_reader_monitor(this));
   periodic_monitor_.reset(TheServiceParticipant->monitor_factory_->create_data_reader_periodic_monitor(this));
 }
@@ -134,7 +139,7 @@ DataReaderImpl::~DataReaderImpl()
 {
   DBG_ENTRY_LVL("DataReaderImpl", "~DataReaderImpl", 6);
 
-  deadline_task_->cancel();
+  cancel_all_deadlines();
 
 #ifndef OPENDDS_SAFETY_PROFILE
   RcHandle<DomainParticipantImpl> participant = participant_servant_.lock();
@@ -284,10 +289,12 @@ DataReaderImpl::add_association(const WriterAssociation& writer,
 
     {
       ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
+      const WriterInfo_rch& added = bpair.first->second;
       statistics_.insert(
         StatsMapType::value_type(
           writer_id,
-          WriterStats(raw_latency_buffer_size_, raw_latency_buffer_type_)));
+          WriterStats(raw_latency_buffer_size_, raw_latency_buffer_type_,
+                      statistics_enabled_ ? added->create_latency_histogram() : LatencyHistogram_rch())));
     }
 
     // If this is a durable reader
@@ -1309,7 +1316,7 @@ DataReaderImpl::enable()
   return return_value;
 }
 
-void
+WriterInfo_rch
 DataReaderImpl::writer_activity(const DataSampleHeader& header)
 {
   // caller should have the sample_lock_ !!!
@@ -1355,6 +1362,8 @@ DataReaderImpl::writer_activity(const DataSampleHeader& header)
 #endif
     }
   }
+
+  return writer;
 }
 
 void
@@ -1393,7 +1402,7 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
 
     DataSampleHeader const & header = sample.header_;
 
-    this->writer_activity(header);
+    const WriterInfo_rch writer = this->writer_activity(header);
 
     // Verify data has not exceeded its lifespan.
     if (this->filter_sample(header)) break;
@@ -1406,7 +1415,7 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
 
     // Only gather statistics about real samples, not registration data, etc.
     if (header.message_id_ == SAMPLE_DATA) {
-      this->process_latency(sample);
+      this->process_latency(sample, writer);
     }
 
     // This also adds to the sample container and makes any callbacks
@@ -1789,20 +1798,45 @@ CORBA::Long DataReaderImpl::total_samples() const
   return count;
 }
 
+DataReaderImpl::LivelinessTimer::LivelinessTimer(DataReaderImpl* data_reader)
+  : data_reader_(*data_reader)
+  , dispatcher_(TheServiceParticipant->timer_dispatcher())
+  , liveliness_timer_id_(-1)
+{
+  check_event_ = make_rch<PmfEvent<LivelinessTimer> >(rchandle_from(this), &LivelinessTimer::check);
+  timeout_event_ = make_rch<PmfEvent<LivelinessTimer> >(rchandle_from(this), &LivelinessTimer::timeout);
+}
+
+DataReaderImpl::LivelinessTimer::~LivelinessTimer()
+{
+  if (liveliness_timer_id_ != -1 && dispatcher_) {
+    dispatcher_->cancel(liveliness_timer_id_);
+  }
+}
+
 void
 DataReaderImpl::LivelinessTimer::check_liveliness()
 {
-  execute_or_enqueue(make_rch<CheckLivelinessCommand>(this));
+  if (dispatcher_) {
+    dispatcher_->dispatch(check_event_);
+  }
 }
 
-int
-DataReaderImpl::LivelinessTimer::handle_timeout(const ACE_Time_Value& tv,
-                                                const void * /*arg*/)
+void
+DataReaderImpl::LivelinessTimer::check()
 {
   ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
 
-  check_liveliness_i(false, MonotonicTimePoint(tv));
-  return 0;
+  check_liveliness_i(true, MonotonicTimePoint::now());
+}
+
+void
+DataReaderImpl::LivelinessTimer::timeout()
+{
+  ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
+
+  liveliness_timer_id_ = -1;
+  check_liveliness_i(false, MonotonicTimePoint::now());
 }
 
 void
@@ -1813,7 +1847,6 @@ DataReaderImpl::LivelinessTimer::check_liveliness_i(bool cancel,
 
   RcHandle<DataReaderImpl> data_reader = data_reader_.lock();
   if (! data_reader) {
-    this->reactor()->purge_pending_notifications(this);
     return;
   }
 
@@ -1830,14 +1863,7 @@ DataReaderImpl::LivelinessTimer::check_liveliness_i(bool cancel,
 
     // called from add_associations and there is already a timer
     // so cancel the existing timer.
-    if (this->reactor()->cancel_timer(local_timer_id) == -1) {
-      // this could fail because the reactor's call and
-      // the add_associations' call to this could overlap
-      // so it is not a failure.
-      ACE_DEBUG((LM_DEBUG,
-                 ACE_TEXT("(%P|%t) ERROR: DataReaderImpl::LivelinessTimer::check_liveliness_i: ")
-                 ACE_TEXT(" %p.\n"), ACE_TEXT("cancel_timer")));
-    }
+    dispatcher_->cancel(local_timer_id);
 
     timer_was_reset = true;
   }
@@ -1889,13 +1915,12 @@ DataReaderImpl::LivelinessTimer::check_liveliness_i(bool cancel,
   if (DCPS_debug_level >= 5) {
     ACE_DEBUG((LM_DEBUG,
         ACE_TEXT("(%P|%t) DataReaderImpl::LivelinessTimer::check_liveliness_i: ")
-        ACE_TEXT("reader %C has %d live writers; from_reactor=%d\n"),
+        ACE_TEXT("reader %C has %d live writers; from_timer=%d\n"),
         LogGuid(data_reader->get_guid()).c_str(),
         alive_writers,
         !cancel));
   }
 
-  // Call into the reactor after releasing the sample lock.
   if (alive_writers) {
     // compare the time now with the earliest(smallest) deadline we found
     TimeDuration relative;
@@ -1904,9 +1929,10 @@ DataReaderImpl::LivelinessTimer::check_liveliness_i(bool cancel,
     } else {
       relative = TimeDuration(0, 1); // ASAP
     }
-    liveliness_timer_id_ = this->reactor()->schedule_timer(this, 0, relative.value());
+    liveliness_timer_id_ = dispatcher_->schedule(timeout_event_, now + relative);
 
-    if (liveliness_timer_id_ == -1) {
+    if (liveliness_timer_id_ < 0) {
+      liveliness_timer_id_ = -1;
       ACE_ERROR((LM_ERROR,
           ACE_TEXT("(%P|%t) ERROR: DataReaderImpl::LivelinessTimer::check_liveliness_i: ")
           ACE_TEXT(" %p.\n"), ACE_TEXT("schedule_timer")));
@@ -1938,6 +1964,9 @@ DataReaderImpl::release_instance(DDS::InstanceHandle_t handle)
   {
     ACE_GUARD(ACE_Recursive_Thread_Mutex, instance_guard, instances_lock_);
     instances_.erase(handle);
+    if (instance_shards_) {
+      instance_shards_->erase(handle);
+    }
   }
 
   this->release_instance_i(handle);
@@ -1955,27 +1984,62 @@ DataReaderImpl::state_updated(DDS::InstanceHandle_t handle)
 
 OpenDDS::DCPS::WriterStats::WriterStats(
     int amount,
-    DataCollector<double>::OnFull type) : stats_(amount, type)
+    DataCollector<double>::OnFull type,
+    const LatencyHistogram_rch& histogram)
+  : stats_(amount, type)
+  , histogram_(histogram)
 {
 }
 
+namespace {
+  double to_seconds(const OpenDDS::DCPS::TimeDuration& delay)
+  {
+    double datum = static_cast<double>(delay.value().sec());
+    datum += delay.value().usec() / 1000000.0;
+    return datum;
+  }
+}
+
 void OpenDDS::DCPS::WriterStats::add_stat(const TimeDuration& delay)
 {
-  double datum = static_cast<double>(delay.value().sec());
-  datum += delay.value().usec() / 1000000.0;
-  this->stats_.add(datum);
+  this->stats_.add(to_seconds(delay));
+}
+
+void OpenDDS::DCPS::WriterStats::histogram(const LatencyHistogram_rch& histogram)
+{
+  histogram_ = histogram;
 }
 
 OpenDDS::DCPS::LatencyStatistics OpenDDS::DCPS::WriterStats::get_stats() const
 {
   LatencyStatistics value;
 
+  LatencyHistogram::Snapshot snapshot;
+  if (histogram_) {
+    histogram_->snapshot(snapshot);
+  }
+  value.publication = GUID_UNKNOWN;
+  value.n           = static_cast<CORBA::ULong>(snapshot.total);
+  value.maximum     = to_seconds(snapshot.percentile(1));
+  value.minimum     = to_seconds(snapshot.percentile(0));
+  snapshot.moments(value.mean, value.variance);
+
+  return value;
+}
+
+OpenDDS::DCPS::LatencyPercentiles OpenDDS::DCPS::WriterStats::get_percentiles() const
+{
+  LatencyPercentiles value;
+
+  LatencyHistogram::Snapshot snapshot;
+  if (histogram_) {
+    histogram_->snapshot(snapshot);
+  }
   value.publication = GUID_UNKNOWN;
-  value.n           = this->stats_.n();
-  value.maximum     = this->stats_.maximum();
-  value.minimum     = this->stats_.minimum();
-  value.mean        = this->stats_.mean();
-  value.variance    = this->stats_.var();
+  value.n           = snapshot.total;
+  value.p50         = to_seconds(snapshot.percentile(0.5));
+  value.p99         = to_seconds(snapshot.percentile(0.99));
+  value.p99_99      = to_seconds(snapshot.percentile(0.9999));
 
   return value;
 }
@@ -1983,6 +2047,9 @@ OpenDDS::DCPS::LatencyStatistics OpenDDS::DCPS::WriterStats::get_stats() const
 void OpenDDS::DCPS::WriterStats::reset_stats()
 {
   this->stats_.reset();
+  if (histogram_) {
+    histogram_->reset();
+  }
 }
 
 #ifndef OPENDDS_SAFETY_PROFILE
@@ -2255,56 +2322,70 @@ void DataReaderImpl::dispose_unregister(const ReceivedDataSample&,
   }
 }
 
-void DataReaderImpl::process_latency(const ReceivedDataSample& sample)
+void DataReaderImpl::process_latency(const ReceivedDataSample& sample, const WriterInfo_rch& writer)
 {
-  ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
-  StatsMapType::iterator location = this->statistics_.find(sample.header_.publication_id_);
-
-  if (location != this->statistics_.end()) {
-    const DDS::Duration_t zero = { DDS::DURATION_ZERO_SEC, DDS::DURATION_ZERO_NSEC };
-
-    // Only when the user has specified a latency budget or statistics
-    // are enabled we need to calculate our latency
-    if ((this->statistics_enabled()) ||
-        (this->qos_.latency_budget.duration > zero)) {
-      const DDS::Time_t timestamp = {
-        sample.header_.source_timestamp_sec_,
-        sample.header_.source_timestamp_nanosec_
-      };
-      const TimeDuration latency = SystemTimePoint::now() - SystemTimePoint(timestamp);
-
-      if (this->statistics_enabled()) {
-        location->second.add_stat(latency);
-      }
+  if (!writer) {
+    if (DCPS_debug_level > 0) {
+      /// NB: This message is generated contemporaneously with a similar
+      ///     message from writer_activity().  That message is not marked
+      ///     as an error, so we follow that lead and leave this as an
+      ///     informational message, guarded by debug level.  This seems
+      ///     to be due to late samples (samples delivered after an
+      ///     association has been torn down).  We may want to promote this
+      ///     to a warning if other conditions causing this symptom are
+      ///     discovered.
+      ACE_DEBUG((LM_DEBUG,
+          ACE_TEXT("(%P|%t) DataReaderImpl::process_latency() - ")
+          ACE_TEXT("reader %C is not associated with writer %C (late sample?).\n"),
+          LogGuid(get_guid()).c_str(),
+          LogGuid(sample.header_.publication_id_).c_str()));
+    }
+    return;
+  }
 
-      if (DCPS_debug_level > 9) {
-        ACE_DEBUG((LM_DEBUG,
-            ACE_TEXT("(%P|%t) DataReaderImpl::process_latency() - ")
-            ACE_TEXT("measured latency of %C for current sample.\n"),
-            latency.str().c_str()));
-      }
+  const DDS::Duration_t zero = { DDS::DURATION_ZERO_SEC, DDS::DURATION_ZERO_NSEC };
 
-      if (this->qos_.latency_budget.duration > zero) {
-        // Check latency against the budget.
-        if (latency > TimeDuration(this->qos_.latency_budget.duration)) {
-          this->notify_latency(sample.header_.publication_id_);
-        }
+  // Only when the user has specified a latency budget or statistics
+  // are enabled we need to calculate our latency
+  const bool statistics = this->statistics_enabled();
+  if (!statistics && !(this->qos_.latency_budget.duration > zero)) {
+    return;
+  }
+
+  const DDS::Time_t timestamp = {
+    sample.header_.source_timestamp_sec_,
+    sample.header_.source_timestamp_nanosec_
+  };
+  const TimeDuration latency = SystemTimePoint::now() - SystemTimePoint(timestamp);
+
+  if (statistics) {
+    LatencyHistogram* const histogram = writer->latency_histogram();
+    if (histogram) {
+      histogram->record(latency);
+    }
+
+    // Only keeping the raw data needs the lock.
+    if (raw_latency_buffer_size_) {
+      ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
+      StatsMapType::iterator location = this->statistics_.find(sample.header_.publication_id_);
+      if (location != this->statistics_.end()) {
+        location->second.add_stat(latency);
       }
     }
-  } else if (DCPS_debug_level > 0) {
-    /// NB: This message is generated contemporaneously with a similar
-    ///     message from writer_activity().  That message is not marked
-    ///     as an error, so we follow that lead and leave this as an
-    ///     informational message, guarded by debug level.  This seems
-    ///     to be due to late samples (samples delivered after an
-    ///     association has been torn down).  We may want to promote this
-    ///     to a warning if other conditions causing this symptom are
-    ///     discovered.
+  }
+
+  if (DCPS_debug_level > 9) {
     ACE_DEBUG((LM_DEBUG,
         ACE_TEXT("(%P|%t) DataReaderImpl::process_latency() - ")
-        ACE_TEXT("reader %C is not associated with writer %C (late sample?).\n"),
-        LogGuid(get_guid()).c_str(),
-        LogGuid(sample.header_.publication_id_).c_str()));
+        ACE_TEXT("measured latency of %C for current sample.\n"),
+        latency.str().c_str()));
+  }
+
+  if (this->qos_.latency_budget.duration > zero) {
+    // Check latency against the budget.
+    if (latency > TimeDuration(this->qos_.latency_budget.duration)) {
+      this->notify_latency(sample.header_.publication_id_);
+    }
   }
 }
 
@@ -2354,6 +2435,22 @@ DataReaderImpl::get_latency_stats(
     stats[ index].publication = current->first;
   }
 }
+
+void
+DataReaderImpl::get_latency_percentiles(
+    OpenDDS::DCPS::LatencyPercentilesSeq & stats)
+{
+  ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
+  stats.length(static_cast<CORBA::ULong>(this->statistics_.size()));
+  CORBA::ULong index = 0;
+
+  for (StatsMapType::const_iterator current = this->statistics_.begin();
+      current != this->statistics_.end();
+      ++current, ++index) {
+    stats[index] = current->second.get_percentiles();
+    stats[index].publication = current->first;
+  }
+}
 #endif
 
 void
@@ -2377,6 +2474,17 @@ void
 DataReaderImpl::statistics_enabled(
     CORBA::Boolean statistics_enabled)
 {
+  if (statistics_enabled) {
+    // Writers only get a histogram once statistics are enabled.
+    ACE_READ_GUARD(ACE_RW_Thread_Mutex, read_guard, writers_lock_);
+    ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
+    for (WriterMapType::iterator iter = writers_.begin(); iter != writers_.end(); ++iter) {
+      const StatsMapType::iterator location = statistics_.find(iter->first);
+      if (location != statistics_.end()) {
+        location->second.histogram(iter->second->create_latency_histogram());
+      }
+    }
+  }
   statistics_enabled_ = statistics_enabled;
 }
 
@@ -2398,6 +2506,18 @@ DataReaderImpl::prepare_to_delete()
 SubscriptionInstance_rch
 DataReaderImpl::get_handle_instance(DDS::InstanceHandle_t handle)
 {
+  if (instance_shards_) {
+    const SubscriptionInstance_rch instance = instance_shards_->find(handle);
+    if (!instance) {
+      ACE_DEBUG((LM_WARNING,
+          ACE_TEXT("(%P|%t) WARNING: ")
+          ACE_TEXT("DataReaderImpl::get_handle_instance: ")
+          ACE_TEXT("lookup for 0x%x failed\n"),
+          handle));
+    }
+    return instance;
+  }
+
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, instance_guard, this->instances_lock_, SubscriptionInstance_rch());
 
   SubscriptionInstanceMapType::iterator iter = instances_.find(handle);
@@ -3364,7 +3484,7 @@ void DataReaderImpl::accept_sample_processing(const SubscriptionInstance_rch& in
     instance->cur_sample_tv_.set_to_now();
 
     if (is_new_instance) {
-      schedule_deadline(instance, false);
+      schedule_deadline(instance);
     } else {
       process_deadline(instance, MonotonicTimePoint::now(), false);
     }
@@ -3549,22 +3669,35 @@ const DataReaderImpl::HandleSet& DataReaderImpl::lookup_matching_instances(CORBA
   return ci->second;
 }
 
-void DataReaderImpl::schedule_deadline(SubscriptionInstance_rch instance,
-                                       bool timer_called)
+void DataReaderImpl::schedule_deadline(SubscriptionInstance_rch instance)
 {
   // Should be called with sample_lock_.
   if (instance->deadline_ == MonotonicTimePoint::zero_value) {
     instance->deadline_ = MonotonicTimePoint::now() + deadline_period_;
-    const bool schedule = deadline_queue_.empty();
-    deadline_queue_.insert(std::make_pair(instance->deadline_, instance));
-    if (!timer_called) {
-      if (schedule) {
-        deadline_task_->schedule(deadline_period_);
-      } else if (deadline_queue_.begin()->second == instance) {
-        // Moved to front.
-        deadline_task_->cancel();
-        deadline_task_->schedule(deadline_period_);
-      }
+    schedule_deadline_timer(instance);
+  }
+}
+
+void DataReaderImpl::schedule_deadline_timer(const SubscriptionInstance_rch& instance)
+{
+  // Should be called with sample_lock_.
+  if (!timer_dispatcher_) {
+    return;
+  }
+  if (instance->deadline_timer_id_ != -1) {
+    timer_dispatcher_->cancel(instance->deadline_timer_id_);
+  }
+  if (!instance->deadline_event_) {
+    instance->deadline_event_ = make_rch<DeadlineEvent>(this, instance.in());
+  }
+  instance->deadline_timer_id_ = timer_dispatcher_->schedule(instance->deadline_event_, instance->deadline_);
+  if (instance->deadline_timer_id_ < 0) {
+    instance->deadline_timer_id_ = -1;
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: DataReaderImpl::schedule_deadline_timer: ")
+                 ACE_TEXT("unable to schedule deadline timer for instance 0x%x\n"),
+                 instance->instance_handle_));
     }
   }
 }
@@ -3573,11 +3706,11 @@ void DataReaderImpl::cancel_deadline(SubscriptionInstance_rch instance)
 {
   // Should be called with sample_lock_.
   if (instance->deadline_ != MonotonicTimePoint::zero_value) {
-    for (DeadlineQueue::iterator pos = deadline_queue_.lower_bound(instance->deadline_), limit = deadline_queue_.upper_bound(instance->deadline_); pos != limit; ++pos) {
-      if (pos->second == instance) {
-        deadline_queue_.erase(pos);
-        break;
+    if (instance->deadline_timer_id_ != -1) {
+      if (timer_dispatcher_) {
+        timer_dispatcher_->cancel(instance->deadline_timer_id_);
       }
+      instance->deadline_timer_id_ = -1;
     }
     instance->deadline_ = MonotonicTimePoint::zero_value;
   }
@@ -3647,19 +3780,20 @@ void DataReaderImpl::process_deadline(SubscriptionInstance_rch instance,
     // This next part is without status_lock_ held to avoid reactor deadlock.
     if (timer_called) {
       instance->deadline_ = MonotonicTimePoint::zero_value;
-      schedule_deadline(instance, timer_called);
     } else {
       cancel_deadline(instance);
-      schedule_deadline(instance, timer_called);
     }
+    schedule_deadline(instance);
   }
 }
 
 void DataReaderImpl::cancel_all_deadlines()
 {
+  ACE_GUARD(ACE_Recursive_Thread_Mutex, instance_guard, instances_lock_);
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
-  deadline_queue_.clear();
-  deadline_task_->cancel();
+  for (SubscriptionInstanceMapType::iterator iter = instances_.begin(); iter != instances_.end(); ++iter) {
+    cancel_deadline(iter->second);
+  }
 }
 
 void DataReaderImpl::reset_deadline_period(const TimeDuration& deadline_period)
@@ -3689,42 +3823,31 @@ void DataReaderImpl::reschedule_deadline(SubscriptionInstance_rch instance,
   // So the datareader can call back into us.
   if (instance->deadline_ != MonotonicTimePoint::zero_value) {
 
-    // Remove.
-    for (DeadlineQueue::iterator pos = deadline_queue_.lower_bound(instance->deadline_), limit = deadline_queue_.upper_bound(instance->deadline_); pos != limit; ++pos) {
-      if (pos->second == instance) {
-        deadline_queue_.erase(pos);
-        break;
-      }
-    }
-
     instance->deadline_ = now + (deadline_period_ - (instance->deadline_ - now));
-
-    const bool schedule = deadline_queue_.empty();
-    deadline_queue_.insert(std::make_pair(instance->deadline_, instance));
-    if (schedule) {
-      deadline_task_->schedule(deadline_period_);
-    } else if (deadline_queue_.begin()->second == instance) {
-      // Moved to front.
-      deadline_task_->cancel();
-      deadline_task_->schedule(deadline_period_);
-    }
+    schedule_deadline_timer(instance);
   }
 }
 
-void DataReaderImpl::deadline_task(const MonotonicTimePoint& now)
+void DataReaderImpl::deadline_expired(SubscriptionInstance_rch instance, const MonotonicTimePoint& now)
 {
   ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
 
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
-  for (DeadlineQueue::iterator pos = deadline_queue_.begin(), limit = deadline_queue_.end(); pos != limit && pos->first <= now;) {
-    SubscriptionInstance_rch instance = pos->second;
-    deadline_queue_.erase(pos++);
-    // pos is no longer valid.
-    process_deadline(instance, now, true);
+  // A deadline that was canceled or moved after the timer expired is handled
+  // by whoever changed it.
+  if (instance->deadline_ == MonotonicTimePoint::zero_value || now < instance->deadline_) {
+    return;
   }
+  instance->deadline_timer_id_ = -1;
+  process_deadline(instance, now, true);
+}
 
-  if (!deadline_queue_.empty()) {
-    deadline_task_->schedule(deadline_queue_.begin()->first - now);
+void DataReaderImpl::DeadlineEvent::handle_event()
+{
+  const RcHandle<DataReaderImpl> data_reader = data_reader_.lock();
+  const SubscriptionInstance_rch instance = instance_.lock();
+  if (data_reader && instance) {
+    data_reader->deadline_expired(instance, MonotonicTimePoint::now());
   }
 }
 
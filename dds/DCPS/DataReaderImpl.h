@@ -21,6 +21,7 @@
 #include "EntityImpl.h"
 #include "GroupRakeData.h"
 #include "InstanceState.h"
+#include "LatencyHistogram.h"
 #include "MultiTopicImpl.h"
 #include "OwnershipManager.h"
 #include "PoolAllocator.h"
@@ -29,6 +30,7 @@
 #include "RcObject.h"
 #include "ReactorInterceptor.h"
 #include "Service_Participant.h"
+#include "ShardedInstanceMap.h"
 #include "Stats_T.h"
 #include "SubscriptionInstance.h"
 #include "TimeTypes.h"
@@ -86,17 +88,25 @@ public:
   /// Default constructor.
   WriterStats(
     int amount = 0,
-    DataCollector<double>::OnFull type = DataCollector<double>::KeepOldest);
+    DataCollector<double>::OnFull type = DataCollector<double>::KeepOldest,
+    const LatencyHistogram_rch& histogram = LatencyHistogram_rch());
 #ifdef ACE_HAS_CPP11
   WriterStats(const WriterStats&) = default;
 #endif
 
-  /// Add a datum to the latency statistics.
+  /// Add a datum to the raw latency data.
   void add_stat(const TimeDuration& delay);
 
-  /// Extract the current latency statistics for this writer.
+  /// Set the histogram of the writer once statistics are enabled.
+  void histogram(const LatencyHistogram_rch& histogram);
+
+  /// Extract the current latency statistics for this writer, at the
+  /// resolution of the histogram.
   LatencyStatistics get_stats() const;
 
+  /// Extract the current latency percentiles for this writer.
+  LatencyPercentiles get_percentiles() const;
+
   /// Reset the latency statistics for this writer.
   void reset_stats();
 
@@ -106,8 +116,13 @@ public:
 #endif
 
 private:
-  /// Latency statistics for the DataWriter to this DataReader.
+  /// Raw latency data for the DataWriter to this DataReader, only kept if
+  /// a raw latency buffer size is set.
   Stats<double> stats_;
+
+  /// Shared with the WriterInfo, which records to it without statistics_lock_.
+  /// Null until statistics are enabled.
+  LatencyHistogram_rch histogram_;
 };
 
 #ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
@@ -333,6 +348,9 @@ public:
 #ifndef OPENDDS_SAFETY_PROFILE
   virtual void get_latency_stats(
     LatencyStatisticsSeq & stats);
+
+  virtual void get_latency_percentiles(
+    LatencyPercentilesSeq & stats);
 #endif
 
   virtual void reset_latency_stats();
@@ -357,7 +375,7 @@ public:
   /// @}
 
   /// update liveliness info for this writer.
-  void writer_activity(const DataSampleHeader& header);
+  WriterInfo_rch writer_activity(const DataSampleHeader& header);
 
   /// process a message that has been received - could be control or a data sample.
   virtual void data_received(const ReceivedDataSample& sample);
@@ -392,7 +410,7 @@ public:
                                   DDS::InstanceHandle_t publication_handle,
                                   SubscriptionInstance_rch& instance);
 
-  void process_latency(const ReceivedDataSample& sample);
+  void process_latency(const ReceivedDataSample& sample, const WriterInfo_rch& writer);
   void notify_latency(GUID_t writer);
 
   size_t get_depth() const
@@ -720,6 +738,12 @@ protected:
   /// @TODO: remove the recursive nature of the instances_lock if not needed.
   mutable ACE_Recursive_Thread_Mutex instances_lock_;
 
+  /// Copy of instances_ used by get_handle_instance() when
+  /// DCPSReaderInstanceShards is set, so that looking up a single instance
+  /// doesn't need instances_lock_.  Only changed while holding
+  /// instances_lock_ to keep it consistent with instances_.
+  unique_ptr<ShardedInstanceMap> instance_shards_;
+
   /// Check if the received data sample or instance should
   /// be filtered.
   /**
@@ -889,72 +913,28 @@ private:
   /// timer.
   ACE_Reactor_Timer_Interface* reactor_;
 
-  class LivelinessTimer : public ReactorInterceptor {
+  /// Runs on the Service_Participant's timer_dispatcher(), which has a
+  /// single thread, so liveliness_timer_id_ needs no lock.
+  class LivelinessTimer : public virtual RcObject {
   public:
-    LivelinessTimer(ACE_Reactor* reactor,
-                    ACE_thread_t owner,
-                    DataReaderImpl* data_reader)
-      : ReactorInterceptor(reactor, owner)
-      , data_reader_(*data_reader)
-      , liveliness_timer_id_(-1)
-    { }
+    explicit LivelinessTimer(DataReaderImpl* data_reader);
 
     void check_liveliness();
 
-    void cancel_timer()
-    {
-      execute_or_enqueue(make_rch<CancelCommand>(this));
-    }
-
-    virtual bool reactor_is_shut_down() const
-    {
-      return TheServiceParticipant->is_shut_down();
-    }
-
   private:
-    ~LivelinessTimer() { }
+    ~LivelinessTimer();
 
     WeakRcHandle<DataReaderImpl> data_reader_;
+    const EventDispatcher_rch dispatcher_;
+    RcHandle<EventBase> check_event_;
+    RcHandle<EventBase> timeout_event_;
 
     /// liveliness timer id; -1 if no timer is set
     long liveliness_timer_id_;
     void check_liveliness_i(bool cancel, const MonotonicTimePoint& now);
 
-    int handle_timeout(const ACE_Time_Value& current_time, const void* arg);
-
-    class CommandBase : public Command {
-    public:
-      CommandBase(LivelinessTimer* timer)
-        : timer_(timer)
-      { }
-
-    protected:
-      LivelinessTimer* timer_;
-    };
-
-    class CheckLivelinessCommand : public CommandBase {
-    public:
-      CheckLivelinessCommand(LivelinessTimer* timer)
-        : CommandBase(timer)
-      { }
-      virtual void execute()
-      {
-        timer_->check_liveliness_i(true, MonotonicTimePoint::now());
-      }
-    };
-
-    class CancelCommand : public CommandBase {
-    public:
-      CancelCommand(LivelinessTimer* timer)
-        : CommandBase(timer)
-      { }
-      virtual void execute()
-      {
-        if (timer_->liveliness_timer_id_ != -1) {
-          timer_->reactor()->cancel_timer(timer_);
-        }
-      }
-    };
+    void check();
+    void timeout();
   };
   RcHandle<LivelinessTimer> liveliness_timer_;
 
@@ -962,20 +942,33 @@ private:
   /// Watchdog responsible for reporting missed offered
   /// deadlines.
   TimeDuration deadline_period_;
-  typedef OPENDDS_MULTIMAP(MonotonicTimePoint, SubscriptionInstance_rch) DeadlineQueue;
-  DeadlineQueue deadline_queue_;
+  /// Deadlines are tracked with one timer per instance on the
+  /// Service_Participant's timer_dispatcher().
   bool deadline_queue_enabled_;
-  typedef PmfSporadicTask<DataReaderImpl> DRISporadicTask;
-  RcHandle<DRISporadicTask> deadline_task_;
+  EventDispatcher_rch timer_dispatcher_;
+
+  class DeadlineEvent : public EventBase {
+  public:
+    DeadlineEvent(DataReaderImpl* data_reader, SubscriptionInstance* instance)
+      : data_reader_(*data_reader)
+      , instance_(*instance)
+    { }
+
+    void handle_event();
+
+  private:
+    WeakRcHandle<DataReaderImpl> data_reader_;
+    WeakRcHandle<SubscriptionInstance> instance_;
+  };
 
-  void schedule_deadline(SubscriptionInstance_rch instance,
-                         bool timer_called);
+  void schedule_deadline(SubscriptionInstance_rch instance);
+  void schedule_deadline_timer(const SubscriptionInstance_rch& instance);
   void reset_deadline_period(const TimeDuration& deadline_period);
   void reschedule_deadline(SubscriptionInstance_rch instance,
                            const MonotonicTimePoint& now);
   void cancel_deadline(SubscriptionInstance_rch instance);
   void cancel_all_deadlines();
-  void deadline_task(const MonotonicTimePoint& now);
+  void deadline_expired(SubscriptionInstance_rch instance, const MonotonicTimePoint& now);
   void process_deadline(SubscriptionInstance_rch instance,
                         const MonotonicTimePoint& now,
                         bool timer_called);
@@ -15,6 +15,7 @@
 #include "TypeSupportImpl.h"
 #include "dcps_export.h"
 #include "GuidConverter.h"
+#include "InstanceKeyIndex.h"
 #include "XTypes/DynamicDataAdapter.h"
 
 #ifndef OPENDDS_HAS_STD_SHARED_PTR
@@ -120,7 +121,11 @@ namespace OpenDDS {
     DataReaderImpl_T()
       : filter_delayed_sample_task_(make_rch<DRISporadicTask>(TheServiceParticipant->time_source(), TheServiceParticipant->interceptor(), rchandle_from(this), &DataReaderImpl_T::filter_delayed))
       , marshal_skip_serialize_(false)
+      , key_buffer_(64)
     {
+      if (TheServiceParticipant->instance_key_index()) {
+        key_index_.reset(new InstanceKeyIndex);
+      }
       initialize_lookup_maps();
     }
 
@@ -128,10 +133,10 @@ namespace OpenDDS {
     {
       filter_delayed_sample_task_->cancel();
 
-      for (typename InstanceMap::iterator it = instance_map_.begin();
-           it != instance_map_.end(); ++it)
+      for (DDS::InstanceHandle_t handle = next_instance_handle(DDS::HANDLE_NIL);
+           handle != DDS::HANDLE_NIL; handle = next_instance_handle(handle))
         {
-          OpenDDS::DCPS::SubscriptionInstance_rch ptr = get_handle_instance(it->second);
+          OpenDDS::DCPS::SubscriptionInstance_rch ptr = get_handle_instance(handle);
           if (!ptr) continue;
           purge_data(ptr);
         }
@@ -659,6 +664,18 @@ namespace OpenDDS {
   {
     ACE_Guard<ACE_Recursive_Thread_Mutex> guard(sample_lock_);
 
+    if (key_index_) {
+      const String* const key = key_index_->key(handle);
+      if (!key) {
+        return DDS::RETCODE_BAD_PARAMETER;
+      }
+      ACE_Message_Block mb(key->data(), key->size());
+      mb.wr_ptr(key->size());
+      Serializer ser(&mb, InstanceKeyIndex::key_encoding());
+      KeyOnly<MessageType> key_only(key_holder);
+      return (ser >> key_only) ? DDS::RETCODE_OK : DDS::RETCODE_ERROR;
+    }
+
     const typename ReverseInstanceMap::const_iterator pos = reverse_instance_map_.find(handle);
     if (pos != reverse_instance_map_.end()) {
       key_holder = pos->second->first;
@@ -672,11 +689,7 @@ namespace OpenDDS {
   {
     ACE_Guard<ACE_Recursive_Thread_Mutex> guard(sample_lock_);
 
-    const typename InstanceMap::const_iterator it = instance_map_.find(instance_data);
-    if (it != instance_map_.end()) {
-      return it->second;
-    }
-    return DDS::HANDLE_NIL;
+    return find_instance_handle(instance_data);
   }
 
   virtual DDS::ReturnCode_t auto_return_loan(void* seq)
@@ -986,11 +999,7 @@ namespace OpenDDS {
       return;
     }
 
-    DDS::InstanceHandle_t handle(DDS::HANDLE_NIL);
-    typename InstanceMap::const_iterator const it = instance_map_.find(data);
-    if (it != instance_map_.end()) {
-      handle = it->second;
-    }
+    const DDS::InstanceHandle_t handle = find_instance_handle(data);
 
     if (handle == DDS::HANDLE_NIL) {
       instance.reset();
@@ -1053,12 +1062,11 @@ namespace OpenDDS {
   {
     ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, sample_lock_);
 
-    const typename InstanceMap::iterator end = instance_map_.end();
-    typename InstanceMap::iterator it = instance_map_.begin();
-    while (it != end) {
-      const DDS::InstanceHandle_t handle = it->second;
-      ++it; // it will be invalid, so iterate now.
+    DDS::InstanceHandle_t handle = next_instance_handle(DDS::HANDLE_NIL);
+    while (handle != DDS::HANDLE_NIL) {
+      const DDS::InstanceHandle_t next = next_instance_handle(handle); // handle will be released, so iterate now.
       release_instance(handle);
+      handle = next;
     }
   }
 
@@ -1226,6 +1234,13 @@ protected:
 
   virtual void release_instance_i(DDS::InstanceHandle_t handle)
   {
+    if (key_index_) {
+      if (key_index_->erase(handle)) {
+        remove_from_lookup_maps(handle);
+      }
+      return;
+    }
+
     const typename ReverseInstanceMap::iterator pos = reverse_instance_map_.find(handle);
     if (pos != reverse_instance_map_.end()) {
       remove_from_lookup_maps(handle);
@@ -1383,8 +1398,7 @@ private:
     results.insert_sample(item.rde_, item.rdel_, item.si_, item.index_in_instance_);
     const ValueDispatcher* vd = get_value_dispatcher();
     if (observer && item.rde_->registered_data_ && vd) {
-      typename InstanceMap::iterator i = instance_map_.begin();
-      const DDS::InstanceHandle_t handle = (i != instance_map_.end()) ? i->second : DDS::HANDLE_NIL;
+      const DDS::InstanceHandle_t handle = next_instance_handle(DDS::HANDLE_NIL);
       Observer::Sample s(handle, item.si_->instance_state_->instance_state(), *item.rde_, *vd);
       observer->on_sample_read(this, s);
     }
@@ -1620,21 +1634,8 @@ DDS::ReturnCode_t read_next_instance_i(MessageSequenceType& received_data,
 {
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, sample_lock_, DDS::RETCODE_ERROR);
 
-  typename InstanceMap::iterator it = instance_map_.begin();
-  const typename InstanceMap::iterator the_end = instance_map_.end();
-  if (a_handle != DDS::HANDLE_NIL) {
-    const typename ReverseInstanceMap::const_iterator pos = reverse_instance_map_.find(a_handle);
-    if (pos != reverse_instance_map_.end()) {
-      it = pos->second;
-      ++it;
-    } else {
-      it = the_end;
-    }
-  }
-
-  DDS::InstanceHandle_t handle(DDS::HANDLE_NIL);
-  for (; it != the_end; ++it) {
-    handle = it->second;
+  for (DDS::InstanceHandle_t handle = next_instance_handle(a_handle);
+       handle != DDS::HANDLE_NIL; handle = next_instance_handle(handle)) {
     const DDS::ReturnCode_t status =
       read_instance_i(received_data, info_seq, max_samples, handle,
                       sample_states, view_states, instance_states,
@@ -1668,21 +1669,8 @@ DDS::ReturnCode_t take_next_instance_i(MessageSequenceType& received_data,
 {
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, sample_lock_, DDS::RETCODE_ERROR);
 
-  typename InstanceMap::iterator it = instance_map_.begin();
-  const typename InstanceMap::iterator the_end = instance_map_.end();
-  if (a_handle != DDS::HANDLE_NIL) {
-    const typename ReverseInstanceMap::const_iterator pos = reverse_instance_map_.find(a_handle);
-    if (pos != reverse_instance_map_.end()) {
-      it = pos->second;
-      ++it;
-    } else {
-      it = the_end;
-    }
-  }
-
-  DDS::InstanceHandle_t handle(DDS::HANDLE_NIL);
-  for (; it != the_end; ++it) {
-    handle = it->second;
+  for (DDS::InstanceHandle_t handle = next_instance_handle(a_handle);
+       handle != DDS::HANDLE_NIL; handle = next_instance_handle(handle)) {
     const DDS::ReturnCode_t status =
       take_instance_i(received_data, info_seq, max_samples, handle,
                       sample_states, view_states, instance_states,
@@ -1730,9 +1718,9 @@ void store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data,
   //!!! caller should already have the sample_lock_
   //We will unlock it before calling into listeners
 
-  typename InstanceMap::const_iterator const it = instance_map_.find(*instance_data);
+  const DDS::InstanceHandle_t existing_handle = find_instance_handle(*instance_data);
 
-  if (it == instance_map_.end()) {
+  if (existing_handle == DDS::HANDLE_NIL) {
     if (is_dispose_msg || is_unregister_msg) {
       return;
     }
@@ -1829,6 +1817,9 @@ void store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data,
         }
         return;
       }
+      if (instance_shards_) {
+        instance_shards_->insert(handle, instance);
+      }
       update_lookup_maps(bpair.first);
 
 #ifndef OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE
@@ -1872,10 +1863,7 @@ void store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data,
 #endif
     } // scope for instances_lock_
 
-    std::pair<typename InstanceMap::iterator, bool> bpair =
-      instance_map_.insert(typename InstanceMap::value_type(*instance_data,
-        handle));
-    if (bpair.second == false)
+    if (!insert_instance_handle(*instance_data, handle))
     {
       if (DCPS_debug_level > 0) {
         ACE_ERROR ((LM_ERROR,
@@ -1886,12 +1874,11 @@ void store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data,
       }
       return;
     }
-    reverse_instance_map_[handle] = bpair.first;
   }
   else
   {
     just_registered = false;
-    handle = it->second;
+    handle = existing_handle;
   }
 
   if (header.message_id_ != OpenDDS::DCPS::INSTANCE_REGISTRATION)
@@ -2431,6 +2418,60 @@ unique_ptr<DataAllocator>& data_allocator() { return data_allocator_; }
 
 unique_ptr<DataAllocator> data_allocator_;
 
+/// Serialize the key of data to key_buffer_ for key_index_
+bool load_key(const MessageType& data)
+{
+  if (serialize_instance_key(key_buffer_, KeyOnly<const MessageType>(data))) {
+    return true;
+  }
+  if (log_level >= LogLevel::Notice) {
+    ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: %CDataReaderImpl::load_key: "
+               "failed to serialize key\n", TraitsType::type_name()));
+  }
+  return false;
+}
+
+DDS::InstanceHandle_t find_instance_handle(const MessageType& data)
+{
+  if (key_index_) {
+    return load_key(data) ? key_index_->find(key_buffer_) : DDS::HANDLE_NIL;
+  }
+  const typename InstanceMap::const_iterator it = instance_map_.find(data);
+  return it == instance_map_.end() ? DDS::HANDLE_NIL : it->second;
+}
+
+bool insert_instance_handle(const MessageType& data, DDS::InstanceHandle_t handle)
+{
+  if (key_index_) {
+    return load_key(data) && key_index_->insert(key_buffer_, handle);
+  }
+  const std::pair<typename InstanceMap::iterator, bool> bpair =
+    instance_map_.insert(typename InstanceMap::value_type(data, handle));
+  if (bpair.second) {
+    reverse_instance_map_[handle] = bpair.first;
+  }
+  return bpair.second;
+}
+
+/// The instance after handle in the order read/take_next_instance use, or
+/// the first instance if handle is HANDLE_NIL.
+DDS::InstanceHandle_t next_instance_handle(DDS::InstanceHandle_t handle) const
+{
+  if (key_index_) {
+    return key_index_->next(handle);
+  }
+  typename InstanceMap::const_iterator it = instance_map_.begin();
+  if (handle != DDS::HANDLE_NIL) {
+    const typename ReverseInstanceMap::const_iterator pos = reverse_instance_map_.find(handle);
+    if (pos == reverse_instance_map_.end()) {
+      return DDS::HANDLE_NIL;
+    }
+    it = pos->second;
+    ++it;
+  }
+  return it == instance_map_.end() ? DDS::HANDLE_NIL : it->second;
+}
+
 InstanceMap instance_map_;
 ReverseInstanceMap reverse_instance_map_;
 
@@ -2460,6 +2501,10 @@ FilterDelayedSampleQueue filter_delayed_sample_queue_;
 
 bool marshal_skip_serialize_;
 
+/// Used instead of instance_map_ if DCPSInstanceKeyIndex is enabled
+unique_ptr<InstanceKeyIndex> key_index_;
+ACE_Message_Block key_buffer_;
+
 };
 
 template <typename MessageType>
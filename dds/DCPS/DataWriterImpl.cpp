@@ -82,7 +82,12 @@ DataWriterImpl::DataWriterImpl()
   , max_suspended_transaction_id_(0)
   , liveliness_asserted_(false)
   , liveness_timer_(make_rch<LivenessTimer>(ref(*this)))
+  , instance_key_buffer_(64)
 {
+  if (TheServiceParticipant->instance_key_index()) {
+    instance_key_index_.reset(new InstanceKeyIndex);
+  }
+
   liveliness_lost_status_.total_count = 0;
   liveliness_lost_status_.total_count_change = 0;
 
@@ -240,11 +245,20 @@ DataWriterImpl::add_association(const ReaderAssociation& reader,
 
   {
     ACE_GUARD(ACE_Thread_Mutex, reader_info_guard, this->reader_info_lock_);
-    reader_info_.insert(std::make_pair(reader.readerId,
-                                       ReaderInfo(reader.filterClassName,
-                                                  TheServiceParticipant->publisher_content_filter() ? reader.filterExpression : "",
-                                                  reader.exprParams, participant_servant_,
-                                                  reader.readerQos.durability.kind > DDS::VOLATILE_DURABILITY_QOS)));
+    const std::pair<RepoIdToReaderInfoMap::iterator, bool> result =
+      reader_info_.insert(std::make_pair(reader.readerId,
+                                         ReaderInfo(reader.filterClassName,
+                                                    TheServiceParticipant->publisher_content_filter() ? reader.filterExpression : "",
+                                                    reader.exprParams, participant_servant_,
+                                                    reader.readerQos.durability.kind > DDS::VOLATILE_DURABILITY_QOS)));
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    const ReaderInfo& ri = result.first->second;
+    if (result.second && ri.eval_) {
+      filter_index_.insert(reader.readerId, ri.eval_, ri.expression_params_);
+    }
+#else
+    ACE_UNUSED_ARG(result);
+#endif
   }
 
   if (DCPS_debug_level > 4) {
@@ -619,6 +633,9 @@ DataWriterImpl::remove_associations(const ReaderIdSeq & readers,
 
       ACE_GUARD(ACE_Thread_Mutex, reader_info_guard, this->reader_info_lock_);
       reader_info_.erase(readers[i]);
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+      filter_index_.erase(readers[i]);
+#endif
       //else reader is already removed which indicates remove_association()
       //is called multiple times.
     }
@@ -907,6 +924,7 @@ DataWriterImpl::update_subscription_params(const GUID_t& readerId,
 
   if (iter != reader_info_.end()) {
     iter->second.expression_params_ = params;
+    filter_index_.update_params(readerId, params);
 
   } else if (DCPS_debug_level > 4 &&
              TheServiceParticipant->publisher_content_filter()) {
@@ -1848,13 +1866,8 @@ DataWriterImpl::unregister_instances(const DDS::Time_t& source_timestamp)
 
   while (!this->data_container_->instances_.empty()) {
     const DDS::InstanceHandle_t handle = data_container_->instances_.begin()->first;
-    InstanceHandlesToValues::const_iterator pos = instance_handles_to_values_.find(handle);
-    if (pos != instance_handles_to_values_.end()) {
-      const Sample& s = *pos->second;
-      unregister_instance_i(handle, &s, source_timestamp);
-    } else {
-      unregister_instance_i(handle, 0, source_timestamp);
-    }
+    const Sample_rch sample = instance_key(handle);
+    unregister_instance_i(handle, sample.in(), source_timestamp);
   }
 }
 
@@ -1863,7 +1876,8 @@ DataWriterImpl::write(Message_Block_Ptr data,
                       DDS::InstanceHandle_t handle,
                       const DDS::Time_t& source_timestamp,
                       GUIDSeq* filter_out,
-                      const void* real_data)
+                      const void* real_data,
+                      const GUID_t& reader)
 {
   DBG_ENTRY_LVL("DataWriterImpl","write",6);
 
@@ -1914,6 +1928,10 @@ DataWriterImpl::write(Message_Block_Ptr data,
   }
 
   element->set_filter_out(filter_out_var._retn()); // ownership passed to element
+  if (reader != GUID_UNKNOWN) {
+    element->set_num_subs(1);
+    element->set_sub_id(0, reader);
+  }
 
   ret = this->data_container_->enqueue(element, handle);
 
@@ -1927,7 +1945,7 @@ DataWriterImpl::write(Message_Block_Ptr data,
   }
   last_liveliness_activity_time_.set_to_now();
 
-  track_sequence_number(filter_out);
+  track_sequence_number(filter_out, reader);
 
   if (this->coherent_) {
     ++this->coherent_samples_;
@@ -1966,12 +1984,20 @@ DataWriterImpl::write(Message_Block_Ptr data,
 }
 
 void
-DataWriterImpl::track_sequence_number(GUIDSeq* filter_out)
+DataWriterImpl::track_sequence_number(GUIDSeq* filter_out, const GUID_t& reader)
 {
   const SequenceNumber sn = get_max_sn();
   ACE_GUARD(ACE_Thread_Mutex, reader_info_guard, this->reader_info_lock_);
 
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+  if (reader != GUID_UNKNOWN) {
+    const RepoIdToReaderInfoMap::iterator iter = reader_info_.find(reader);
+    if (iter != reader_info_.end()) {
+      iter->second.expected_sequence_ = sn;
+    }
+    return;
+  }
+
   // Track individual expected sequence numbers in ReaderInfo
   RepoIdSet excluded;
 
@@ -1990,6 +2016,7 @@ DataWriterImpl::track_sequence_number(GUIDSeq* filter_out)
 
 #else
   ACE_UNUSED_ARG(filter_out);
+  ACE_UNUSED_ARG(reader);
   for (RepoIdToReaderInfoMap::iterator iter = reader_info_.begin(),
        end = reader_info_.end(); iter != end; ++iter) {
     iter->second.expected_sequence_ = sn;
@@ -2945,19 +2972,18 @@ DDS::ReturnCode_t DataWriterImpl::setup_serialization()
 DDS::ReturnCode_t DataWriterImpl::get_key_value(Sample_rch& sample, DDS::InstanceHandle_t handle)
 {
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, get_lock(), DDS::RETCODE_ERROR);
-  const InstanceHandlesToValues::iterator it = instance_handles_to_values_.find(handle);
-  if (it == instance_handles_to_values_.end()) {
+  const Sample_rch key = instance_key(handle);
+  if (!key) {
     return DDS::RETCODE_BAD_PARAMETER;
   }
-  sample = it->second->copy(Sample::Mutable);
+  sample = key->copy(Sample::Mutable);
   return DDS::RETCODE_OK;
 }
 
 DDS::InstanceHandle_t DataWriterImpl::lookup_instance(const Sample& sample)
 {
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, get_lock(), DDS::RETCODE_ERROR);
-  const InstanceValuesToHandles::iterator it = find_instance(sample);
-  return it == instance_values_to_handles_.end() ? DDS::HANDLE_NIL : it->second;
+  return find_instance(sample);
 }
 
 DDS::InstanceHandle_t DataWriterImpl::register_instance_w_timestamp(
@@ -3016,8 +3042,6 @@ DDS::ReturnCode_t DataWriterImpl::dispose_w_timestamp(
 
 ACE_Message_Block* DataWriterImpl::serialize_sample(const Sample& sample)
 {
-  const bool encapsulated = cdr_encapsulation();
-  const Encoding& encoding = encoding_mode_.encoding();
   Message_Block_Ptr mb;
   ACE_Message_Block* tmp_mb;
 
@@ -3053,13 +3077,25 @@ ACE_Message_Block* DataWriterImpl::serialize_sample(const Sample& sample)
   }
   mb.reset(tmp_mb);
 
+  if (!serialize_sample_into(sample, mb)) {
+    return 0;
+  }
+
+  return mb.release();
+}
+
+bool DataWriterImpl::serialize_sample_into(const Sample& sample, Message_Block_Ptr& mb)
+{
+  const bool encapsulated = cdr_encapsulation();
+  const Encoding& encoding = encoding_mode_.encoding();
+
   if (skip_serialize_) {
     if (!sample.to_message_block(*mb)) {
       if (log_level >= LogLevel::Error) {
         ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriterImpl::serialize_sample: "
                    "to_message_block failed\n"));
       }
-      return 0;
+      return false;
     }
   } else {
     Serializer serializer(mb.get(), encoding);
@@ -3067,14 +3103,14 @@ ACE_Message_Block* DataWriterImpl::serialize_sample(const Sample& sample)
       EncapsulationHeader encap;
       if (!encap.from_encoding(encoding, type_support_->base_extensibility())) {
         // from_encoding logged the error
-        return 0;
+        return false;
       }
       if (!(serializer << encap)) {
         if (log_level >= LogLevel::Error) {
           ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriterImpl::serialize_sample: "
             "failed to serialize data encapsulation header\n"));
         }
-        return 0;
+        return false;
       }
     }
     if (!sample.serialize(serializer)) {
@@ -3082,23 +3118,34 @@ ACE_Message_Block* DataWriterImpl::serialize_sample(const Sample& sample)
         ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriterImpl::serialize_sample: "
           "failed to serialize sample data\n"));
       }
-      return 0;
+      return false;
     }
     if (encapsulated && !EncapsulationHeader::set_encapsulation_options(mb)) {
       if (log_level >= LogLevel::Error) {
         ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriterImpl::serialize_sample: "
           "set_encapsulation_options failed\n"));
       }
-      return 0;
+      return false;
     }
   }
 
-  return mb.release();
+  return true;
 }
 
 bool DataWriterImpl::insert_instance(DDS::InstanceHandle_t handle, Sample_rch& sample)
 {
   OPENDDS_ASSERT(sample->key_only());
+  if (instance_key_index_) {
+    if (!sample->serialize_key(instance_key_buffer_) ||
+        !instance_key_index_->insert(instance_key_buffer_, handle)) {
+      return false;
+    }
+    if (!instance_key_prototype_) {
+      instance_key_prototype_ = sample;
+    }
+    return true;
+  }
+
   if (!instance_handles_to_values_.insert(
         InstanceHandlesToValues::value_type(handle, sample)).second) {
     return false;
@@ -3111,13 +3158,57 @@ bool DataWriterImpl::insert_instance(DDS::InstanceHandle_t handle, Sample_rch& s
   return true;
 }
 
-DataWriterImpl::InstanceValuesToHandles::iterator
-DataWriterImpl::find_instance(const Sample& sample)
+DDS::InstanceHandle_t DataWriterImpl::find_instance(const Sample& sample)
 {
+  if (instance_key_index_) {
+    return sample.serialize_key(instance_key_buffer_) ?
+      instance_key_index_->find(instance_key_buffer_) : DDS::HANDLE_NIL;
+  }
+
   Sample_rch dummy_rch(const_cast<Sample*>(&sample), keep_count());
-  InstanceValuesToHandles::iterator pos = instance_values_to_handles_.find(dummy_rch);
+  const InstanceValuesToHandles::iterator pos = instance_values_to_handles_.find(dummy_rch);
   dummy_rch._retn();
-  return pos;
+  return pos == instance_values_to_handles_.end() ? DDS::HANDLE_NIL : pos->second;
+}
+
+void DataWriterImpl::erase_instance(DDS::InstanceHandle_t handle)
+{
+  if (instance_key_index_) {
+    instance_key_index_->erase(handle);
+    return;
+  }
+
+  const InstanceHandlesToValues::iterator pos = instance_handles_to_values_.find(handle);
+  if (pos == instance_handles_to_values_.end()) {
+    return;
+  }
+  instance_values_to_handles_.erase(pos->second);
+  instance_handles_to_values_.erase(pos);
+}
+
+Sample_rch DataWriterImpl::instance_key(DDS::InstanceHandle_t handle) const
+{
+  if (!instance_key_index_) {
+    const InstanceHandlesToValues::const_iterator pos = instance_handles_to_values_.find(handle);
+    return pos == instance_handles_to_values_.end() ? Sample_rch() : pos->second;
+  }
+
+  const String* const key = instance_key_index_->key(handle);
+  if (!key || !instance_key_prototype_) {
+    return Sample_rch();
+  }
+  ACE_Message_Block mb(key->data(), key->size());
+  mb.wr_ptr(key->size());
+  Serializer ser(&mb, InstanceKeyIndex::key_encoding());
+  const Sample_rch sample = instance_key_prototype_->copy(Sample::Mutable, Sample::KeyOnly);
+  if (!sample->deserialize(ser)) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriterImpl::instance_key: "
+        "failed to deserialize the key of instance %d\n", handle));
+    }
+    return Sample_rch();
+  }
+  return sample;
 }
 
 DDS::ReturnCode_t DataWriterImpl::get_or_create_instance_handle(
@@ -3190,8 +3281,8 @@ DDS::ReturnCode_t DataWriterImpl::instance_must_exist(
 
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex, guard, get_lock(), DDS::RETCODE_ERROR);
 
-  const InstanceValuesToHandles::iterator pos = find_instance(sample);
-  if (pos == instance_values_to_handles_.end()) {
+  const DDS::InstanceHandle_t handle = find_instance(sample);
+  if (handle == DDS::HANDLE_NIL) {
     if (log_level >= LogLevel::Notice) {
       ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DataWriterImpl::%C: "
         "The instance sample is not registered\n",
@@ -3200,15 +3291,14 @@ DDS::ReturnCode_t DataWriterImpl::instance_must_exist(
     return DDS::RETCODE_ERROR;
   }
 
-  if (instance_handle != DDS::HANDLE_NIL && instance_handle != pos->second) {
+  if (instance_handle != DDS::HANDLE_NIL && instance_handle != handle) {
     return DDS::RETCODE_PRECONDITION_NOT_MET;
   }
 
-  instance_handle = pos->second;
+  instance_handle = handle;
 
   if (remove) {
-    instance_values_to_handles_.erase(pos);
-    instance_handles_to_values_.erase(instance_handle);
+    erase_instance(instance_handle);
   }
 
   return DDS::RETCODE_OK;
@@ -3218,6 +3308,77 @@ DDS::ReturnCode_t DataWriterImpl::write_w_timestamp(
   const Sample& sample,
   DDS::InstanceHandle_t handle,
   const DDS::Time_t& source_timestamp)
+{
+  GUIDSeq_var filter_out;
+  GUID_t reader = GUID_UNKNOWN;
+  const DDS::ReturnCode_t ret = prepare_write(sample, handle, source_timestamp, filter_out, reader);
+  if (ret != DDS::RETCODE_OK) {
+    return ret;
+  }
+
+  return write_sample(sample, handle, source_timestamp, filter_out._retn(), reader);
+}
+
+DDS::ReturnCode_t DataWriterImpl::loan_buffer(LoanedBuffer& buffer)
+{
+  const SerializedSizeBound bound = encoding_mode_.buffer_size_bound();
+  if (!bound || skip_serialize_) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DataWriterImpl::loan_buffer: "
+        "%C has no serialized size bound, use write instead\n",
+        get_type_support()->name()));
+    }
+    return DDS::RETCODE_UNSUPPORTED;
+  }
+
+  buffer.buffer_.reset(TransportClient::loan_buffer(bound.get(), get_db_lock()));
+  if (!buffer.valid()) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DataWriterImpl::loan_buffer: "
+        "the transport can't loan buffers, this needs a single shmem transport "
+        "with ring_size set, use write instead\n"));
+    }
+    return DDS::RETCODE_UNSUPPORTED;
+  }
+  return DDS::RETCODE_OK;
+}
+
+DDS::ReturnCode_t DataWriterImpl::write_loaned_w_timestamp(
+  const Sample& sample,
+  LoanedBuffer& buffer,
+  DDS::InstanceHandle_t handle,
+  const DDS::Time_t& source_timestamp)
+{
+  if (!buffer.valid()) {
+    return DDS::RETCODE_BAD_PARAMETER;
+  }
+
+  GUIDSeq_var filter_out;
+  GUID_t reader = GUID_UNKNOWN;
+  const DDS::ReturnCode_t ret = prepare_write(sample, handle, source_timestamp, filter_out, reader);
+  if (ret != DDS::RETCODE_OK) {
+    return ret;
+  }
+
+  if (buffer.length() == 0 && !serialize_sample_into(sample, buffer.buffer_)) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DataWriterImpl::write_loaned_w_timestamp: "
+        "failed to serialize sample\n"));
+    }
+    // Whatever was serialized is discarded so the buffer can be reused.
+    buffer.length(0);
+    return DDS::RETCODE_ERROR;
+  }
+
+  return write(move(buffer.buffer_), handle, source_timestamp, filter_out._retn(), sample.native_data(), reader);
+}
+
+DDS::ReturnCode_t DataWriterImpl::prepare_write(
+  const Sample& sample,
+  DDS::InstanceHandle_t& handle,
+  const DDS::Time_t& source_timestamp,
+  GUIDSeq_var& filter_out,
+  GUID_t& reader)
 {
   // This operation assumes the provided handle is valid. The handle provided
   // will not be verified.
@@ -3240,33 +3401,35 @@ DDS::ReturnCode_t DataWriterImpl::write_w_timestamp(
   }
 
   // list of reader GUID_ts that should not get data
-  GUIDSeq_var filter_out;
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
   if (TheServiceParticipant->publisher_content_filter()) {
     ACE_GUARD_RETURN(ACE_Thread_Mutex, reader_info_guard, reader_info_lock_, DDS::RETCODE_ERROR);
-    for (RepoIdToReaderInfoMap::iterator iter = reader_info_.begin(),
-         end = reader_info_.end(); iter != end; ++iter) {
-      const ReaderInfo& ri = iter->second;
-      if (!ri.eval_.is_nil()) {
-        if (!filter_out.ptr()) {
-          filter_out = new OpenDDS::DCPS::GUIDSeq;
-        }
-        if (!sample.eval(*ri.eval_, ri.expression_params_)) {
-          push_back(filter_out.inout(), iter->first);
-        }
+    if (!filter_index_.empty()) {
+      if (!filter_out.ptr()) {
+        filter_out = new OpenDDS::DCPS::GUIDSeq;
+      }
+      GuidSet pass;
+      filter_index_.filter(sample, pass);
+      if (pass.size() == 1 && filter_index_.size() == reader_info_.size()) {
+        // Every reader has a filter and only one passes, so send to it
+        // without listing all of the others.
+        reader = *pass.begin();
+      } else {
+        filter_index_.exclude(pass, filter_out.inout());
       }
     }
   }
 #endif
 
-  return write_sample(sample, handle, source_timestamp, filter_out._retn());
+  return DDS::RETCODE_OK;
 }
 
 DDS::ReturnCode_t DataWriterImpl::write_sample(
   const Sample& sample,
   DDS::InstanceHandle_t handle,
   const DDS::Time_t& source_timestamp,
-  GUIDSeq* filter_out)
+  GUIDSeq* filter_out,
+  const GUID_t& reader)
 {
   Message_Block_Ptr serialized(serialize_sample(sample));
   if (!serialized) {
@@ -3277,7 +3440,7 @@ DDS::ReturnCode_t DataWriterImpl::write_sample(
     return DDS::RETCODE_ERROR;
   }
 
-  return write(move(serialized), handle, source_timestamp, filter_out, sample.native_data());
+  return write(move(serialized), handle, source_timestamp, filter_out, sample.native_data(), reader);
 }
 
 } // namespace DCPS
@@ -21,9 +21,11 @@
 #include "Time_Helper.h"
 #include "CoherentChangeControl.h"
 #include "GuidUtils.h"
+#include "ContentFilterIndex.h"
 #include "RcEventHandler.h"
 #include "unique_ptr.h"
 #include "Message_Block_Ptr.h"
+#include "LoanedSample.h"
 #include "TimeTypes.h"
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
 #  include "FilterEvaluator.h"
@@ -270,18 +272,22 @@ public:
    *        or won't evaluate the filters), or a list of
    *        associated reader GUID_ts that should NOT get the
    *        data sample due to content filtering.
+   * \param reader if not GUID_UNKNOWN, the only reader that
+   *        should get the data sample due to content filtering.
    */
   DDS::ReturnCode_t write(Message_Block_Ptr sample,
                           DDS::InstanceHandle_t handle,
                           const DDS::Time_t& source_timestamp,
                           GUIDSeq* filter_out,
-                          const void* real_data);
+                          const void* real_data,
+                          const GUID_t& reader = GUID_UNKNOWN);
 
   DDS::ReturnCode_t write_sample(
     const Sample& sample,
     DDS::InstanceHandle_t handle,
     const DDS::Time_t& source_timestamp,
-    GUIDSeq* filter_out);
+    GUIDSeq* filter_out,
+    const GUID_t& reader = GUID_UNKNOWN);
 
   /**
    * Delegate to the WriteDataContainer to dispose all data
@@ -543,6 +549,7 @@ protected:
   DDS::ReturnCode_t setup_serialization();
 
   ACE_Message_Block* serialize_sample(const Sample& sample);
+  bool serialize_sample_into(const Sample& sample, Message_Block_Ptr& mb);
 
   /// The number of chunks for the cached allocator.
   size_t n_chunks_;
@@ -585,6 +592,12 @@ protected:
   typedef OPENDDS_MAP_CMP(GUID_t, ReaderInfo, GUID_tKeyLessThan) RepoIdToReaderInfoMap;
   RepoIdToReaderInfoMap reader_info_;
 
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+  /// The readers in reader_info_ that have a filter, protected by
+  /// reader_info_lock_
+  ContentFilterIndex filter_index_;
+#endif
+
   struct AckCustomization {
     GUIDSeq customized_;
     AckToken& token_;
@@ -672,9 +685,36 @@ protected:
     DDS::InstanceHandle_t handle,
     const DDS::Time_t& source_timestamp);
 
+  /// Get a buffer from the transport, sized for the type's serialized size
+  /// bound, that can be sent without copying it.  Returns
+  /// RETCODE_UNSUPPORTED if the type is unbounded or the transport can't
+  /// loan buffers.
+  DDS::ReturnCode_t loan_buffer(LoanedBuffer& buffer);
+
+  /// Like write_w_timestamp, but using a buffer from loan_buffer.  An empty
+  /// buffer has the sample serialized into it, otherwise it's assumed to
+  /// already hold the serialized sample.  The buffer is given to the
+  /// transport once the sample is accepted for writing, if an error is
+  /// returned before that the application still holds it.
+  DDS::ReturnCode_t write_loaned_w_timestamp(
+    const Sample& sample,
+    LoanedBuffer& buffer,
+    DDS::InstanceHandle_t handle,
+    const DDS::Time_t& source_timestamp);
+
 private:
+  /// Common to write_w_timestamp and write_loaned_w_timestamp: find or
+  /// register the instance and evaluate the content filters.  If they pass
+  /// the sample to a single reader, that reader is returned and filter_out
+  /// is empty.
+  DDS::ReturnCode_t prepare_write(
+    const Sample& sample,
+    DDS::InstanceHandle_t& handle,
+    const DDS::Time_t& source_timestamp,
+    GUIDSeq_var& filter_out,
+    GUID_t& reader);
 
-  void track_sequence_number(GUIDSeq* filter_out);
+  void track_sequence_number(GUIDSeq* filter_out, const GUID_t& reader);
 
   void notify_publication_lost(const DDS::InstanceHandleSeq& handles);
 
@@ -848,9 +888,19 @@ private:
   InstanceHandlesToValues instance_handles_to_values_;
   typedef OPENDDS_MAP_CMP(Sample_rch, DDS::InstanceHandle_t, SampleRchCmp) InstanceValuesToHandles;
   InstanceValuesToHandles instance_values_to_handles_;
+  /// Used instead of both maps if DCPSInstanceKeyIndex is enabled, so only
+  /// the serialized key of each instance is kept.
+  unique_ptr<InstanceKeyIndex> instance_key_index_;
+  ACE_Message_Block instance_key_buffer_;
+  /// A key-only sample of the first instance, copied to deserialize the keys
+  /// in instance_key_index_.
+  Sample_rch instance_key_prototype_;
 
   bool insert_instance(DDS::InstanceHandle_t handle, Sample_rch& sample);
-  InstanceValuesToHandles::iterator find_instance(const Sample& sample);
+  DDS::InstanceHandle_t find_instance(const Sample& sample);
+  void erase_instance(DDS::InstanceHandle_t handle);
+  /// The key-only sample of an instance, or null if there's no such instance.
+  Sample_rch instance_key(DDS::InstanceHandle_t handle) const;
 
 #ifdef OPENDDS_SECURITY
 protected:
@@ -94,6 +94,39 @@ public:
     return DataWriterImpl::write_w_timestamp(sample, handle, source_timestamp);
   }
 
+  /// Get a transport buffer big enough for any serialized MessageType.  This
+  /// is only supported for bounded types when the writer's only transport can
+  /// send it without copying (currently shmem with ring_size set), otherwise
+  /// RETCODE_UNSUPPORTED is returned and write() should be used.
+  DDS::ReturnCode_t loan_sample(LoanedSample<MessageType>& sample)
+  {
+    return DataWriterImpl::loan_buffer(sample);
+  }
+
+  /// Write using a buffer from loan_sample().  If the buffer is empty the
+  /// sample is serialized directly into it, otherwise it must already contain
+  /// the serialized sample including its encapsulation header.  Once the
+  /// sample is accepted for writing the buffer belongs to the transport and
+  /// 'sample' no longer holds it.
+  DDS::ReturnCode_t write_loaned(
+    const MessageType& instance_data,
+    LoanedSample<MessageType>& sample,
+    DDS::InstanceHandle_t handle)
+  {
+    return write_loaned_w_timestamp(instance_data, sample, handle,
+                                    SystemTimePoint::now().to_dds_time());
+  }
+
+  DDS::ReturnCode_t write_loaned_w_timestamp(
+    const MessageType& instance_data,
+    LoanedSample<MessageType>& loaned,
+    DDS::InstanceHandle_t handle,
+    const DDS::Time_t& source_timestamp)
+  {
+    const SampleType sample(instance_data);
+    return DataWriterImpl::write_loaned_w_timestamp(sample, loaned, handle, source_timestamp);
+  }
+
   DDS::ReturnCode_t dispose(const MessageType& instance_data, DDS::InstanceHandle_t instance_handle)
   {
     return dispose_w_timestamp(instance_data, instance_handle, SystemTimePoint::now().to_dds_time());
@@ -315,6 +315,14 @@ DisjointSequence::missing_sequence_ranges() const
   return missing;
 }
 
+SequenceRange
+DisjointSequence::pop_front_range()
+{
+  const SequenceRange range = *sequences_.begin();
+  sequences_.ranges_.erase(sequences_.ranges_.begin());
+  return range;
+}
+
 void
 DisjointSequence::dump() const
 {
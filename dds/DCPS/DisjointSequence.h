@@ -73,6 +73,10 @@ public:
 
   void erase(SequenceNumber value);
 
+  /// Remove the lowest contiguous range from the set and return it.
+  /// Precondition: !empty()
+  SequenceRange pop_front_range();
+
   /// Insert using the RTPS compact representation of a set.  The three
   /// parameters, taken together, describe a set with each 1 bit starting
   /// at the msb of bits[0] and extending through num_bits (which are located at
@@ -152,6 +152,7 @@ size_t DispatchService::cancel(FunPtr fun, void* arg)
 ACE_THR_FUNC_RETURN DispatchService::run(void* arg)
 {
   DispatchService& dispatcher = *static_cast<DispatchService*>(arg);
+  ThreadStatusManager::Start s(TheServiceParticipant->get_thread_status_manager(), "DispatchService");
   dispatcher.run_event_loop();
   return 0;
 }
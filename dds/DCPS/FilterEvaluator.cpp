@@ -21,6 +21,7 @@
 #include <stdexcept>
 #include <cstring>
 #include <algorithm>
+#include <new>
 #include <sstream>
 
 namespace {
@@ -40,9 +41,33 @@ FilterEvaluator::DataForEval::~DataForEval()
 FilterEvaluator::DeserializedForEval::~DeserializedForEval()
 {}
 
+FieldReader::~FieldReader()
+{}
+
+namespace {
+  /// The default FieldReader, which looks the field up by name every time
+  class NamedFieldReader : public FieldReader {
+  public:
+    NamedFieldReader(const MetaStruct& meta, const char* field)
+      : meta_(meta), field_(field) {}
+
+    Value read(const void* stru) const
+    {
+      return meta_.getValue(stru, field_.c_str());
+    }
+
+  private:
+    const MetaStruct& meta_;
+    const OPENDDS_STRING field_;
+  };
+}
+
 FilterEvaluator::FilterEvaluator(const char* filter, bool allowOrderBy)
   : extended_grammar_(false)
-  , filter_root_(0)
+  , last_field_readers_(0)
+  , stack_depth_(0)
+  , max_stack_depth_(0)
+  , max_temporaries_(0)
   , number_parameters_(0)
 {
   const char* out = filter + std::strlen(filter);
@@ -60,82 +85,44 @@ FilterEvaluator::FilterEvaluator(const char* filter, bool allowOrderBy)
     } else if (found_order_by && iter->TypeMatches<FieldName>()) {
       order_bys_.push_back(toString(iter));
     } else {
-      filter_root_ = walkAst(iter);
+      walkAst(iter);
     }
   }
 }
 
 FilterEvaluator::FilterEvaluator(const AstNodeWrapper& yardNode)
   : extended_grammar_(false)
-  , filter_root_(walkAst(yardNode))
+  , last_field_readers_(0)
+  , stack_depth_(0)
+  , max_stack_depth_(0)
+  , max_temporaries_(0)
   , number_parameters_(0)
 {
+  walkAst(yardNode);
 }
 
-class FilterEvaluator::EvalNode {
-public:
-  void addChild(EvalNode* n)
-  {
-    children_.push_back(n);
-  }
-
-  virtual ~EvalNode()
-  {
-    std::for_each(children_.begin(), children_.end(), deleteChild);
-  }
-
-  virtual bool has_non_key_fields(const TypeSupportImpl& ts) const
-  {
-    for (OPENDDS_VECTOR(EvalNode*)::const_iterator i = children_.begin(); i != children_.end(); ++i) {
-      EvalNode* child = *i;
-      if (child->has_non_key_fields(ts)) {
-        return true;
-      }
-    }
-    return false;
-  }
-
-  virtual Value eval(DataForEval& data) = 0;
-
-private:
-  static void deleteChild(EvalNode* child)
-  {
-    delete child;
-  }
-
-protected:
-  OPENDDS_VECTOR(EvalNode*) children_;
-};
-
-class FilterEvaluator::Operand : public FilterEvaluator::EvalNode {
-public:
-  virtual bool isParameter() const { return false; }
-};
-
 Value
-FilterEvaluator::DeserializedForEval::lookup(const char* field) const
+FilterEvaluator::DeserializedForEval::lookup(unsigned int field) const
 {
-  return meta_.getValue(deserialized_, field);
+  return readers_.readers_[field]->read(deserialized_);
 }
 
 FilterEvaluator::SerializedForEval::SerializedForEval(ACE_Message_Block* data,
                                                       const TypeSupportImpl& type_support,
                                                       const DDS::StringSeq& params,
-                                                      Encoding encoding)
+                                                      Encoding encoding,
+                                                      const OPENDDS_VECTOR(OPENDDS_STRING)& fields)
   : DataForEval(type_support.getMetaStructForType(), params)
   , serialized_(data)
   , encoding_(encoding)
   , type_support_(type_support)
   , exten_(type_support.base_extensibility())
+  , fields_(fields)
 {}
 
 Value
-FilterEvaluator::SerializedForEval::lookup(const char* field) const
+FilterEvaluator::SerializedForEval::lookup(unsigned int field) const
 {
-  const OPENDDS_MAP(OPENDDS_STRING, Value)::const_iterator iter = cache_.find(field);
-  if (iter != cache_.end()) {
-    return iter->second;
-  }
   Message_Block_Ptr mb(serialized_->duplicate());
   Serializer ser(mb.get(), encoding_);
   if (encoding_.is_encapsulated()) {
@@ -157,14 +144,37 @@ FilterEvaluator::SerializedForEval::lookup(const char* field) const
     }
     ser.encoding(encoding);
   }
-  const Value v = meta_.getValue(ser, field, &type_support_);
-  cache_.insert(std::make_pair(OPENDDS_STRING(field), v));
-  return v;
+  return meta_.getValue(ser, fields_[field].c_str(), &type_support_);
 }
 
 FilterEvaluator::~FilterEvaluator()
 {
-  delete filter_root_;
+}
+
+const FilterEvaluator::FieldReaders&
+FilterEvaluator::field_readers(const MetaStruct& meta) const
+{
+  const FieldReaders* last = last_field_readers_;
+  if (last && last->meta_ == &meta) {
+    return *last;
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(field_readers_lock_);
+  OPENDDS_LIST(FieldReaders)::iterator pos = field_readers_.begin();
+  while (pos != field_readers_.end() && pos->meta_ != &meta) {
+    ++pos;
+  }
+  if (pos == field_readers_.end()) {
+    FieldReaders readers;
+    readers.meta_ = &meta;
+    readers.readers_.reserve(fields_.size());
+    for (OPENDDS_VECTOR(OPENDDS_STRING)::const_iterator i = fields_.begin(); i != fields_.end(); ++i) {
+      readers.readers_.push_back(meta.getFieldReader(i->c_str()));
+    }
+    pos = field_readers_.insert(field_readers_.end(), readers);
+  }
+  last_field_readers_ = &*pos;
+  return *pos;
 }
 
 bool FilterEvaluator::has_non_key_fields(const TypeSupportImpl& ts) const
@@ -175,301 +185,36 @@ bool FilterEvaluator::has_non_key_fields(const TypeSupportImpl& ts) const
     }
   }
 
-  return filter_root_->has_non_key_fields(ts);
+  for (OPENDDS_VECTOR(OPENDDS_STRING)::const_iterator i = fields_.begin(); i != fields_.end(); ++i) {
+    if (!ts.is_dcps_key(i->c_str())) {
+      return true;
+    }
+  }
+  return false;
 }
 
 namespace {
-
-  class FieldLookup : public FilterEvaluator::Operand {
-  public:
-    explicit FieldLookup(AstNode* fnNode)
-      : fieldName_(toString(fnNode))
-    {
-    }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      return data.lookup(fieldName_.c_str());
-    }
-
-    bool has_non_key_fields(const TypeSupportImpl& ts) const
-    {
-      return !ts.is_dcps_key(fieldName_.c_str());
-    }
-
-    OPENDDS_STRING fieldName_;
-  };
-
-  class LiteralInt : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralInt(AstNode* fnNode)
-      : value_(0, true)
-    {
-      const OPENDDS_STRING strVal = toString(fnNode);
-      if (strVal.length() > 2 && strVal[0] == '0'
-          && (strVal[1] == 'x' || strVal[1] == 'X')) {
-        std::istringstream is(strVal.c_str() + 2);
-        ACE_UINT64 val;
-        is >> std::hex >> val;
-        value_ = Value(val, true);
-      } else if (!strVal.empty() && strVal[0] == '-') {
-        ACE_INT64 val;
-        std::istringstream is(strVal.c_str());
-        is >> val;
-        value_ = Value(val, true);
-      } else {
-        ACE_UINT64 val;
-        std::istringstream is(strVal.c_str());
-        is >> val;
-        value_ = Value(val, true);
-      }
-    }
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return value_;
-    }
-
-    Value value_;
-  };
-
-  class LiteralChar : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralChar(AstNode* fnNode)
-      : value_(toString(fnNode)[1])
-    {}
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return Value(value_, true);
-    }
-
-    char value_;
-  };
-
-  class LiteralFloat : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralFloat(AstNode* fnNode)
-      : value_(std::atof(toString(fnNode).c_str()))
-    {}
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return Value(value_, true);
-    }
-
-    double value_;
-  };
-
-  class LiteralString : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralString(AstNode* fnNode)
-      : value_(toString(fnNode).substr(1) /* trim left ' */)
-    {
-      value_.erase(value_.length() - 1); // trim right '
-    }
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return Value(value_.c_str(), true);
-    }
-
-    OPENDDS_STRING value_;
-  };
-
-  class Parameter : public FilterEvaluator::Operand {
-  public:
-    explicit Parameter(AstNode* fnNode)
-      : param_(std::atoi(toString(fnNode).c_str() + 1 /* skip % */))
-    {}
-
-    bool isParameter() const { return true; }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      return Value(data.params_[static_cast<CORBA::ULong>(param_)], true);
-    }
-
-    size_t param() { return param_; }
-
-    size_t param_;
-  };
-
-  class Comparison : public FilterEvaluator::EvalNode {
-  public:
-    enum Operator {OPER_EQ, OPER_LT, OPER_GT, OPER_LTEQ, OPER_GTEQ, OPER_NEQ,
-      OPER_LIKE, OPER_INVALID};
-
-    explicit Comparison(AstNode* op, FilterEvaluator::Operand* left, FilterEvaluator::Operand* right)
-      : left_(left)
-      , right_(right)
-    {
-      addChild(left_);
-      addChild(right_);
-      setOperator(op);
-    }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      Value left = left_->eval(data);
-      Value right = right_->eval(data);
-      switch (oper_type_) {
-      case OPER_EQ:
-        return left == right;
-      case OPER_LT:
-        return left < right;
-      case OPER_GT:
-        return right < left;
-      case OPER_LTEQ:
-        return !(right < left);
-      case OPER_GTEQ:
-        return !(left < right);
-      case OPER_NEQ:
-        return !(left == right);
-      case OPER_LIKE:
-        return left.like(right);
-      default:
-        break;
-      }
-      return false; // not reached
-    }
-
-  private:
-    void setOperator(AstNode* node)
-    {
-      if (node->TypeMatches<OP_EQ>()) {
-        oper_type_ = OPER_EQ;
-      } else if (node->TypeMatches<OP_LT>()) {
-        oper_type_ = OPER_LT;
-      } else if (node->TypeMatches<OP_GT>()) {
-        oper_type_ = OPER_GT;
-      } else if (node->TypeMatches<OP_LTEQ>()) {
-        oper_type_ = OPER_LTEQ;
-      } else if (node->TypeMatches<OP_GTEQ>()) {
-        oper_type_ = OPER_GTEQ;
-      } else if (node->TypeMatches<OP_NEQ>()) {
-        oper_type_ = OPER_NEQ;
-      } else if (node->TypeMatches<OP_LIKE>()) {
-        oper_type_ = OPER_LIKE;
-      } else {
-        oper_type_ = OPER_INVALID;
-      }
-    }
-
-    FilterEvaluator::Operand* left_;
-    FilterEvaluator::Operand* right_;
-    Operator oper_type_;
-  };
-
-  class Between : public FilterEvaluator::EvalNode {
-  public:
-    Between(FilterEvaluator::Operand* field, AstNode* betweenOrNot, FilterEvaluator::Operand* left, FilterEvaluator::Operand* right)
-      : invert_(betweenOrNot->TypeMatches<NOT_BETWEEN>())
-      , field_(field)
-      , left_(left)
-      , right_(right)
-    {
-      addChild(field_);
-      addChild(left_);
-      addChild(right_);
-    }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      Value field = field_->eval(data);
-      Value left = left_->eval(data);
-      Value right = right_->eval(data);
-      bool btwn = !(field < left) && !(right < field);
-      return invert_ ? !btwn : btwn;
-    }
-
-  private:
-    bool invert_;
-    FilterEvaluator::Operand* field_;
-    FilterEvaluator::Operand* left_;
-    FilterEvaluator::Operand* right_;
-  };
-
-  class Call : public FilterEvaluator::Operand {
-  public:
-    enum Operator { OP_MOD };
-
-    explicit Call(const OPENDDS_STRING& name)
-    {
-      if (name == MOD) {
-        op_ = OP_MOD;
-      } else {
-        throw std::runtime_error("Unknown function: " + std::string(name.c_str ()));
-      }
-    }
-
-    virtual Value eval(FilterEvaluator::DataForEval& data)
-    {
-      switch (op_) {
-      case OP_MOD:
-        {
-          if (children_.size() != 2) {
-            std::stringstream ss;
-            ss << MOD << " expects 2 arguments, given " << children_.size();
-            throw std::runtime_error(ss.str ());
-          }
-          Value left = children_[0]->eval(data);
-          Value right = children_[1]->eval(data);
-          return left % right;
-        }
-        break;
-      }
-      OPENDDS_ASSERT(0);
-      return Value(0);
-    }
-
-  private:
-    Operator op_;
-  };
-
-  class Logical : public FilterEvaluator::EvalNode {
-  public:
-    enum LogicalOp {LG_AND, LG_OR, LG_NOT};
-
-    explicit Logical(EvalNode* child)
-      : op_(LG_NOT)
-    {
-      addChild(child);
-    }
-
-    Logical(AstNode* op, EvalNode* left, EvalNode* right)
-    {
-      addChild(left);
-      addChild(right);
-      if (op->TypeMatches<AND>()) {
-        op_ = LG_AND;
-      } else if (op->TypeMatches<OR>()) {
-        op_ = LG_OR;
-      } else {
-        OPENDDS_ASSERT(0);
-      }
-    }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      Value left = children_[0]->eval(data);
-      OPENDDS_ASSERT(left.type_ == Value::VAL_BOOL);
-      switch (op_) {
-      case LG_NOT:
-        return !left.b_;
-      case LG_AND:
-        if (!left.b_) return false;
-        break;
-      case LG_OR:
-        if (left.b_) return true;
-        break;
-      }
-      return children_[1]->eval(data);
+  Value parseInt(const OPENDDS_STRING& strVal)
+  {
+    if (strVal.length() > 2 && strVal[0] == '0'
+        && (strVal[1] == 'x' || strVal[1] == 'X')) {
+      std::istringstream is(strVal.c_str() + 2);
+      ACE_UINT64 val;
+      is >> std::hex >> val;
+      return Value(val, true);
+    } else if (!strVal.empty() && strVal[0] == '-') {
+      ACE_INT64 val;
+      std::istringstream is(strVal.c_str());
+      is >> val;
+      return Value(val, true);
     }
+    ACE_UINT64 val;
+    std::istringstream is(strVal.c_str());
+    is >> val;
+    return Value(val, true);
+  }
 
-  private:
-    LogicalOp op_;
-  };
+  const unsigned int VALUE_TYPES = Value::VAL_STRING + 1;
 }
 
 static size_t arity(const FilterEvaluator::AstNodeWrapper& node)
@@ -488,82 +233,147 @@ static FilterEvaluator::AstNodeWrapper child(const FilterEvaluator::AstNodeWrapp
   return iter;
 }
 
-FilterEvaluator::EvalNode*
+void
+FilterEvaluator::emit(OpCode op, unsigned int arg, int stack_change)
+{
+  const Instruction ins = {op, arg};
+  program_.push_back(ins);
+  stack_depth_ = static_cast<size_t>(static_cast<int>(stack_depth_) + stack_change);
+  if (stack_depth_ > max_stack_depth_) {
+    max_stack_depth_ = stack_depth_;
+  }
+  if (op == OP_FIELD || op == OP_PARAMETER || op == OP_MOD) {
+    ++max_temporaries_;
+  }
+}
+
+unsigned int
+FilterEvaluator::add_constant(const Value& value)
+{
+  constants_.push_back(value);
+  for (unsigned int t = 0; t < VALUE_TYPES; ++t) {
+    Value converted(value);
+    const Value::Type type = static_cast<Value::Type>(t);
+    const bool ok = type == value.type_ || converted.convert(type);
+    converted_constants_.push_back(ok ? converted : value);
+    convertible_constants_.push_back(ok);
+  }
+  return static_cast<unsigned int>(constants_.size() - 1);
+}
+
+unsigned int
+FilterEvaluator::add_field(const OPENDDS_STRING& name)
+{
+  const OPENDDS_VECTOR(OPENDDS_STRING)::iterator pos = std::find(fields_.begin(), fields_.end(), name);
+  if (pos != fields_.end()) {
+    return static_cast<unsigned int>(pos - fields_.begin());
+  }
+  fields_.push_back(name);
+  return static_cast<unsigned int>(fields_.size() - 1);
+}
+
+void
 FilterEvaluator::walkAst(const FilterEvaluator::AstNodeWrapper& node)
 {
   if (node->TypeMatches<CompPredDef>()) {
-    Operand* left = walkOperand(child(node, 0));
+    const bool left_param = walkOperand(child(node, 0));
     const FilterEvaluator::AstNodeWrapper& op = child(node, 1);
-    Operand* right = walkOperand(child(node, 2));
-    if (left->isParameter() && right->isParameter()) {
+    const bool right_param = walkOperand(child(node, 2));
+    if (left_param && right_param) {
       extended_grammar_ = true;
     }
-    return new Comparison(op, left, right);
+    Comparison cmp = CMP_EQ;
+    if (op->TypeMatches<OP_LT>()) {
+      cmp = CMP_LT;
+    } else if (op->TypeMatches<OP_GT>()) {
+      cmp = CMP_GT;
+    } else if (op->TypeMatches<OP_LTEQ>()) {
+      cmp = CMP_LTEQ;
+    } else if (op->TypeMatches<OP_GTEQ>()) {
+      cmp = CMP_GTEQ;
+    } else if (op->TypeMatches<OP_NEQ>()) {
+      cmp = CMP_NEQ;
+    } else if (op->TypeMatches<OP_LIKE>()) {
+      cmp = CMP_LIKE;
+    } else {
+      OPENDDS_ASSERT(op->TypeMatches<OP_EQ>());
+    }
+    emit(OP_COMPARE, cmp, -1);
+    return;
   } else if (node->TypeMatches<BetweenPredDef>()) {
-    Operand* field = walkOperand(child(node, 0));
+    walkOperand(child(node, 0));
     const FilterEvaluator::AstNodeWrapper& op = child(node, 1);
-    Operand* low = walkOperand(child(node, 2));
-    Operand* high = walkOperand(child(node, 3));
-    return new Between(field, op, low, high);
+    walkOperand(child(node, 2));
+    walkOperand(child(node, 3));
+    emit(OP_BETWEEN, op->TypeMatches<NOT_BETWEEN>() ? 1 : 0, -2);
+    return;
   } else if (node->TypeMatches<CondDef>() || node->TypeMatches<Cond>()) {
     size_t a = arity(node);
     if (a == 1) {
-      return walkAst(child(node, 0));
+      walkAst(child(node, 0));
+      return;
     } else if (a == 2) {
       OPENDDS_ASSERT(child(node, 0)->TypeMatches<NOT>());
-      return new Logical(walkAst(child(node, 1)));
+      walkAst(child(node, 1));
+      emit(OP_NOT, 0, 0);
+      return;
     } else if (a == 3) {
-      EvalNode* left = walkAst(child(node, 0));
+      walkAst(child(node, 0));
       const FilterEvaluator::AstNodeWrapper& op = child(node, 1);
-      EvalNode* right = walkAst(child(node, 2));
-      return new Logical(op, left, right);
+      OPENDDS_ASSERT(op->TypeMatches<AND>() || op->TypeMatches<OR>());
+      const size_t jump = program_.size();
+      emit(op->TypeMatches<AND>() ? OP_AND : OP_OR, 0, -1);
+      walkAst(child(node, 2));
+      program_[jump].arg_ = static_cast<unsigned int>(program_.size());
+      return;
     }
   }
 
   OPENDDS_ASSERT(0);
-  return 0;
 }
 
-FilterEvaluator::Operand*
+bool
 FilterEvaluator::walkOperand(const FilterEvaluator::AstNodeWrapper& node)
 {
   if (node->TypeMatches<FieldName>()) {
-    return new FieldLookup(node);
+    emit(OP_FIELD, add_field(toString(node)));
   } else if (node->TypeMatches<IntVal>()) {
-    return new LiteralInt(node);
+    emit(OP_CONSTANT, add_constant(parseInt(toString(node))));
   } else if (node->TypeMatches<CharVal>()) {
-    return new LiteralChar(node);
+    emit(OP_CONSTANT, add_constant(Value(toString(node)[1], true)));
   } else if (node->TypeMatches<FloatVal>()) {
-    return new LiteralFloat(node);
+    emit(OP_CONSTANT, add_constant(Value(std::atof(toString(node).c_str()), true)));
   } else if (node->TypeMatches<StrVal>()) {
-    return new LiteralString(node);
+    OPENDDS_STRING str = toString(node).substr(1); // trim left '
+    str.erase(str.length() - 1); // trim right '
+    emit(OP_CONSTANT, add_constant(Value(str.c_str(), true)));
   } else if (node->TypeMatches<ParamVal>()) {
-    Parameter* retval = new Parameter(node);
+    const unsigned int param = static_cast<unsigned int>(std::atoi(toString(node).c_str() + 1 /* skip % */));
     // Keep track of the highest parameter number
-    if (retval->param() + 1 > number_parameters_) {
-      number_parameters_ = retval->param() + 1;
+    if (param + 1 > number_parameters_) {
+      number_parameters_ = param + 1;
     }
-    return retval;
+    emit(OP_PARAMETER, param);
+    return true;
   } else if (node->TypeMatches<CallDef>()) {
     if (arity(node) == 1) {
       return walkOperand(child(node, 0));
-    } else {
-      extended_grammar_ = true;
-      Call* call = new Call(toString(child(node, 0)));
-      for (AstNode* iter = child(node, 1); iter != 0; iter = iter->GetSibling()) {
-        call->addChild(walkOperand(iter));
-      }
-      return call;
     }
+    extended_grammar_ = true;
+    const OPENDDS_STRING name = toString(child(node, 0));
+    if (name != MOD) {
+      throw std::runtime_error("Unknown function: " + std::string(name.c_str()));
+    }
+    int args = 0;
+    for (AstNode* iter = child(node, 1); iter != 0; iter = iter->GetSibling()) {
+      walkOperand(iter);
+      ++args;
+    }
+    emit(OP_MOD, static_cast<unsigned int>(args), 1 - args);
+  } else {
+    OPENDDS_ASSERT(0);
   }
-  OPENDDS_ASSERT(0);
-  return 0;
-}
-
-bool
-FilterEvaluator::eval_i(DataForEval& data) const
-{
-  return filter_root_->eval(data).b_;
+  return false;
 }
 
 OPENDDS_VECTOR(OPENDDS_STRING)
@@ -575,7 +385,48 @@ FilterEvaluator::getOrderBys() const
 bool
 FilterEvaluator::hasFilter() const
 {
-  return filter_root_ != 0;
+  return !program_.empty();
+}
+
+bool
+FilterEvaluator::simple_comparison(OPENDDS_STRING& field, Comparison& cmp,
+                                   unsigned int& param) const
+{
+  if (program_.size() != 3 || program_[2].op_ != OP_COMPARE
+      || program_[2].arg_ == CMP_LIKE) {
+    return false;
+  }
+
+  cmp = static_cast<Comparison>(program_[2].arg_);
+  if (program_[0].op_ == OP_FIELD && program_[1].op_ == OP_PARAMETER) {
+    field = fields_[program_[0].arg_];
+    param = program_[1].arg_;
+    return true;
+  }
+
+  if (program_[0].op_ == OP_PARAMETER && program_[1].op_ == OP_FIELD) {
+    field = fields_[program_[1].arg_];
+    param = program_[0].arg_;
+    switch (cmp) {
+    case CMP_LT:
+      cmp = CMP_GT;
+      break;
+    case CMP_GT:
+      cmp = CMP_LT;
+      break;
+    case CMP_LTEQ:
+      cmp = CMP_GTEQ;
+      break;
+    case CMP_GTEQ:
+      cmp = CMP_LTEQ;
+      break;
+    default:
+      break;
+    }
+    return true;
+  }
+
+  return false;
 }
 
 Value::Value(bool b, bool conversion_preferred)
@@ -840,6 +691,10 @@ namespace {
 bool
 Value::operator==(const Value& v) const
 {
+  if (type_ == v.type_) {
+    Equals visitor(*this);
+    return visit(visitor, v);
+  }
   Value lhs = *this;
   Value rhs = v;
   conversion(lhs, rhs);
@@ -850,6 +705,10 @@ Value::operator==(const Value& v) const
 bool
 Value::operator<(const Value& v) const
 {
+  if (type_ == v.type_) {
+    Less visitor(*this);
+    return visit(visitor, v);
+  }
   Value lhs = *this;
   Value rhs = v;
   conversion(lhs, rhs);
@@ -986,10 +845,251 @@ Value::conversion(Value& lhs, Value& rhs)
   }
 }
 
+struct FilterEvaluator::Operand {
+  const Value* value_;
+  /// Index in constants_, or -1 if the operand isn't a constant
+  int constant_;
+};
+
+namespace {
+  const Value true_value(true);
+  const Value false_value(false);
+
+  bool equal(const Value& lhs, const Value& rhs)
+  {
+    if (lhs.type_ != rhs.type_) {
+      return lhs == rhs;
+    }
+    Equals visitor(lhs);
+    return visit(visitor, rhs);
+  }
+
+  bool less(const Value& lhs, const Value& rhs)
+  {
+    if (lhs.type_ != rhs.type_) {
+      return lhs < rhs;
+    }
+    Less visitor(lhs);
+    return visit(visitor, rhs);
+  }
+}
+
+const Value&
+FilterEvaluator::constant_as(unsigned int constant, Value::Type type) const
+{
+  return converted_constants_[constant * VALUE_TYPES + type];
+}
+
+const Value*
+FilterEvaluator::convert_operand(const Operand& operand, const Operand& other) const
+{
+  // Value::conversion() would convert a constant compared to a value of
+  // another type that doesn't prefer conversion to that value's type.  Use
+  // the constant converted in advance instead.
+  const Value::Type type = other.value_->type_;
+  if (operand.constant_ < 0 || operand.value_->type_ == type || other.value_->conversion_preferred_
+      || !convertible_constants_[operand.constant_ * VALUE_TYPES + type]) {
+    return operand.value_;
+  }
+  return &constant_as(operand.constant_, type);
+}
+
+bool
+FilterEvaluator::compare(Comparison cmp, const Operand& left, const Operand& right) const
+{
+  if (cmp == CMP_LIKE) {
+    return left.value_->like(*right.value_);
+  }
+
+  const Value& lhs = *convert_operand(left, right);
+  const Value& rhs = *convert_operand(right, left);
+  switch (cmp) {
+  case CMP_EQ:
+    return equal(lhs, rhs);
+  case CMP_LT:
+    return less(lhs, rhs);
+  case CMP_GT:
+    return less(rhs, lhs);
+  case CMP_LTEQ:
+    return !less(rhs, lhs);
+  case CMP_GTEQ:
+    return !less(lhs, rhs);
+  case CMP_NEQ:
+    return !equal(lhs, rhs);
+  default:
+    break;
+  }
+  return false; // not reached
+}
+
+Value
+FilterEvaluator::modulus(const Operand& left, const Operand& right) const
+{
+  return *convert_operand(left, right) % *convert_operand(right, left);
+}
+
+/// The stack and values of one evaluation.  The sizes are known when the
+/// filter is compiled and are small for any realistic filter, so this uses
+/// arrays inside the object, which lives on eval_i's stack, and only
+/// allocates for filters that don't fit.
+struct FilterEvaluator::EvalState {
+  enum { INLINE_SIZE = 16 };
+
+  EvalState(size_t stack_depth, size_t temporaries, size_t fields)
+    : stack_(stack_depth <= INLINE_SIZE ? stack_inline_ : new Operand[stack_depth])
+    , stack_size_(0)
+    , temporaries_(temporaries <= INLINE_SIZE ? temporaries_inline_ : new ValueStorage[temporaries])
+    , temporaries_size_(0)
+    , fields_(fields <= INLINE_SIZE ? fields_inline_ : new const Value*[fields])
+    , stack_depth_(stack_depth)
+    , temporaries_capacity_(temporaries)
+  {
+    std::fill(fields_, fields_ + fields, static_cast<const Value*>(0));
+  }
+
+  ~EvalState()
+  {
+    for (size_t i = 0; i < temporaries_size_; ++i) {
+      temporary(i).~Value();
+    }
+    if (stack_ != stack_inline_) {
+      delete[] stack_;
+    }
+    if (temporaries_ != temporaries_inline_) {
+      delete[] temporaries_;
+    }
+    if (fields_ != fields_inline_) {
+      delete[] fields_;
+    }
+  }
+
+  void push(const Value* value, int constant = -1)
+  {
+    OPENDDS_ASSERT(stack_size_ < stack_depth_);
+    const Operand operand = {value, constant};
+    stack_[stack_size_++] = operand;
+  }
+
+  const Value* push_temporary(const Value& value)
+  {
+    OPENDDS_ASSERT(temporaries_size_ < temporaries_capacity_);
+    Value* const temp = new (&temporaries_[temporaries_size_]) Value(value);
+    ++temporaries_size_;
+    push(temp);
+    return temp;
+  }
+
+  /// The operand n places below the top of the stack.
+  Operand& top(size_t n = 0) { return stack_[stack_size_ - 1 - n]; }
+  void pop(size_t n = 1) { stack_size_ -= n; }
+
+  /// Raw storage for a Value, aligned like one.
+  union ValueStorage {
+    char bytes_[sizeof(Value)];
+    ACE_CDR::LongDouble ld_;
+    ACE_UINT64 m_;
+    double f_;
+    void* p_;
+  };
+
+  Value& temporary(size_t i) { return *reinterpret_cast<Value*>(&temporaries_[i]); }
+
+  Operand stack_inline_[INLINE_SIZE];
+  ValueStorage temporaries_inline_[INLINE_SIZE];
+  const Value* fields_inline_[INLINE_SIZE];
+
+  Operand* const stack_;
+  size_t stack_size_;
+  ValueStorage* const temporaries_;
+  size_t temporaries_size_;
+  const Value** const fields_;
+  const size_t stack_depth_;
+  const size_t temporaries_capacity_;
+
+private:
+  EvalState(const EvalState&);
+  EvalState& operator=(const EvalState&);
+};
+
+bool
+FilterEvaluator::eval_i(DataForEval& data) const
+{
+  EvalState state(max_stack_depth_, max_temporaries_, fields_.size());
+
+  for (size_t pc = 0; pc < program_.size(); ++pc) {
+    const Instruction& ins = program_[pc];
+    switch (ins.op_) {
+    case OP_FIELD:
+      if (state.fields_[ins.arg_]) {
+        state.push(state.fields_[ins.arg_]);
+      } else {
+        state.fields_[ins.arg_] = state.push_temporary(data.lookup(ins.arg_));
+      }
+      break;
+    case OP_CONSTANT:
+      state.push(&constants_[ins.arg_], static_cast<int>(ins.arg_));
+      break;
+    case OP_PARAMETER:
+      state.push_temporary(Value(data.params_[static_cast<CORBA::ULong>(ins.arg_)], true));
+      break;
+    case OP_COMPARE:
+      {
+        const bool result = compare(static_cast<Comparison>(ins.arg_), state.top(1), state.top());
+        state.pop();
+        state.top().value_ = result ? &true_value : &false_value;
+        state.top().constant_ = -1;
+      }
+      break;
+    case OP_BETWEEN:
+      {
+        const Operand& field = state.top(2);
+        const bool btwn = compare(CMP_GTEQ, field, state.top(1))
+          && compare(CMP_LTEQ, field, state.top());
+        state.pop(2);
+        state.top().value_ = (ins.arg_ ? !btwn : btwn) ? &true_value : &false_value;
+        state.top().constant_ = -1;
+      }
+      break;
+    case OP_MOD:
+      {
+        if (ins.arg_ != 2) {
+          std::stringstream ss;
+          ss << MOD << " expects 2 arguments, given " << ins.arg_;
+          throw std::runtime_error(ss.str());
+        }
+        const Value result = modulus(state.top(1), state.top());
+        state.pop(2);
+        state.push_temporary(result);
+      }
+      break;
+    case OP_NOT:
+      OPENDDS_ASSERT(state.top().value_->type_ == Value::VAL_BOOL);
+      state.top().value_ = state.top().value_->b_ ? &false_value : &true_value;
+      break;
+    case OP_AND:
+    case OP_OR:
+      OPENDDS_ASSERT(state.top().value_->type_ == Value::VAL_BOOL);
+      if (state.top().value_->b_ == (ins.op_ == OP_OR)) {
+        pc = ins.arg_ - 1;
+      } else {
+        state.pop();
+      }
+      break;
+    }
+  }
+
+  return state.top().value_->b_;
+}
+
 MetaStruct::~MetaStruct()
 {
 }
 
+FieldReader::Ptr MetaStruct::getFieldReader(const char* fieldSpec) const
+{
+  return make_rch<NamedFieldReader>(*this, fieldSpec);
+}
+
 }
 }
 
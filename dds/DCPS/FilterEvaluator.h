@@ -14,9 +14,12 @@
 
 #include "dds/DdsDcpsInfrastructureC.h"
 #include "PoolAllocator.h"
+#include "Atomic.h"
 #include "Comparator_T.h"
 #include "RcObject.h"
 
+#include <ace/Thread_Mutex.h>
+
 #include <dds/DdsDynamicDataC.h>
 
 #include <string>
@@ -88,6 +91,20 @@ struct OpenDDS_Dcps_Export Value {
   bool conversion_preferred_;
 };
 
+/**
+ * Reads one field of a deserialized struct.  MetaStruct::getFieldReader
+ * resolves the field name once, so FilterEvaluator doesn't compare it to the
+ * names of the struct's fields every time it evaluates a sample.
+ */
+class OpenDDS_Dcps_Export FieldReader : public virtual RcObject {
+public:
+  typedef RcHandle<FieldReader> Ptr;
+
+  virtual ~FieldReader();
+
+  virtual Value read(const void* stru) const = 0;
+};
+
 class OpenDDS_Dcps_Export FilterEvaluator : public virtual RcObject {
 public:
 
@@ -109,13 +126,26 @@ public:
 
   bool has_non_key_fields(const TypeSupportImpl& ts) const;
 
+  enum Comparison {
+    CMP_EQ, CMP_LT, CMP_GT, CMP_LTEQ, CMP_GTEQ, CMP_NEQ, CMP_LIKE
+  };
+
+  /**
+   * Returns true if the filter is a single comparison of a field to a
+   * parameter, for example "x < %0" or "%1 = y".  The comparison is returned
+   * with the field on the left-hand side.  LIKE is not reported.
+   */
+  bool simple_comparison(OPENDDS_STRING& field, Comparison& cmp,
+                         unsigned int& param) const;
+
   /**
    * Returns true if the unserialized sample matches the filter.
    */
   template<typename T>
   bool eval(const T& sample, const DDS::StringSeq& params) const
   {
-    DeserializedForEval data(&sample, getMetaStruct<T>(), params);
+    const MetaStruct& meta = getMetaStruct<T>();
+    DeserializedForEval data(&sample, meta, params, field_readers(meta));
     return eval_i(data);
   }
 
@@ -126,18 +156,16 @@ public:
             const TypeSupportImpl& typeSupport,
             const DDS::StringSeq& params) const
   {
-    SerializedForEval data(serializedSample, typeSupport, params, encoding);
+    SerializedForEval data(serializedSample, typeSupport, params, encoding, fields_);
     return eval_i(data);
   }
 
-  class EvalNode;
-  class Operand;
-
   struct OpenDDS_Dcps_Export DataForEval {
     DataForEval(const MetaStruct& meta, const DDS::StringSeq& params)
       : meta_(meta), params_(params) {}
     virtual ~DataForEval();
-    virtual Value lookup(const char* field) const = 0;
+    /// Value of fields_[field] of the FilterEvaluator
+    virtual Value lookup(unsigned int field) const = 0;
     const MetaStruct& meta_;
     const DDS::StringSeq& params_;
   private:
@@ -149,33 +177,97 @@ private:
   FilterEvaluator(const FilterEvaluator&);
   FilterEvaluator& operator=(const FilterEvaluator&);
 
-  EvalNode* walkAst(const AstNodeWrapper& node);
-  Operand* walkOperand(const AstNodeWrapper& node);
+  /**
+   * The filter is compiled to a program for a stack machine.  Operands push
+   * a Value, comparisons and MOD replace their operands with the result.
+   * AND and OR skip to arg_ if the top of the stack decides the result,
+   * otherwise they pop it and evaluate their right-hand side.
+   */
+  enum OpCode {
+    OP_FIELD,     ///< push fields_[arg_]
+    OP_CONSTANT,  ///< push constants_[arg_]
+    OP_PARAMETER, ///< push parameter %arg_
+    OP_COMPARE,   ///< compare using Comparison arg_
+    OP_BETWEEN,   ///< field BETWEEN low AND high, negated if arg_ is nonzero
+    OP_MOD,       ///< MOD with arg_ arguments
+    OP_NOT,
+    OP_AND,
+    OP_OR
+  };
+
+  struct Instruction {
+    OpCode op_;
+    unsigned int arg_;
+  };
+
+  struct Operand;
+  struct EvalState;
+
+  void walkAst(const AstNodeWrapper& node);
+  /// Returns true if the operand is a parameter
+  bool walkOperand(const AstNodeWrapper& node);
+  void emit(OpCode op, unsigned int arg = 0, int stack_change = 1);
+  unsigned int add_constant(const Value& value);
+  unsigned int add_field(const OPENDDS_STRING& name);
+
+  const Value& constant_as(unsigned int constant, Value::Type type) const;
+  const Value* convert_operand(const Operand& operand, const Operand& other) const;
+  bool compare(Comparison cmp, const Operand& left, const Operand& right) const;
+  Value modulus(const Operand& left, const Operand& right) const;
+
+  /// A FieldReader for each of fields_, resolved for one MetaStruct
+  struct FieldReaders {
+    const MetaStruct* meta_;
+    OPENDDS_VECTOR(FieldReader::Ptr) readers_;
+  };
+
+  const FieldReaders& field_readers(const MetaStruct& meta) const;
 
   struct OpenDDS_Dcps_Export DeserializedForEval : DataForEval {
     DeserializedForEval(const void* data, const MetaStruct& meta,
-                        const DDS::StringSeq& params)
-      : DataForEval(meta, params), deserialized_(data) {}
+                        const DDS::StringSeq& params, const FieldReaders& readers)
+      : DataForEval(meta, params), deserialized_(data), readers_(readers) {}
     virtual ~DeserializedForEval();
-    Value lookup(const char* field) const;
+    Value lookup(unsigned int field) const;
     const void* const deserialized_;
+    const FieldReaders& readers_;
   };
 
   struct SerializedForEval : DataForEval {
     SerializedForEval(ACE_Message_Block* data, const TypeSupportImpl& type_support,
-                      const DDS::StringSeq& params, Encoding encoding);
-    Value lookup(const char* field) const;
+                      const DDS::StringSeq& params, Encoding encoding,
+                      const OPENDDS_VECTOR(OPENDDS_STRING)& fields);
+    Value lookup(unsigned int field) const;
     ACE_Message_Block* serialized_;
     Encoding encoding_;
     const TypeSupportImpl& type_support_;
-    mutable OPENDDS_MAP(OPENDDS_STRING, Value) cache_;
     Extensibility exten_;
+    const OPENDDS_VECTOR(OPENDDS_STRING)& fields_;
   };
 
   bool eval_i(DataForEval& data) const;
 
   bool extended_grammar_;
-  EvalNode* filter_root_;
+  OPENDDS_VECTOR(Instruction) program_;
+  /// Distinct fields used by the filter, each is looked up at most once per
+  /// evaluation
+  OPENDDS_VECTOR(OPENDDS_STRING) fields_;
+  /// Readers of fields_ for each MetaStruct the filter has been evaluated
+  /// with, usually just one.  The list isn't changed after an element is
+  /// added, so the last one used can be read without field_readers_lock_.
+  mutable ACE_Thread_Mutex field_readers_lock_;
+  mutable OPENDDS_LIST(FieldReaders) field_readers_;
+  mutable Atomic<const FieldReaders*> last_field_readers_;
+  OPENDDS_VECTOR(Value) constants_;
+  /// Each constant converted to each Value::Type, so comparing it to a field
+  /// of another type doesn't convert it every time.  A constant that can't
+  /// be converted to the type is left as is and converting it again throws.
+  OPENDDS_VECTOR(Value) converted_constants_;
+  OPENDDS_VECTOR(bool) convertible_constants_;
+  size_t stack_depth_;
+  size_t max_stack_depth_;
+  /// Number of Values an evaluation creates at most
+  size_t max_temporaries_;
   OPENDDS_VECTOR(OPENDDS_STRING) order_bys_;
   /// Number of parameters used in the filter, this should
   /// match the number of values passed when evaluating the filter
@@ -190,6 +282,11 @@ public:
   virtual Value getValue(const void* stru, const char* fieldSpec) const = 0;
   virtual Value getValue(Serializer& ser, const char* fieldSpec, const TypeSupportImpl* ts = 0) const = 0;
 
+  /// Returns a reader of the field for FilterEvaluator.  opendds_idl
+  /// generates readers that access the members directly.  This default, used
+  /// for the fields that they don't cover, calls getValue with the name.
+  virtual FieldReader::Ptr getFieldReader(const char* fieldSpec) const;
+
   virtual ComparatorBase::Ptr create_qc_comparator(const char* fieldSpec,
     ComparatorBase::Ptr next) const = 0;
 
@@ -221,6 +318,53 @@ public:
 template<typename T>
 struct MetaStructImpl;
 
+/// Reads a scalar member of Sample, see FieldComparator in Comparator_T.h
+template <class Sample, class Field>
+class MemberFieldReader : public FieldReader {
+public:
+  typedef Field Sample::* MemberPtr;
+  explicit MemberFieldReader(MemberPtr mp) : mp_(mp) {}
+
+  Value read(const void* stru) const
+  {
+    return Value(static_cast<const Sample*>(stru)->*mp_);
+  }
+
+private:
+  MemberPtr mp_;
+};
+
+template <class Sample, class Field>
+FieldReader::Ptr make_member_reader(Field Sample::* mp)
+{
+  return make_rch<MemberFieldReader<Sample, Field> >(mp);
+}
+
+/// Reads a field of a nested struct member of Sample with the reader of the
+/// nested struct's field, see StructComparator in Comparator_T.h
+template <class Sample, class Field>
+class NestedFieldReader : public FieldReader {
+public:
+  typedef Field Sample::* MemberPtr;
+  NestedFieldReader(MemberPtr mp, const FieldReader::Ptr& delegate)
+    : mp_(mp), delegate_(delegate) {}
+
+  Value read(const void* stru) const
+  {
+    return delegate_->read(&(static_cast<const Sample*>(stru)->*mp_));
+  }
+
+private:
+  MemberPtr mp_;
+  FieldReader::Ptr delegate_;
+};
+
+template <class Sample, class Field>
+FieldReader::Ptr make_nested_reader(Field Sample::* mp, const FieldReader::Ptr& delegate)
+{
+  return make_rch<NestedFieldReader<Sample, Field> >(mp, delegate);
+}
+
 }  }
 
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,236 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "InstanceKeyIndex.h"
+
+#include "Hash.h"
+
+#include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  const size_t initial_slots = 16;
+}
+
+InstanceKeyIndex::InstanceKeyIndex()
+  : key_slots_(initial_slots, 0)
+  , handle_slots_(initial_slots, 0)
+  , first_(npos)
+  , last_(npos)
+{
+}
+
+const Encoding&
+InstanceKeyIndex::key_encoding()
+{
+  // XCDR2 because DynamicDataImpl can't serialize structures as XCDR1
+  static const Encoding encoding(Encoding::KIND_XCDR2, ENDIAN_BIG);
+  return encoding;
+}
+
+ACE_UINT32
+InstanceKeyIndex::hash(const char* key, size_t size)
+{
+  return one_at_a_time_hash(reinterpret_cast<const uint8_t*>(key), size);
+}
+
+ACE_UINT32
+InstanceKeyIndex::hash(DDS::InstanceHandle_t handle)
+{
+  // Handles are mostly consecutive, so spread them with Fibonacci hashing
+  return static_cast<ACE_UINT32>(handle) * 2654435769u;
+}
+
+size_t
+InstanceKeyIndex::probe(const char* key, size_t size, ACE_UINT32 hash) const
+{
+  const size_t mask = key_slots_.size() - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    if (!key_slots_[i]) {
+      return i;
+    }
+    const Entry& entry = entries_[key_slots_[i] - 1];
+    if (entry.hash_ == hash && entry.key_.size() == size &&
+        std::memcmp(entry.key_.data(), key, size) == 0) {
+      return i;
+    }
+  }
+}
+
+size_t
+InstanceKeyIndex::probe(DDS::InstanceHandle_t handle) const
+{
+  const size_t mask = handle_slots_.size() - 1;
+  for (size_t i = hash(handle) & mask;; i = (i + 1) & mask) {
+    if (!handle_slots_[i] || entries_[handle_slots_[i] - 1].handle_ == handle) {
+      return i;
+    }
+  }
+}
+
+size_t
+InstanceKeyIndex::key_slot_of(size_t entry) const
+{
+  const size_t mask = key_slots_.size() - 1;
+  for (size_t i = entries_[entry].hash_ & mask;; i = (i + 1) & mask) {
+    if (key_slots_[i] == entry + 1) {
+      return i;
+    }
+  }
+}
+
+size_t
+InstanceKeyIndex::home(ACE_UINT32 slot, bool by_handle) const
+{
+  const Entry& entry = entries_[slot - 1];
+  return by_handle ? hash(entry.handle_) : entry.hash_;
+}
+
+void
+InstanceKeyIndex::erase_slot(Slots& slots, size_t hole, bool by_handle)
+{
+  // Backward shift deletion: move later slots of the probe sequence into the
+  // hole unless their home slot is after it, so no tombstones are needed.
+  const size_t mask = slots.size() - 1;
+  for (size_t i = (hole + 1) & mask; slots[i]; i = (i + 1) & mask) {
+    const size_t h = home(slots[i], by_handle) & mask;
+    const bool stays = hole < i ? (hole < h && h <= i) : (hole < h || h <= i);
+    if (!stays) {
+      slots[hole] = slots[i];
+      hole = i;
+    }
+  }
+  slots[hole] = 0;
+}
+
+void
+InstanceKeyIndex::grow()
+{
+  const size_t size = key_slots_.size() * 2;
+  Slots(size, 0).swap(key_slots_);
+  Slots(size, 0).swap(handle_slots_);
+  const size_t mask = size - 1;
+  for (size_t e = 0; e < entries_.size(); ++e) {
+    size_t i = entries_[e].hash_ & mask;
+    while (key_slots_[i]) {
+      i = (i + 1) & mask;
+    }
+    key_slots_[i] = static_cast<ACE_UINT32>(e + 1);
+    handle_slots_[probe(entries_[e].handle_)] = static_cast<ACE_UINT32>(e + 1);
+  }
+}
+
+DDS::InstanceHandle_t
+InstanceKeyIndex::find(const ACE_Message_Block& key) const
+{
+  const ACE_UINT32 slot = key_slots_[probe(key.rd_ptr(), key.length(), hash(key.rd_ptr(), key.length()))];
+  return slot ? entries_[slot - 1].handle_ : DDS::HANDLE_NIL;
+}
+
+bool
+InstanceKeyIndex::insert(const ACE_Message_Block& key, DDS::InstanceHandle_t handle)
+{
+  // Keep the load factor at most 3/4
+  if ((entries_.size() + 1) * 4 > key_slots_.size() * 3) {
+    grow();
+  }
+
+  const size_t handle_slot = probe(handle);
+  if (handle_slots_[handle_slot]) {
+    return false;
+  }
+
+  const ACE_UINT32 h = hash(key.rd_ptr(), key.length());
+  const size_t key_slot = probe(key.rd_ptr(), key.length(), h);
+  if (key_slots_[key_slot]) {
+    return false;
+  }
+
+  const ACE_UINT32 e = static_cast<ACE_UINT32>(entries_.size());
+  entries_.push_back(Entry());
+  Entry& entry = entries_.back();
+  entry.key_.assign(key.rd_ptr(), key.length());
+  entry.hash_ = h;
+  entry.handle_ = handle;
+  entry.prev_ = last_;
+  entry.next_ = npos;
+  if (last_ == npos) {
+    first_ = e;
+  } else {
+    entries_[last_].next_ = e;
+  }
+  last_ = e;
+
+  key_slots_[key_slot] = e + 1;
+  handle_slots_[handle_slot] = e + 1;
+  return true;
+}
+
+bool
+InstanceKeyIndex::erase(DDS::InstanceHandle_t handle)
+{
+  const size_t handle_slot = probe(handle);
+  if (!handle_slots_[handle_slot]) {
+    return false;
+  }
+  const ACE_UINT32 e = handle_slots_[handle_slot] - 1;
+
+  erase_slot(key_slots_, key_slot_of(e), false);
+  erase_slot(handle_slots_, handle_slot, true);
+
+  const Entry& entry = entries_[e];
+  (entry.prev_ == npos ? first_ : entries_[entry.prev_].next_) = entry.next_;
+  (entry.next_ == npos ? last_ : entries_[entry.next_].prev_) = entry.prev_;
+
+  // Keep entries_ dense by moving the last entry into the erased one
+  const ACE_UINT32 moved = static_cast<ACE_UINT32>(entries_.size() - 1);
+  if (e != moved) {
+    Entry& to = entries_[e];
+    Entry& from = entries_[moved];
+    key_slots_[key_slot_of(moved)] = e + 1;
+    handle_slots_[probe(from.handle_)] = e + 1;
+    to.key_.swap(from.key_);
+    to.hash_ = from.hash_;
+    to.handle_ = from.handle_;
+    to.prev_ = from.prev_;
+    to.next_ = from.next_;
+    (to.prev_ == npos ? first_ : entries_[to.prev_].next_) = e;
+    (to.next_ == npos ? last_ : entries_[to.next_].prev_) = e;
+  }
+  entries_.pop_back();
+  return true;
+}
+
+const String*
+InstanceKeyIndex::key(DDS::InstanceHandle_t handle) const
+{
+  const ACE_UINT32 slot = handle_slots_[probe(handle)];
+  return slot ? &entries_[slot - 1].key_ : 0;
+}
+
+DDS::InstanceHandle_t
+InstanceKeyIndex::next(DDS::InstanceHandle_t handle) const
+{
+  ACE_UINT32 e = first_;
+  if (handle != DDS::HANDLE_NIL) {
+    const ACE_UINT32 slot = handle_slots_[probe(handle)];
+    if (!slot) {
+      return DDS::HANDLE_NIL;
+    }
+    e = entries_[slot - 1].next_;
+  }
+  return e == npos ? DDS::HANDLE_NIL : entries_[e].handle_;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,123 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_INSTANCEKEYINDEX_H
+#define OPENDDS_DCPS_INSTANCEKEYINDEX_H
+
+#include "dcps_export.h"
+#include "PoolAllocator.h"
+#include "Serializer.h"
+
+#include <dds/DdsDcpsInfrastructureC.h>
+
+#include <ace/Message_Block.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Index of instance handles by serialized key, an alternative to a map keyed
+ * on a copy of a sample.  Keys are serialized with key_encoding(), so equal
+ * keys have equal bytes.  Only the key bytes are stored, in a flat hash table
+ * using open addressing with linear probing.  A second table of the same kind
+ * finds entries by handle, and the entries are linked in the order they were
+ * inserted for iterating over the instances.
+ */
+class OpenDDS_Dcps_Export InstanceKeyIndex {
+public:
+  InstanceKeyIndex();
+
+  static const Encoding& key_encoding();
+
+  /// Returns HANDLE_NIL if the key isn't in the index
+  DDS::InstanceHandle_t find(const ACE_Message_Block& key) const;
+
+  /// Returns false if the key or handle is already in the index
+  bool insert(const ACE_Message_Block& key, DDS::InstanceHandle_t handle);
+
+  bool erase(DDS::InstanceHandle_t handle);
+
+  /// Returns the serialized key of the instance or null if it's not in the index
+  const String* key(DDS::InstanceHandle_t handle) const;
+
+  /// Returns the handle inserted after handle, or the first handle if handle
+  /// is HANDLE_NIL.  Returns HANDLE_NIL at the end or if handle isn't in the
+  /// index.  Erasing handle after getting the next one doesn't affect the
+  /// iteration.
+  DDS::InstanceHandle_t next(DDS::InstanceHandle_t handle) const;
+
+  size_t size() const { return entries_.size(); }
+
+private:
+  static const ACE_UINT32 npos = 0xffffffff;
+
+  struct Entry {
+    String key_;
+    ACE_UINT32 hash_;
+    DDS::InstanceHandle_t handle_;
+    /// Neighbors in insertion order, npos at the ends
+    ACE_UINT32 prev_;
+    ACE_UINT32 next_;
+  };
+
+  /// Each slot is an index in entries_ plus one, zero means the slot is empty
+  typedef OPENDDS_VECTOR(ACE_UINT32) Slots;
+
+  static ACE_UINT32 hash(const char* key, size_t size);
+  static ACE_UINT32 hash(DDS::InstanceHandle_t handle);
+
+  /// The slot in key_slots_ that has the key or the empty slot it would be
+  /// inserted at
+  size_t probe(const char* key, size_t size, ACE_UINT32 hash) const;
+
+  /// The slot in handle_slots_ that has the handle or the empty slot it would
+  /// be inserted at
+  size_t probe(DDS::InstanceHandle_t handle) const;
+
+  /// The slot in key_slots_ that refers to entries_[entry]
+  size_t key_slot_of(size_t entry) const;
+
+  /// Empty the slot at hole, moving later slots of its probe sequence back
+  void erase_slot(Slots& slots, size_t hole, bool by_handle);
+
+  /// Where an entry's probe sequence starts in key_slots_ or handle_slots_
+  size_t home(ACE_UINT32 slot, bool by_handle) const;
+
+  void grow();
+
+  Slots key_slots_;
+  Slots handle_slots_;
+  OPENDDS_VECTOR(Entry) entries_;
+  ACE_UINT32 first_;
+  ACE_UINT32 last_;
+};
+
+/// Serialize key, which is usually a KeyOnly wrapper, to buffer for use with
+/// InstanceKeyIndex.  buffer is reset first and grown if needed.
+template <typename Key>
+bool serialize_instance_key(ACE_Message_Block& buffer, const Key& key)
+{
+  const Encoding& encoding = InstanceKeyIndex::key_encoding();
+  const size_t size = serialized_size(encoding, key);
+  buffer.reset();
+  if (buffer.space() < size && buffer.size(size) != 0) {
+    return false;
+  }
+  Serializer ser(&buffer, encoding);
+  return ser << key;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_INSTANCEKEYINDEX_H */
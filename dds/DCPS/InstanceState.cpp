@@ -6,8 +6,6 @@
  */
 
 #include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
-#include "ace/Event_Handler.h"
-#include "ace/Reactor.h"
 #include "InstanceState.h"
 #include "DataReaderImpl.h"
 #include "SubscriptionInstance.h"
@@ -28,9 +26,7 @@ namespace DCPS {
 InstanceState::InstanceState(const DataReaderImpl_rch& reader,
                              ACE_Recursive_Thread_Mutex& lock,
                              DDS::InstanceHandle_t handle)
-  : ReactorInterceptor(TheServiceParticipant->reactor(),
-                       TheServiceParticipant->reactor_owner()),
-    lock_(lock),
+  : lock_(lock),
     instance_state_(0),
     view_state_(0),
     disposed_generation_count_(0),
@@ -38,6 +34,7 @@ InstanceState::InstanceState(const DataReaderImpl_rch& reader,
     empty_(true),
     release_pending_(false),
     release_timer_id_(-1),
+    timer_dispatcher_(TheServiceParticipant->timer_dispatcher()),
     reader_(reader),
     handle_(handle),
     owner_(GUID_UNKNOWN),
@@ -45,10 +42,15 @@ InstanceState::InstanceState(const DataReaderImpl_rch& reader,
     exclusive_(reader->qos_.ownership.kind == DDS::EXCLUSIVE_OWNERSHIP_QOS),
 #endif
     registered_(false)
-{}
+{
+  release_event_ = make_rch<PmfEvent<InstanceState> >(rchandle_from(this), &InstanceState::release_timeout);
+}
 
 InstanceState::~InstanceState()
 {
+  if (release_timer_id_ != -1 && timer_dispatcher_) {
+    timer_dispatcher_->cancel(release_timer_id_);
+  }
 #ifndef OPENDDS_NO_OWNERSHIP_KIND_EXCLUSIVE
   if (registered_) {
     RcHandle<DataReaderImpl> reader = reader_.lock();
@@ -100,20 +102,27 @@ void InstanceState::sample_info(DDS::SampleInfo& si, const ReceivedDataElement*
 
 // cannot ACE_INLINE because of #include loop
 
-int InstanceState::handle_timeout(const ACE_Time_Value&, const void*)
+void InstanceState::release_timeout()
 {
   ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
 
+  {
+    ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, lock_);
+    if (release_timer_id_ == -1 || MonotonicTimePoint::now() < release_deadline_) {
+      // Canceled or rescheduled after the timer expired.
+      return;
+    }
+    release_timer_id_ = -1;
+  }
+
   if (DCPS_debug_level) {
     ACE_DEBUG((LM_NOTICE,
                ACE_TEXT("(%P|%t) NOTICE:")
-               ACE_TEXT(" InstanceState::handle_timeout:")
+               ACE_TEXT(" InstanceState::release_timeout:")
                ACE_TEXT(" autopurging samples with instance handle 0x%x!\n"),
                handle_));
   }
   release();
-
-  return 0;
 }
 
 bool InstanceState::dispose_was_received(const GUID_t& writer_id)
@@ -226,7 +235,20 @@ void InstanceState::schedule_release()
   if (delay.sec != DDS::DURATION_INFINITE_SEC &&
       delay.nanosec != DDS::DURATION_INFINITE_NSEC) {
 
-    execute_or_enqueue(make_rch<ScheduleCommand>(this, TimeDuration(delay)));
+    if (release_timer_id_ != -1 && timer_dispatcher_) {
+      timer_dispatcher_->cancel(release_timer_id_);
+    }
+
+    release_deadline_ = MonotonicTimePoint::now() + TimeDuration(delay);
+    release_timer_id_ = timer_dispatcher_ ?
+      timer_dispatcher_->schedule(release_event_, release_deadline_) : -1;
+
+    if (release_timer_id_ < 0) {
+      release_timer_id_ = -1;
+      ACE_ERROR((LM_ERROR,
+                 ACE_TEXT("(%P|%t) ERROR: InstanceState::schedule_release:")
+                 ACE_TEXT(" Unable to schedule timer!\n")));
+    }
 
   } else {
     // N.B. instance transitions are always followed by a non-valid
@@ -240,7 +262,12 @@ void InstanceState::schedule_release()
 void InstanceState::cancel_release()
 {
   release_pending_ = false;
-  execute_or_enqueue(make_rch<CancelCommand>(this));
+  if (release_timer_id_ != -1) {
+    if (timer_dispatcher_) {
+      timer_dispatcher_->cancel(release_timer_id_);
+    }
+    release_timer_id_ = -1;
+  }
 }
 
 bool InstanceState::release_if_empty()
@@ -312,35 +339,6 @@ bool InstanceState::most_recent_generation(ReceivedDataElement* item) const
     && item->no_writers_generation_count_ == no_writers_generation_count_;
 }
 
-bool InstanceState::reactor_is_shut_down() const
-{
-  return TheServiceParticipant->is_shut_down();
-}
-
-void InstanceState::CancelCommand::execute()
-{
-  if (instance_state_->release_timer_id_ != -1) {
-    instance_state_->reactor()->cancel_timer(instance_state_);
-    instance_state_->release_timer_id_ = -1;
-  }
-}
-
-void InstanceState::ScheduleCommand::execute()
-{
-  if (instance_state_->release_timer_id_ != -1) {
-    instance_state_->reactor()->cancel_timer(instance_state_);
-  }
-
-  instance_state_->release_timer_id_ =
-    instance_state_->reactor()->schedule_timer(instance_state_, 0, delay_.value());
-
-  if (instance_state_->release_timer_id_ == -1) {
-    ACE_ERROR((LM_ERROR,
-               ACE_TEXT("(%P|%t) ERROR: InstanceState::ScheduleCommand::execute:")
-               ACE_TEXT(" Unable to schedule timer!\n")));
-  }
-}
-
 const char* InstanceState::instance_state_string(DDS::InstanceStateKind value)
 {
   switch (value) {
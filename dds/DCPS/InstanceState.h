@@ -10,11 +10,13 @@
 
 #include "dcps_export.h"
 #include "ace/Time_Value.h"
+#include "ace/Recursive_Thread_Mutex.h"
+#include "ace/Thread_Mutex.h"
 #include "dds/DdsDcpsInfrastructureC.h"
 #include "Definitions.h"
 #include "GuidUtils.h"
 #include "PoolAllocator.h"
-#include "ReactorInterceptor.h"
+#include "EventDispatcher.h"
 #include "TimeTypes.h"
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
@@ -46,7 +48,7 @@ class ReceivedDataElement;
  * Accessors are provided to query the current value of each of
  * these states.
  */
-class OpenDDS_Dcps_Export InstanceState : public ReactorInterceptor {
+class OpenDDS_Dcps_Export InstanceState : public virtual RcObject {
 public:
   InstanceState(const DataReaderImpl_rch& reader,
                 ACE_Recursive_Thread_Mutex& lock,
@@ -127,9 +129,6 @@ public:
   WeakRcHandle<DataReaderImpl> data_reader() const;
   void state_updated() const;
 
-  virtual int handle_timeout(const ACE_Time_Value& current_time,
-                             const void* arg);
-
   void set_owner (const GUID_t& owner);
   GUID_t get_owner ();
   bool is_exclusive () const;
@@ -153,7 +152,8 @@ public:
   static OPENDDS_STRING instance_state_mask_string(DDS::InstanceStateMask mask);
 
 private:
-  bool reactor_is_shut_down() const;
+  /// Autopurge delay expired, called by the timer dispatcher.
+  void release_timeout();
 
   ACE_Recursive_Thread_Mutex& lock_;
   ACE_Thread_Mutex owner_lock_;
@@ -210,6 +210,12 @@ private:
    * Keep track of a scheduled release timer.
    */
   long release_timer_id_;
+  /// When the scheduled release is due.  release_event_ is shared by every
+  /// timer this schedules, so this tells a replaced timer that has already
+  /// expired from the current one.
+  MonotonicTimePoint release_deadline_;
+  EventDispatcher_rch timer_dispatcher_;
+  RcHandle<EventBase> release_event_;
 
   /**
    * Reference to our containing reader.  This is used to call back
@@ -226,33 +232,6 @@ private:
   /// registered with participant so it can be called back as
   /// the owner is updated.
   bool registered_;
-
-  struct CommandBase : Command {
-    explicit CommandBase(InstanceState* instance_state)
-      : instance_state_(instance_state)
-    {}
-
-    InstanceState* instance_state_;
-  };
-
-  struct CancelCommand : CommandBase {
-    explicit CancelCommand(InstanceState* instance_state)
-      : CommandBase(instance_state)
-    {}
-
-    void execute();
-  };
-
-  struct ScheduleCommand : CommandBase {
-    ScheduleCommand(InstanceState* instance_state, const TimeDuration& delay)
-      : CommandBase(instance_state)
-      , delay_(delay)
-    {}
-
-    const TimeDuration delay_;
-    void execute();
-  };
-
 };
 
 } // namespace DCPS
@@ -0,0 +1,145 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "LatencyHistogram.h"
+
+#include <cmath>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+LatencyHistogram::Snapshot::Snapshot()
+  : counts(BUCKET_COUNT, 0)
+  , total(0)
+{
+}
+
+TimeDuration LatencyHistogram::Snapshot::percentile(double fraction) const
+{
+  if (total == 0) {
+    return TimeDuration::zero_value;
+  }
+
+  ACE_UINT64 rank = static_cast<ACE_UINT64>(std::ceil(fraction * static_cast<double>(total)));
+  if (rank == 0) {
+    rank = 1;
+  } else if (rank > total) {
+    rank = total;
+  }
+
+  ACE_UINT64 seen = 0;
+  size_t i = 0;
+  for (; i < BUCKET_COUNT - 1; ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      break;
+    }
+  }
+  const ACE_UINT64 usec = bucket_limit(i);
+  return TimeDuration(static_cast<time_t>(usec / 1000000), static_cast<suseconds_t>(usec % 1000000));
+}
+
+void LatencyHistogram::Snapshot::moments(double& mean, double& variance) const
+{
+  mean = 0;
+  variance = 0;
+  if (total == 0) {
+    return;
+  }
+
+  double sum = 0;
+  double sum_squares = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    if (counts[i]) {
+      const double low = i ? static_cast<double>(bucket_limit(i - 1) + 1) : 0;
+      const double mid = (low + static_cast<double>(bucket_limit(i))) / 2e6;
+      const double count = static_cast<double>(counts[i]);
+      sum += count * mid;
+      sum_squares += count * mid * mid;
+    }
+  }
+  const double n = static_cast<double>(total);
+  mean = sum / n;
+  variance = sum_squares / n - mean * mean;
+  if (variance < 0) {
+    variance = 0;
+  }
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+  reset();
+}
+
+void LatencyHistogram::record(const TimeDuration& latency)
+{
+  const ACE_Time_Value& tv = latency.value();
+  if (tv < ACE_Time_Value::zero) {
+    // The writer's clock is ahead of this one.
+    ++counts_[0];
+    return;
+  }
+  ACE_UINT64 usec;
+  tv.to_usec(usec);
+  ++counts_[bucket_index(usec)];
+}
+
+void LatencyHistogram::reset()
+{
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    counts_[i] = 0;
+  }
+}
+
+void LatencyHistogram::snapshot(Snapshot& snap) const
+{
+  snap.counts.assign(BUCKET_COUNT, 0);
+  snap.total = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    snap.counts[i] = counts_[i].load();
+    snap.total += snap.counts[i];
+  }
+}
+
+size_t LatencyHistogram::bucket_index(ACE_UINT64 usec)
+{
+  if (usec < SUB_BUCKETS) {
+    return static_cast<size_t>(usec);
+  }
+
+  unsigned int msb = SUB_BUCKET_BITS;
+  while (msb < MAX_BITS - 1 && (usec >> (msb + 1)) != 0) {
+    ++msb;
+  }
+  if ((usec >> (msb + 1)) != 0) {
+    return BUCKET_COUNT - 1;
+  }
+  // The top SUB_BUCKET_BITS bits of the value, of which the highest is set.
+  const size_t sub = static_cast<size_t>(usec >> (msb - (SUB_BUCKET_BITS - 1)));
+  return SUB_BUCKETS + (msb - SUB_BUCKET_BITS) * HALF_SUB_BUCKETS + (sub - HALF_SUB_BUCKETS);
+}
+
+ACE_UINT64 LatencyHistogram::bucket_limit(size_t index)
+{
+  if (index < SUB_BUCKETS) {
+    return index;
+  }
+
+  const size_t j = index - SUB_BUCKETS;
+  const unsigned int shift = static_cast<unsigned int>(j / HALF_SUB_BUCKETS) + 1;
+  const ACE_UINT64 sub = HALF_SUB_BUCKETS + j % HALF_SUB_BUCKETS;
+  return ((sub + 1) << shift) - 1;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,88 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_LATENCY_HISTOGRAM_H
+#define OPENDDS_DCPS_LATENCY_HISTOGRAM_H
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "Atomic.h"
+#include "PoolAllocator.h"
+#include "RcObject.h"
+#include "TimeDuration.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * LatencyHistogram counts latencies in log-linear buckets
+ *
+ * Latencies are counted in microseconds. Values below 32us each have their
+ * own bucket, and every power of two above that is split into 16 buckets, so
+ * a percentile is reported within about 6% of the true value. Latencies of
+ * more than 2^36us (about 19 hours) are counted in the last bucket.
+ *
+ * record only increments atomic counters, so it can be called without a lock
+ * while the counts are read by snapshot.
+ */
+class OpenDDS_Dcps_Export LatencyHistogram : public virtual RcObject {
+public:
+  static const unsigned int SUB_BUCKET_BITS = 5;
+  static const unsigned int SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+  static const unsigned int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+  static const unsigned int MAX_BITS = 36;
+  static const size_t BUCKET_COUNT = SUB_BUCKETS + (MAX_BITS - SUB_BUCKET_BITS) * HALF_SUB_BUCKETS;
+
+  struct OpenDDS_Dcps_Export Snapshot {
+    Snapshot();
+
+    /// The latency that 'fraction' (0 to 1) of the counted latencies are at
+    /// or below, rounded up to the top of its bucket. Zero if nothing was
+    /// counted.
+    TimeDuration percentile(double fraction) const;
+
+    /// The mean and variance of the counted latencies in seconds, taking
+    /// each latency to be the middle of its bucket. Zero if nothing was
+    /// counted.
+    void moments(double& mean, double& variance) const;
+
+    OPENDDS_VECTOR(ACE_UINT64) counts;
+    ACE_UINT64 total;
+  };
+
+  LatencyHistogram();
+
+  void record(const TimeDuration& latency);
+
+  /// Set all the counts to zero.
+  void reset();
+
+  /// Read the counts. Latencies recorded while this is running may or may
+  /// not be included.
+  void snapshot(Snapshot& snap) const;
+
+  static size_t bucket_index(ACE_UINT64 usec);
+
+  /// The largest latency in microseconds counted by the bucket at 'index'.
+  static ACE_UINT64 bucket_limit(size_t index);
+
+private:
+  Atomic<ACE_UINT64> counts_[BUCKET_COUNT];
+};
+
+typedef RcHandle<LatencyHistogram> LatencyHistogram_rch;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_LATENCY_HISTOGRAM_H */
@@ -0,0 +1,76 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_LOANEDSAMPLE_H
+#define OPENDDS_DCPS_LOANEDSAMPLE_H
+
+#include "Message_Block_Ptr.h"
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class DataWriterImpl;
+
+/**
+ * A buffer that the DataWriter's transport loaned for writing one sample
+ * without copying it, see DataWriterImpl_T::loan_sample.  The buffer goes
+ * back to the transport when the sample is written or when this object is
+ * destroyed or reset.
+ */
+class LoanedBuffer {
+public:
+  LoanedBuffer() {}
+
+  /// True while this holds a buffer.
+  bool valid() const { return buffer_.get() != 0; }
+
+  /// Start of the buffer, for writing an already serialized sample into it.
+  char* data() const { return buffer_ ? buffer_->rd_ptr() : 0; }
+
+  /// Size of the buffer.
+  size_t capacity() const { return buffer_ ? buffer_->size() : 0; }
+
+  /// Number of bytes of serialized sample, including the encapsulation
+  /// header, written to data().  If this is left at 0 write_loaned
+  /// serializes the sample into the buffer.
+  size_t length() const { return buffer_ ? buffer_->length() : 0; }
+  bool length(size_t length)
+  {
+    if (!buffer_ || length > capacity()) {
+      return false;
+    }
+    buffer_->wr_ptr(buffer_->rd_ptr() + length);
+    return true;
+  }
+
+  /// Give the buffer back without writing it.
+  void reset() { buffer_.reset(); }
+
+private:
+  LoanedBuffer(const LoanedBuffer&);
+  LoanedBuffer& operator=(const LoanedBuffer&);
+
+  friend class DataWriterImpl;
+  Message_Block_Ptr buffer_;
+};
+
+/// A LoanedBuffer for a sample of MessageType, so it can only be written by
+/// a DataWriter of that type.
+template <typename MessageType>
+class LoanedSample : public LoanedBuffer {
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_LOANEDSAMPLE_H */
@@ -472,6 +472,11 @@ void MultiTopicDataReaderBase::get_latency_stats(LatencyStatisticsSeq& stats)
   resulting_reader_->get_latency_stats(stats);
 }
 
+void MultiTopicDataReaderBase::get_latency_percentiles(LatencyPercentilesSeq& stats)
+{
+  resulting_reader_->get_latency_percentiles(stats);
+}
+
 void MultiTopicDataReaderBase::reset_latency_stats()
 {
   resulting_reader_->reset_latency_stats();
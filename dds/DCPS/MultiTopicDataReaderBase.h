@@ -116,6 +116,8 @@ public:
 
   void get_latency_stats(LatencyStatisticsSeq& stats);
 
+  void get_latency_percentiles(LatencyPercentilesSeq& stats);
+
   void reset_latency_stats();
 
   CORBA::Boolean statistics_enabled();
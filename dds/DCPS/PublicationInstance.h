@@ -72,6 +72,12 @@ struct OpenDDS_Dcps_Export PublicationInstance : public virtual RcObject {
 
   /// Deadline for Deadline QoS.
   MonotonicTimePoint deadline_;
+
+  /// Preallocated DataSampleElements for the samples of a bounded KEEP_LAST
+  /// history, see WriteDataContainer::obtain_buffer.  Null for other
+  /// histories.  The elements hold a reference to the instance, so this
+  /// outlives them.
+  unique_ptr<DataSampleElementAllocator> slots_;
 };
 
 typedef RcHandle<PublicationInstance> PublicationInstance_rch;
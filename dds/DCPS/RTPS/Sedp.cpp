@@ -49,23 +49,28 @@ namespace {
 
 const OpenDDS::DCPS::MonotonicTime_t MTZERO = { 0, 0 };
 
+// Set 'rematch' if a policy that affects matching changed.
 bool checkAndAssignQos(DDS::PublicationBuiltinTopicData& dest,
-                       const DDS::PublicationBuiltinTopicData& src)
+                       const DDS::PublicationBuiltinTopicData& src,
+                       bool& rematch)
 {
 #ifndef OPENDDS_SAFETY_PROFILE
   using OpenDDS::DCPS::operator!=;
 #endif
   bool changed = false;
+  rematch = false;
 
   // check each Changeable QoS policy value in Publication BIT Data
 
   if (dest.deadline != src.deadline) {
     changed = true;
+    rematch = true;
     dest.deadline = src.deadline;
   }
 
   if (dest.latency_budget != src.latency_budget) {
     changed = true;
+    rematch = true;
     dest.latency_budget = src.latency_budget;
   }
 
@@ -86,6 +91,7 @@ bool checkAndAssignQos(DDS::PublicationBuiltinTopicData& dest,
 
   if (dest.partition != src.partition) {
     changed = true;
+    rematch = true;
     dest.partition = src.partition;
   }
 
@@ -102,23 +108,28 @@ bool checkAndAssignQos(DDS::PublicationBuiltinTopicData& dest,
   return changed;
 }
 
+// Set 'rematch' if a policy that affects matching changed.
 bool checkAndAssignQos(DDS::SubscriptionBuiltinTopicData& dest,
-                       const DDS::SubscriptionBuiltinTopicData& src)
+                       const DDS::SubscriptionBuiltinTopicData& src,
+                       bool& rematch)
 {
 #ifndef OPENDDS_SAFETY_PROFILE
   using OpenDDS::DCPS::operator!=;
 #endif
   bool changed = false;
+  rematch = false;
 
   // check each Changeable QoS policy value in Subscription BIT Data
 
   if (dest.deadline != src.deadline) {
     changed = true;
+    rematch = true;
     dest.deadline = src.deadline;
   }
 
   if (dest.latency_budget != src.latency_budget) {
     changed = true;
+    rematch = true;
     dest.latency_budget = src.latency_budget;
   }
 
@@ -134,6 +145,7 @@ bool checkAndAssignQos(DDS::SubscriptionBuiltinTopicData& dest,
 
   if (dest.partition != src.partition) {
     changed = true;
+    rematch = true;
     dest.partition = src.partition;
   }
 
@@ -2202,8 +2214,9 @@ void Sedp::process_discovered_writer_data(DCPS::MessageId message_id,
       }
       match_endpoints(guid, top_it->second);
     } else {
+      bool rematch = false;
       if (checkAndAssignQos(iter->second.writer_data_.ddsPublicationData,
-                            wdata.ddsPublicationData)) { // update existing
+                            wdata.ddsPublicationData, rematch)) { // update existing
 
         spdp_.bit_subscriber_->add_publication(iter->second.writer_data_.ddsPublicationData, DDS::NOT_NEW_VIEW_STATE);
         if (spdp_.shutting_down()) { return; }
@@ -2211,7 +2224,7 @@ void Sedp::process_discovered_writer_data(DCPS::MessageId message_id,
         // Match/unmatch local subscription(s)
         topic_name = iter->second.get_topic_name();
         TopicDetailsMap::iterator top_it = topics_.find(topic_name);
-        if (top_it != topics_.end()) {
+        if (rematch && top_it != topics_.end()) {
           if (DCPS::DCPS_debug_level > 3) {
             ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) Sedp::process_discovered_writer_data - ")
                        ACE_TEXT("calling match_endpoints update\n")));
@@ -2503,8 +2516,9 @@ void Sedp::process_discovered_reader_data(DCPS::MessageId message_id,
       }
       match_endpoints(guid, top_it->second);
     } else { // update existing
+      bool rematch = false;
       if (checkAndAssignQos(iter->second.reader_data_.ddsSubscriptionData,
-                            rdata.ddsSubscriptionData)) {
+                            rdata.ddsSubscriptionData, rematch)) {
 
         spdp_.bit_subscriber_->add_subscription(iter->second.reader_data_.ddsSubscriptionData, DDS::NOT_NEW_VIEW_STATE);
         if (spdp_.shutting_down()) { return; }
@@ -2512,7 +2526,7 @@ void Sedp::process_discovered_reader_data(DCPS::MessageId message_id,
         // Match/unmatch local publication(s)
         topic_name = iter->second.get_topic_name();
         TopicDetailsMap::iterator top_it = topics_.find(topic_name);
-        if (top_it != topics_.end()) {
+        if (rematch && top_it != topics_.end()) {
           if (DCPS::DCPS_debug_level > 3) {
             ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) Sedp::process_discovered_reader_data - ")
                        ACE_TEXT("calling match_endpoints update\n")));
@@ -6681,6 +6695,25 @@ void Sedp::match_endpoints(GUID_t repoId, const DCPS::TopicDetails& td, bool rem
   }
 
   const bool reader = DCPS::GuidConverter(repoId).isReader();
+
+  if (remove) {
+    // Only local endpoints have associations to break, so the discovered
+    // endpoints of the topic don't need to be visited. If repoId is a
+    // discovered endpoint that is still known, only the local endpoints it
+    // could be associated with need to be visited.
+    RepoIdSet local_endpoints;
+    if (!associated_local_endpoints(repoId, local_endpoints)) {
+      local_endpoints = reader ? td.local_publications() : td.local_subscriptions();
+    }
+    for (RepoIdSet::const_iterator iter = local_endpoints.begin();
+         iter != local_endpoints.end(); ++iter) {
+      if (DCPS::GuidConverter(*iter).isReader() != reader) {
+        remove_assoc(*iter, repoId);
+      }
+    }
+    return;
+  }
+
   // Copy the endpoint set - lock can be released in match()
   RepoIdSet local_endpoints;
   RepoIdSet discovered_endpoints;
@@ -6702,11 +6735,7 @@ void Sedp::match_endpoints(GUID_t repoId, const DCPS::TopicDetails& td, bool rem
        iter != local_endpoints.end(); ++iter) {
     // check to make sure it's a Reader/Writer or Writer/Reader match
     if (DCPS::GuidConverter(*iter).isReader() != reader) {
-      if (remove) {
-        remove_assoc(*iter, repoId);
-      } else {
-        match(reader ? *iter : repoId, reader ? repoId : *iter);
-      }
+      match(reader ? *iter : repoId, reader ? repoId : *iter);
     }
   }
 
@@ -6719,13 +6748,33 @@ void Sedp::match_endpoints(GUID_t repoId, const DCPS::TopicDetails& td, bool rem
        iter != discovered_endpoints.end(); ++iter) {
     // check to make sure it's a Reader/Writer or Writer/Reader match
     if (DCPS::GuidConverter(*iter).isReader() != reader) {
-      if (remove) {
-        remove_assoc(*iter, repoId);
-      } else {
-        match(reader ? *iter : repoId, reader ? repoId : *iter);
+      match(reader ? *iter : repoId, reader ? repoId : *iter);
+    }
+  }
+}
+
+bool Sedp::associated_local_endpoints(const GUID_t& remote, RepoIdSet& local_endpoints) const
+{
+  const DiscoveredPublicationMap::const_iterator dpi = discovered_publications_.find(remote);
+  if (dpi != discovered_publications_.end()) {
+    local_endpoints = dpi->second.matched_endpoints_;
+    return true;
+  }
+
+  const DiscoveredSubscriptionMap::const_iterator dsi = discovered_subscriptions_.find(remote);
+  if (dsi != discovered_subscriptions_.end()) {
+    local_endpoints = dsi->second.matched_endpoints_;
+    // Local writers can also expect an association the reader reported.
+    const DCPS::GUIDSeq& writers = dsi->second.reader_data_.readerProxy.associatedWriters;
+    for (CORBA::ULong i = 0; i < writers.length(); ++i) {
+      if (equal_guid_prefixes(writers[i], participant_id_)) {
+        local_endpoints.insert(writers[i]);
       }
     }
+    return true;
   }
+
+  return false;
 }
 
 void Sedp::cleanup_writer_association(DCPS::DataWriterCallbacks_wrch callbacks,
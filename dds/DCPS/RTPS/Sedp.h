@@ -1053,6 +1053,10 @@ protected:
   void match_endpoints(GUID_t repoId, const DCPS::TopicDetails& td,
                        bool remove = false);
 
+  /// Set 'local_endpoints' to the local endpoints that may be associated with
+  /// the discovered endpoint 'remote'. Return false if 'remote' isn't known.
+  bool associated_local_endpoints(const GUID_t& remote, RepoIdSet& local_endpoints) const;
+
   void remove_assoc(const GUID_t& remove_from, const GUID_t& removing);
 
   struct MatchingData {
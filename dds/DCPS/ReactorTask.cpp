@@ -13,8 +13,13 @@
 #endif /* __ACE_INLINE__ */
 
 #include "Service_Participant.h"
+#include "debug.h"
 
 #include <ace/Select_Reactor.h>
+#if defined ACE_HAS_EVENT_POLL || defined ACE_HAS_DEV_POLL
+#  include <ace/Dev_Poll_Reactor.h>
+#  define OPENDDS_HAS_DEV_POLL_REACTOR
+#endif
 #include <ace/WFMO_Reactor.h>
 #include <ace/Proactor.h>
 #include <ace/Proactor_Impl.h>
@@ -29,6 +34,24 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  ACE_Reactor_Impl* make_reactor_impl(const String& name)
+  {
+    const String type = TheServiceParticipant->reactor_type();
+#ifdef OPENDDS_HAS_DEV_POLL_REACTOR
+    if (type == "dev_poll") {
+      return new ACE_Dev_Poll_Reactor;
+    }
+#endif
+    if (type != "select" && log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: ReactorTask::open_reactor_task: %C: "
+                 "unsupported reactor type \"%C\", using \"select\"\n",
+                 name.c_str(), type.c_str()));
+    }
+    return new ACE_Select_Reactor;
+  }
+}
+
 ReactorTask::ReactorTask(bool useAsyncSend)
   : condition_(lock_)
   , state_(STATE_UNINITIALIZED)
@@ -100,7 +123,7 @@ int ReactorTask::open_reactor_task(void*,
   } else
 #endif
   if (!reactor_) {
-    reactor_ = new ACE_Reactor(new ACE_Select_Reactor, true);
+    reactor_ = new ACE_Reactor(make_reactor_impl(name_), true);
     proactor_ = 0;
   }
 
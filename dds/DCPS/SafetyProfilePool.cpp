@@ -8,6 +8,7 @@
 #include "DCPS/DdsDcps_pch.h"  ////Only the _pch include should start with DCPS/
 #include "SafetyProfilePool.h"
 #include "debug.h"
+#include <cstring>
 #include <stdexcept>
 
 #ifdef OPENDDS_SAFETY_PROFILE
@@ -15,25 +16,199 @@ namespace OpenDDS {  namespace DCPS {
 
 SafetyProfilePool::SafetyProfilePool()
 : main_pool_(0)
+, magazine_size_(0)
+, cache_key_()
 {
+  stats_.hits_ = 0;
+  stats_.misses_ = 0;
+  stats_.cached_blocks_hwm_ = 0;
 }
 
 SafetyProfilePool::~SafetyProfilePool()
 {
   // Never delete, because this is always a SAFETY_PROFILE build
   //delete main_pool_;
+  if (magazine_size_) {
+    ACE_OS::thr_keyfree(cache_key_);
+  }
 }
 
 void
-SafetyProfilePool::configure_pool(size_t size, size_t granularity)
+SafetyProfilePool::configure_pool(size_t size, size_t granularity, size_t magazine_size)
 {
   ACE_GUARD(ACE_Thread_Mutex, lock, lock_);
 
   if (main_pool_ == NULL) {
     main_pool_ = new MemoryPool(size, granularity);
+
+    if (magazine_size) {
+      if (ACE_OS::thr_keycreate(&cache_key_, &SafetyProfilePool::thread_exit) == -1) {
+        if (DCPS_debug_level) {
+          ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: SafetyProfilePool::configure_pool: "
+                     "thr_keycreate failed, not using thread caches\n"));
+        }
+      } else {
+        magazine_size_ = magazine_size < MAX_MAGAZINE_SIZE ? magazine_size : size_t(MAX_MAGAZINE_SIZE);
+      }
+    }
   }
 }
 
+void*
+SafetyProfilePool::cached_malloc(size_t size)
+{
+  ThreadCache* const cache = thread_cache();
+  if (!cache) {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, lock, lock_, 0);
+    return main_pool_->pool_alloc(size);
+  }
+
+  size_t size_class = 0;
+  while (class_size(size_class) < size) {
+    ++size_class;
+  }
+
+  Magazine& mag = cache->magazines_[size_class];
+  if (mag.count_) {
+    ++cache->hits_;
+  } else {
+    refill(*cache, size_class);
+    if (!mag.count_) {
+      return 0;
+    }
+  }
+
+  --cache->cached_;
+  return mag.blocks_[--mag.count_];
+}
+
+void
+SafetyProfilePool::cached_free(void* ptr)
+{
+  if (!ptr) {
+    return;
+  }
+
+  ThreadCache* const cache = main_pool_->includes(ptr) ? thread_cache() : 0;
+  // The block can be larger than what was asked for, it's cached in the
+  // largest size class it can satisfy.
+  const size_t size = (reinterpret_cast<AllocHeader*>(ptr) - 1)->size();
+  if (!cache || size < MIN_CACHED_SIZE || size >= 2 * MAX_CACHED_SIZE) {
+    ACE_GUARD(ACE_Thread_Mutex, lock, lock_);
+    main_pool_->pool_free(ptr);
+    return;
+  }
+
+  size_t size_class = SIZE_CLASSES - 1;
+  while (class_size(size_class) > size) {
+    --size_class;
+  }
+
+  Magazine& mag = cache->magazines_[size_class];
+  if (mag.count_ == magazine_size_) {
+    drain(*cache, size_class, (magazine_size_ + 1) / 2);
+  }
+
+  mag.blocks_[mag.count_++] = ptr;
+  if (++cache->cached_ > cache->cached_hwm_) {
+    cache->cached_hwm_ = cache->cached_;
+  }
+}
+
+SafetyProfilePool::ThreadCache*
+SafetyProfilePool::thread_cache()
+{
+  void* cache = 0;
+  if (ACE_OS::thr_getspecific(cache_key_, &cache) == -1) {
+    return 0;
+  }
+
+  if (!cache) {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, lock, lock_, 0);
+    cache = main_pool_->pool_alloc(sizeof(ThreadCache));
+    if (!cache) {
+      return 0;
+    }
+    std::memset(cache, 0, sizeof(ThreadCache));
+    static_cast<ThreadCache*>(cache)->pool_ = this;
+    if (ACE_OS::thr_setspecific(cache_key_, cache) == -1) {
+      main_pool_->pool_free(cache);
+      return 0;
+    }
+  }
+
+  return static_cast<ThreadCache*>(cache);
+}
+
+void
+SafetyProfilePool::refill(ThreadCache& cache, size_t size_class)
+{
+  ACE_GUARD(ACE_Thread_Mutex, lock, lock_);
+  ++stats_.misses_;
+  fold_stats(cache);
+
+  Magazine& mag = cache.magazines_[size_class];
+  const size_t batch = (magazine_size_ + 1) / 2;
+  while (mag.count_ < batch) {
+    void* const block = main_pool_->pool_alloc(class_size(size_class));
+    if (!block) {
+      break;
+    }
+    mag.blocks_[mag.count_++] = block;
+    ++cache.cached_;
+  }
+}
+
+void
+SafetyProfilePool::drain(ThreadCache& cache, size_t size_class, size_t count)
+{
+  ACE_GUARD(ACE_Thread_Mutex, lock, lock_);
+  fold_stats(cache);
+
+  // Return the blocks at the bottom of the magazine, the ones at the top were
+  // used most recently.
+  Magazine& mag = cache.magazines_[size_class];
+  for (size_t i = 0; i < count; ++i) {
+    main_pool_->pool_free(mag.blocks_[i]);
+  }
+  std::memmove(mag.blocks_, mag.blocks_ + count, (mag.count_ - count) * sizeof(void*));
+  mag.count_ -= count;
+  cache.cached_ -= count;
+}
+
+void
+SafetyProfilePool::fold_stats(ThreadCache& cache)
+{
+  stats_.hits_ += cache.hits_;
+  cache.hits_ = 0;
+  if (cache.cached_hwm_ > stats_.cached_blocks_hwm_) {
+    stats_.cached_blocks_hwm_ = cache.cached_hwm_;
+  }
+}
+
+void
+SafetyProfilePool::thread_exit(void* arg)
+{
+  ThreadCache* const cache = static_cast<ThreadCache*>(arg);
+  SafetyProfilePool* const pool = cache->pool_;
+  ACE_GUARD(ACE_Thread_Mutex, lock, pool->lock_);
+  pool->fold_stats(*cache);
+  for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+    const Magazine& mag = cache->magazines_[i];
+    for (size_t j = 0; j < mag.count_; ++j) {
+      pool->main_pool_->pool_free(mag.blocks_[j]);
+    }
+  }
+  pool->main_pool_->pool_free(cache);
+}
+
+SafetyProfilePool::CacheStats
+SafetyProfilePool::cache_stats() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, lock, lock_, stats_);
+  return stats_;
+}
+
 void
 SafetyProfilePool::install()
 {
@@ -59,6 +234,11 @@ struct InstanceMaker {
       if (SafetyProfilePool::instance_->main_pool_) {
         ACE_DEBUG((LM_INFO, "LWM: main pool: %d bytes\n",
                    SafetyProfilePool::instance_->main_pool_->lwm_free_bytes()));
+        if (SafetyProfilePool::instance_->magazine_size_) {
+          const SafetyProfilePool::CacheStats stats = SafetyProfilePool::instance_->cache_stats();
+          ACE_DEBUG((LM_INFO, "thread caches: %B hits, %B misses, at most %B blocks cached\n",
+                     stats.hits_, stats.misses_, stats.cached_blocks_hwm_));
+        }
       }
     }
   }
@@ -13,6 +13,7 @@
 
 #ifdef OPENDDS_SAFETY_PROFILE
 #include "ace/Atomic_Op.h"
+#include "ace/OS_NS_Thread.h"
 #include "ace/Singleton.h"
 #include "dcps_export.h"
 #include "MemoryPool.h"
@@ -31,6 +32,12 @@ namespace DCPS {
 /// Safety Profile disallows std::free() and the delete operators
 /// See PoolAllocator.h for a class that allows STL containers to use an
 /// instance of SafetyProfilePool managed by our Service_Participant singleton.
+///
+/// When configured with a nonzero magazine size each thread keeps a cache of
+/// small blocks, grouped in power of two size classes, in front of the main
+/// pool.  A thread only takes the pool's lock to move half a magazine at a
+/// time to or from the main pool.  Cached blocks are returned when the thread
+/// exits.
 class OpenDDS_Dcps_Export SafetyProfilePool : public ACE_Allocator
 {
   friend class SafetyProfilePoolTest;
@@ -38,17 +45,24 @@ public:
   SafetyProfilePool();
   ~SafetyProfilePool();
 
-  void configure_pool(size_t size, size_t granularity);
+  void configure_pool(size_t size, size_t granularity, size_t magazine_size = 0);
   void install();
 
   void* malloc(std::size_t size)
   {
+    if (magazine_size_ && size <= MAX_CACHED_SIZE) {
+      return cached_malloc(size);
+    }
     ACE_GUARD_RETURN(ACE_Thread_Mutex, lock, lock_, 0);
     return main_pool_->pool_alloc(size);
   }
 
   void free(void* ptr)
   {
+    if (magazine_size_) {
+      cached_free(ptr);
+      return;
+    }
     ACE_GUARD(ACE_Thread_Mutex, lock, lock_);
     main_pool_->pool_free(ptr);
   }
@@ -81,12 +95,59 @@ public:
   /// Return a singleton instance of this class.
   static SafetyProfilePool* instance();
 
+  /// Counters for the per-thread caches.  Hits of a thread are only added
+  /// when it next uses the main pool or exits.
+  struct CacheStats {
+    size_t hits_;
+    size_t misses_;
+    /// Most blocks held by any single thread's cache.
+    size_t cached_blocks_hwm_;
+  };
+  CacheStats cache_stats() const;
+
+  enum {
+    SIZE_CLASSES = 8,
+    MIN_CACHED_SIZE = 16,
+    MAX_CACHED_SIZE = MIN_CACHED_SIZE << (SIZE_CLASSES - 1),
+    MAX_MAGAZINE_SIZE = 64
+  };
+
 private:
   SafetyProfilePool(const SafetyProfilePool&);
   SafetyProfilePool& operator=(const SafetyProfilePool&);
 
+  struct Magazine {
+    size_t count_;
+    void* blocks_[MAX_MAGAZINE_SIZE];
+  };
+
+  struct ThreadCache {
+    SafetyProfilePool* pool_;
+    Magazine magazines_[SIZE_CLASSES];
+    size_t cached_;
+    size_t cached_hwm_;
+    size_t hits_;
+  };
+
+  static size_t class_size(size_t size_class)
+  {
+    return static_cast<size_t>(MIN_CACHED_SIZE) << size_class;
+  }
+
+
+  void* cached_malloc(size_t size);
+  void cached_free(void* ptr);
+  ThreadCache* thread_cache();
+  void refill(ThreadCache& cache, size_t size_class);
+  void drain(ThreadCache& cache, size_t size_class, size_t count);
+  void fold_stats(ThreadCache& cache);
+  static void thread_exit(void* cache);
+
   MemoryPool* main_pool_;
-  ACE_Thread_Mutex lock_;
+  mutable ACE_Thread_Mutex lock_;
+  size_t magazine_size_;
+  ACE_thread_key_t cache_key_;
+  CacheStats stats_;
   static SafetyProfilePool* instance_;
   friend class InstanceMaker;
 };
@@ -10,6 +10,7 @@
 #include "TypeSupportImpl.h"
 #include "RcHandle_T.h"
 #include "FilterEvaluator.h"
+#include "InstanceKeyIndex.h"
 
 #include <dds/DdsDynamicDataC.h>
 
@@ -81,6 +82,9 @@ public:
   virtual bool deserialize(Serializer& ser) = 0;
   virtual size_t serialized_size(const Encoding& enc) const = 0;
   virtual bool compare(const Sample& other) const = 0;
+  /// Serialize only the key fields, regardless of the extent, for use with
+  /// InstanceKeyIndex.
+  virtual bool serialize_key(ACE_Message_Block& buffer) const = 0;
   virtual bool to_message_block(ACE_Message_Block& mb) const = 0;
   virtual bool from_message_block(const ACE_Message_Block& mb) = 0;
   virtual Sample_rch copy(Mutability mutability, Extent extent) const = 0;
@@ -98,6 +102,8 @@ public:
 
 #ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
   virtual bool eval(FilterEvaluator& evaluator, const DDS::StringSeq& params) const = 0;
+  /// Value of a field as the filter of a ContentFilteredTopic would see it
+  virtual Value get_field_value(const char* field) const = 0;
 #endif
 
 protected:
@@ -224,6 +230,11 @@ public:
     return typename TraitsType::LessThanType()(*data_, *other_same_kind->data_);
   }
 
+  bool serialize_key(ACE_Message_Block& buffer) const
+  {
+    return serialize_instance_key(buffer, key_only_data());
+  }
+
   bool to_message_block(ACE_Message_Block& mb) const
   {
     return MarshalTraitsType::to_message_block(mb, data());
@@ -270,6 +281,11 @@ public:
   {
     return evaluator.eval(*data_, params);
   }
+
+  Value get_field_value(const char* field) const
+  {
+    return getMetaStruct<NativeType>().getValue(data_, field);
+  }
 #endif
 
 private:
@@ -695,6 +695,11 @@ public:
   /// Alignments of 2, 4, or 8 are supported by CDR and this implementation.
   bool align_w(size_t alignment);
 
+  /// True if reading or writing can start here without any padding for the
+  /// given alignment, i.e. align_r/align_w would not move the position.
+  bool is_aligned_r(size_t alignment) const;
+  bool is_aligned_w(size_t alignment) const;
+
   /**
    * Read a XCDR parameter ID used in XCDR parameter lists.
    *
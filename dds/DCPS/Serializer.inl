@@ -4,6 +4,7 @@
  */
 
 #include "Serializer.h"
+#include "ByteSwap.h"
 #include "debug.h"
 
 #include <ace/Message_Block.h>
@@ -487,13 +488,36 @@ Serializer::read_array(char* x, size_t size,
 
   } else {
     //
-    // Swapping _must_ be done at 'size' boundaries, so we need to spin
-    // through the array element by element.  This silently corrupts the
-    // data if there is padding in the buffer.
+    // Swapping _must_ be done at 'size' boundaries, so the elements that are
+    // wholly in the current block are swapped together and an element split
+    // across blocks is read on its own.  This silently corrupts the data if
+    // there is padding in the buffer.
     //
-    while (length-- > 0) {
-      buffer_read(x, size, true);
-      x += size;
+    while (length > 0) {
+      if (current_ == 0) {
+        good_bit_ = false;
+        return;
+      }
+      const size_t n = (std::min)(size_t(length), current_->length() / size);
+      if (n == 0) {
+        buffer_read(x, size, true);
+        x += size;
+        --length;
+        continue;
+      }
+      const size_t bytes = n * size;
+      swap_copy_array(x, current_->rd_ptr(), size, n);
+      current_->rd_ptr(bytes);
+      rpos_ += bytes;
+      x += bytes;
+      length -= static_cast<ACE_CDR::ULong>(n);
+      if (current_->length() == 0) {
+        if (encoding().alignment()) {
+          align_cont_r();
+        } else {
+          current_ = current_->cont();
+        }
+      }
     }
   }
 }
@@ -516,15 +540,38 @@ Serializer::write_array(const char* x, size_t size,
 
   } else {
     //
-    // Swapping _must_ be done at 'size' boundaries, so we need to spin
-    // through the array element by element.
+    // Swapping _must_ be done at 'size' boundaries, so the elements that fit
+    // in the current block are swapped together and an element split across
+    // blocks is written on its own.
     // NOTE: This assumes that there is _no_ padding between the array
     //       elements.  If this is not the case, do not use this
     //       method.
     //
-    while (length-- > 0) {
-      buffer_write(x, size, true);
-      x += size;
+    while (length > 0) {
+      if (current_ == 0) {
+        good_bit_ = false;
+        return;
+      }
+      const size_t n = (std::min)(size_t(length), current_->space() / size);
+      if (n == 0) {
+        buffer_write(x, size, true);
+        x += size;
+        --length;
+        continue;
+      }
+      const size_t bytes = n * size;
+      swap_copy_array(current_->wr_ptr(), x, size, n);
+      current_->wr_ptr(bytes);
+      wpos_ += bytes;
+      x += bytes;
+      length -= static_cast<ACE_CDR::ULong>(n);
+      if (current_->space() == 0) {
+        if (encoding().alignment()) {
+          align_cont_w();
+        } else {
+          current_ = current_->cont();
+        }
+      }
     }
   }
 }
@@ -826,6 +873,32 @@ bool Serializer::align_r(size_t al)
   return skip(static_cast<ACE_CDR::UShort>(len));
 }
 
+ACE_INLINE
+bool Serializer::is_aligned_r(size_t al) const
+{
+  if (!alignment()) {
+    return true;
+  }
+  if (!current_) {
+    return false;
+  }
+  al = (std::min)(al, encoding().max_align());
+  return (al - ptrdiff_t(current_->rd_ptr()) + align_rshift_) % al == 0;
+}
+
+ACE_INLINE
+bool Serializer::is_aligned_w(size_t al) const
+{
+  if (!alignment()) {
+    return true;
+  }
+  if (!current_) {
+    return false;
+  }
+  al = (std::min)(al, encoding().max_align());
+  return (al - ptrdiff_t(current_->wr_ptr()) + align_wshift_) % al == 0;
+}
+
 ACE_INLINE
 bool Serializer::align_w(size_t al)
 {
@@ -22,6 +22,7 @@
 #include "StaticDiscovery.h"
 #include "ThreadStatusManager.h"
 #include "Qos_Helper.h"
+#include "ServiceEventDispatcher.h"
 #include "../Version.h"
 #ifdef OPENDDS_SECURITY
 #  include "security/framework/SecurityRegistry.h"
@@ -334,6 +335,12 @@ Service_Participant::job_queue() const
   return job_queue_;
 }
 
+EventDispatcher_rch
+Service_Participant::timer_dispatcher() const
+{
+  return timer_dispatcher_;
+}
+
 DDS::ReturnCode_t Service_Participant::shutdown()
 {
   if (DCPS_debug_level >= 1) {
@@ -392,6 +399,11 @@ DDS::ReturnCode_t Service_Participant::shutdown()
 
       domain_ranges_.clear();
 
+      if (timer_dispatcher_) {
+        timer_dispatcher_->shutdown();
+        timer_dispatcher_.reset();
+      }
+
       reactor_task_.stop();
 
       discoveryMap_.clear();
@@ -577,6 +589,9 @@ Service_Participant::get_domain_participant_factory(int &argc,
 
       job_queue_ = make_rch<JobQueue>(reactor_task_.get_reactor());
 
+      timer_dispatcher_ = make_rch<TimingWheelEventDispatcher>(make_rch<ServiceEventDispatcher>(1),
+                                                               timer_wheel_tick());
+
       const bool monitor_enabled = config_store_->get_boolean(OPENDDS_COMMON_DCPS_MONITOR,
                                                              OPENDDS_COMMON_DCPS_MONITOR_default);
 
@@ -1420,6 +1435,19 @@ Service_Participant::scheduler() const
   return -1;
 }
 
+void
+Service_Participant::instance_key_index(bool flag)
+{
+  config_store_->set_boolean(OPENDDS_COMMON_DCPS_INSTANCE_KEY_INDEX, flag);
+}
+
+bool
+Service_Participant::instance_key_index() const
+{
+  return config_store_->get_boolean(OPENDDS_COMMON_DCPS_INSTANCE_KEY_INDEX,
+                                   OPENDDS_COMMON_DCPS_INSTANCE_KEY_INDEX_default);
+}
+
 void
 Service_Participant::publisher_content_filter(bool flag)
 {
@@ -1433,6 +1461,46 @@ Service_Participant::publisher_content_filter() const
                                    OPENDDS_COMMON_DCPS_PUBLISHER_CONTENT_FILTER_default);
 }
 
+void
+Service_Participant::reactor_type(const String& type)
+{
+  config_store_->set(OPENDDS_COMMON_DCPS_REACTOR_TYPE, type);
+}
+
+String
+Service_Participant::reactor_type() const
+{
+  return config_store_->get(OPENDDS_COMMON_DCPS_REACTOR_TYPE,
+                            OPENDDS_COMMON_DCPS_REACTOR_TYPE_default);
+}
+
+void
+Service_Participant::reader_instance_shards(size_t shards)
+{
+  config_store_->set_uint32(OPENDDS_COMMON_DCPS_READER_INSTANCE_SHARDS, static_cast<DDS::UInt32>(shards));
+}
+
+size_t
+Service_Participant::reader_instance_shards() const
+{
+  return config_store_->get_uint32(OPENDDS_COMMON_DCPS_READER_INSTANCE_SHARDS,
+                                  OPENDDS_COMMON_DCPS_READER_INSTANCE_SHARDS_default);
+}
+
+void
+Service_Participant::timer_wheel_tick(const TimeDuration& tick)
+{
+  config_store_->set(OPENDDS_COMMON_DCPS_TIMER_WHEEL_TICK, tick, ConfigStoreImpl::Format_IntegerMilliseconds);
+}
+
+TimeDuration
+Service_Participant::timer_wheel_tick() const
+{
+  return config_store_->get(OPENDDS_COMMON_DCPS_TIMER_WHEEL_TICK,
+                           OPENDDS_COMMON_DCPS_TIMER_WHEEL_TICK_default,
+                           ConfigStoreImpl::Format_IntegerMilliseconds);
+}
+
 TimeDuration
 Service_Participant::pending_timeout() const
 {
@@ -2478,8 +2546,10 @@ Service_Participant::configure_pool()
                                                     OPENDDS_COMMON_POOL_SIZE_default);
   const size_t pool_granularity = config_store_->get_uint32(OPENDDS_COMMON_POOL_GRANULARITY,
                                                           OPENDDS_COMMON_POOL_GRANULARITY_default);
+  const size_t pool_magazine_size = config_store_->get_uint32(OPENDDS_COMMON_POOL_MAGAZINE_SIZE,
+                                                             OPENDDS_COMMON_POOL_MAGAZINE_SIZE_default);
   if (pool_size) {
-    SafetyProfilePool::instance()->configure_pool(pool_size, pool_granularity);
+    SafetyProfilePool::instance()->configure_pool(pool_size, pool_granularity, pool_magazine_size);
     SafetyProfilePool::instance()->install();
   }
 }
@@ -15,6 +15,7 @@
 #include "unique_ptr.h"
 #include "ReactorTask.h"
 #include "JobQueue.h"
+#include "TimingWheelEventDispatcher.h"
 #include "NetworkConfigMonitor.h"
 #include "NetworkConfigModifier.h"
 #include "Recorder.h"
@@ -105,6 +106,9 @@ const String OPENDDS_COMMON_DCPS_GLOBAL_TRANSPORT_CONFIG_default = "";
 
 const char OPENDDS_COMMON_DCPS_INFO_REPO[] = "OPENDDS_COMMON_DCPS_INFO_REPO";
 
+const char OPENDDS_COMMON_DCPS_INSTANCE_KEY_INDEX[] = "OPENDDS_COMMON_DCPS_INSTANCE_KEY_INDEX";
+const bool OPENDDS_COMMON_DCPS_INSTANCE_KEY_INDEX_default = false;
+
 const char OPENDDS_COMMON_DCPS_LIVELINESS_FACTOR[] = "OPENDDS_COMMON_DCPS_LIVELINESS_FACTOR";
 const int OPENDDS_COMMON_DCPS_LIVELINESS_FACTOR_default = 80;
 
@@ -125,8 +129,17 @@ const String OPENDDS_COMMON_DCPS_PERSISTENT_DATA_DIR_default = "OpenDDS-durable-
 const char OPENDDS_COMMON_DCPS_PUBLISHER_CONTENT_FILTER[] = "OPENDDS_COMMON_DCPS_PUBLISHER_CONTENT_FILTER";
 const bool OPENDDS_COMMON_DCPS_PUBLISHER_CONTENT_FILTER_default = true;
 
+const char OPENDDS_COMMON_DCPS_REACTOR_TYPE[] = "OPENDDS_COMMON_DCPS_REACTOR_TYPE";
+const String OPENDDS_COMMON_DCPS_REACTOR_TYPE_default = "select";
+
+const char OPENDDS_COMMON_DCPS_READER_INSTANCE_SHARDS[] = "OPENDDS_COMMON_DCPS_READER_INSTANCE_SHARDS";
+const size_t OPENDDS_COMMON_DCPS_READER_INSTANCE_SHARDS_default = 0;
+
 const char OPENDDS_COMMON_DCPS_THREAD_STATUS_INTERVAL[] = "OPENDDS_COMMON_DCPS_THREAD_STATUS_INTERVAL";
 
+const char OPENDDS_COMMON_DCPS_TIMER_WHEEL_TICK[] = "OPENDDS_COMMON_DCPS_TIMER_WHEEL_TICK";
+const TimeDuration OPENDDS_COMMON_DCPS_TIMER_WHEEL_TICK_default(0, 10000);
+
 const char OPENDDS_COMMON_DCPS_TRANSPORT_DEBUG_LEVEL[] = "OPENDDS_COMMON_DCPS_TRANSPORT_DEBUG_LEVEL";
 
 const char OPENDDS_COMMON_DCPS_TYPE_OBJECT_ENCODING[] = "OPENDDS_COMMON_DCPS_TYPE_OBJECT_ENCODING";
@@ -175,6 +188,9 @@ const char OPENDDS_COMMON_DCPS_SECURITY_FAKE_ENCRYPTION[] = "OPENDDS_COMMON_DCPS
 const char OPENDDS_COMMON_POOL_GRANULARITY[] = "OPENDDS_COMMON_POOL_GRANULARITY";
 const size_t OPENDDS_COMMON_POOL_GRANULARITY_default = 8;
 
+const char OPENDDS_COMMON_POOL_MAGAZINE_SIZE[] = "OPENDDS_COMMON_POOL_MAGAZINE_SIZE";
+const size_t OPENDDS_COMMON_POOL_MAGAZINE_SIZE_default = 0;
+
 const char OPENDDS_COMMON_POOL_SIZE[] = "OPENDDS_COMMON_POOL_SIZE";
 const size_t OPENDDS_COMMON_POOL_SIZE_default = 1024 * 1024 * 16;
 #endif
@@ -230,6 +246,10 @@ public:
 
   JobQueue_rch job_queue() const;
 
+  /// Get the dispatcher for the per-instance and per-writer timers.
+  /// Intended for use by OpenDDS internals only.
+  EventDispatcher_rch timer_dispatcher() const;
+
   void set_shutdown_listener(RcHandle<ShutdownListener> listener);
 
   /**
@@ -406,12 +426,44 @@ public:
   long scheduler() const;
   //@}
 
+  /// Accessors for InstanceKeyIndex.  If enabled, DataReaders and DataWriters
+  /// created afterwards look up instances with an InstanceKeyIndex of the
+  /// serialized keys instead of a map of samples.
+  //@{
+  void instance_key_index(bool flag);
+  bool instance_key_index() const;
+  //@}
+
   /// Accessors for PublisherContentFilter.
   //@{
   void publisher_content_filter(bool);
   bool publisher_content_filter() const;
   //@}
 
+  /// Accessors for ReactorType, the ACE reactor implementation used by
+  /// ReactorTask: "select" (the default) or "dev_poll", which uses epoll on
+  /// Linux.  Only affects reactor tasks opened afterwards.
+  //@{
+  void reactor_type(const String& type);
+  String reactor_type() const;
+  //@}
+
+  /// Accessors for ReaderInstanceShards, the number of shards in the index
+  /// DataReaders use to look up instances by handle.  Zero (the default)
+  /// disables the index.  Only affects DataReaders created afterwards.
+  //@{
+  void reader_instance_shards(size_t shards);
+  size_t reader_instance_shards() const;
+  //@}
+
+  /// Accessors for TimerWheelTick, the granularity in milliseconds of the
+  /// timing wheel returned by timer_dispatcher().  Only takes effect when the
+  /// Service_Participant is initialized.
+  //@{
+  void timer_wheel_tick(const TimeDuration& tick);
+  TimeDuration timer_wheel_tick() const;
+  //@}
+
   /// Accessors for pending data timeout.
   //@{
   TimeDuration pending_timeout() const;
@@ -672,6 +724,7 @@ private:
   const TimeSource time_source_;
   ReactorTask reactor_task_;
   JobQueue_rch job_queue_;
+  TimingWheelEventDispatcher_rch timer_dispatcher_;
 
   RcHandle<DomainParticipantFactoryImpl> dp_factory_servant_;
 
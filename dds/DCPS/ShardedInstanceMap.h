@@ -0,0 +1,102 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SHARDEDINSTANCEMAP_H
+#define OPENDDS_DCPS_SHARDEDINSTANCEMAP_H
+
+#include "PoolAllocator.h"
+#include "RcObject.h"
+#include "SubscriptionInstance.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Thread_Mutex.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Index of a DataReader's instances by handle, split into shards that each
+ * have their own lock.  Lookups from the transport and application threads
+ * only contend when they hit the same shard, instead of serializing on the
+ * reader's instances_lock_ which is also held while iterating all instances.
+ * Handles are allocated sequentially so they are spread across the shards by
+ * their value.  Instance is a handle type where a default-constructed value
+ * means not found, like SubscriptionInstance_rch.
+ */
+template <typename Instance>
+class ShardedInstanceMap_T {
+public:
+  explicit ShardedInstanceMap_T(size_t shards)
+  {
+    shards_.reserve(shards ? shards : 1);
+    do {
+      shards_.push_back(make_rch<Shard>());
+    } while (shards_.size() < shards);
+  }
+
+  Instance find(DDS::InstanceHandle_t handle) const
+  {
+    const Shard& s = shard(handle);
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, s.lock_, Instance());
+    const typename Map::const_iterator iter = s.map_.find(handle);
+    return iter == s.map_.end() ? Instance() : iter->second;
+  }
+
+  bool insert(DDS::InstanceHandle_t handle, const Instance& instance)
+  {
+    Shard& s = shard(handle);
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, s.lock_, false);
+    return s.map_.insert(typename Map::value_type(handle, instance)).second;
+  }
+
+  void erase(DDS::InstanceHandle_t handle)
+  {
+    Shard& s = shard(handle);
+    ACE_GUARD(ACE_Thread_Mutex, guard, s.lock_);
+    s.map_.erase(handle);
+  }
+
+  size_t shard_count() const { return shards_.size(); }
+
+  size_t shard_index(DDS::InstanceHandle_t handle) const
+  {
+    return static_cast<size_t>(handle) % shards_.size();
+  }
+
+private:
+#ifdef ACE_HAS_CPP11
+  typedef OPENDDS_UNORDERED_MAP_T(DDS::InstanceHandle_t, Instance) Map;
+#else
+  typedef OPENDDS_MAP_T(DDS::InstanceHandle_t, Instance) Map;
+#endif
+
+  struct Shard : RcObject {
+    mutable ACE_Thread_Mutex lock_;
+    Map map_;
+  };
+  typedef RcHandle<Shard> Shard_rch;
+
+  Shard& shard(DDS::InstanceHandle_t handle) const
+  {
+    return *shards_[shard_index(handle)];
+  }
+
+  OPENDDS_VECTOR(Shard_rch) shards_;
+};
+
+typedef ShardedInstanceMap_T<SubscriptionInstance_rch> ShardedInstanceMap;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_SHARDEDINSTANCEMAP_H */
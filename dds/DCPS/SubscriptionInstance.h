@@ -72,6 +72,10 @@ public:
 
   MonotonicTimePoint deadline_;
 
+  /// Requested deadline timer, -1 if no timer is scheduled
+  long deadline_timer_id_;
+  EventBase_rch deadline_event_;
+
   MonotonicTimePoint last_accepted_;
 };
 
@@ -0,0 +1,378 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#include "TimingWheelEventDispatcher.h"
+
+#include "Service_Participant.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  // Timer ids are (generation << INDEX_BITS) | (index + 1) so that they are
+  // always positive and a stale id does not cancel a recycled timer.
+  const unsigned int INDEX_BITS = 24;
+  const unsigned long INDEX_MASK = (1ul << INDEX_BITS) - 1;
+  const unsigned long GENERATION_MASK = ~0ul >> (INDEX_BITS + 1);
+  const size_t MAX_TIMERS = INDEX_MASK;
+}
+
+TimingWheelEventDispatcher::TimingWheelEventDispatcher(EventDispatcher_rch base, const TimeDuration& tick)
+ : base_(base)
+ , origin_(MonotonicTimePoint::now())
+ , tick_usec_(0)
+ , current_(0)
+ , size_(0)
+ , shutdown_(false)
+{
+  tick.value().to_usec(tick_usec_);
+  if (tick_usec_ == 0) {
+    tick_usec_ = 1;
+  }
+  for (size_t i = 0; i <= NEAR_SLOT; ++i) {
+    heads_[i] = NIL;
+  }
+  for (size_t i = 0; i <= LEVELS; ++i) {
+    counts_[i] = 0;
+  }
+  wakeup_ = make_rch<SporadicEvent>(base_,
+    make_rch<PmfNowEvent<TimingWheelEventDispatcher> >(rchandle_from(this), &TimingWheelEventDispatcher::expire));
+}
+
+TimingWheelEventDispatcher::~TimingWheelEventDispatcher()
+{
+  shutdown();
+}
+
+void TimingWheelEventDispatcher::shutdown(bool immediate)
+{
+  EventDispatcher_rch local;
+  EventList canceled;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    shutdown_ = true;
+    local.swap(base_);
+    for (size_t slot = 0; slot <= NEAR_SLOT; ++slot) {
+      while (heads_[slot] != NIL) {
+        canceled.push_back(release(heads_[slot]));
+      }
+    }
+  }
+  if (local) {
+    wakeup_->cancel();
+    local->shutdown(immediate);
+  }
+  for (EventList::iterator it = canceled.begin(), limit = canceled.end(); it != limit; ++it) {
+    (*it)->handle_cancel();
+    (*it)->_remove_ref();
+  }
+}
+
+bool TimingWheelEventDispatcher::dispatch(EventBase_rch event)
+{
+  EventDispatcher_rch local;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    local = base_;
+  }
+  return local ? local->dispatch(event) : false;
+}
+
+long TimingWheelEventDispatcher::schedule(EventBase_rch event, const MonotonicTimePoint& expiration)
+{
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  MonotonicTimePoint wakeup;
+  long id;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (shutdown_ || !event) {
+      return -1;
+    }
+
+    size_t index;
+    if (!free_.empty()) {
+      index = free_.back();
+      free_.pop_back();
+    } else if (timers_.size() < MAX_TIMERS) {
+      index = timers_.size();
+      timers_.push_back(Timer());
+    } else {
+      return -1;
+    }
+
+    if (wheel_empty()) {
+      // Nothing is waiting on the wheel, so it can be moved forward without
+      // walking the ticks that elapsed while it was idle.
+      const Tick now_tick = tick_floor(now);
+      if (current_ < now_tick) {
+        current_ = now_tick;
+      }
+    }
+
+    Timer& timer = timers_[index];
+    event->_add_ref();
+    timer.event_ = event.in();
+    timer.expiration_ = expiration;
+    if (expiration < tick_time(1) + (now - origin_)) {
+      timer.tick_ = 0;
+      link(index, NEAR_SLOT);
+      wakeup = expiration;
+    } else {
+      timer.tick_ = tick_ceil(expiration);
+      place(index);
+      // Timers on the higher levels are cascaded at the next block boundary,
+      // at which point the wakeup is recomputed.
+      wakeup = tick_time(timer.slot_ < SLOTS ? timer.tick_ : (current_ + SLOT_MASK) & ~SLOT_MASK);
+    }
+    ++size_;
+    id = static_cast<long>(((timer.generation_ & GENERATION_MASK) << INDEX_BITS) | (index + 1));
+  }
+  wakeup_->schedule(wakeup - now);
+  return id;
+}
+
+size_t TimingWheelEventDispatcher::cancel(long id)
+{
+  if (id <= 0) {
+    return 0;
+  }
+  const unsigned long uid = static_cast<unsigned long>(id);
+  const size_t index = (uid & INDEX_MASK) - 1;
+  EventBase* event = 0;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (index >= timers_.size() || timers_[index].slot_ == NIL
+        || (timers_[index].generation_ & GENERATION_MASK) != (uid >> INDEX_BITS)) {
+      return 0;
+    }
+    event = release(index);
+  }
+  event->handle_cancel();
+  event->_remove_ref();
+  return 1;
+}
+
+size_t TimingWheelEventDispatcher::size() const
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  return size_;
+}
+
+TimingWheelEventDispatcher::Tick TimingWheelEventDispatcher::tick_floor(const MonotonicTimePoint& time) const
+{
+  if (time <= origin_) {
+    return 0;
+  }
+  ACE_UINT64 usec;
+  (time - origin_).value().to_usec(usec);
+  return usec / tick_usec_;
+}
+
+TimingWheelEventDispatcher::Tick TimingWheelEventDispatcher::tick_ceil(const MonotonicTimePoint& time) const
+{
+  if (time <= origin_) {
+    return 0;
+  }
+  ACE_UINT64 usec;
+  (time - origin_).value().to_usec(usec);
+  return (usec + tick_usec_ - 1) / tick_usec_;
+}
+
+MonotonicTimePoint TimingWheelEventDispatcher::tick_time(Tick tick) const
+{
+  const ACE_UINT64 usec = tick * tick_usec_;
+  return origin_ + TimeDuration(static_cast<time_t>(usec / 1000000), static_cast<suseconds_t>(usec % 1000000));
+}
+
+bool TimingWheelEventDispatcher::wheel_empty() const
+{
+  for (size_t level = 0; level < LEVELS; ++level) {
+    if (counts_[level]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TimingWheelEventDispatcher::link(size_t index, size_t slot)
+{
+  Timer& timer = timers_[index];
+  timer.slot_ = slot;
+  timer.prev_ = NIL;
+  timer.next_ = heads_[slot];
+  if (timer.next_ != NIL) {
+    timers_[timer.next_].prev_ = index;
+  }
+  heads_[slot] = index;
+  ++counts_[slot / SLOTS];
+}
+
+void TimingWheelEventDispatcher::unlink(size_t index)
+{
+  Timer& timer = timers_[index];
+  if (timer.prev_ != NIL) {
+    timers_[timer.prev_].next_ = timer.next_;
+  } else {
+    heads_[timer.slot_] = timer.next_;
+  }
+  if (timer.next_ != NIL) {
+    timers_[timer.next_].prev_ = timer.prev_;
+  }
+  --counts_[timer.slot_ / SLOTS];
+  timer.slot_ = NIL;
+  timer.prev_ = NIL;
+  timer.next_ = NIL;
+}
+
+EventBase* TimingWheelEventDispatcher::release(size_t index)
+{
+  unlink(index);
+  Timer& timer = timers_[index];
+  EventBase* const event = timer.event_;
+  timer.event_ = 0;
+  ++timer.generation_;
+  free_.push_back(index);
+  --size_;
+  return event;
+}
+
+void TimingWheelEventDispatcher::place(size_t index)
+{
+  const Tick tick = timers_[index].tick_ < current_ ? current_ : timers_[index].tick_;
+  const Tick delta = tick - current_;
+  size_t level = 0;
+  while (level + 1 < LEVELS && delta >= (Tick(1) << (SLOT_BITS * (level + 1)))) {
+    ++level;
+  }
+  // Beyond the range of the wheel: park in the farthest slot and re-place on cascade.
+  const Tick range = Tick(1) << (SLOT_BITS * LEVELS);
+  const Tick slot_tick = delta < range ? tick : current_ + range - 1;
+  link(index, level * SLOTS + static_cast<size_t>((slot_tick >> (SLOT_BITS * level)) & SLOT_MASK));
+}
+
+void TimingWheelEventDispatcher::cascade(size_t level, size_t slot)
+{
+  const size_t head = level * SLOTS + slot;
+  while (heads_[head] != NIL) {
+    const size_t index = heads_[head];
+    unlink(index);
+    place(index);
+  }
+}
+
+void TimingWheelEventDispatcher::expire_slot(size_t slot, EventList& events)
+{
+  while (heads_[slot] != NIL) {
+    events.push_back(release(heads_[slot]));
+  }
+}
+
+void TimingWheelEventDispatcher::advance(Tick now, EventList& events)
+{
+  while (current_ <= now) {
+    if (wheel_empty()) {
+      current_ = now + 1;
+      break;
+    }
+    if (counts_[0] == 0 && (current_ & SLOT_MASK) != 0) {
+      // Nothing left on the first level, skip ahead to the next cascade.
+      const Tick boundary = (current_ | SLOT_MASK) + 1;
+      if (boundary > now) {
+        current_ = now + 1;
+        break;
+      }
+      current_ = boundary;
+      continue;
+    }
+    if ((current_ & SLOT_MASK) == 0) {
+      for (size_t level = 1; level < LEVELS; ++level) {
+        const size_t slot = static_cast<size_t>((current_ >> (SLOT_BITS * level)) & SLOT_MASK);
+        cascade(level, slot);
+        if (slot != 0) {
+          break;
+        }
+      }
+    }
+    expire_slot(static_cast<size_t>(current_ & SLOT_MASK), events);
+    ++current_;
+  }
+}
+
+void TimingWheelEventDispatcher::expire_near(const MonotonicTimePoint& now, EventList& events)
+{
+  size_t index = heads_[NEAR_SLOT];
+  while (index != NIL) {
+    const size_t next = timers_[index].next_;
+    if (timers_[index].expiration_ <= now) {
+      events.push_back(release(index));
+    }
+    index = next;
+  }
+}
+
+bool TimingWheelEventDispatcher::next_wakeup(MonotonicTimePoint& next) const
+{
+  bool found = false;
+  if (counts_[0]) {
+    for (Tick tick = current_; tick < current_ + SLOTS; ++tick) {
+      if (heads_[tick & SLOT_MASK] != NIL) {
+        next = tick_time(tick);
+        found = true;
+        break;
+      }
+    }
+  }
+  if (counts_[0] != size_ - counts_[LEVELS]) {
+    const MonotonicTimePoint boundary = tick_time((current_ + SLOT_MASK) & ~SLOT_MASK);
+    if (!found || boundary < next) {
+      next = boundary;
+      found = true;
+    }
+  }
+  for (size_t index = heads_[NEAR_SLOT]; index != NIL; index = timers_[index].next_) {
+    if (!found || timers_[index].expiration_ < next) {
+      next = timers_[index].expiration_;
+      found = true;
+    }
+  }
+  return found;
+}
+
+void TimingWheelEventDispatcher::expire(const MonotonicTimePoint& now)
+{
+  EventList expired;
+  MonotonicTimePoint next;
+  bool pending;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (shutdown_) {
+      return;
+    }
+    expire_near(now, expired);
+    advance(tick_floor(now), expired);
+    pending = next_wakeup(next);
+  }
+  if (pending) {
+    wakeup_->schedule(next - now);
+  }
+  if (expired.empty()) {
+    return;
+  }
+  ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager());
+  for (EventList::iterator it = expired.begin(), limit = expired.end(); it != limit; ++it) {
+    (**it)();
+  }
+}
+
+} // DCPS
+} // OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,117 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TIMING_WHEEL_EVENT_DISPATCHER_H
+#define OPENDDS_DCPS_TIMING_WHEEL_EVENT_DISPATCHER_H
+
+#include "EventDispatcher.h"
+#include "SporadicEvent.h"
+#include "PoolAllocator.h"
+
+#include <ace/Thread_Mutex.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * TimingWheelEventDispatcher is an EventDispatcher for large numbers of timers
+ *
+ * Scheduled events are kept in a hierarchical timing wheel (four levels of
+ * 256 slots) where schedule and cancel are O(1). Expiration times are rounded
+ * up to a multiple of the tick so that timers sharing a tick are expired
+ * together by a single wakeup of the base dispatcher, and expired events are
+ * run after the wheel's lock is released. Events due in less than one tick are
+ * kept apart from the wheel and are dispatched at their exact time, so that
+ * short delays (e.g. zero-delay sporadic events) are not stretched to a tick.
+ * Immediate dispatch is forwarded to the base dispatcher, which also provides
+ * the thread(s) events are run on.
+ */
+class OpenDDS_Dcps_Export TimingWheelEventDispatcher : public EventDispatcher {
+public:
+  /**
+   * Create a TimingWheelEventDispatcher
+   * @param base the dispatcher used for running events, owned (and shut down) by this one
+   * @param tick the granularity of the wheel
+   */
+  TimingWheelEventDispatcher(EventDispatcher_rch base, const TimeDuration& tick);
+  virtual ~TimingWheelEventDispatcher();
+
+  void shutdown(bool immediate = false);
+
+  bool dispatch(EventBase_rch event);
+
+  long schedule(EventBase_rch event, const MonotonicTimePoint& expiration = MonotonicTimePoint::now());
+
+  size_t cancel(long id);
+
+  /// Number of events currently scheduled
+  size_t size() const;
+
+private:
+  typedef ACE_UINT64 Tick;
+
+  static const size_t LEVELS = 4;
+  static const unsigned int SLOT_BITS = 8;
+  static const size_t SLOTS = size_t(1) << SLOT_BITS;
+  static const Tick SLOT_MASK = SLOTS - 1;
+  static const size_t NEAR_SLOT = LEVELS * SLOTS;
+  static const size_t NIL = ~size_t(0);
+
+  struct Timer {
+    Timer() : event_(0), tick_(0), generation_(0), slot_(NIL), prev_(NIL), next_(NIL) {}
+
+    EventBase* event_;
+    MonotonicTimePoint expiration_;
+    Tick tick_;
+    unsigned long generation_;
+    size_t slot_;
+    size_t prev_;
+    size_t next_;
+  };
+
+  typedef OPENDDS_VECTOR(EventBase*) EventList;
+
+  Tick tick_floor(const MonotonicTimePoint& time) const;
+  Tick tick_ceil(const MonotonicTimePoint& time) const;
+  MonotonicTimePoint tick_time(Tick tick) const;
+
+  bool wheel_empty() const;
+  void link(size_t index, size_t slot);
+  void unlink(size_t index);
+  EventBase* release(size_t index);
+  void place(size_t index);
+  void cascade(size_t level, size_t slot);
+  void expire_slot(size_t slot, EventList& events);
+  void advance(Tick now, EventList& events);
+  void expire_near(const MonotonicTimePoint& now, EventList& events);
+  bool next_wakeup(MonotonicTimePoint& next) const;
+
+  void expire(const MonotonicTimePoint& now);
+
+  mutable ACE_Thread_Mutex mutex_;
+  EventDispatcher_rch base_;
+  RcHandle<SporadicEvent> wakeup_;
+  const MonotonicTimePoint origin_;
+  ACE_UINT64 tick_usec_;
+  Tick current_;
+  OPENDDS_VECTOR(Timer) timers_;
+  OPENDDS_VECTOR(size_t) free_;
+  size_t heads_[NEAR_SLOT + 1];
+  size_t counts_[LEVELS + 1];
+  size_t size_;
+  bool shutdown_;
+};
+typedef RcHandle<TimingWheelEventDispatcher> TimingWheelEventDispatcher_rch;
+
+} // DCPS
+} // OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_DCPS_TIMING_WHEEL_EVENT_DISPATCHER_H
@@ -65,6 +65,19 @@ resend_data_expired(const DataSampleElement& element,
   return false;
 }
 
+namespace {
+  /// Deeper KEEP_LAST histories only use the container's allocator, so the
+  /// memory preallocated for each instance stays small.
+  const CORBA::Long max_slotted_depth = 16;
+
+  size_t slots_per_instance(CORBA::Long history_depth)
+  {
+    // One more than the depth so the new sample can be obtained before the
+    // oldest one is removed.
+    return history_depth > 0 && history_depth <= max_slotted_depth ? history_depth + 1 : 0;
+  }
+}
+
 WriteDataContainer::WriteDataContainer(
   DataWriterImpl* writer,
   CORBA::Long max_samples_per_instance,
@@ -86,10 +99,12 @@ WriteDataContainer::WriteDataContainer(
   CORBA::Long& deadline_last_total_count)
   : cached_cumulative_ack_valid_(false)
   , transaction_id_(0)
+  , num_all_samples_(0)
   , publication_id_(GUID_UNKNOWN)
   , writer_(writer)
   , max_samples_per_instance_(max_samples_per_instance)
   , history_depth_(history_depth)
+  , slots_per_instance_(slots_per_instance(history_depth))
   , max_durable_per_instance_(max_durable_per_instance)
   , max_num_instances_(max_instances)
   , max_num_samples_(max_total_samples)
@@ -299,9 +314,11 @@ WriteDataContainer::enqueue(
     return DDS::RETCODE_ERROR;
   }
 
-  // Get the PublicationInstance pointer from InstanceHandle_t.
-  PublicationInstance_rch instance =
-    get_handle_instance(instance_handle);
+  // obtain_buffer() already looked up the instance for this sample.
+  PublicationInstance_rch instance = sample->get_handle();
+  if (!instance) {
+    instance = get_handle_instance(instance_handle);
+  }
   // Extract the instance queue.
   InstanceDataSampleList& instance_list = instance->samples_;
 
@@ -318,6 +335,7 @@ WriteDataContainer::enqueue(
   //
   // Add this sample to the INSTANCE scope list.
   instance_list.enqueue_tail(sample);
+  ++num_all_samples_;
 
   return DDS::RETCODE_OK;
 }
@@ -423,6 +441,10 @@ WriteDataContainer::register_instance(
     } // if (0 != insert_attempt)
 
     instance->instance_handle_ = instance_handle;
+    instance_index_[instance_handle] = instance.in();
+    if (slots_per_instance_) {
+      instance->slots_.reset(new DataSampleElementAllocator(slots_per_instance_));
+    }
 
     extend_deadline(instance);
 
@@ -473,6 +495,7 @@ WriteDataContainer::unregister(
     }
     instance = pos->second;
     instances_.erase(pos);
+    instance_index_.erase(instance_handle);
   }
 
   return remove_instance(instance, registered_sample, dup_registered_sample);
@@ -562,21 +585,12 @@ WriteDataContainer::num_samples(DDS::InstanceHandle_t handle,
 size_t
 WriteDataContainer::num_all_samples()
 {
-  size_t size = 0;
-
   ACE_GUARD_RETURN(ACE_Recursive_Thread_Mutex,
                    guard,
                    lock_,
                    0);
 
-  for (PublicationInstanceMapType::iterator iter = instances_.begin();
-       iter != instances_.end();
-       ++iter)
-  {
-    size += iter->second->samples_.size();
-  }
-
-  return size;
+  return num_all_samples_;
 }
 
 ACE_UINT64
@@ -762,11 +776,17 @@ WriteDataContainer::data_delivered(const DataSampleElement* sample)
       const_cast<DataSampleElement*>(sample)->get_header().historic_sample_ = true;
       DataSampleHeader::set_flag(HISTORIC_SAMPLE_FLAG, sample->get_sample());
       sent_data_.enqueue_tail(sample);
+      const PublicationInstance_rch inst = sample->get_handle();
+      if (durable_check_.empty() || durable_check_.back() != inst) {
+        durable_check_.push_back(inst);
+      }
 
     } else {
       if (InstanceDataSampleList::on_some_list(sample)) {
         PublicationInstance_rch inst = sample->get_handle();
-        inst->samples_.dequeue(sample);
+        if (inst->samples_.dequeue(sample)) {
+          --num_all_samples_;
+        }
       }
       release_buffer(stale);
       stale = 0;
@@ -945,12 +965,14 @@ WriteDataContainer::remove_excess_durable()
 
   size_t n_released = 0;
 
-  for (PublicationInstanceMapType::iterator iter = instances_.begin();
-       iter != instances_.end();
+  // Checking an instance more than once is harmless, the later checks find
+  // nothing to remove.
+  for (PublicationInstanceVec::iterator iter = durable_check_.begin();
+       iter != durable_check_.end();
        ++iter) {
 
     CORBA::Long durable_allowed = max_durable_per_instance_;
-    InstanceDataSampleList& instance_list = iter->second->samples_;
+    InstanceDataSampleList& instance_list = (*iter)->samples_;
 
     for (DataSampleElement* it = instance_list.tail(), *prev; it; it = prev) {
       prev = InstanceDataSampleList::prev(it);
@@ -960,7 +982,9 @@ WriteDataContainer::remove_excess_durable()
         if (durable_allowed) {
           --durable_allowed;
         } else {
-          instance_list.dequeue(it);
+          if (instance_list.dequeue(it)) {
+            --num_all_samples_;
+          }
           sent_data_.dequeue(it);
           release_buffer(it);
           ++n_released;
@@ -968,6 +992,7 @@ WriteDataContainer::remove_excess_durable()
       }
     }
   }
+  durable_check_.clear();
 
   if (n_released && DCPS_debug_level > 9) {
     ACE_DEBUG((LM_DEBUG,
@@ -996,6 +1021,7 @@ WriteDataContainer::remove_oldest_sample(
                       ACE_TEXT("dequeue_head_next_sample failed\n")),
                      DDS::RETCODE_ERROR);
   }
+  --num_all_samples_;
 
   //
   // Remove the stale data from the next_writer_sample_ list.  The
@@ -1148,10 +1174,15 @@ WriteDataContainer::obtain_buffer(DataSampleElement*& element,
     return DDS::RETCODE_BAD_PARAMETER;
   }
 
+  // Once the instance's slots are used up, for example by samples the
+  // transport still holds, elements come from the container's allocator.
+  DataSampleElementAllocator& allocator =
+    (instance->slots_ && instance->slots_->available()) ?
+    *instance->slots_ : sample_list_element_allocator_;
   ACE_NEW_MALLOC_RETURN(
     element,
     static_cast<DataSampleElement*>(
-      sample_list_element_allocator_.malloc(
+      allocator.malloc(
         sizeof(DataSampleElement))),
     DataSampleElement(publication_id_,
                           this->writer_,
@@ -1311,9 +1342,14 @@ WriteDataContainer::release_buffer(DataSampleElement* element)
 {
   if (element->get_header().message_id_ == SAMPLE_DATA)
     data_holder_.dequeue(element);
-  // Release the memory to the allocator.
+  // Release the memory to the allocator.  The reference keeps the instance,
+  // and so its slots, alive after the element is destroyed.
+  const PublicationInstance_rch instance = element->get_handle();
+  DataSampleElementAllocator& allocator =
+    (instance && instance->slots_ && instance->slots_->owns(element)) ?
+    *instance->slots_ : sample_list_element_allocator_;
   ACE_DES_FREE(element,
-               sample_list_element_allocator_.free,
+               allocator.free,
                DataSampleElement);
 }
 
@@ -1349,21 +1385,22 @@ WriteDataContainer::unregister_all()
     writer_->return_handle(pos->first);
     instances_.erase(pos++);
   }
+  instance_index_.clear();
 }
 
 PublicationInstance_rch
 WriteDataContainer::get_handle_instance(DDS::InstanceHandle_t handle)
 {
-  PublicationInstance_rch instance;
-
-  if (0 != find(instances_, handle, instance)) {
+  const PublicationInstanceIndex::const_iterator pos = instance_index_.find(handle);
+  if (pos == instance_index_.end()) {
     ACE_DEBUG((LM_DEBUG,
                ACE_TEXT("(%P|%t) ")
                ACE_TEXT("WriteDataContainer::get_handle_instance, ")
                ACE_TEXT("lookup for %d failed\n"), handle));
+    return PublicationInstance_rch();
   }
 
-  return instance;
+  return rchandle_from(pos->second);
 }
 
 void
@@ -45,9 +45,20 @@ class DataDurabilityCache;
 #endif
 class FilterEvaluator;
 
+// Ordered by handle: obtain_buffer picks the instance to evict from and
+// unregister_all unregisters the instances in this order.
 typedef OPENDDS_MAP(DDS::InstanceHandle_t, PublicationInstance_rch)
   PublicationInstanceMapType;
 
+// Finds instances by handle on the write path, instances_ holds them.
+#ifdef ACE_HAS_CPP11
+typedef OPENDDS_UNORDERED_MAP(DDS::InstanceHandle_t, PublicationInstance*)
+  PublicationInstanceIndex;
+#else
+typedef OPENDDS_MAP(DDS::InstanceHandle_t, PublicationInstance*)
+  PublicationInstanceIndex;
+#endif
+
 /**
  * @class WriteDataContainer
  *
@@ -461,6 +472,15 @@ private:
 
   /// The individual instance queue threads in the data.
   PublicationInstanceMapType instances_;
+  PublicationInstanceIndex instance_index_;
+
+  /// Sum of the sizes of the instances' samples_ lists.
+  size_t num_all_samples_;
+
+  /// Instances that have had samples become historic since the last
+  /// remove_excess_durable(), the only ones that can have excess samples.
+  typedef OPENDDS_VECTOR(PublicationInstance_rch) PublicationInstanceVec;
+  PublicationInstanceVec durable_check_;
 
   /// The publication Id from repo.
   GUID_t    publication_id_;
@@ -474,6 +494,10 @@ private:
 
   CORBA::Long history_depth_;
 
+  /// The number of DataSampleElements preallocated for each instance of a
+  /// KEEP_LAST history (PublicationInstance::slots_), or zero.
+  size_t const slots_per_instance_;
+
   /// The maximum number of samples from each instance that
   /// can be added to the resend_data_ for durability.
   CORBA::Long                     max_durable_per_instance_;
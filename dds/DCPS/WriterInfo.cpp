@@ -67,6 +67,7 @@ WriterInfo::WriterInfo(const WriterInfoListener_rch& reader,
   , writer_id_(writer_id)
   , writer_qos_(writer_qos)
   , handle_(DDS::HANDLE_NIL)
+  , latency_histogram_(0)
 {
 #ifndef OPENDDS_NO_OBJECT_MODEL_PROFILE
   reset_coherent_info();
@@ -81,6 +82,24 @@ WriterInfo::WriterInfo(const WriterInfoListener_rch& reader,
   }
 }
 
+WriterInfo::~WriterInfo()
+{
+  LatencyHistogram* const histogram = latency_histogram_;
+  if (histogram) {
+    histogram->_remove_ref();
+  }
+}
+
+LatencyHistogram_rch WriterInfo::create_latency_histogram()
+{
+  LatencyHistogram* histogram = latency_histogram_;
+  if (!histogram) {
+    histogram = new LatencyHistogram;
+    latency_histogram_ = histogram;
+  }
+  return rchandle_from(histogram);
+}
+
 const char* WriterInfo::get_state_str() const
 {
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
@@ -14,6 +14,7 @@
 #include "ConditionVariable.h"
 #include "Definitions.h"
 #include "DisjointSequence.h"
+#include "LatencyHistogram.h"
 #include "PoolAllocator.h"
 #include "RcObject.h"
 #include "TimeTypes.h"
@@ -89,6 +90,8 @@ public:
              const GUID_t& writer_id,
              const DDS::DataWriterQos& writer_qos);
 
+  ~WriterInfo();
+
   /// check to see if this writer is alive (called by handle_timeout).
   /// @param now next monotonic time this DataWriter will become not active (not alive)
   ///      if no sample or liveliness message is received.
@@ -168,6 +171,18 @@ public:
 
   const char* get_state_str() const;
 
+  /// Latencies of samples from this writer, or null if the reader hasn't
+  /// enabled statistics. Once created it isn't replaced, so it can be used
+  /// without mutex_.
+  LatencyHistogram* latency_histogram() const
+  {
+    return latency_histogram_;
+  }
+
+  /// Create latency_histogram() if it doesn't exist. The reader serializes
+  /// calls with its statistics lock.
+  LatencyHistogram_rch create_latency_histogram();
+
   /// update liveliness when remove_association is called.
   void removed();
 
@@ -240,6 +255,10 @@ private:
   /// Number of received coherent changes in active change set.
   Atomic<ACE_UINT32> coherent_samples_;
 
+  /// Latencies of samples from this writer, shared with the reader's
+  /// WriterStats. This holds a reference, released by the destructor.
+  Atomic<LatencyHistogram*> latency_histogram_;
+
   /// Is this writer evaluated for owner ?
   typedef OPENDDS_MAP(DDS::InstanceHandle_t, bool) OwnerEvaluateFlags;
   OwnerEvaluateFlags owner_evaluated_;
@@ -17,6 +17,9 @@
 #  include <dds/DdsDynamicDataSeqTypeSupportImpl.h>
 #  include <dds/DdsDcpsCoreTypeSupportImpl.h>
 
+#  include <algorithm>
+#  include <cstring>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -26,10 +29,89 @@ using DCPS::LogLevel;
 using DCPS::log_level;
 using DCPS::retcode_to_string;
 
+namespace {
+  // Values of the member kinds in a FlatLayout are kept in native byte order.
+  template<typename T>
+  void flat_store(unsigned char* to, const T& value)
+  {
+    std::memcpy(to, &value, sizeof value);
+  }
+
+  void flat_store(unsigned char* to, const ACE_OutputCDR::from_int8& value)
+  {
+    std::memcpy(to, &value.val_, 1);
+  }
+
+  void flat_store(unsigned char* to, const ACE_OutputCDR::from_uint8& value)
+  {
+    std::memcpy(to, &value.val_, 1);
+  }
+
+  void flat_store(unsigned char* to, const ACE_OutputCDR::from_char& value)
+  {
+    std::memcpy(to, &value.val_, 1);
+  }
+
+  void flat_store(unsigned char* to, const ACE_OutputCDR::from_octet& value)
+  {
+    std::memcpy(to, &value.val_, 1);
+  }
+
+  void flat_store(unsigned char* to, const ACE_OutputCDR::from_boolean& value)
+  {
+    *to = value.val_ ? 1 : 0;
+  }
+
+  template<typename T>
+  void flat_load(const unsigned char* from, T& value)
+  {
+    std::memcpy(&value, from, sizeof value);
+  }
+
+  void flat_load(const unsigned char* from, ACE_OutputCDR::from_int8& value)
+  {
+    std::memcpy(&value.val_, from, 1);
+  }
+
+  void flat_load(const unsigned char* from, ACE_OutputCDR::from_uint8& value)
+  {
+    std::memcpy(&value.val_, from, 1);
+  }
+
+  void flat_load(const unsigned char* from, ACE_OutputCDR::from_char& value)
+  {
+    std::memcpy(&value.val_, from, 1);
+  }
+
+  void flat_load(const unsigned char* from, ACE_OutputCDR::from_octet& value)
+  {
+    std::memcpy(&value.val_, from, 1);
+  }
+
+  void flat_load(const unsigned char* from, ACE_OutputCDR::from_boolean& value)
+  {
+    value.val_ = *from != 0;
+  }
+
+  template<typename T>
+  T flat_value(const unsigned char* from, T value)
+  {
+    flat_load(from, value);
+    return value;
+  }
+}
+
 DynamicDataImpl::DynamicDataImpl(DDS::DynamicType_ptr type)
   : DynamicDataBase(type)
   , container_(type_, this)
 {
+  DynamicTypeImpl* const type_impl = dynamic_cast<DynamicTypeImpl*>(type_.in());
+  if (type_impl) {
+    flat_layout_ = type_impl->get_flat_layout();
+    if (flat_layout_) {
+      flat_buffer_.resize(flat_layout_->size);
+    }
+  }
 }
 
 DynamicDataImpl::DynamicDataImpl(const DynamicDataImpl& other)
@@ -39,6 +121,8 @@ DynamicDataImpl::DynamicDataImpl(const DynamicDataImpl& other)
   , DCPS::RcObject()
   , DynamicDataBase(other.type_)
   , container_(other.container_, this)
+  , flat_layout_(other.flat_layout_)
+  , flat_buffer_(other.flat_buffer_)
 {}
 
 DDS::ReturnCode_t DynamicDataImpl::set_descriptor(MemberId, DDS::MemberDescriptor*)
@@ -336,6 +420,62 @@ void DynamicDataImpl::clear_container()
   container_.single_map_.clear();
   container_.sequence_map_.clear();
   container_.complex_map_.clear();
+  std::fill(flat_buffer_.begin(), flat_buffer_.end(), 0);
+}
+
+void DynamicDataImpl::unflatten()
+{
+  if (!flat_layout_) {
+    return;
+  }
+  const DCPS::RcHandle<FlatLayout> layout = flat_layout_;
+  flat_layout_.reset();
+  for (FlatLayout::Members::const_iterator it = layout->members.begin();
+       it != layout->members.end(); ++it) {
+    const unsigned char* const from = &flat_buffer_[it->offset];
+    switch (it->kind) {
+    case TK_BOOLEAN:
+      insert_single(it->id, flat_value(from, ACE_OutputCDR::from_boolean(false)));
+      break;
+    case TK_BYTE:
+      insert_single(it->id, flat_value(from, ACE_OutputCDR::from_octet(0)));
+      break;
+    case TK_INT8:
+      insert_single(it->id, flat_value(from, ACE_OutputCDR::from_int8(0)));
+      break;
+    case TK_UINT8:
+      insert_single(it->id, flat_value(from, ACE_OutputCDR::from_uint8(0)));
+      break;
+    case TK_CHAR8:
+      insert_single(it->id, flat_value(from, ACE_OutputCDR::from_char(0)));
+      break;
+    case TK_INT16:
+      insert_single(it->id, flat_value(from, CORBA::Short()));
+      break;
+    case TK_UINT16:
+      insert_single(it->id, flat_value(from, CORBA::UShort()));
+      break;
+    case TK_INT32:
+      insert_single(it->id, flat_value(from, CORBA::Long()));
+      break;
+    case TK_UINT32:
+      insert_single(it->id, flat_value(from, CORBA::ULong()));
+      break;
+    case TK_INT64:
+      insert_single(it->id, flat_value(from, CORBA::LongLong()));
+      break;
+    case TK_UINT64:
+      insert_single(it->id, flat_value(from, CORBA::ULongLong()));
+      break;
+    case TK_FLOAT32:
+      insert_single(it->id, flat_value(from, CORBA::Float()));
+      break;
+    case TK_FLOAT64:
+      insert_single(it->id, flat_value(from, CORBA::Double()));
+      break;
+    }
+  }
+  flat_buffer_.clear();
 }
 
 DDS::ReturnCode_t DynamicDataImpl::clear_nonkey_values()
@@ -403,6 +543,14 @@ DDS::ReturnCode_t DynamicDataImpl::clear_value(DDS::MemberId id)
   }
   case TK_STRUCTURE:
   case TK_UNION: {
+    if (flat_layout_) {
+      const FlatLayout::Member* const member = flat_layout_->find(id);
+      if (!member) {
+        return DDS::RETCODE_ERROR;
+      }
+      std::fill_n(flat_buffer_.begin() + member->offset, member->size, 0);
+      break;
+    }
     DDS::DynamicTypeMember_var dtm;
     if (type_->get_member(dtm, id) != DDS::RETCODE_OK) {
       return DDS::RETCODE_ERROR;
@@ -688,6 +836,14 @@ bool DynamicDataImpl::insert_complex(DDS::MemberId id, const DDS::DynamicData_va
 template<TypeKind MemberTypeKind, typename MemberType>
 bool DynamicDataImpl::set_value_to_struct(DDS::MemberId id, const MemberType& value)
 {
+  if (flat_layout_) {
+    const FlatLayout::Member* const member = flat_layout_->find(id);
+    if (member && member->kind == MemberTypeKind) {
+      flat_store(&flat_buffer_[member->offset], value);
+      return true;
+    }
+  }
+
   DDS::MemberDescriptor_var md;
   DDS::DynamicType_var member_type;
   const DDS::ReturnCode_t rc = check_member(
@@ -695,6 +851,7 @@ bool DynamicDataImpl::set_value_to_struct(DDS::MemberId id, const MemberType& va
   if (rc != DDS::RETCODE_OK) {
     return false;
   }
+  unflatten();
   return insert_single(id, value);
 }
 
@@ -1995,6 +2152,44 @@ DDS::ReturnCode_t DynamicDataImpl::get_simple_value_enum(DCPS::Value& value,
 
 DDS::ReturnCode_t DynamicDataImpl::get_simple_value(DCPS::Value& value, DDS::MemberId id)
 {
+  if (flat_layout_) {
+    const FlatLayout::Member* const member = flat_layout_->find(id);
+    if (!member) {
+      return DDS::RETCODE_ERROR;
+    }
+    const unsigned char* const from = &flat_buffer_[member->offset];
+    switch (member->kind) {
+    case TK_BOOLEAN:
+      value = flat_value(from, ACE_OutputCDR::from_boolean(false)).val_;
+      return DDS::RETCODE_OK;
+    case TK_INT32:
+      value = flat_value(from, CORBA::Long());
+      return DDS::RETCODE_OK;
+    case TK_UINT32:
+      value = flat_value(from, CORBA::ULong());
+      return DDS::RETCODE_OK;
+    case TK_INT64:
+      value = flat_value(from, CORBA::LongLong());
+      return DDS::RETCODE_OK;
+    case TK_UINT64:
+      value = flat_value(from, CORBA::ULongLong());
+      return DDS::RETCODE_OK;
+    case TK_CHAR8:
+      value = flat_value(from, ACE_OutputCDR::from_char(0)).val_;
+      return DDS::RETCODE_OK;
+    case TK_FLOAT64:
+      value = flat_value(from, CORBA::Double());
+      return DDS::RETCODE_OK;
+    default:
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataImpl::get_simple_value:"
+                   " Member type %C is not supported by DCPS::Value\n",
+                   typekind_to_string(member->kind)));
+      }
+      return DDS::RETCODE_ERROR;
+    }
+  }
+
   DDS::DynamicTypeMember_var dtm;
   if (type_->get_member(dtm, id) != DDS::RETCODE_OK) {
     return DDS::RETCODE_ERROR;
@@ -2053,6 +2248,7 @@ bool DynamicDataImpl::set_complex_to_struct(DDS::MemberId id, DDS::DynamicData_v
   if (!member_type || !value_type || !member_type->equals(value_type)) {
     return false;
   }
+  unflatten();
   return insert_complex(id, value);
 }
 
@@ -2755,6 +2951,14 @@ bool DynamicDataImpl::get_value_from_bitmask<TK_STRING16>(CORBA::WChar*&, DDS::M
 template<TypeKind ValueTypeKind, typename ValueType>
 bool DynamicDataImpl::get_value_from_struct(ValueType& value, DDS::MemberId id)
 {
+  if (flat_layout_) {
+    const FlatLayout::Member* const member = flat_layout_->find(id);
+    if (member && member->kind == ValueTypeKind) {
+      flat_load(&flat_buffer_[member->offset], value);
+      return true;
+    }
+  }
+
   DDS::MemberDescriptor_var md;
   DDS::DynamicType_var member_type;
   DDS::ReturnCode_t rc = check_member(
@@ -2762,6 +2966,7 @@ bool DynamicDataImpl::get_value_from_struct(ValueType& value, DDS::MemberId id)
   if (rc != DDS::RETCODE_OK) {
     return false;
   }
+  unflatten();
   if (read_basic_member(value, id)) {
     return true;
   }
@@ -3595,6 +3800,7 @@ bool DynamicDataImpl::get_complex_from_aggregated(DDS::DynamicData_var& value, D
 
 bool DynamicDataImpl::get_complex_from_struct(DDS::DynamicData_ptr& value, DDS::MemberId id)
 {
+  unflatten();
   FoundStatus found_status = NOT_FOUND;
   DDS::DynamicData_var dd_var;
   if (!get_complex_from_aggregated(dd_var, id, found_status)) {
@@ -8446,6 +8652,107 @@ bool DynamicDataImpl::DataContainer::serialize_union(DCPS::Serializer& ser, DCPS
   return false;
 }
 
+bool DynamicDataImpl::serialized_size_flat(const DCPS::Encoding& encoding, size_t& size,
+                                           DCPS::Sample::Extent ext) const
+{
+  if (encoding.xcdr_version() != DCPS::Encoding::XCDR_VERSION_2) {
+    // Like DataContainer, only XCDR2 is supported for structs.
+    return false;
+  }
+  if (flat_layout_->appendable) {
+    serialized_size_delimiter(encoding, size);
+  }
+  if (ext == DCPS::Sample::Full && encoding.max_align() == 4 && size % 4 == 0) {
+    size += flat_layout_->size;
+    return true;
+  }
+  for (FlatLayout::Members::const_iterator it = flat_layout_->members.begin();
+       it != flat_layout_->members.end(); ++it) {
+    if (!exclude_member(ext, it->key, flat_layout_->has_explicit_keys)) {
+      encoding.align(size, it->size);
+      size += it->size;
+    }
+  }
+  return true;
+}
+
+bool DynamicDataImpl::serialize_flat(DCPS::Serializer& ser, DCPS::Sample::Extent ext) const
+{
+  const DCPS::Encoding& encoding = ser.encoding();
+  if (encoding.xcdr_version() != DCPS::Encoding::XCDR_VERSION_2) {
+    // Like DataContainer, only XCDR2 is supported for structs.
+    return false;
+  }
+  if (flat_layout_->appendable) {
+    size_t total_size = 0;
+    if (!serialized_size_flat(encoding, total_size, ext) || !ser.write_delimiter(total_size)) {
+      return false;
+    }
+  }
+
+  // The buffer already is the serialized form of the members when the stream
+  // is in native byte order and aligned the same way.
+  if (ext == DCPS::Sample::Full && !ser.swap_bytes() &&
+      encoding.max_align() == 4 && ser.is_aligned_w(4)) {
+    return flat_buffer_.empty() ||
+      ser.write_octet_array(&flat_buffer_[0], static_cast<ACE_CDR::ULong>(flat_buffer_.size()));
+  }
+
+  for (FlatLayout::Members::const_iterator it = flat_layout_->members.begin();
+       it != flat_layout_->members.end(); ++it) {
+    if (exclude_member(ext, it->key, flat_layout_->has_explicit_keys)) {
+      continue;
+    }
+    const unsigned char* const from = &flat_buffer_[it->offset];
+    bool good = false;
+    switch (it->kind) {
+    case TK_BOOLEAN:
+      good = ser << flat_value(from, ACE_OutputCDR::from_boolean(false));
+      break;
+    case TK_BYTE:
+      good = ser << flat_value(from, ACE_OutputCDR::from_octet(0));
+      break;
+    case TK_INT8:
+      good = ser << flat_value(from, ACE_OutputCDR::from_int8(0));
+      break;
+    case TK_UINT8:
+      good = ser << flat_value(from, ACE_OutputCDR::from_uint8(0));
+      break;
+    case TK_CHAR8:
+      good = ser << flat_value(from, ACE_OutputCDR::from_char(0));
+      break;
+    case TK_INT16:
+      good = ser << flat_value(from, CORBA::Short());
+      break;
+    case TK_UINT16:
+      good = ser << flat_value(from, CORBA::UShort());
+      break;
+    case TK_INT32:
+      good = ser << flat_value(from, CORBA::Long());
+      break;
+    case TK_UINT32:
+      good = ser << flat_value(from, CORBA::ULong());
+      break;
+    case TK_INT64:
+      good = ser << flat_value(from, CORBA::LongLong());
+      break;
+    case TK_UINT64:
+      good = ser << flat_value(from, CORBA::ULongLong());
+      break;
+    case TK_FLOAT32:
+      good = ser << flat_value(from, CORBA::Float());
+      break;
+    case TK_FLOAT64:
+      good = ser << flat_value(from, CORBA::Double());
+      break;
+    }
+    if (!good) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool DynamicDataImpl::serialized_size_i(const DCPS::Encoding& encoding, size_t& size, DCPS::Sample::Extent ext) const
 {
   const TypeKind tk = type_->get_kind();
@@ -8499,6 +8806,9 @@ bool DynamicDataImpl::serialized_size_i(const DCPS::Encoding& encoding, size_t&
     return container_.serialized_size_wstring(encoding, size);
 #endif
   case TK_STRUCTURE:
+    if (flat_layout_) {
+      return serialized_size_flat(encoding, size, ext);
+    }
     return container_.serialized_size_structure(encoding, size, ext);
   case TK_UNION:
     return container_.serialized_size_union(encoding, size, ext);
@@ -8561,6 +8871,9 @@ bool DynamicDataImpl::serialize_i(DCPS::Serializer& ser, DCPS::Sample::Extent ex
     return container_.serialize_wstring_value(ser);
 #endif
   case TK_STRUCTURE:
+    if (flat_layout_) {
+      return serialize_flat(ser, ext);
+    }
     return container_.serialize_structure(ser, ext);
   case TK_UNION:
     return container_.serialize_union(ser, ext);
@@ -1006,6 +1006,18 @@ private:
 
   DataContainer container_;
 
+  // A struct whose type has a FlatLayout (a final or appendable struct of
+  // non-optional primitives) keeps its members in flat_buffer_, which is
+  // serialized in place, instead of container_. Other types always use
+  // container_. Non-const operations that need container_ first call
+  // unflatten to move the members there for good.
+  DCPS::RcHandle<FlatLayout> flat_layout_;
+  OPENDDS_VECTOR(unsigned char) flat_buffer_;
+
+  void unflatten();
+  bool serialized_size_flat(const DCPS::Encoding& encoding, size_t& size, DCPS::Sample::Extent ext) const;
+  bool serialize_flat(DCPS::Serializer& ser, DCPS::Sample::Extent ext) const;
+
   bool serialized_size_i(const DCPS::Encoding& encoding, size_t& size, DCPS::Sample::Extent ext) const;
   bool serialize_i(DCPS::Serializer& ser, DCPS::Sample::Extent ext) const;
 
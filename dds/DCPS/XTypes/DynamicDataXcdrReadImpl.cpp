@@ -130,6 +130,7 @@ void DynamicDataXcdrReadImpl::copy(const DynamicDataXcdrReadImpl& other)
   strm_ = other.strm_;
   type_ = other.type_;
   item_count_ = other.item_count_;
+  offset_cache_ = other.offset_cache_;
 }
 
 DDS::ReturnCode_t DynamicDataXcdrReadImpl::set_descriptor(MemberId, DDS::MemberDescriptor*)
@@ -990,22 +991,30 @@ bool DynamicDataXcdrReadImpl::skip_to_sequence_element(MemberId id, DDS::Dynamic
     return (strm_ >> length) &&
       get_index_from_id(id, index, length) &&
       strm_.skip(index, size);
-  } else {
-    ACE_CDR::ULong length, index;
+  } else if (skip_all) {
+    ACE_CDR::ULong length;
     if (!strm_.skip_delimiter() || !(strm_ >> length)) {
       return false;
     }
-    if (skip_all) {
-      index = length;
-    } else if (!get_index_from_id(id, index, length)) {
-      return false;
-    }
-    for (ACE_CDR::ULong i = 0; i < index; ++i) {
+    for (ACE_CDR::ULong i = 0; i < length; ++i) {
       if (!skip_member(elem_type)) {
         return false;
       }
     }
     return true;
+  } else {
+    const size_t start = strm_.rpos();
+    OffsetIndex& offsets = offset_index(start);
+    if (!offsets.started) {
+      if (!strm_.skip_delimiter() || !(strm_ >> offsets.length)) {
+        return false;
+      }
+      offsets.starts.push_back(strm_.rpos() - start);
+      offsets.started = true;
+    }
+    ACE_CDR::ULong index;
+    return get_index_from_id(id, index, offsets.length) &&
+      skip_to_indexed_element(offsets, start, index, elem_type);
   }
 }
 
@@ -1040,22 +1049,29 @@ bool DynamicDataXcdrReadImpl::skip_to_array_element(MemberId id, DDS::DynamicTyp
   if (get_primitive_size(elem_type, size)) {
     ACE_CDR::ULong index;
     return get_index_from_id(id, index, length) && strm_.skip(index, size);
-  } else {
+  } else if (skip_all) {
     if (!strm_.skip_delimiter()) {
       return false;
     }
-    ACE_CDR::ULong index;
-    if (skip_all) {
-      index = length;
-    } else if (!get_index_from_id(id, index, length)) {
-      return false;
-    }
-    for (ACE_CDR::ULong i = 0; i < index; ++i) {
+    for (ACE_CDR::ULong i = 0; i < length; ++i) {
       if (!skip_member(elem_type)) {
         return false;
       }
     }
     return true;
+  } else {
+    const size_t start = strm_.rpos();
+    OffsetIndex& offsets = offset_index(start);
+    if (!offsets.started) {
+      if (!strm_.skip_delimiter()) {
+        return false;
+      }
+      offsets.starts.push_back(strm_.rpos() - start);
+      offsets.started = true;
+    }
+    ACE_CDR::ULong index;
+    return get_index_from_id(id, index, length) &&
+      skip_to_indexed_element(offsets, start, index, elem_type);
   }
 }
 
@@ -1545,7 +1561,7 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::get_complex_value(DDS::DynamicData_pt
           good = false;
         } else {
           CORBA::release(value);
-          value = new DynamicDataXcdrReadImpl(strm_, member_type, nested(extent_));
+          value = nested_data(member_type);
         }
       } else {
         good = false;
@@ -1583,7 +1599,7 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::get_complex_value(DDS::DynamicData_pt
           }
         }
         CORBA::release(value);
-        value = new DynamicDataXcdrReadImpl(strm_, disc_type, nested(extent_));
+        value = nested_data(disc_type);
         break;
       }
 
@@ -1607,7 +1623,7 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::get_complex_value(DDS::DynamicData_pt
         good = false;
       } else {
         CORBA::release(value);
-        value = new DynamicDataXcdrReadImpl(strm_, member_type, nested(extent_));
+        value = nested_data(member_type);
       }
       break;
     }
@@ -1621,7 +1637,7 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::get_complex_value(DDS::DynamicData_pt
         good = false;
       } else {
         CORBA::release(value);
-        value = new DynamicDataXcdrReadImpl(strm_, descriptor->element_type(), nested(extent_));
+        value = nested_data(descriptor->element_type());
       }
       break;
     }
@@ -2136,21 +2152,40 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
     return rc;
   }
 
+  const size_t start = strm_.rpos();
+  OffsetIndex& index = offset_index(start);
+
   const DDS::ExtensibilityKind ek = descriptor->extensibility_kind();
   if (ek == DDS::FINAL || ek == DDS::APPENDABLE) {
-    size_t dheader = 0;
     const bool xcdr2_appendable = encoding_.xcdr_version() == DCPS::Encoding::XCDR_VERSION_2 &&
       ek == DDS::APPENDABLE;
-    if (xcdr2_appendable && !strm_.read_delimiter(dheader)) {
-      if (log_level >= LogLevel::Notice) {
-        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataXcdrReadImpl::skip_to_struct_member: "
-                   "Failed to read DHEADER for member ID %d\n", id));
+    if (!index.started) {
+      size_t dheader = 0;
+      if (xcdr2_appendable && !strm_.read_delimiter(dheader)) {
+        if (log_level >= LogLevel::Notice) {
+          ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicDataXcdrReadImpl::skip_to_struct_member: "
+                     "Failed to read DHEADER for member ID %d\n", id));
+        }
+        return DDS::RETCODE_ERROR;
       }
-      return DDS::RETCODE_ERROR;
+      index.end = strm_.rpos() - start + dheader;
+      index.starts.push_back(strm_.rpos() - start);
+      index.started = true;
+    }
+
+    const ACE_CDR::ULong target = member_desc->index();
+    if (target >= index.no_data_from) {
+      return DDS::RETCODE_NO_DATA;
+    }
+    if (target < index.starts.size()) {
+      return seek(start, index.starts[target]) ? DDS::RETCODE_OK : DDS::RETCODE_ERROR;
     }
-    const size_t end_of_struct = strm_.rpos() + dheader;
 
-    for (ACE_CDR::ULong i = 0; i < member_desc->index(); ++i) {
+    // Resume from the last member found.
+    if (!seek(start, index.starts.back())) {
+      return DDS::RETCODE_ERROR;
+    }
+    for (ACE_CDR::ULong i = static_cast<ACE_CDR::ULong>(index.starts.size() - 1); i < target; ++i) {
       DDS::DynamicTypeMember_var dtm;
       rc = type_->get_member_by_index(dtm, i);
       if (rc != DDS::RETCODE_OK) {
@@ -2170,7 +2205,8 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         return rc;
       }
       if (exclude_member(extent_, md->is_key(), has_explicit_keys(type_))) {
-        // This member is not present in the sample, don't need to do anything.
+        // This member is not present in the sample, the next one starts at the same place.
+        index.starts.push_back(index.starts.back());
         continue;
       }
 
@@ -2182,24 +2218,39 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         }
         return DDS::RETCODE_ERROR;
       }
-      if (xcdr2_appendable && strm_.rpos() >= end_of_struct) {
+      index.starts.push_back(strm_.rpos() - start);
+      if (xcdr2_appendable && index.starts.back() >= index.end) {
+        index.no_data_from = i + 1;
         return DDS::RETCODE_NO_DATA;
       }
     }
     return DDS::RETCODE_OK;
   } else {
-    size_t dheader = 0;
-    if (!strm_.read_delimiter(dheader)) {
-      if (DCPS::DCPS_debug_level >= 1) {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
-                   ACE_TEXT(" Failed to read DHEADER for member ID %d\n"), id));
+    if (!index.started) {
+      size_t dheader = 0;
+      if (!strm_.read_delimiter(dheader)) {
+        if (DCPS::DCPS_debug_level >= 1) {
+          ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                     ACE_TEXT(" Failed to read DHEADER for member ID %d\n"), id));
+        }
+        return DDS::RETCODE_ERROR;
       }
-      return DDS::RETCODE_ERROR;
+      index.scan = strm_.rpos() - start;
+      index.end = index.scan + dheader;
+      index.started = true;
     }
 
-    const size_t end_of_struct = strm_.rpos() + dheader;
+    const OPENDDS_MAP(MemberId, size_t)::const_iterator found = index.by_id.find(id);
+    if (found != index.by_id.end()) {
+      return seek(start, found->second) ? DDS::RETCODE_OK : DDS::RETCODE_ERROR;
+    }
+
+    // Resume from the first member header that hasn't been read.
+    if (!seek(start, index.scan)) {
+      return DDS::RETCODE_ERROR;
+    }
     while (true) {
-      if (strm_.rpos() >= end_of_struct) {
+      if (index.scan >= index.end) {
         if (DCPS::DCPS_debug_level >= 1) {
           ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
                      ACE_TEXT(" Could not find a member with ID %d\n"), id));
@@ -2218,6 +2269,9 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         return DDS::RETCODE_ERROR;
       }
 
+      const size_t value_start = strm_.rpos() - start;
+      index.by_id.insert(std::make_pair(member_id, value_start));
+      index.scan = value_start + member_size;
       if (member_id == id) {
         return DDS::RETCODE_OK;
       }
@@ -2233,6 +2287,49 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
   }
 }
 
+DynamicDataXcdrReadImpl::OffsetIndex& DynamicDataXcdrReadImpl::offset_index(size_t start)
+{
+  if (!offset_cache_) {
+    offset_cache_ = DCPS::make_rch<OffsetCache>();
+  }
+  return offset_cache_->indexes[OffsetIndexKey(start, type_.in())];
+}
+
+bool DynamicDataXcdrReadImpl::seek(size_t start, size_t offset)
+{
+  const size_t pos = strm_.rpos() - start;
+  return offset >= pos && strm_.skip(offset - pos);
+}
+
+bool DynamicDataXcdrReadImpl::skip_to_indexed_element(OffsetIndex& index, size_t start,
+                                                      ACE_CDR::ULong target,
+                                                      DDS::DynamicType_ptr elem_type)
+{
+  if (target < index.starts.size()) {
+    return seek(start, index.starts[target]);
+  }
+  if (!seek(start, index.starts.back())) {
+    return false;
+  }
+  for (ACE_CDR::ULong i = static_cast<ACE_CDR::ULong>(index.starts.size() - 1); i < target; ++i) {
+    if (!skip_member(elem_type)) {
+      return false;
+    }
+    index.starts.push_back(strm_.rpos() - start);
+  }
+  return true;
+}
+
+DynamicDataXcdrReadImpl* DynamicDataXcdrReadImpl::nested_data(DDS::DynamicType_ptr type)
+{
+  if (!offset_cache_) {
+    offset_cache_ = DCPS::make_rch<OffsetCache>();
+  }
+  DynamicDataXcdrReadImpl* const data = new DynamicDataXcdrReadImpl(strm_, type, nested(extent_));
+  data->offset_cache_ = offset_cache_;
+  return data;
+}
+
 bool DynamicDataXcdrReadImpl::get_from_struct_common_checks(const DDS::MemberDescriptor_var& md,
   MemberId id, TypeKind kind, bool is_sequence)
 {
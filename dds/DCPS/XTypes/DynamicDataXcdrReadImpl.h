@@ -432,6 +432,58 @@ private:
   ///
   DDS::ReturnCode_t skip_to_struct_member(DDS::MemberDescriptor* member_desc, MemberId id);
 
+  /// Where the members of a struct or the elements of a collection start,
+  /// relative to the start of that struct or collection, as far as they have
+  /// been found. Skipping to a member that was found before seeks straight to
+  /// it, and skipping past the last one found resumes from there.
+  struct OffsetIndex {
+    OffsetIndex()
+      : length(0)
+      , no_data_from(ACE_UINT32_MAX)
+      , end(0)
+      , scan(0)
+      , started(false)
+    {}
+
+    /// Start of each member of a final or appendable struct by index, or of
+    /// each non-primitive element of a collection.
+    OPENDDS_VECTOR(size_t) starts;
+    /// Start of the value of each member of a mutable struct by id.
+    OPENDDS_MAP(MemberId, size_t) by_id;
+    /// Length of a sequence.
+    ACE_CDR::ULong length;
+    /// First member index of an appendable struct that isn't in the sample.
+    ACE_CDR::ULong no_data_from;
+    /// End of an appendable or mutable struct.
+    size_t end;
+    /// Next member header of a mutable struct.
+    size_t scan;
+    bool started;
+  };
+
+  /// The offset indexes of all the structs and collections of a sample,
+  /// by the position and type of each. It is shared with the DynamicData
+  /// objects returned by get_complex_value, which index the same sample.
+  typedef std::pair<size_t, const void*> OffsetIndexKey;
+  struct OffsetCache : public DCPS::RcObject {
+    OPENDDS_MAP(OffsetIndexKey, OffsetIndex) indexes;
+  };
+
+  /// Index of the data starting at position 'start' of strm_.
+  OffsetIndex& offset_index(size_t start);
+
+  /// Move strm_ forward to 'offset' from position 'start'.
+  bool seek(size_t start, size_t offset);
+
+  /// Skip to the non-primitive element at 'target' using an index whose
+  /// first start has been filled in.
+  bool skip_to_indexed_element(OffsetIndex& index, size_t start, ACE_CDR::ULong target,
+                               DDS::DynamicType_ptr elem_type);
+
+  /// Create a DynamicData for the data at the current position of strm_
+  /// that shares offset_cache_.
+  DynamicDataXcdrReadImpl* nested_data(DDS::DynamicType_ptr type);
+
   bool get_from_struct_common_checks(const DDS::MemberDescriptor_var& md, MemberId id,
                                      TypeKind kind, bool is_sequence = false);
 
@@ -561,6 +613,8 @@ private:
 
   /// Cache the number of items (i.e., members or elements) in the data it holds.
   ACE_CDR::ULong item_count_;
+
+  DCPS::RcHandle<OffsetCache> offset_cache_;
 };
 
 OpenDDS_Dcps_Export bool print_dynamic_data(DDS::DynamicData_ptr dd,
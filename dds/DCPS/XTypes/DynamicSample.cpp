@@ -22,6 +22,29 @@ namespace XTypes {
 
 using namespace OpenDDS::DCPS;
 
+namespace {
+  // Data read by DynamicSample::deserialize, like the keys DataWriterImpl
+  // keeps in its InstanceKeyIndex, has to be copied to a DynamicDataImpl to be
+  // serialized again.
+  DDS::DynamicData_var serializable(const DDS::DynamicData_var& data)
+  {
+    if (!dynamic_cast<DynamicDataXcdrReadImpl*>(data.in())) {
+      return data;
+    }
+    const DDS::DynamicType_var type = data->type();
+    DDS::DynamicData_var impl = new DynamicDataImpl(type);
+    const DDS::ReturnCode_t rc = copy(impl.in(), data.in());
+    if (rc != DDS::RETCODE_OK) {
+      if (log_level >= LogLevel::Warning) {
+        ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: DynamicSample: "
+          "copying deserialized data returned %C\n", retcode_to_string(rc)));
+      }
+      return DDS::DynamicData_var();
+    }
+    return impl;
+  }
+}
+
 DynamicSample::DynamicSample()
 {}
 
@@ -42,7 +65,8 @@ DynamicSample& DynamicSample::operator=(const DynamicSample& rhs)
 
 size_t DynamicSample::serialized_size(const Encoding& enc) const
 {
-  const DynamicDataImpl* const ddi = dynamic_cast<DynamicDataImpl*>(data_.in());
+  const DDS::DynamicData_var data = serializable(data_);
+  const DynamicDataImpl* const ddi = dynamic_cast<DynamicDataImpl*>(data.in());
   if (!ddi) {
     if (log_level >= LogLevel::Warning) {
       ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: DynamicSample::serialized_size: "
@@ -57,7 +81,8 @@ size_t DynamicSample::serialized_size(const Encoding& enc) const
 
 bool DynamicSample::serialize(Serializer& ser) const
 {
-  const DynamicDataImpl* const ddi = dynamic_cast<DynamicDataImpl*>(data_.in());
+  const DDS::DynamicData_var data = serializable(data_);
+  const DynamicDataImpl* const ddi = dynamic_cast<DynamicDataImpl*>(data.in());
   if (!ddi) {
     if (log_level >= LogLevel::Notice) {
       ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicSample::serialize: "
@@ -70,6 +95,20 @@ bool DynamicSample::serialize(Serializer& ser) const
     : ser << *ddi;
 }
 
+bool DynamicSample::serialize_key(ACE_Message_Block& buffer) const
+{
+  const DDS::DynamicData_var data = serializable(data_);
+  const DynamicDataImpl* const ddi = dynamic_cast<DynamicDataImpl*>(data.in());
+  if (!ddi) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DynamicSample::serialize_key: "
+        "DynamicData must be DynamicDataImpl, the type supplied by DynamicDataFactory\n"));
+    }
+    return false;
+  }
+  return serialize_instance_key(buffer, DCPS::KeyOnly<const DynamicDataImpl>(*ddi));
+}
+
 bool DynamicSample::deserialize(Serializer& ser)
 {
   // DynamicDataXcdrReadImpl uses a message block to read the data on demand,
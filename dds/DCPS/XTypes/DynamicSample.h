@@ -45,6 +45,7 @@ public:
   bool deserialize(DCPS::Serializer& ser);
   size_t serialized_size(const DCPS::Encoding& enc) const;
   bool compare(const DCPS::Sample& other) const;
+  bool serialize_key(ACE_Message_Block& buffer) const;
 
   bool to_message_block(ACE_Message_Block&) const
   {
@@ -86,6 +87,11 @@ public:
   {
     return evaluator.eval(*this, params);
   }
+
+  DCPS::Value get_field_value(const char* field) const
+  {
+    return DCPS::getMetaStruct<DynamicSample>().getValue(this, field);
+  }
 #endif
 
   struct KeyLessThan {
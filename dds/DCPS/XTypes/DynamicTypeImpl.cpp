@@ -6,10 +6,12 @@
 
 #include "DynamicTypeMemberImpl.h"
 
+#include <dds/DCPS/Serializer.h>
 #include <dds/DCPS/debug.h>
 
 #include <dds/DdsDcpsInfrastructureC.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -17,8 +19,122 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace XTypes {
 
+namespace {
+  const size_t no_member = ~size_t(0);
+
+  bool id_less(const FlatLayout::Member& member, DDS::MemberId id)
+  {
+    return member.id < id;
+  }
+
+  bool id_order(const FlatLayout::Member& a, const FlatLayout::Member& b)
+  {
+    return a.id < b.id;
+  }
+}
+
+const FlatLayout::Member* FlatLayout::find(DDS::MemberId id) const
+{
+  if (!index_by_id_.empty()) {
+    if (id >= index_by_id_.size() || index_by_id_[id] == no_member) {
+      return 0;
+    }
+    return &members[index_by_id_[id]];
+  }
+  const Members::const_iterator it = std::lower_bound(by_id_.begin(), by_id_.end(), id, id_less);
+  return it != by_id_.end() && it->id == id ? &*it : 0;
+}
+
+size_t FlatLayout::kind_size(TypeKind kind)
+{
+  switch (kind) {
+  case TK_BOOLEAN:
+  case TK_BYTE:
+  case TK_INT8:
+  case TK_UINT8:
+  case TK_CHAR8:
+    return 1;
+  case TK_INT16:
+  case TK_UINT16:
+    return 2;
+  case TK_INT32:
+  case TK_UINT32:
+  case TK_FLOAT32:
+    return 4;
+  case TK_INT64:
+  case TK_UINT64:
+  case TK_FLOAT64:
+    return 8;
+  default:
+    return 0;
+  }
+}
+
+DCPS::RcHandle<FlatLayout> FlatLayout::make(DDS::DynamicType_ptr type)
+{
+  DCPS::RcHandle<FlatLayout> none;
+  if (!type || type->get_kind() != TK_STRUCTURE) {
+    return none;
+  }
+  DDS::TypeDescriptor_var td;
+  if (type->get_descriptor(td) != DDS::RETCODE_OK) {
+    return none;
+  }
+  const DDS::ExtensibilityKind ek = td->extensibility_kind();
+  if (ek == DDS::MUTABLE || td->base_type()) {
+    return none;
+  }
+
+  DCPS::RcHandle<FlatLayout> layout = DCPS::make_rch<FlatLayout>();
+  layout->appendable = ek == DDS::APPENDABLE;
+  const ACE_CDR::ULong count = type->get_member_count();
+  DDS::MemberId max_id = 0;
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    DDS::DynamicTypeMember_var dtm;
+    DDS::MemberDescriptor_var md;
+    if (type->get_member_by_index(dtm, i) != DDS::RETCODE_OK ||
+        dtm->get_descriptor(md) != DDS::RETCODE_OK ||
+        md->is_optional()) {
+      return none;
+    }
+    const DDS::DynamicType_var member_type = get_base_type(md->type());
+    if (!member_type) {
+      return none;
+    }
+    Member member;
+    member.id = md->id();
+    member.kind = member_type->get_kind();
+    member.size = kind_size(member.kind);
+    if (!member.size) {
+      return none;
+    }
+    member.key = md->is_key();
+    layout->has_explicit_keys = layout->has_explicit_keys || member.key;
+    // XCDR2 aligns 8-byte values to 4.
+    DCPS::align(layout->size, (std::min)(member.size, size_t(4)));
+    member.offset = layout->size;
+    layout->size += member.size;
+    layout->members.push_back(member);
+    max_id = (std::max)(max_id, member.id);
+  }
+
+  // Member ids are usually sequential, so look them up directly when that
+  // doesn't waste much space and fall back to a binary search otherwise.
+  if (max_id < 2 * count + 16) {
+    layout->index_by_id_.resize(max_id + 1, no_member);
+    for (size_t i = 0; i < layout->members.size(); ++i) {
+      layout->index_by_id_[layout->members[i].id] = i;
+    }
+  } else {
+    layout->by_id_ = layout->members;
+    std::sort(layout->by_id_.begin(), layout->by_id_.end(), id_order);
+  }
+  return layout;
+}
+
 DynamicTypeImpl::DynamicTypeImpl()
   : preset_type_info_set_(false)
+  , flat_layout_computed_(false)
 {}
 
 DynamicTypeImpl::~DynamicTypeImpl()
@@ -29,6 +145,7 @@ void DynamicTypeImpl::set_descriptor(DDS::TypeDescriptor* descriptor)
   // ValueTypes don't have a duplicate so manually add_ref.
   CORBA::add_ref(descriptor);
   descriptor_ = descriptor;
+  reset_flat_layout();
 }
 
 DDS::ReturnCode_t DynamicTypeImpl::get_descriptor(DDS::TypeDescriptor*& descriptor)
@@ -164,6 +281,7 @@ void DynamicTypeImpl::insert_dynamic_member(DDS::DynamicTypeMember_ptr dtm)
     member_by_id_.insert(std::make_pair(d->id(), DDS::DynamicTypeMember::_duplicate(dtm)));
   }
   member_by_name_.insert(std::make_pair(d->name(), DDS::DynamicTypeMember::_duplicate(dtm)));
+  reset_flat_layout();
 }
 
 void DynamicTypeImpl::clear()
@@ -172,6 +290,24 @@ void DynamicTypeImpl::clear()
   member_by_id_.clear();
   member_by_index_.clear();
   descriptor_ = 0;
+  reset_flat_layout();
+}
+
+DCPS::RcHandle<FlatLayout> DynamicTypeImpl::get_flat_layout()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(flat_layout_mutex_);
+  if (!flat_layout_computed_) {
+    flat_layout_ = FlatLayout::make(this);
+    flat_layout_computed_ = true;
+  }
+  return flat_layout_;
+}
+
+void DynamicTypeImpl::reset_flat_layout()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(flat_layout_mutex_);
+  flat_layout_computed_ = false;
+  flat_layout_.reset();
 }
 
 DDS::DynamicType_var get_base_type(DDS::DynamicType_ptr type)
@@ -10,6 +10,8 @@
 #include <dds/DCPS/RcObject.h>
 #include <dds/DdsDynamicDataC.h>
 
+#include <ace/Thread_Mutex.h>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -97,6 +99,45 @@ private:
   MapType map_;
 };
 
+/**
+ * Layout of a struct whose members are all non-optional primitives, used by
+ * DynamicDataImpl to store such a struct in one contiguous buffer. Members
+ * are placed in declaration order with XCDR2 alignment, so an aligned buffer
+ * in native byte order is the serialized form of the struct's members.
+ */
+struct OpenDDS_Dcps_Export FlatLayout : public DCPS::RcObject {
+  struct Member {
+    DDS::MemberId id;
+    TypeKind kind;
+    size_t offset;
+    size_t size;
+    bool key;
+  };
+
+  typedef OPENDDS_VECTOR(Member) Members;
+  Members members;
+  size_t size;
+  bool appendable;
+  bool has_explicit_keys;
+
+  FlatLayout() : size(0), appendable(false), has_explicit_keys(false) {}
+
+  /// Returns null if there is no member with the given id.
+  const Member* find(DDS::MemberId id) const;
+
+  /// Returns null if the type can't be laid out flat.
+  static DCPS::RcHandle<FlatLayout> make(DDS::DynamicType_ptr type);
+
+  /// Serialized size of the primitive kinds stored in a FlatLayout, 0 otherwise.
+  static size_t kind_size(TypeKind kind);
+
+private:
+  /// Index into members by member id, used when the ids are dense.
+  OPENDDS_VECTOR(size_t) index_by_id_;
+  /// Members sorted by id, used otherwise.
+  Members by_id_;
+};
+
 class OpenDDS_Dcps_Export DynamicTypeImpl : public DDS::DynamicType {
 public:
   DynamicTypeImpl();
@@ -120,6 +161,10 @@ public:
   void insert_dynamic_member(DDS::DynamicTypeMember_ptr dtm);
   void clear();
 
+  /// The FlatLayout of this type, computed on first use. Null if the type
+  /// can't be laid out flat.
+  DCPS::RcHandle<FlatLayout> get_flat_layout();
+
   void set_minimal_type_identifier(const TypeIdentifier& ti)
   {
     minimal_ti_ = ti;
@@ -184,6 +229,12 @@ private:
   TypeMap complete_tm_;
   bool preset_type_info_set_;
   TypeInformation preset_type_info_;
+
+  ACE_Thread_Mutex flat_layout_mutex_;
+  bool flat_layout_computed_;
+  DCPS::RcHandle<FlatLayout> flat_layout_;
+
+  void reset_flat_layout();
 };
 
 OpenDDS_Dcps_Export DDS::DynamicType_var get_base_type(DDS::DynamicType_ptr type);
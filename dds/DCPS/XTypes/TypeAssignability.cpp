@@ -137,8 +137,17 @@ bool TypeAssignability::assignable(const TypeIdentifier& ta,
     // Assuming only equivalence kind of EK_MINIMAL is supported
     return false;
   case EK_MINIMAL: {
+    // Only ignore_member_names affects the result, so results for hashed
+    // types can be shared by every reader and writer using tl_service_.
+    bool result = false;
+    ACE_UINT64 generation = 0;
+    if (tl_service_->get_assignable(ta, tb, type_consistency_.ignore_member_names, result, generation)) {
+      return result;
+    }
     const MinimalTypeObject& base_type_a = lookup_minimal(ta);
-    return assignable(TypeObject(base_type_a), tb);
+    result = assignable(TypeObject(base_type_a), tb);
+    tl_service_->set_assignable(ta, tb, type_consistency_.ignore_member_names, result, generation);
+    return result;
   }
   default:
     return false; // Future extensions
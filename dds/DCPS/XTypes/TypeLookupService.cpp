@@ -35,6 +35,7 @@ namespace OpenDDS {
 namespace XTypes {
 
 TypeLookupService::TypeLookupService()
+  : assignable_generation_(0)
 {
   to_empty_.minimal.kind = TK_NONE;
   to_empty_.complete.kind = TK_NONE;
@@ -135,6 +136,7 @@ void TypeLookupService::add_type_objects_to_cache(const TypeIdentifierTypeObject
       TypeObject to = types[i].type_object;
       if (set_type_object_defaults(to)) {
         type_map_.insert(std::make_pair(types[i].type_identifier, to));
+        types_added_i();
       }
     }
   }
@@ -143,7 +145,11 @@ void TypeLookupService::add_type_objects_to_cache(const TypeIdentifierTypeObject
 void TypeLookupService::add(TypeMap::const_iterator begin, TypeMap::const_iterator end)
 {
   ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+  const size_t size = type_map_.size();
   type_map_.insert(begin, end);
+  if (type_map_.size() != size) {
+    types_added_i();
+  }
 }
 
 void TypeLookupService::add(const TypeIdentifier& ti, const TypeObject& tobj)
@@ -152,6 +158,7 @@ void TypeLookupService::add(const TypeIdentifier& ti, const TypeObject& tobj)
   TypeMap::const_iterator pos = type_map_.find(ti);
   if (pos == type_map_.end()) {
     type_map_.insert(std::make_pair(ti, tobj));
+    types_added_i();
   }
 }
 
@@ -1108,6 +1115,54 @@ void TypeLookupService::add_type_dependencies(const TypeIdentifier& type_id,
   }
 }
 
+bool TypeLookupService::get_assignable(const TypeIdentifier& ta, const TypeIdentifier& tb,
+                                       bool ignore_member_names, bool& result,
+                                       ACE_UINT64& generation) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
+  const AssignableMap::const_iterator pos = assignable_map_.find(AssignableKey(ta, tb, ignore_member_names));
+  if (pos == assignable_map_.end()) {
+    ++assignability_stats_.misses;
+    generation = assignable_generation_;
+    return false;
+  }
+  ++assignability_stats_.hits;
+  result = pos->second;
+  return true;
+}
+
+void TypeLookupService::set_assignable(const TypeIdentifier& ta, const TypeIdentifier& tb,
+                                       bool ignore_member_names, bool result, ACE_UINT64 generation)
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+  // A type added while the result was computed may have been the one that was missing.
+  if (result || generation == assignable_generation_) {
+    assignable_map_[AssignableKey(ta, tb, ignore_member_names)] = result;
+  }
+}
+
+TypeLookupService::AssignabilityStats TypeLookupService::assignability_stats() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, AssignabilityStats());
+  AssignabilityStats stats = assignability_stats_;
+  stats.entries = assignable_map_.size();
+  return stats;
+}
+
+void TypeLookupService::types_added_i()
+{
+  // Adding a type never replaces one, so only a result that failed because
+  // of a missing type can change.
+  for (AssignableMap::iterator pos = assignable_map_.begin(); pos != assignable_map_.end();) {
+    if (pos->second) {
+      ++pos;
+    } else {
+      assignable_map_.erase(pos++);
+    }
+  }
+  ++assignable_generation_;
+}
+
 bool TypeLookupService::type_object_in_cache(const TypeIdentifier& ti) const
 {
   ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
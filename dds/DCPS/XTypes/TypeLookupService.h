@@ -74,6 +74,26 @@ public:
   void cache_type_info(const DDS::BuiltinTopicKey_t& key, const TypeInformation& type_info);
   const TypeInformation& get_type_info(const DDS::BuiltinTopicKey_t& key) const;
 
+  /// For remembering the results of TypeAssignability for pairs of hashed
+  /// TypeIdentifiers. Negative results are forgotten when a type is added,
+  /// since the type may have been missing when they were computed.
+  ///@{
+  struct AssignabilityStats {
+    AssignabilityStats() : hits(0), misses(0), entries(0) {}
+    ACE_UINT64 hits;
+    ACE_UINT64 misses;
+    size_t entries;
+  };
+
+  /// Return true and set 'result' if the result for the pair is known.
+  /// Otherwise set 'generation' to pass to set_assignable.
+  bool get_assignable(const TypeIdentifier& ta, const TypeIdentifier& tb,
+                      bool ignore_member_names, bool& result, ACE_UINT64& generation) const;
+  void set_assignable(const TypeIdentifier& ta, const TypeIdentifier& tb,
+                      bool ignore_member_names, bool result, ACE_UINT64 generation);
+  AssignabilityStats assignability_stats() const;
+  ///@}
+
 private:
   const TypeObject& get_type_object_i(const TypeIdentifier& type_id) const;
   void get_type_dependencies_i(const TypeIdentifierSeq& type_ids,
@@ -122,6 +142,37 @@ private:
                           DCPS::BuiltinTopicKey_tKeyLessThan) TypeInformationMap;
   TypeInformationMap type_info_map_;
   TypeInformation type_info_empty_;
+
+  struct AssignableKey {
+    AssignableKey(const TypeIdentifier& ta, const TypeIdentifier& tb, bool ignore_member_names)
+      : ta(ta), tb(tb), ignore_member_names(ignore_member_names) {}
+
+    bool operator<(const AssignableKey& other) const
+    {
+      if (ignore_member_names != other.ignore_member_names) {
+        return ignore_member_names < other.ignore_member_names;
+      }
+      if (ta < other.ta) {
+        return true;
+      }
+      if (other.ta < ta) {
+        return false;
+      }
+      return tb < other.tb;
+    }
+
+    TypeIdentifier ta;
+    TypeIdentifier tb;
+    bool ignore_member_names;
+  };
+  typedef OPENDDS_MAP(AssignableKey, bool) AssignableMap;
+  AssignableMap assignable_map_;
+  /// Incremented when a type is added.
+  ACE_UINT64 assignable_generation_;
+  mutable AssignabilityStats assignability_stats_;
+
+  /// Forget the negative results in assignable_map_. mutex_ must be held.
+  void types_added_i();
 };
 
 typedef DCPS::RcHandle<TypeLookupService> TypeLookupService_rch;
@@ -24,6 +24,9 @@
 #include "dds/DCPS/RTPS/MessageParser.h"
 #include "dds/DCPS/RTPS/RtpsCoreTypeSupportImpl.h"
 
+#include <ace/TSS_T.h>
+
+#include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
@@ -89,7 +92,7 @@ bool CryptoBuiltInImpl::marshal(TAO_OutputCDR&)
 
 NativeCryptoHandle CryptoBuiltInImpl::generate_handle()
 {
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   return generate_handle_i();
 }
 
@@ -164,7 +167,7 @@ ParticipantCryptoHandle CryptoBuiltInImpl::register_local_participant(
   KeySeq keys;
   DCPS::push_back(keys, key);
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -365,7 +368,7 @@ DatawriterCryptoHandle CryptoBuiltInImpl::register_local_datawriter(
     }
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -412,7 +415,7 @@ DatareaderCryptoHandle CryptoBuiltInImpl::register_matched_remote_datareader(
     return DDS::HANDLE_NIL;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto_handle);
   if (iter == keys_.end()) {
     CommonUtilities::set_security_error(ex, -1, 0, "Invalid Local DataWriter Crypto Handle");
@@ -520,7 +523,7 @@ DatareaderCryptoHandle CryptoBuiltInImpl::register_local_datareader(
     DCPS::push_back(keys, key);
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[h] = keys;
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -566,7 +569,7 @@ DatawriterCryptoHandle CryptoBuiltInImpl::register_matched_remote_datawriter(
     return DDS::HANDLE_NIL;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto_handle);
   if (iter == keys_.end()) {
     CommonUtilities::set_security_error(ex, -1, 0, "Invalid Local DataReader Crypto Handle");
@@ -652,7 +655,7 @@ bool CryptoBuiltInImpl::unregister_participant(ParticipantCryptoHandle handle, S
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_common_data(handle);
   for (DerivedKeyIndex_t::iterator it = derived_key_handles_.lower_bound(std::make_pair(handle, 0));
        it != derived_key_handles_.end() && it->first.first == handle; derived_key_handles_.erase(it++)) {
@@ -715,7 +718,7 @@ bool CryptoBuiltInImpl::unregister_datawriter(DatawriterCryptoHandle handle, Sec
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_endpoint_data(handle);
   return true;
 }
@@ -726,7 +729,7 @@ bool CryptoBuiltInImpl::unregister_datareader(DatareaderCryptoHandle handle, Sec
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid Crypto Handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   clear_endpoint_data(handle);
   return true;
 }
@@ -808,7 +811,7 @@ bool CryptoBuiltInImpl::create_local_participant_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote participant handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_participant_crypto);
   if (iter != keys_.end()) {
     local_participant_crypto_tokens = keys_to_tokens(iter->second);
@@ -831,7 +834,7 @@ bool CryptoBuiltInImpl::have_local_participant_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_participant_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -852,7 +855,7 @@ bool CryptoBuiltInImpl::set_remote_participant_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote participant handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_participant_crypto] = tokens_to_keys(remote_participant_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -873,7 +876,7 @@ bool CryptoBuiltInImpl::have_remote_participant_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_participant_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -894,7 +897,7 @@ bool CryptoBuiltInImpl::create_local_datawriter_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote reader handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto);
   if (iter != keys_.end()) {
     local_datawriter_crypto_tokens = keys_to_tokens(iter->second);
@@ -916,7 +919,7 @@ bool CryptoBuiltInImpl::have_local_datawriter_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datawriter_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -937,7 +940,7 @@ bool CryptoBuiltInImpl::set_remote_datawriter_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote datawriter handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_datawriter_crypto] = tokens_to_keys(remote_datawriter_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -958,7 +961,7 @@ bool CryptoBuiltInImpl::have_remote_datawriter_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_datawriter_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -979,7 +982,7 @@ bool CryptoBuiltInImpl::create_local_datareader_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote writer handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto);
   if (iter != keys_.end()) {
     local_datareader_crypto_tokens = keys_to_tokens(iter->second);
@@ -1001,7 +1004,7 @@ bool CryptoBuiltInImpl::have_local_datareader_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(local_datareader_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -1022,7 +1025,7 @@ bool CryptoBuiltInImpl::set_remote_datareader_crypto_tokens(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid remote datareader handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Write_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   keys_[remote_datareader_crypto] = tokens_to_keys(remote_datareader_tokens);
   if (DCPS::security_debug.bookkeeping) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {bookkeeping} ")
@@ -1043,7 +1046,7 @@ bool CryptoBuiltInImpl::have_remote_datareader_crypto_tokens(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(remote_datareader_crypto);
   if (iter == keys_.end()) {
     return false;
@@ -1076,13 +1079,58 @@ namespace {
           kind[TransformKindIndex] == CRYPTO_TRANSFORMATION_KIND_AES256_GMAC);
   }
 
-  struct CipherContext {
-    EVP_CIPHER_CTX* ctx_;
-    CipherContext() : ctx_(EVP_CIPHER_CTX_new()) {}
-    operator EVP_CIPHER_CTX*() { return ctx_; }
-    ~CipherContext() { EVP_CIPHER_CTX_free(ctx_); }
+  // AES-256-GCM context reused by one thread across operations.  The key
+  // schedule is only recomputed when the key differs from the previous
+  // operation's, otherwise just the IV (and with it the GCM state) is reset.
+  class CachedCipher {
+  public:
+    explicit CachedCipher(bool encrypt)
+      : ctx_(EVP_CIPHER_CTX_new())
+      , encrypt_(encrypt)
+      , keyed_(false)
+    {}
+
+    ~CachedCipher()
+    {
+      EVP_CIPHER_CTX_free(ctx_);
+      OPENSSL_cleanse(key_, sizeof key_);
+    }
+
+    EVP_CIPHER_CTX* init(const unsigned char* key, const unsigned char* iv)
+    {
+      if (!ctx_) {
+        return 0;
+      }
+      if (keyed_ && std::memcmp(key_, key, sizeof key_) == 0
+          && EVP_CipherInit_ex(ctx_, 0, 0, 0, iv, encrypt_) == 1) {
+        return ctx_;
+      }
+      keyed_ = false;
+      if (EVP_CipherInit_ex(ctx_, EVP_aes_256_gcm(), 0, key, iv, encrypt_) != 1) {
+        return 0;
+      }
+      std::memcpy(key_, key, sizeof key_);
+      keyed_ = true;
+      return ctx_;
+    }
+
+  private:
+    CachedCipher(const CachedCipher&);
+    CachedCipher& operator=(const CachedCipher&);
+
+    EVP_CIPHER_CTX* const ctx_;
+    const int encrypt_;
+    unsigned char key_[KEY_LEN_BYTES];
+    bool keyed_;
+  };
+
+  struct ThreadCiphers {
+    ThreadCiphers() : encrypt_(true), decrypt_(false) {}
+    CachedCipher encrypt_, decrypt_;
   };
 
+  ACE_TSS<ThreadCiphers> thread_ciphers;
+
   bool inc32(unsigned char* a)
   {
     for (int i = 0; i < 4; ++i) {
@@ -1110,7 +1158,7 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
     return CommonUtilities::set_security_error(ex, -1, 0, "Invalid datawriter handle");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator keys_iter = keys_.find(sending_datawriter_crypto);
   const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(sending_datawriter_crypto);
   if (eo_iter == encrypt_options_.end()) {
@@ -1137,12 +1185,12 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   const KeyId_t sKey = std::make_pair(sending_datawriter_crypto, key_idx);
 
   if (encrypts(keyseq[key_idx])) {
-    ok = encrypt(keyseq[key_idx], sessions_[sKey], plain_buffer,
+    ok = encrypt(keyseq[key_idx], sKey, plain_buffer,
                  header, footer, out, ex);
     pOut = &out;
 
   } else if (authenticates(keyseq[key_idx])) {
-    ok = authtag(keyseq[key_idx], sessions_[sKey], plain_buffer,
+    ok = authtag(keyseq[key_idx], sKey, plain_buffer,
                  header, footer, ex);
 
   } else {
@@ -1176,6 +1224,28 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   return ser.good_bit();
 }
 
+CryptoBuiltInImpl::Session& CryptoBuiltInImpl::session(const KeyId_t& id)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(session_mutex_);
+  return sessions_[id];
+}
+
+ACE_Thread_Mutex& CryptoBuiltInImpl::session_lock(const KeyId_t& id)
+{
+  const size_t h = static_cast<size_t>(id.first) * 31 + id.second;
+  return session_locks_[h % SESSION_LOCK_COUNT];
+}
+
+void CryptoBuiltInImpl::Session::copy_key(SessionKey& sess_key) const
+{
+  sess_key.valid_ = key_.length() == sizeof sess_key.key_;
+  if (sess_key.valid_) {
+    std::memcpy(sess_key.key_, key_.get_buffer(), sizeof sess_key.key_);
+  }
+  std::memcpy(sess_key.iv_, &id_, sizeof id_);
+  std::memcpy(sess_key.iv_ + sizeof id_, &iv_suffix_, sizeof iv_suffix_);
+}
+
 void CryptoBuiltInImpl::Session::create_key(const KeyMaterial& master)
 {
   RAND_bytes(id_, sizeof id_);
@@ -1200,13 +1270,18 @@ void CryptoBuiltInImpl::Session::inc_iv()
   }
 }
 
-void CryptoBuiltInImpl::encauth_setup(const KeyMaterial& master, Session& sess,
+void CryptoBuiltInImpl::encauth_setup(const KeyMaterial& master,
+                                      const KeyId_t& sess_id,
                                       const DDS::OctetSeq& plain,
-                                      CryptoHeader& header)
+                                      CryptoHeader& header,
+                                      SessionKey& sess_key)
 {
   const unsigned int blocks =
     (plain.length() + BLOCK_LEN_BYTES - 1) / BLOCK_LEN_BYTES;
 
+  ACE_Guard<ACE_Thread_Mutex> guard(session_lock(sess_id));
+  Session& sess = session(sess_id);
+
   if (!sess.key_.length()) {
     sess.create_key(master);
 
@@ -1224,9 +1299,11 @@ void CryptoBuiltInImpl::encauth_setup(const KeyMaterial& master, Session& sess,
               &master.sender_key_id, sizeof master.sender_key_id);
   std::memcpy(&header.session_id, &sess.id_, sizeof sess.id_);
   std::memcpy(&header.initialization_vector_suffix, &sess.iv_suffix_, sizeof sess.iv_suffix_);
+  sess.copy_key(sess_key);
 }
 
-bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
+bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master,
+                                const KeyId_t& sess_id,
                                 const DDS::OctetSeq& plain,
                                 CryptoHeader& header, CryptoFooter& footer,
                                 DDS::OctetSeq& out, SecurityException& ex)
@@ -1237,20 +1314,20 @@ bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
       to_dds_string(master).c_str()));
   }
 
-  encauth_setup(master, sess, plain, header);
-  static const int IV_LEN = 12, IV_SUFFIX_IDX = 4;
-  unsigned char iv[IV_LEN];
-  std::memcpy(iv, &sess.id_, sizeof sess.id_);
-  std::memcpy(iv + IV_SUFFIX_IDX, &sess.iv_suffix_, sizeof sess.iv_suffix_);
+  SessionKey sess_key;
+  encauth_setup(master, sess_id, plain, header, sess_key);
 
   if (security_debug.fake_encryption) {
     out = plain;
     return true;
   }
 
-  CipherContext ctx;
-  const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  if (!sess_key.valid_) {
+    return CommonUtilities::set_security_error(ex, -1, 0, "no session key");
+  }
+
+  EVP_CIPHER_CTX* const ctx = thread_ciphers->encrypt_.init(sess_key.key_, sess_key.iv_);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "EVP_EncryptInit_ex");
   }
 
@@ -1277,21 +1354,22 @@ bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
   return true;
 }
 
-bool CryptoBuiltInImpl::authtag(const KeyMaterial& master, Session& sess,
+bool CryptoBuiltInImpl::authtag(const KeyMaterial& master,
+                                const KeyId_t& sess_id,
                                 const DDS::OctetSeq& plain,
                                 CryptoHeader& header,
                                 CryptoFooter& footer,
                                 SecurityException& ex)
 {
-  encauth_setup(master, sess, plain, header);
-  static const int IV_LEN = 12, IV_SUFFIX_IDX = 4;
-  unsigned char iv[IV_LEN];
-  std::memcpy(iv, &sess.id_, sizeof sess.id_);
-  std::memcpy(iv + IV_SUFFIX_IDX, &sess.iv_suffix_, sizeof sess.iv_suffix_);
-
-  CipherContext ctx;
-  const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  SessionKey sess_key;
+  encauth_setup(master, sess_id, plain, header, sess_key);
+
+  if (!sess_key.valid_) {
+    return CommonUtilities::set_security_error(ex, -1, 0, "no session key");
+  }
+
+  EVP_CIPHER_CTX* const ctx = thread_ciphers->encrypt_.init(sess_key.key_, sess_key.iv_);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "EVP_EncryptInit_ex");
   }
 
@@ -1407,7 +1485,7 @@ bool CryptoBuiltInImpl::encode_submessage(
   bool authOnly = false;
 
   if (encrypts(keyseq[submessage_key_index])) {
-    ok = encrypt(keyseq[submessage_key_index], sessions_[sKey], plain_rtps_submessage,
+    ok = encrypt(keyseq[submessage_key_index], sKey, plain_rtps_submessage,
                  header, footer, out, ex);
     pOut = &out;
 
@@ -1417,7 +1495,7 @@ bool CryptoBuiltInImpl::encode_submessage(
     if (setOctetsToNextHeader(out, plain_rtps_submessage)) {
       pOut = &out;
     }
-    ok = authtag(keyseq[submessage_key_index], sessions_[sKey], *pOut,
+    ok = authtag(keyseq[submessage_key_index], sKey, *pOut,
                  header, footer, ex);
     authOnly = true;
 
@@ -1501,7 +1579,7 @@ bool CryptoBuiltInImpl::encode_datawriter_submessage(
   }
 
   NativeCryptoHandle encode_handle = sending_datawriter_crypto;
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(encode_handle);
   if (eo_iter == encrypt_options_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 0, "Datawriter handle lacks encrypt options");
@@ -1549,7 +1627,7 @@ bool CryptoBuiltInImpl::encode_datareader_submessage(
   }
 
   NativeCryptoHandle encode_handle = sending_datareader_crypto;
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   if (receiving_datawriter_crypto_list.length() == 1) {
     const KeyTable_t::const_iterator iter = keys_.find(encode_handle);
     if (iter != keys_.end()) {
@@ -1580,7 +1658,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_participant_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 0, "No entry for sending_participant_crypto");
@@ -1609,7 +1687,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
   const KeyId_t sKey = std::make_pair(sending_participant_crypto, 0);
 
   if (encrypts(key)) {
-    ok = encrypt(key, sessions_[sKey], transformed, cryptoHdr, cryptoFooter, out, ex);
+    ok = encrypt(key, sKey, transformed, cryptoHdr, cryptoFooter, out, ex);
     pOut = &out;
     addSecBody = true;
 
@@ -1620,7 +1698,7 @@ bool CryptoBuiltInImpl::encode_rtps_message(
     if (offsetFinal && setOctetsToNextHeader(out, transformed, offsetFinal)) {
       pOut = &out;
     }
-    ok = authtag(key, sessions_[sKey], *pOut, cryptoHdr, cryptoFooter, ex);
+    ok = authtag(key, sKey, *pOut, cryptoHdr, cryptoFooter, ex);
 
   } else {
     return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
@@ -1710,7 +1788,7 @@ bool CryptoBuiltInImpl::preprocess_secure_submsg(
       "Could not deserializer CyptoHeader\n"));
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   typedef std::multimap<ParticipantCryptoHandle, EntityInfo>::iterator iter_t;
   const std::pair<iter_t, iter_t> iters =
     participant_to_entity_.equal_range(sending_participant_crypto);
@@ -1771,7 +1849,7 @@ bool CryptoBuiltInImpl::preprocess_secure_submsg(
   return false;
 }
 
-KeyOctetSeq
+const KeyOctetSeq&
 CryptoBuiltInImpl::Session::get_key(const KeyMaterial& master,
                                     const CryptoHeader& header)
 {
@@ -1823,7 +1901,25 @@ void CryptoBuiltInImpl::Session::derive_key(const KeyMaterial& master)
   }
 }
 
-bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
+void CryptoBuiltInImpl::decode_setup(const KeyMaterial& master,
+                                     const KeyId_t& sess_id,
+                                     const CryptoHeader& header,
+                                     SessionKey& sess_key)
+{
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(session_lock(sess_id));
+    Session& sess = session(sess_id);
+    sess.get_key(master, header);
+    sess.copy_key(sess_key);
+  }
+  std::memcpy(sess_key.iv_, &header.session_id, sizeof header.session_id);
+  std::memcpy(sess_key.iv_ + sizeof header.session_id,
+              &header.initialization_vector_suffix,
+              sizeof header.initialization_vector_suffix);
+}
+
+bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master,
+                                const KeyId_t& sess_id,
                                 const char* ciphertext, unsigned int n,
                                 const CryptoHeader& header,
                                 const CryptoFooter& footer, DDS::OctetSeq& out,
@@ -1836,8 +1932,9 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
       to_dds_string(master).c_str()));
   }
 
-  const KeyOctetSeq sess_key = sess.get_key(master, header);
-  if (!sess_key.length()) {
+  SessionKey sess_key;
+  decode_setup(master, sess_id, header, sess_key);
+  if (!sess_key.valid_) {
     return CommonUtilities::set_security_error(ex, -1, 0, "no session key");
   }
 
@@ -1855,10 +1952,8 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
     return true;
   }
 
-  CipherContext ctx;
-  // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  EVP_CIPHER_CTX* const ctx = thread_ciphers->decrypt_.init(sess_key.key_, sess_key.iv_);
+  if (!ctx) {
     ACE_ERROR((LM_ERROR, "(%P|%t) CryptoBuiltInImpl::decrypt - ERROR "
                "EVP_DecryptInit_ex %Ld\n", ERR_peek_last_error()));
     return CommonUtilities::set_security_error(ex, -1, 0, "EVP_DecryptInit_ex");
@@ -1892,15 +1987,17 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
   return CommonUtilities::set_security_error(ex, -1, 0, "EVP_DecryptFinal_ex");
 }
 
-bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
+bool CryptoBuiltInImpl::verify(const KeyMaterial& master,
+                               const KeyId_t& sess_id,
                                const char* in, unsigned int n,
                                const CryptoHeader& header,
                                const CryptoFooter& footer, DDS::OctetSeq& out,
                                SecurityException& ex)
 
 {
-  const KeyOctetSeq sess_key = sess.get_key(master, header);
-  if (!sess_key.length()) {
+  SessionKey sess_key;
+  decode_setup(master, sess_id, header, sess_key);
+  if (!sess_key.valid_) {
     return CommonUtilities::set_security_error(ex, -1, 0, "no session key");
   }
 
@@ -1912,10 +2009,8 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
     return CommonUtilities::set_security_error(ex, -1, 0, "unsupported transformation kind");
   }
 
-  CipherContext ctx;
-  // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  EVP_CIPHER_CTX* const ctx = thread_ciphers->decrypt_.init(sess_key.key_, sess_key.iv_);
+  if (!ctx) {
     ACE_ERROR((LM_ERROR, "(%P|%t) CryptoBuiltInImpl::verify - ERROR "
                "EVP_DecryptInit_ex %Ld\n", ERR_peek_last_error()));
     return CommonUtilities::set_security_error(ex, -1, 0, "EVP_DecryptInit_ex");
@@ -2032,7 +2127,7 @@ bool CryptoBuiltInImpl::decode_rtps_message(
     return CommonUtilities::set_security_error(ex, -9, 0, "Failed to find SRTPS_PREFIX/POSTFIX wrapper");
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_participant_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 2, "No key for Sending Participant handle");
@@ -2049,14 +2144,14 @@ bool CryptoBuiltInImpl::decode_rtps_message(
           return CommonUtilities::set_security_error(ex, -15, 0, "Failed to find SEC_BODY submessage");
         }
         foundKey = true;
-        if (!decrypt(keyseq[i], sessions_[sKey], encrypted, sizeOfEncrypted,
+        if (!decrypt(keyseq[i], sKey, encrypted, sizeOfEncrypted,
                      ch, cf, transformed, ex)) {
           return false;
         }
 
       } else if (authenticates(keyseq[i])) {
         foundKey = true;
-        if (!verify(keyseq[i], sessions_[sKey], afterSrtpsPrefix, sizeOfAuthenticated,
+        if (!verify(keyseq[i], sKey, afterSrtpsPrefix, sizeOfAuthenticated,
                     ch, cf, transformed, ex)) {
           return false;
         }
@@ -2151,7 +2246,7 @@ bool CryptoBuiltInImpl::decode_submessage(
     return false;
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator keys_iter = keys_.find(sender_handle);
   if (keys_iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -2, 3, "Crypto Key not found");
@@ -2171,11 +2266,11 @@ bool CryptoBuiltInImpl::decode_submessage(
             "Failed to deserialize content size(?)\n"));
           return false;
         }
-        return decrypt(keyseq[i], sessions_[sKey], mb_in.rd_ptr(), n, ch, cf,
+        return decrypt(keyseq[i], sKey, mb_in.rd_ptr(), n, ch, cf,
                        plain_rtps_submessage, ex);
 
       } else if (authenticates(keyseq[i])) {
-        return verify(keyseq[i], sessions_[sKey], mb_in.rd_ptr() - RTPS::SMHDR_SZ,
+        return verify(keyseq[i], sKey, mb_in.rd_ptr() - RTPS::SMHDR_SZ,
                       RTPS::SMHDR_SZ + octetsToNext, ch, cf, plain_rtps_submessage, ex);
 
       } else {
@@ -2260,7 +2355,7 @@ bool CryptoBuiltInImpl::decode_serialized_payload(
       sending_datawriter_crypto, receiving_datareader_crypto));
   }
 
-  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ACE_Read_Guard<ACE_RW_Thread_Mutex> guard(mutex_);
   const KeyTable_t::const_iterator iter = keys_.find(sending_datawriter_crypto);
   if (iter == keys_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 1, "No key for DataWriter crypto handle");
@@ -2305,7 +2400,7 @@ bool CryptoBuiltInImpl::decode_serialized_payload(
         if (!(de_ser >> cf)) {
           return CommonUtilities::set_security_error(ex, -3, 6, "Failed to deserialize CryptoFooter");
         }
-        return decrypt(keyseq[i], sessions_[sKey], ciphertext, n, ch, cf, plain_buffer, ex);
+        return decrypt(keyseq[i], sKey, ciphertext, n, ch, cf, plain_buffer, ex);
 
       } else if (authenticates(keyseq[i])) {
         return CommonUtilities::set_security_error(ex, -3, 3, "Auth-only payload "
@@ -14,6 +14,7 @@
 
 #include <tao/LocalObject.h>
 
+#include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
 
 #include <map>
@@ -245,7 +246,10 @@ private:
   DDS::Security::NativeCryptoHandle generate_handle();
   DDS::Security::NativeCryptoHandle generate_handle_i();
 
-  ACE_Thread_Mutex mutex_;
+  /// Protects the handle tables below.  Registration, unregistration and
+  /// setting remote tokens take it for writing; the encode/decode paths
+  /// only read the tables and may run concurrently.
+  ACE_RW_Thread_Mutex mutex_;
   int next_handle_;
 
   typedef KeyMaterial_AES_GCM_GMAC KeyMaterial;
@@ -281,22 +285,45 @@ private:
   typedef std::map<HandlePair_t, DDS::Security::NativeCryptoHandle> DerivedKeyIndex_t;
   DerivedKeyIndex_t derived_key_handles_;
 
+  /// Copy of a session's key and IV used by a single encrypt or decrypt
+  struct SessionKey {
+    unsigned char key_[32];
+    unsigned char iv_[12];
+    bool valid_;
+  };
+
   struct Session {
     SessionIdType id_;
     IV_SuffixType iv_suffix_;
     KeyOctetSeq key_;
     ACE_UINT64 counter_;
 
-    KeyOctetSeq get_key(const KeyMaterial& master, const CryptoHeader& header);
+    const KeyOctetSeq& get_key(const KeyMaterial& master, const CryptoHeader& header);
     void create_key(const KeyMaterial& master);
     void derive_key(const KeyMaterial& master);
     void next_id(const KeyMaterial& master);
     void inc_iv();
+    void copy_key(SessionKey& sess_key) const;
   };
   typedef std::pair<DDS::Security::NativeCryptoHandle, unsigned int> KeyId_t;
   typedef std::map<KeyId_t, Session> SessionTable_t;
   SessionTable_t sessions_;
 
+  /// Readers of mutex_ create sessions on first use, session_mutex_
+  /// serializes those inserts.  Writers of mutex_ may erase sessions
+  /// without it.
+  ACE_Thread_Mutex session_mutex_;
+
+  /// The state of each Session is protected by one of these, chosen by
+  /// hashing its KeyId_t, so that operations on different sessions don't
+  /// contend.  Only the session state update is done under the lock, the
+  /// cipher itself runs on a copy of the key and IV.
+  static const size_t SESSION_LOCK_COUNT = 32;
+  ACE_Thread_Mutex session_locks_[SESSION_LOCK_COUNT];
+
+  Session& session(const KeyId_t& id);
+  ACE_Thread_Mutex& session_lock(const KeyId_t& id);
+
   void clear_endpoint_data(DDS::Security::NativeCryptoHandle handle);
   void clear_common_data(DDS::Security::NativeCryptoHandle handle);
 
@@ -305,31 +332,35 @@ private:
                          DDS::Security::NativeCryptoHandle sender_handle,
                          DDS::Security::SecurityException& ex);
 
-  bool encrypt(const KeyMaterial& master, Session& sess,
+  bool encrypt(const KeyMaterial& master, const KeyId_t& sess_id,
                const DDS::OctetSeq& plain,
                CryptoHeader& header, CryptoFooter& footer,
                DDS::OctetSeq& out, DDS::Security::SecurityException& ex);
 
-  bool authtag(const KeyMaterial& master, Session& sess,
+  bool authtag(const KeyMaterial& master, const KeyId_t& sess_id,
                const DDS::OctetSeq& plain,
                CryptoHeader& header, CryptoFooter& footer,
                DDS::Security::SecurityException& ex);
 
-  void encauth_setup(const KeyMaterial& master, Session& sess,
-                     const DDS::OctetSeq& plain, CryptoHeader& header);
+  void encauth_setup(const KeyMaterial& master, const KeyId_t& sess_id,
+                     const DDS::OctetSeq& plain, CryptoHeader& header,
+                     SessionKey& sess_key);
+
+  void decode_setup(const KeyMaterial& master, const KeyId_t& sess_id,
+                    const CryptoHeader& header, SessionKey& sess_key);
 
   bool decode_submessage(DDS::OctetSeq& plain_rtps_submessage,
                          const DDS::OctetSeq& encoded_rtps_submessage,
                          DDS::Security::NativeCryptoHandle sender_handle,
                          DDS::Security::SecurityException& ex);
 
-  bool decrypt(const KeyMaterial& master, Session& sess, const char* ciphertext,
-               unsigned int n, const CryptoHeader& header,
+  bool decrypt(const KeyMaterial& master, const KeyId_t& sess_id,
+               const char* ciphertext, unsigned int n, const CryptoHeader& header,
                const CryptoFooter& footer, DDS::OctetSeq& out,
                DDS::Security::SecurityException& ex);
 
-  bool verify(const KeyMaterial& master, Session& sess, const char* in,
-              unsigned int n, const CryptoHeader& header,
+  bool verify(const KeyMaterial& master, const KeyId_t& sess_id,
+              const char* in, unsigned int n, const CryptoHeader& header,
               const CryptoFooter& footer, DDS::OctetSeq& out,
               DDS::Security::SecurityException& ex);
 };
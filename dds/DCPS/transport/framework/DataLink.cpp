@@ -736,15 +736,52 @@ DataLink::data_received_i(ReceivedDataSample& sample,
 
   ReceiveListenerSet_rch listener_set;
   TransportReceiveListener_rch listener;
-  {
-    GuardType guard(this->pub_sub_maps_lock_);
-    AssocByRemote::iterator iter = assoc_by_remote_.find(publication_id);
-    if (iter != assoc_by_remote_.end()) {
-      listener_set = iter->second;
-    } else {
-      listener = this->default_listener_.lock();
-    }
+  find_listeners(publication_id, listener_set, listener);
+  deliver_i(sample, readerId, incl_excl, constrain, listener_set, listener);
+}
+
+void
+DataLink::data_received_batch(OPENDDS_VECTOR(ReceivedDataSample)& samples,
+                              const GUID_t& readerId)
+{
+  DBG_ENTRY_LVL("DataLink", "data_received_batch", 6);
+  if (samples.empty()) {
+    return;
+  }
+
+  ReceiveListenerSet_rch listener_set;
+  TransportReceiveListener_rch listener;
+  find_listeners(samples[0].header_.publication_id_, listener_set, listener);
+
+  const RepoIdSet none;
+  for (OPENDDS_VECTOR(ReceivedDataSample)::iterator it = samples.begin(); it != samples.end(); ++it) {
+    deliver_i(*it, readerId, none, ReceiveListenerSet::SET_EXCLUDED, listener_set, listener);
   }
+}
+
+void
+DataLink::find_listeners(const GUID_t& publication_id,
+                         ReceiveListenerSet_rch& listener_set,
+                         TransportReceiveListener_rch& listener)
+{
+  GuardType guard(this->pub_sub_maps_lock_);
+  AssocByRemote::iterator iter = assoc_by_remote_.find(publication_id);
+  if (iter != assoc_by_remote_.end()) {
+    listener_set = iter->second;
+  } else {
+    listener = this->default_listener_.lock();
+  }
+}
+
+void
+DataLink::deliver_i(ReceivedDataSample& sample,
+                    const GUID_t& readerId,
+                    const RepoIdSet& incl_excl,
+                    ReceiveListenerSet::ConstrainReceiveSet constrain,
+                    const ReceiveListenerSet_rch& listener_set,
+                    const TransportReceiveListener_rch& listener)
+{
+  const GUID_t& publication_id = sample.header_.publication_id_;
 
   if (listener_set.is_nil()) {
     if (listener) {
@@ -174,6 +174,13 @@ public:
   /// Any reader ID that does not appear in the include set will be skipped.
   void data_received_include(ReceivedDataSample& sample, const RepoIdSet& incl);
 
+  /// Variation of data_received() for consecutive samples from one
+  /// publication that are all for readerId (or all readers when it is
+  /// GUID_UNKNOWN).  The publication's listeners are looked up once for
+  /// all of them.
+  void data_received_batch(OPENDDS_VECTOR(ReceivedDataSample)& samples,
+                           const GUID_t& readerId = GUID_UNKNOWN);
+
   /// Obtain a unique identifier for this DataLink object.
   DataLinkIdType id() const;
 
@@ -372,6 +379,19 @@ private:
                        const RepoIdSet& incl_excl,
                        ReceiveListenerSet::ConstrainReceiveSet constrain);
 
+  /// The listeners for the samples from publication_id: listener_set if
+  /// it is associated, otherwise the default listener, if any.
+  void find_listeners(const GUID_t& publication_id,
+                      ReceiveListenerSet_rch& listener_set,
+                      TransportReceiveListener_rch& listener);
+
+  void deliver_i(ReceivedDataSample& sample,
+                 const GUID_t& readerId,
+                 const RepoIdSet& incl_excl,
+                 ReceiveListenerSet::ConstrainReceiveSet constrain,
+                 const ReceiveListenerSet_rch& listener_set,
+                 const TransportReceiveListener_rch& listener);
+
   void notify_reactor();
 
   typedef ACE_SYNCH_MUTEX     LockType;
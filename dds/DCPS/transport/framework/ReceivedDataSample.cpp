@@ -104,6 +104,22 @@ DDS::OctetSeq ReceivedDataSample::copy_data() const
   return dst;
 }
 
+void ReceivedDataSample::detach_data()
+{
+  if (blocks_.empty()) {
+    return;
+  }
+  MessageBlock copy(data_length());
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    const MessageBlock& element = blocks_[i];
+    const size_t len = element.len();
+    std::memcpy(copy.wr_ptr(), element.rd_ptr(), len);
+    copy.write(len);
+  }
+  blocks_.clear();
+  blocks_.push_back(copy);
+}
+
 unsigned char ReceivedDataSample::peek(size_t offset) const
 {
   size_t remain = offset;
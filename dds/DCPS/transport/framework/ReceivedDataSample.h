@@ -61,6 +61,10 @@ public:
   /// copy the data payload into an OctetSeq
   DDS::OctetSeq copy_data() const;
 
+  /// Replace the data payload with a copy of it in one new Data Block, so
+  /// the sample no longer keeps the blocks it was received in referenced.
+  void detach_data();
+
   /// @brief Retreive one byte of data from the payload
   /// @param offset must be in the range [0, data_length())
   unsigned char peek(size_t offset) const;
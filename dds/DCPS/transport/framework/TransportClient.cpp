@@ -880,6 +880,20 @@ TransportClient::get_ice_endpoint()
   return WeakRcHandle<ICE::Endpoint>();
 }
 
+ACE_Message_Block*
+TransportClient::loan_buffer(size_t size, ACE_Lock* locking_strategy)
+{
+  // With more than one impl the sample could go out on either of them, so
+  // a buffer that only one of them can send without copying doesn't help.
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, lock_, 0);
+  if (impls_.size() != 1) {
+    return 0;
+  }
+
+  TransportImpl_rch impl = impls_[0].lock();
+  return impl ? impl->loan_buffer(size, locking_strategy) : 0;
+}
+
 bool
 TransportClient::send_response(const GUID_t& peer,
                                const DataSampleHeader& header,
@@ -105,6 +105,9 @@ public:
 
   WeakRcHandle<ICE::Endpoint> get_ice_endpoint();
 
+  /// Buffer from TransportImpl::loan_buffer, only when there's a single impl.
+  ACE_Message_Block* loan_buffer(size_t size, ACE_Lock* locking_strategy);
+
   // Data transfer:
 
   bool send_response(const GUID_t& peer,
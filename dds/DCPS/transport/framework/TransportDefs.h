@@ -27,6 +27,7 @@
 ACE_BEGIN_VERSIONED_NAMESPACE_DECL
 class ACE_Message_Block;
 class ACE_Data_Block;
+class ACE_Lock;
 ACE_END_VERSIONED_NAMESPACE_DECL
 
 /**
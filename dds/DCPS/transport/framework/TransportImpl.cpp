@@ -18,6 +18,7 @@
 #include "dds/DCPS/MonitorFactory.h"
 #include "dds/DCPS/Service_Participant.h"
 #include "dds/DCPS/ServiceEventDispatcher.h"
+#include "dds/DCPS/TimingWheelEventDispatcher.h"
 #include "tao/debug.h"
 #include "dds/DCPS/SafetyProfileStreams.h"
 
@@ -32,7 +33,8 @@ namespace DCPS {
 
 TransportImpl::TransportImpl(TransportInst_rch config)
   : config_(config)
-  , event_dispatcher_(make_rch<ServiceEventDispatcher>(1))
+  , event_dispatcher_(make_rch<TimingWheelEventDispatcher>(make_rch<ServiceEventDispatcher>(1),
+                                                           TheServiceParticipant->timer_wheel_tick()))
   , is_shut_down_(false)
 {
   DBG_ENTRY_LVL("TransportImpl", "TransportImpl", 6);
@@ -113,6 +113,10 @@ public:
   virtual void rtps_relay_address_change() {}
   virtual void append_transport_statistics(TransportStatisticsSequence& /*seq*/) {}
 
+  /// Allocate a buffer of at least size bytes that the transport can send
+  /// without copying its contents.  Returns null if not supported.
+  virtual ACE_Message_Block* loan_buffer(size_t /*size*/, ACE_Lock* /*locking_strategy*/) { return 0; }
+
   /// Interface to the transport's reactor for scheduling timers.
   ACE_Reactor_Timer_Interface* timer() const;
 
@@ -50,6 +50,24 @@ TransportSendBuffer::resend_one(const BufferType& buffer)
 
 const size_t SingleSendBuffer::UNLIMITED = 0;
 
+namespace {
+  // Ring size used when the capacity is unlimited
+  const size_t UNLIMITED_SLOTS = 256;
+  // Largest ring, samples beyond it are kept in a map
+  const size_t MAX_SLOTS = 4096;
+
+  size_t ring_slots(size_t capacity)
+  {
+    const size_t wanted = capacity == SingleSendBuffer::UNLIMITED ? UNLIMITED_SLOTS
+      : std::min(capacity, MAX_SLOTS);
+    size_t size = 1;
+    while (size < wanted) {
+      size *= 2;
+    }
+    return size;
+  }
+}
+
 SingleSendBuffer::SingleSendBuffer(size_t capacity,
                                    size_t max_samples_per_packet)
   : TransportSendBuffer(capacity),
@@ -57,7 +75,11 @@ SingleSendBuffer::SingleSendBuffer(size_t capacity,
     retained_mb_allocator_(n_chunks_ * 2),
     retained_db_allocator_(n_chunks_ * 2),
     replaced_mb_allocator_(n_chunks_ * 2),
-    replaced_db_allocator_(n_chunks_ * 2)
+    replaced_db_allocator_(n_chunks_ * 2),
+    slots_(ring_slots(capacity)),
+    ring_end_(0),
+    ring_count_(0),
+    count_(0)
 {
 }
 
@@ -70,18 +92,16 @@ void
 SingleSendBuffer::release_all()
 {
   ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
-  for (BufferMap::iterator it = buffers_.begin();
-       it != buffers_.end();) {
-    release_i(it++);
+  while (count_) {
+    release_i(low_);
   }
 }
 
 void
 SingleSendBuffer::release_acked(SequenceNumber seq) {
   ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
-  BufferMap::iterator buffer_iter = buffers_.find(seq);
-  if (buffer_iter != buffers_.end()) {
-    release_i(buffer_iter);
+  if (find_i(seq)) {
+    release_i(seq);
   }
   minimum_sn_allowed_ = std::max(minimum_sn_allowed_, seq + 1);
 }
@@ -89,17 +109,163 @@ SingleSendBuffer::release_acked(SequenceNumber seq) {
 void
 SingleSendBuffer::remove_acked(SequenceNumber seq, BufferVec& removed) {
   ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
-  BufferMap::iterator buffer_iter = buffers_.find(seq);
-  if (buffer_iter != buffers_.end()) {
-    remove_i(buffer_iter, removed);
+  if (find_i(seq)) {
+    remove_i(seq, removed);
   }
   minimum_sn_allowed_ = std::max(minimum_sn_allowed_, seq + 1);
 }
 
+bool
+SingleSendBuffer::next_i(const SequenceNumber& seq, SequenceNumber& next) const
+{
+  if (in_ring(seq)) {
+    if (seq == ring_high_) {
+      return false;
+    }
+    next = slots_[index(seq)].next;
+    return true;
+  }
+  SlotMap::const_iterator it = older_.find(seq);
+  if (it != older_.end() && ++it != older_.end()) {
+    next = it->first;
+    return true;
+  }
+  if (ring_count_) {
+    next = ring_low_;
+    return true;
+  }
+  return false;
+}
+
+SingleSendBuffer::Slot&
+SingleSendBuffer::emplace_i(const SequenceNumber& seq)
+{
+  if (seq.getValue() >= ring_end_) {
+    advance_ring_i(seq.getValue() + 1);
+  }
+
+  if (!in_ring(seq)) {
+    Slot& slot = older_[seq];
+    if (!slot.used) {
+      slot.used = true;
+      ++count_;
+      update_bounds_i();
+    }
+    return slot;
+  }
+
+  Slot& slot = slots_[index(seq)];
+  if (!slot.used) {
+    link_i(seq, slot);
+    ++count_;
+    update_bounds_i();
+  }
+  return slot;
+}
+
+void
+SingleSendBuffer::erase_i(const SequenceNumber& seq)
+{
+  if (in_ring(seq)) {
+    Slot& slot = slots_[index(seq)];
+    unlink_i(seq, slot);
+    slot = Slot();
+  } else {
+    older_.erase(seq);
+  }
+  --count_;
+  update_bounds_i();
+}
+
+void
+SingleSendBuffer::advance_ring_i(SequenceNumber::Value end)
+{
+  // Samples that are still buffered move to older_, which keeps older_
+  // below the ring.
+  const SequenceNumber::Value begin = end - static_cast<SequenceNumber::Value>(slots_.size());
+  while (ring_count_ && ring_low_.getValue() < begin) {
+    const SequenceNumber seq = ring_low_;
+    Slot& slot = slots_[index(seq)];
+    older_[seq] = slot;
+    unlink_i(seq, slot);
+    slot = Slot();
+  }
+  ring_end_ = end;
+}
+
+void
+SingleSendBuffer::link_i(const SequenceNumber& seq, Slot& slot)
+{
+  slot.used = true;
+  if (ring_count_++ == 0) {
+    ring_low_ = ring_high_ = seq;
+  } else if (ring_high_ < seq) {
+    slot.prev = ring_high_;
+    slots_[index(ring_high_)].next = seq;
+    ring_high_ = seq;
+  } else if (seq < ring_low_) {
+    slot.next = ring_low_;
+    slots_[index(ring_low_)].prev = seq;
+    ring_low_ = seq;
+  } else {
+    // Only when sequence numbers are inserted out of order, bounded by the
+    // size of the ring.
+    SequenceNumber prev = seq.previous();
+    while (!slots_[index(prev)].used) {
+      prev = prev.previous();
+    }
+    Slot& prev_slot = slots_[index(prev)];
+    slot.prev = prev;
+    slot.next = prev_slot.next;
+    slots_[index(prev_slot.next)].prev = seq;
+    prev_slot.next = seq;
+  }
+}
+
+void
+SingleSendBuffer::unlink_i(const SequenceNumber& seq, Slot& slot)
+{
+  if (--ring_count_ == 0) {
+    return;
+  }
+  if (seq == ring_low_) {
+    ring_low_ = slot.next;
+  } else {
+    slots_[index(slot.prev)].next = slot.next;
+  }
+  if (seq == ring_high_) {
+    ring_high_ = slot.prev;
+  } else {
+    slots_[index(slot.next)].prev = slot.prev;
+  }
+}
+
+void
+SingleSendBuffer::update_bounds_i()
+{
+  if (count_ == 0) {
+    return;
+  }
+  low_ = older_.empty() ? ring_low_ : older_.begin()->first;
+  high_ = ring_count_ ? ring_high_ : older_.rbegin()->first;
+}
+
 void
-SingleSendBuffer::release_i(BufferMap::iterator buffer_iter)
+SingleSendBuffer::release_buffer(BufferType& buffer)
 {
-  BufferType& buffer(buffer_iter->second);
+  RemoveAllVisitor visitor;
+  buffer.first->accept_remove_visitor(visitor);
+  delete buffer.first;
+  buffer.first = 0;
+
+  Message_Block_Ptr to_release(buffer.second);
+  buffer.second = 0;
+}
+
+void
+SingleSendBuffer::release_i(const SequenceNumber& seq)
+{
+  BufferType& buffer(find_i(seq)->buffer);
   if (Transport_debug_level > 5) {
     ACE_DEBUG((LM_DEBUG,
       ACE_TEXT("(%P|%t) SingleSendBuffer::release() - ")
@@ -110,38 +276,27 @@ SingleSendBuffer::release_i(BufferMap::iterator buffer_iter)
 
   if (buffer.first && buffer.second) {
     // not a fragment
-    RemoveAllVisitor visitor;
-    buffer.first->accept_remove_visitor(visitor);
-    delete buffer.first;
-
-    Message_Block_Ptr to_release(buffer.second);
-    buffer.second = 0;
+    release_buffer(buffer);
 
   } else {
     // data actually stored in fragments_
-    const FragmentMap::iterator fm_it = fragments_.find(buffer_iter->first);
+    const FragmentMap::iterator fm_it = fragments_.find(seq);
     if (fm_it != fragments_.end()) {
       for (BufferMap::iterator bm_it = fm_it->second.begin();
            bm_it != fm_it->second.end(); ++bm_it) {
-        RemoveAllVisitor visitor;
-        bm_it->second.first->accept_remove_visitor(visitor);
-        delete bm_it->second.first;
-
-        Message_Block_Ptr to_release(bm_it->second.second);
-        bm_it->second.second = 0;
+        release_buffer(bm_it->second);
       }
       fragments_.erase(fm_it);
     }
   }
 
-  destinations_.erase(buffer_iter->first);
-  buffers_.erase(buffer_iter);
+  erase_i(seq);
 }
 
 void
-SingleSendBuffer::remove_i(BufferMap::iterator buffer_iter, BufferVec& removed)
+SingleSendBuffer::remove_i(const SequenceNumber& seq, BufferVec& removed)
 {
-  BufferType& buffer(buffer_iter->second);
+  BufferType& buffer(find_i(seq)->buffer);
   if (Transport_debug_level > 5) {
     ACE_DEBUG((LM_DEBUG,
       ACE_TEXT("(%P|%t) SingleSendBuffer::release() - ")
@@ -155,7 +310,7 @@ SingleSendBuffer::remove_i(BufferMap::iterator buffer_iter, BufferVec& removed)
     removed.push_back(buffer);
   } else {
     // data actually stored in fragments_
-    const FragmentMap::iterator fm_it = fragments_.find(buffer_iter->first);
+    const FragmentMap::iterator fm_it = fragments_.find(seq);
     if (fm_it != fragments_.end()) {
       for (BufferMap::iterator bm_it = fm_it->second.begin();
            bm_it != fm_it->second.end(); ++bm_it) {
@@ -165,8 +320,7 @@ SingleSendBuffer::remove_i(BufferMap::iterator buffer_iter, BufferVec& removed)
     }
   }
 
-  destinations_.erase(buffer_iter->first);
-  buffers_.erase(buffer_iter);
+  erase_i(seq);
 }
 
 void
@@ -181,23 +335,24 @@ SingleSendBuffer::retain_all(const GUID_t& pub_id)
     ));
   }
   ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
-  for (BufferMap::iterator it(buffers_.begin());
-       it != buffers_.end();) {
-    if (it->second.first && it->second.second) {
-      if (retain_buffer(pub_id, it->second) == REMOVE_ERROR) {
+  SequenceNumber next = low_;
+  for (bool more = count_ != 0; more;) {
+    const SequenceNumber seq = next;
+    more = next_i(seq, next);
+    Slot* const slot = find_i(seq);
+    if (slot->buffer.first && slot->buffer.second) {
+      if (retain_buffer(pub_id, slot->buffer) == REMOVE_ERROR) {
         LogGuid logger(pub_id);
         ACE_ERROR((LM_WARNING,
                    ACE_TEXT("(%P|%t) WARNING: ")
                    ACE_TEXT("SingleSendBuffer::retain_all: ")
                    ACE_TEXT("failed to retain data from publication: %C!\n"),
                    logger.c_str()));
-        release_i(it++);
-      } else {
-        ++it;
+        release_i(seq);
       }
 
     } else {
-      const FragmentMap::iterator fm_it = fragments_.find(it->first);
+      const FragmentMap::iterator fm_it = fragments_.find(seq);
       if (fm_it != fragments_.end()) {
         for (BufferMap::iterator bm_it = fm_it->second.begin();
              bm_it != fm_it->second.end();) {
@@ -208,13 +363,13 @@ SingleSendBuffer::retain_all(const GUID_t& pub_id)
                        ACE_TEXT("SingleSendBuffer::retain_all: failed to ")
                        ACE_TEXT("retain fragment data from publication: %C!\n"),
                        logger.c_str()));
-            release_i(bm_it++);
+            release_buffer(bm_it->second);
+            fm_it->second.erase(bm_it++);
           } else {
             ++bm_it;
           }
         }
       }
-      ++it;
     }
   }
 }
@@ -253,7 +408,8 @@ SingleSendBuffer::insert(SequenceNumber sequence,
   }
   check_capacity_i(removed);
 
-  BufferType& buffer = buffers_[sequence];
+  Slot& slot = emplace_i(sequence);
+  BufferType& buffer = slot.buffer;
   pre_seq_.erase(sequence);
   insert_buffer(buffer, queue, chain);
 
@@ -272,15 +428,12 @@ SingleSendBuffer::insert(SequenceNumber sequence,
     const ACE_Message_Block* msg = elt->msg();
     if (msg && subId != GUID_UNKNOWN &&
         !DataSampleHeader::test_flag(HISTORIC_SAMPLE_FLAG, msg)) {
-      destinations_[sequence] = subId;
+      slot.destination = subId;
     }
   }
   g.release();
   for (size_t i = 0; i < removed.size(); ++i) {
-    RemoveAllVisitor visitor;
-    removed[i].first->accept_remove_visitor(visitor);
-    delete removed[i].first;
-    Message_Block_Ptr to_release(removed[i].second);
+    release_buffer(removed[i]);
   }
 }
 
@@ -316,11 +469,11 @@ SingleSendBuffer::insert_fragment(SequenceNumber sequence,
   }
   check_capacity_i(removed);
 
-  // Insert into buffers_ so that the overall capacity is maintained
-  // The entry in buffers_ with two null pointers indicates that the
+  // Use a slot so that the overall capacity is maintained
+  // The slot with two null pointers indicates that the
   // actual data is stored in fragments_[sequence].
-  buffers_[sequence] = std::make_pair(static_cast<QueueType*>(0),
-                                      static_cast<ACE_Message_Block*>(0));
+  emplace_i(sequence).buffer = std::make_pair(static_cast<QueueType*>(0),
+                                              static_cast<ACE_Message_Block*>(0));
 
   BufferType& buffer = fragments_[sequence][fragment];
   if (is_last_fragment) {
@@ -338,10 +491,7 @@ SingleSendBuffer::insert_fragment(SequenceNumber sequence,
   }
   g.release();
   for (size_t i = 0; i < removed.size(); ++i) {
-    RemoveAllVisitor visitor;
-    removed[i].first->accept_remove_visitor(visitor);
-    delete removed[i].first;
-    Message_Block_Ptr to_release(removed[i].second);
+    release_buffer(removed[i]);
   }
 }
 
@@ -352,20 +502,18 @@ SingleSendBuffer::check_capacity_i(BufferVec& removed)
     return;
   }
   // Age off oldest sample if we are at capacity:
-  if (buffers_.size() == capacity_) {
-    BufferMap::iterator it(buffers_.begin());
-    if (it == buffers_.end()) return;
-
+  if (count_ == capacity_) {
     if (Transport_debug_level > 5) {
+      const BufferType& buffer = find_i(low_)->buffer;
       ACE_DEBUG((LM_DEBUG,
         ACE_TEXT("(%P|%t) SingleSendBuffer::check_capacity() - ")
         ACE_TEXT("aging off PDU: %q as buffer(0x%@,0x%@)\n"),
-        it->first.getValue(),
-        it->second.first, it->second.second
+        low_.getValue(),
+        buffer.first, buffer.second
       ));
     }
 
-    remove_i(it, removed);
+    remove_i(low_, removed);
   }
 }
 
@@ -394,37 +542,49 @@ SingleSendBuffer::resend_i(const SequenceRange& range, DisjointSequence* gaps,
                            const GUID_t& destination)
 {
   //Special case, nak to make sure it has all history
-  if (buffers_.empty()) throw std::exception();
-  const SequenceNumber lowForAllResent = range.first == SequenceNumber() ? buffers_.begin()->first : range.first;
+  if (count_ == 0) throw std::exception();
+  const SequenceNumber lowForAllResent = range.first == SequenceNumber() ? low_ : range.first;
   const bool has_dest = destination != GUID_UNKNOWN;
 
-  for (SequenceNumber sequence(range.first);
-       sequence <= range.second; ++sequence) {
+  if (range.second < range.first) {
+    return lowForAllResent >= low_ && range.second <= high_;
+  }
+
+  // Only the part of the range that overlaps the buffer is looked up,
+  // the rest is scored against the given DisjointSequence all at once.
+  const SequenceNumber first = std::max(range.first, low_);
+  const SequenceNumber last = std::min(range.second, high_);
+  if (gaps) {
+    if (range.first < low_) {
+      gaps->insert(SequenceRange(range.first, std::min(range.second, low_.previous())));
+    }
+    if (high_ < range.second) {
+      gaps->insert(SequenceRange(std::max(range.first, high_ + 1), range.second));
+    }
+  }
+
+  for (SequenceNumber sequence(first); sequence <= last; ++sequence) {
     // Re-send requested sample if still buffered; missing samples
     // will be scored against the given DisjointSequence:
-    BufferMap::iterator it(buffers_.find(sequence));
-    DestinationMap::iterator dest_data;
-    if (has_dest) {
-      dest_data = destinations_.find(sequence);
-    }
-    if (it == buffers_.end() || (has_dest && (dest_data == destinations_.end() ||
-                                              dest_data->second != destination))) {
+    const Slot* const slot = find_i(sequence);
+    if (!slot || (has_dest && slot->destination != destination)) {
       if (gaps) {
         gaps->insert(sequence);
       }
     } else {
+      const BufferType& buffer = slot->buffer;
       if (Transport_debug_level > 5) {
         ACE_DEBUG((LM_DEBUG,
                    ACE_TEXT("(%P|%t) SingleSendBuffer::resend() - ")
                    ACE_TEXT("resending PDU: %q, (0x%@,0x%@)\n"),
                    sequence.getValue(),
-                   it->second.first,
-                   it->second.second));
+                   buffer.first,
+                   buffer.second));
       }
-      if (it->second.first && it->second.second) {
-        resend_one(it->second);
+      if (buffer.first && buffer.second) {
+        resend_one(buffer);
       } else {
-        const FragmentMap::iterator fm_it = fragments_.find(it->first);
+        const FragmentMap::iterator fm_it = fragments_.find(sequence);
         if (fm_it != fragments_.end()) {
           for (BufferMap::iterator bm_it = fm_it->second.begin();
                 bm_it != fm_it->second.end(); ++bm_it) {
@@ -435,7 +595,7 @@ SingleSendBuffer::resend_i(const SequenceRange& range, DisjointSequence* gaps,
     }
   }
   // Have we resent all requested data?
-  return lowForAllResent >= buffers_.begin()->first && range.second <= buffers_.rbegin()->first;
+  return lowForAllResent >= low_ && range.second <= high_;
 }
 
 void
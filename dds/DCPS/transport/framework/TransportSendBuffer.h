@@ -69,6 +69,11 @@ private:
 /// Implementation of TransportSendBuffer that manages data for a single
 /// domain of SequenceNumbers -- for a given SingleSendBuffer object, the
 /// sequence numbers passed to insert() must be generated from the same place.
+///
+/// The most recent samples are kept in a ring of slots indexed by sequence
+/// number, so finding the sample for a NACKed sequence number doesn't search
+/// a tree.  The ring is sized for the capacity and doesn't grow.  Samples
+/// that are still buffered when they fall behind the ring are moved to a map.
 class OpenDDS_Dcps_Export SingleSendBuffer
   : public TransportSendBuffer, public virtual RcObject {
 public:
@@ -114,31 +119,31 @@ public:
 
     SequenceNumber low() const
     {
-      if (ssb_.buffers_.empty()) throw std::exception();
-      return ssb_.buffers_.begin()->first;
+      if (ssb_.count_ == 0) throw std::exception();
+      return ssb_.low_;
     }
 
     SequenceNumber high() const
     {
-      if (ssb_.buffers_.empty()) throw std::exception();
-      return ssb_.buffers_.rbegin()->first;
+      if (ssb_.count_ == 0) throw std::exception();
+      return ssb_.high_;
     }
 
     bool empty() const
     {
-      return ssb_.buffers_.empty();
+      return ssb_.count_ == 0;
     }
 
     bool contains(SequenceNumber seq) const
     {
-      return ssb_.buffers_.count(seq);
+      return ssb_.find_i(seq);
     }
 
     bool contains(SequenceNumber seq, GUID_t& destination) const
     {
-      if (ssb_.buffers_.count(seq)) {
-        DestinationMap::const_iterator pos = ssb_.destinations_.find(seq);
-        destination = pos == ssb_.destinations_.end() ? GUID_UNKNOWN : pos->second;
+      const Slot* const slot = ssb_.find_i(seq);
+      if (slot) {
+        destination = slot->destination;
         return true;
       }
       return false;
@@ -204,9 +209,67 @@ public:
   bool has_frags(const SequenceNumber& seq) const;
 
 private:
+  struct Slot {
+    Slot()
+      : buffer(static_cast<QueueType*>(0), static_cast<ACE_Message_Block*>(0))
+      , destination(GUID_UNKNOWN)
+      , used(false)
+    {}
+
+    /// Both null if the data is in fragments_
+    BufferType buffer;
+    /// GUID_UNKNOWN unless the sample was sent to a single reader
+    GUID_t destination;
+    bool used;
+    /// Neighboring used slots of the ring, valid between ring_low_ and
+    /// ring_high_
+    SequenceNumber prev;
+    SequenceNumber next;
+  };
+  typedef OPENDDS_VECTOR(Slot) Slots;
+  typedef OPENDDS_MAP(SequenceNumber, Slot) SlotMap;
+
+  size_t index(const SequenceNumber& seq) const
+  {
+    return static_cast<size_t>(seq.getValue()) & (slots_.size() - 1);
+  }
+
+  bool in_ring(const SequenceNumber& seq) const
+  {
+    return seq.getValue() >= ring_end_ - static_cast<SequenceNumber::Value>(slots_.size());
+  }
+
+  const Slot* find_i(const SequenceNumber& seq) const
+  {
+    if (count_ == 0 || seq < low_ || high_ < seq) {
+      return 0;
+    }
+    if (in_ring(seq)) {
+      const Slot& slot = slots_[index(seq)];
+      return slot.used ? &slot : 0;
+    }
+    const SlotMap::const_iterator it = older_.find(seq);
+    return it == older_.end() ? 0 : &it->second;
+  }
+
+  Slot* find_i(const SequenceNumber& seq)
+  {
+    return const_cast<Slot*>(static_cast<const SingleSendBuffer*>(this)->find_i(seq));
+  }
+
+  bool next_i(const SequenceNumber& seq, SequenceNumber& next) const;
+  Slot& emplace_i(const SequenceNumber& seq);
+  void erase_i(const SequenceNumber& seq);
+  void advance_ring_i(SequenceNumber::Value end);
+  void link_i(const SequenceNumber& seq, Slot& slot);
+  void unlink_i(const SequenceNumber& seq, Slot& slot);
+  void update_bounds_i();
+
+  static void release_buffer(BufferType& buffer);
+
   void check_capacity_i(BufferVec& removed);
-  void release_i(BufferMap::iterator buffer_iter);
-  void remove_i(BufferMap::iterator buffer_iter, BufferVec& removed);
+  void release_i(const SequenceNumber& seq);
+  void remove_i(const SequenceNumber& seq, BufferVec& removed);
 
   RemoveResult retain_buffer(const GUID_t& pub_id, BufferType& buffer);
   void insert_buffer(BufferType& buffer,
@@ -228,14 +291,27 @@ private:
   MessageBlockAllocator replaced_mb_allocator_;
   DataBlockAllocator replaced_db_allocator_;
 
-  BufferMap buffers_;
+  /// A power of two in size.  The ring holds the sequence numbers in
+  /// [ring_end_ - slots_.size(), ring_end_) and the slot for one of them is
+  /// slots_[index(seq)].  The used slots are linked in sequence number order
+  /// from ring_low_ to ring_high_.
+  Slots slots_;
+  SequenceNumber::Value ring_end_;
+  SequenceNumber ring_low_;
+  SequenceNumber ring_high_;
+  size_t ring_count_;
+
+  /// Buffered samples older than the ring
+  SlotMap older_;
+
+  /// Lowest and highest of all buffered samples
+  SequenceNumber low_;
+  SequenceNumber high_;
+  size_t count_;
 
   typedef OPENDDS_MAP(SequenceNumber, BufferMap) FragmentMap;
   FragmentMap fragments_;
 
-  typedef OPENDDS_MAP(SequenceNumber, GUID_t) DestinationMap;
-  DestinationMap destinations_;
-
   typedef OPENDDS_SET(SequenceNumber) SequenceNumberSet;
   SequenceNumberSet pre_seq_;
 
@@ -71,6 +71,7 @@ TransportSendStrategy::TransportSendStrategy(
     max_header_size_(0),
     header_block_(0),
     pkt_chain_(0),
+    packet_being_sent_(0),
     header_complete_(false),
     start_counter_(0),
     mode_(MODE_DIRECT),
@@ -1566,6 +1567,13 @@ TransportSendStrategy::get_packet_elems_from_queue()
 {
   DBG_ENTRY_LVL("TransportSendStrategy", "get_packet_elems_from_queue", 6);
 
+  // A budget below optimum_packet_size would make coalesced packets
+  // smaller than the packets built without it.
+  const size_t coalesce = coalesce_budget();
+  const size_t budget = coalesce ? std::max(coalesce, static_cast<size_t>(optimum_size_)) : 0;
+  // Blocks in the packet, including the packet header, when coalescing.
+  size_t blocks = 1;
+
   for (TransportQueueElement* element = queue_.peek(); element != 0;
        element = queue_.peek()) {
 
@@ -1577,6 +1585,24 @@ TransportSendStrategy::get_packet_elems_from_queue()
 
     const size_t avail = current_space_available();
 
+    if (budget && elems_.size()) {
+      // Keep the coalesced packet within one vectored write, and leave an
+      // element that doesn't fit for the next packet instead of
+      // fragmenting it.
+      size_t element_blocks = 0;
+      for (const ACE_Message_Block* mb = element->msg(); mb; mb = mb->cont()) {
+        ++element_blocks;
+      }
+      if (!coalesce_fits(budget, header_.length_, blocks, element_length, element_blocks, avail)) {
+        break;
+      }
+      blocks += element_blocks;
+    } else if (budget) {
+      for (const ACE_Message_Block* mb = element->msg(); mb; mb = mb->cont()) {
+        ++blocks;
+      }
+    }
+
     bool frag = false;
     if (element_length > avail) {
       // The current element won't fit into the current packet
@@ -1621,10 +1647,18 @@ TransportSendStrategy::get_packet_elems_from_queue()
     // use the packet elems_ as it is now.  Always break once
     // we've encountered and dealt with the exclusive_packet case.
     // Also break if fragmentation was required.
-    if (exclusive_packet || frag
+    if (exclusive_packet || frag) {
+      break;
+    }
+    if (budget) {
+      // When coalescing, only the budget limits the packet.
+      if (header_.length_ >= budget) {
+        break;
+      }
+    } else if (
         // If the current number of packet elems_ has reached the maximum
         // number of samples per packet, then we are done.
-        || elems_.size() == max_samples_
+        elems_.size() == max_samples_
         // If the current value of the header_.length_ exceeds (or equals)
         // the optimum_size_ for a packet, then we are done.
         || header_.length_ >= optimum_size_) {
@@ -1784,7 +1818,13 @@ TransportSendStrategy::do_send_packet(const ACE_Message_Block* packet, int& bp)
   VDBG_LVL((LM_DEBUG, "(%P|%t) DBG:   "
             "Attempt to send_bytes() now.\n"), 5);
 
+#ifdef OPENDDS_SECURITY
+  packet_being_sent_ = substitute ? substitute.get() : packet;
+#else
+  packet_being_sent_ = packet;
+#endif
   const ssize_t num_bytes_sent = send_bytes(iov, num_blocks, bp);
+  packet_being_sent_ = 0;
 
   VDBG_LVL((LM_DEBUG, "(%P|%t) DBG:   "
             "The send_bytes() said that num_bytes_sent == [%d].\n",
@@ -1985,6 +2025,14 @@ TransportSendStrategy::mb_to_iov(const ACE_Message_Block& msg, iovec* iov)
   return num_blocks;
 }
 
+bool
+TransportSendStrategy::coalesce_fits(size_t budget, size_t packet_length, size_t packet_blocks,
+                                     size_t element_length, size_t element_blocks, size_t avail)
+{
+  return packet_length + element_length <= budget && element_length <= avail &&
+    packet_blocks + element_blocks <= static_cast<size_t>(MAX_SEND_BLOCKS);
+}
+
 bool TransportSendStrategy::fragmentation_helper(
   TransportQueueElement* original_element, TqeVector& elements_to_send)
 {
@@ -146,6 +146,14 @@ public:
   /// Precondition: iov must be an iovec[] of size MAX_SEND_BLOCKS or greater.
   static int mb_to_iov(const ACE_Message_Block& msg, iovec* iov);
 
+  /// True if a queued element of 'element_length' bytes in 'element_blocks'
+  /// blocks may join a packet being coalesced up to 'budget' bytes (see
+  /// coalesce_budget()), which holds 'packet_length' bytes of samples in
+  /// 'packet_blocks' blocks, including its header, and has room for 'avail'
+  /// more bytes.
+  static bool coalesce_fits(size_t budget, size_t packet_length, size_t packet_blocks,
+                            size_t element_length, size_t element_blocks, size_t avail);
+
   // Subclasses which make use of acceptors should override
   // this method and return the peer handle.
   virtual ACE_HANDLE get_handle();
@@ -204,6 +212,18 @@ protected:
   /// reassembly will be transparent to the user.
   virtual size_t max_message_size() const;
 
+  /// The number of bytes of queued samples that may be put in one packet,
+  /// and so sent with one vectored write, when the queue is drained after
+  /// backpressure.  Zero limits those packets to max_samples_per_packet
+  /// samples and optimum_packet_size bytes like any other packet.  A budget
+  /// below optimum_packet_size is raised to it.
+  virtual size_t coalesce_budget() const { return 0; }
+
+  /// The packet, or the part of it, being passed to send_bytes().
+  /// The iovecs passed to send_bytes() are its blocks in order.  Null
+  /// outside of send_bytes().
+  const ACE_Message_Block* packet_being_sent() const { return packet_being_sent_; }
+
   /// Set graceful disconnecting flag.
   void set_graceful_disconnecting(bool flag);
 
@@ -371,6 +391,9 @@ private:
   /// current transport packet.
   ACE_Message_Block* pkt_chain_;
 
+  /// See packet_being_sent().
+  const ACE_Message_Block* packet_being_sent_;
+
   /// Set to false when the packet header hasn't been fully sent.
   /// Set to true once the packet header has been fully sent.
   bool header_complete_;
@@ -93,9 +93,15 @@ struct OpenDDS_Dcps_Export InternalTransportStatistics {
   typedef OPENDDS_MAP(GUID_t, CORBA::ULong) GuidCountMap;
   GuidCountMap writer_resend_count;
   GuidCountMap reader_nack_count;
+  CORBA::ULong send_syscalls_saved;
+  CORBA::ULong recv_syscalls_saved;
+  GuidCountMap writer_multicast_resend_count;
+  GuidCountMap writer_nack_suppressed_count;
 
   explicit InternalTransportStatistics(const OPENDDS_STRING& a_transport)
     : transport(a_transport)
+    , send_syscalls_saved(0)
+    , recv_syscalls_saved(0)
     , count_messages_(false)
   {}
 
@@ -109,6 +115,10 @@ struct OpenDDS_Dcps_Export InternalTransportStatistics {
     message_count.clear();
     writer_resend_count.clear();
     reader_nack_count.clear();
+    send_syscalls_saved = 0;
+    recv_syscalls_saved = 0;
+    writer_multicast_resend_count.clear();
+    writer_nack_suppressed_count.clear();
   }
 
 private:
@@ -144,6 +154,18 @@ inline void append(TransportStatisticsSequence& seq, const InternalTransportStat
     const GuidCount gc = { pos->first, pos->second };
     push_back(stats.reader_nack_count, gc);
   }
+  stats.send_syscalls_saved = istats.send_syscalls_saved;
+  stats.recv_syscalls_saved = istats.recv_syscalls_saved;
+  for (InternalTransportStatistics::GuidCountMap::const_iterator pos = istats.writer_multicast_resend_count.begin(),
+         limit = istats.writer_multicast_resend_count.end(); pos != limit; ++pos) {
+    const GuidCount gc = { pos->first, pos->second };
+    push_back(stats.writer_multicast_resend_count, gc);
+  }
+  for (InternalTransportStatistics::GuidCountMap::const_iterator pos = istats.writer_nack_suppressed_count.begin(),
+         limit = istats.writer_nack_suppressed_count.end(); pos != limit; ++pos) {
+    const GuidCount gc = { pos->first, pos->second };
+    push_back(stats.writer_nack_suppressed_count, gc);
+  }
 }
 
 } // namespace DCPS
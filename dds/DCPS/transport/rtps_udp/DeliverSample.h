@@ -0,0 +1,175 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_RTPS_UDP_DELIVERSAMPLE_H
+#define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_DELIVERSAMPLE_H
+
+#include <dds/DCPS/EventDispatcher.h>
+#include <dds/DCPS/GuidConverter.h>
+#include <dds/DCPS/GuidUtils.h>
+#include <dds/DCPS/Hash.h>
+#include <dds/DCPS/RcHandle_T.h>
+#include <dds/DCPS/transport/framework/ReceivedDataSample.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/// The index of the delivery thread, out of 'threads', for the samples
+/// from 'writer', or 'threads' if they are delivered on the receiving
+/// thread.  All samples from one writer use the same thread to keep them
+/// in order.  Discovery is not latency sensitive and its listeners expect
+/// to run in order with the rest of the receive processing.
+inline size_t delivery_thread(const GUID_t& writer, size_t threads)
+{
+  if (!threads || GuidConverter(writer).isBuiltinDomainEntity()) {
+    return threads;
+  }
+  return one_at_a_time_hash(reinterpret_cast<const uint8_t*>(&writer), sizeof writer) % threads;
+}
+
+/// Delivers a received sample to local readers on a delivery thread (see
+/// RtpsUdpInst::receive_threads_).  'Link' has the data_received and
+/// data_received_include of DataLink.
+template <typename Link>
+class DeliverSample : public EventBase {
+public:
+  DeliverSample(const WeakRcHandle<Link>& link, const ReceivedDataSample& sample,
+                const GUID_t& reader_id, const RepoIdSet* incl)
+    : link_(link)
+    , sample_(sample)
+    , reader_id_(reader_id)
+    , use_incl_(incl != 0)
+  {
+    // Otherwise the receive buffer the sample was read into stays
+    // referenced until the sample is delivered and has to be replaced
+    // before the next read.
+    sample_.detach_data();
+    if (incl) {
+      incl_ = *incl;
+    }
+  }
+
+  const ReceivedDataSample& sample() const { return sample_; }
+
+private:
+  WeakRcHandle<Link> link_;
+  ReceivedDataSample sample_;
+  const GUID_t reader_id_;
+  RepoIdSet incl_;
+  const bool use_incl_;
+
+  void handle_event()
+  {
+    RcHandle<Link> link = link_.lock();
+    if (!link) {
+      return;
+    }
+
+    if (use_incl_) {
+      link->data_received_include(sample_, incl_);
+    } else {
+      link->data_received(sample_, reader_id_);
+    }
+  }
+};
+
+typedef OPENDDS_VECTOR(ReceivedDataSample) ReceivedDataSampleVec;
+
+/// Delivers consecutive samples from one writer to the same reader (or to
+/// all of them) on a delivery thread with one event.  'Link' has the
+/// data_received_batch of DataLink.
+template <typename Link>
+class DeliverSamples : public EventBase {
+public:
+  DeliverSamples(const WeakRcHandle<Link>& link, ReceivedDataSampleVec& samples,
+                 const GUID_t& reader_id)
+    : link_(link)
+    , reader_id_(reader_id)
+  {
+    samples_.swap(samples);
+    // See DeliverSample.
+    for (ReceivedDataSampleVec::iterator it = samples_.begin(); it != samples_.end(); ++it) {
+      it->detach_data();
+    }
+  }
+
+  const ReceivedDataSampleVec& samples() const { return samples_; }
+
+private:
+  WeakRcHandle<Link> link_;
+  ReceivedDataSampleVec samples_;
+  const GUID_t reader_id_;
+
+  void handle_event()
+  {
+    RcHandle<Link> link = link_.lock();
+    if (link) {
+      link->data_received_batch(samples_, reader_id_);
+    }
+  }
+};
+
+/// The samples dispatched while a batch of datagrams is processed (see
+/// RtpsUdpInst::receive_batch_size_).  Consecutive samples from one writer
+/// to the same reader are collected into a run, which is passed to the
+/// dispatch_data_received_batch of 'Link' once the next sample doesn't
+/// belong to it or the batch ends.  Runs are delivered in the order they
+/// were collected, so each reader still gets every writer's samples in
+/// order.
+template <typename Link>
+class DeliveryBatch {
+public:
+  DeliveryBatch()
+    : active_(false)
+    , reader_id_(GUID_UNKNOWN)
+  {}
+
+  bool active() const { return active_; }
+
+  void begin()
+  {
+    active_ = true;
+  }
+
+  void add(Link& link, const ReceivedDataSample& sample, const GUID_t& reader_id)
+  {
+    if (!run_.empty() &&
+        (reader_id != reader_id_ || sample.header_.publication_id_ != run_[0].header_.publication_id_)) {
+      flush(link);
+    }
+    reader_id_ = reader_id;
+    run_.push_back(sample);
+  }
+
+  /// Deliver the run collected so far.
+  void flush(Link& link)
+  {
+    if (!run_.empty()) {
+      ReceivedDataSampleVec run;
+      run.swap(run_);
+      link.dispatch_data_received_batch(run, reader_id_);
+    }
+  }
+
+  void end(Link& link)
+  {
+    flush(link);
+    active_ = false;
+  }
+
+private:
+  bool active_;
+  GUID_t reader_id_;
+  ReceivedDataSampleVec run_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_RTPS_UDP_DELIVERSAMPLE_H */
@@ -0,0 +1,61 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "MulticastRepairs.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+bool
+MulticastRepairs::use_multicast(size_t threshold, size_t requesting, size_t associated)
+{
+  return threshold ? requesting >= threshold : requesting * 2 > associated;
+}
+
+void
+MulticastRepairs::expire(const MonotonicTimePoint& now, const TimeDuration& suppression)
+{
+  if (suppression.is_zero()) {
+    repairs_.clear();
+    return;
+  }
+  for (RepairMap::iterator pos = repairs_.begin(); pos != repairs_.end();) {
+    if (pos->second.time_ + suppression <= now) {
+      repairs_.erase(pos++);
+    } else {
+      ++pos;
+    }
+  }
+}
+
+void
+MulticastRepairs::insert(const SequenceNumber& seq, const AddrSet& addrs, const MonotonicTimePoint& now)
+{
+  Repair& repair = repairs_[seq];
+  repair.time_ = now;
+  repair.addrs_ = addrs;
+}
+
+bool
+MulticastRepairs::repaired(const SequenceNumber& seq, const AddrSet& addrs) const
+{
+  const RepairMap::const_iterator pos = repairs_.find(seq);
+  if (pos == repairs_.end() || addrs.empty()) {
+    return false;
+  }
+  for (AddrSet::const_iterator it = addrs.begin(), limit = addrs.end(); it != limit; ++it) {
+    if (pos->second.addrs_.count(*it) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
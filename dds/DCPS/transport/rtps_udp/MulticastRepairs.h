@@ -0,0 +1,61 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_RTPS_UDP_MULTICASTREPAIRS_H
+#define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_MULTICASTREPAIRS_H
+
+#include "Rtps_Udp_Export.h"
+
+#include <dds/DCPS/NetworkAddress.h>
+#include <dds/DCPS/PoolAllocator.h>
+#include <dds/DCPS/SequenceNumber.h>
+#include <dds/DCPS/TimeTypes.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * The samples an RTPS writer recently resent to the multicast addresses of
+ * the readers that requested them, see the nak_multicast_threshold and
+ * nak_suppression_duration options of RtpsUdpInst.
+ */
+class OpenDDS_Rtps_Udp_Export MulticastRepairs {
+public:
+  /// True if a sample that 'requesting' of the 'associated' readers asked
+  /// for is resent once to their multicast addresses.  A 'threshold' of 0
+  /// uses multicast when more than half of the readers asked for it.
+  static bool use_multicast(size_t threshold, size_t requesting, size_t associated);
+
+  /// Forget the repairs that were sent 'suppression' or longer before 'now'.
+  void expire(const MonotonicTimePoint& now, const TimeDuration& suppression);
+
+  /// Record that 'seq' was resent to 'addrs' at 'now'.
+  void insert(const SequenceNumber& seq, const AddrSet& addrs, const MonotonicTimePoint& now);
+
+  /// True if 'seq' was resent to every one of 'addrs', which means a
+  /// request for it from a reader with those addresses most likely crossed
+  /// the repair.
+  bool repaired(const SequenceNumber& seq, const AddrSet& addrs) const;
+
+  bool empty() const { return repairs_.empty(); }
+  size_t size() const { return repairs_.size(); }
+
+private:
+  struct Repair {
+    MonotonicTimePoint time_;
+    AddrSet addrs_;
+  };
+  typedef OPENDDS_MAP(SequenceNumber, Repair) RepairMap;
+  RepairMap repairs_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_RTPS_UDP_MULTICASTREPAIRS_H */
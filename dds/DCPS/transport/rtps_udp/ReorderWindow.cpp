@@ -0,0 +1,443 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ReorderWindow.h"
+
+#include <ace/Log_Msg.h>
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  size_t round_capacity(size_t capacity)
+  {
+    if (capacity == 0) {
+      return 0;
+    }
+    size_t rounded = 32;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+}
+
+ReorderWindow::ReorderWindow(size_t capacity)
+  : capacity_(round_capacity(capacity))
+  , empty_(true)
+  , low_(0)
+  , cumulative_(0)
+  , high_(0)
+  , received_(capacity_ / 32, 0)
+  , received_count_(0)
+  , held_low_(0)
+  , held_(capacity_ / 32, 0)
+  , held_count_(0)
+{
+}
+
+SequenceNumber ReorderWindow::cumulative_ack() const
+{
+  return empty_ ? SequenceNumber::SEQUENCENUMBER_UNKNOWN() : SequenceNumber(cumulative_);
+}
+
+SequenceNumber ReorderWindow::last_ack() const
+{
+  if (empty_) {
+    return SequenceNumber::SEQUENCENUMBER_UNKNOWN();
+  }
+  if (!disjoint()) {
+    return low_;
+  }
+
+  Value last;
+  if (!overflow_.empty()) {
+    last = overflow_.last_ack().getValue();
+    if (last > window_end() + 1) {
+      return last;
+    }
+  } else {
+    last = high_;
+  }
+  // cumulative_ + 1 is never received, so this stops above it.
+  while (in_window(last - 1)) {
+    --last;
+  }
+  return last;
+}
+
+SequenceNumber ReorderWindow::high() const
+{
+  if (empty_) {
+    return SequenceNumber::SEQUENCENUMBER_UNKNOWN();
+  }
+  return overflow_.empty() ? SequenceNumber(high_) : overflow_.high();
+}
+
+bool ReorderWindow::disjoint() const
+{
+  return received_count_ || !overflow_.empty();
+}
+
+bool ReorderWindow::contains(const SequenceNumber& seq) const
+{
+  const Value value = seq.getValue();
+  if (empty_ || value < low_) {
+    return false;
+  }
+  if (value <= cumulative_) {
+    return true;
+  }
+  if (value <= window_end()) {
+    return in_window(value);
+  }
+  return overflow_.contains(seq);
+}
+
+bool ReorderWindow::insert(const SequenceNumber& seq)
+{
+  const Value value = seq.getValue();
+  if (empty_) {
+    empty_ = false;
+    low_ = cumulative_ = high_ = value;
+    return true;
+  }
+  if (value <= cumulative_ || value < low_) {
+    return false;
+  }
+  if (value == cumulative_ + 1) {
+    advance(value);
+    slide();
+    return true;
+  }
+  if (value <= window_end()) {
+    return mark(value);
+  }
+  return overflow_.insert(seq);
+}
+
+bool ReorderWindow::insert(const SequenceRange& range)
+{
+  if (range.second < range.first) {
+    return false;
+  }
+  const Value last = range.second.getValue();
+  if (empty_) {
+    empty_ = false;
+    low_ = range.first.getValue();
+    cumulative_ = high_ = last;
+    return true;
+  }
+  if (last <= cumulative_ || last < low_) {
+    return false;
+  }
+  const Value first = std::max(range.first.getValue(), low_);
+
+  if (first <= cumulative_ + 1) {
+    advance(last);
+    while (!overflow_.empty() && overflow_.low().getValue() <= last) {
+      const SequenceRange covered = overflow_.pop_front_range();
+      if (covered.second.getValue() > last) {
+        overflow_.insert(SequenceRange(last + 1, covered.second));
+        break;
+      }
+    }
+    slide();
+    return true;
+  }
+
+  bool inserted = false;
+  const Value end = std::min(last, window_end());
+  for (Value value = first; value <= end; ++value) {
+    inserted = mark(value) || inserted;
+  }
+  if (last > end) {
+    inserted = overflow_.insert(SequenceRange(std::max(first, end + 1), last)) || inserted;
+  }
+  return inserted;
+}
+
+bool ReorderWindow::insert(const SequenceNumber& base, ACE_CDR::ULong num_bits, const ACE_CDR::Long bits[])
+{
+  bool inserted = false;
+  for (ACE_CDR::ULong i = 0; i < num_bits; ++i) {
+    if (static_cast<ACE_CDR::ULong>(bits[i / 32]) & (1u << (31 - i % 32))) {
+      inserted = insert(SequenceNumber(base.getValue() + i)) || inserted;
+    }
+  }
+  return inserted;
+}
+
+bool ReorderWindow::to_bitmap(ACE_CDR::Long bitmap[],
+                              ACE_CDR::ULong length,
+                              ACE_CDR::ULong& num_bits,
+                              ACE_CDR::ULong& cumulative_bits_added,
+                              bool invert) const
+{
+  num_bits = 0;
+  if (empty_ || !disjoint()) {
+    return true;
+  }
+
+  const Value base = cumulative_ + 1;
+  const Value top = invert ? last_ack().getValue() - 1 : high().getValue();
+  const Value span = top - base + 1;
+  const bool fits = span <= static_cast<Value>(length) * 32;
+  const ACE_CDR::ULong count = fits ? static_cast<ACE_CDR::ULong>(span) : length * 32;
+  const Value end = std::min(top, window_end());
+
+  std::fill(bitmap, bitmap + length, 0);
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    const Value value = base + i;
+    const bool present = value <= end ? in_window(value) : overflow_.contains(value);
+    if (present != invert) {
+      bitmap[i / 32] = static_cast<ACE_CDR::Long>(static_cast<ACE_CDR::ULong>(bitmap[i / 32]) | (1u << (31 - i % 32)));
+      num_bits = i + 1;
+      ++cumulative_bits_added;
+    }
+  }
+  return fits;
+}
+
+OPENDDS_VECTOR(SequenceRange) ReorderWindow::present_sequence_ranges() const
+{
+  OPENDDS_VECTOR(SequenceRange) present;
+  if (empty_) {
+    return present;
+  }
+
+  present.push_back(SequenceRange(low_, cumulative_));
+  if (received_count_) {
+    for (Value value = cumulative_ + 2; value <= high_; ++value) {
+      if (!in_window(value)) {
+        continue;
+      }
+      if (present.back().second.getValue() == value - 1) {
+        present.back().second = value;
+      } else {
+        present.push_back(SequenceRange(value, value));
+      }
+    }
+  }
+
+  const OPENDDS_VECTOR(SequenceRange) ahead = overflow_.present_sequence_ranges();
+  for (size_t i = 0; i < ahead.size(); ++i) {
+    if (present.back().second + 1 == ahead[i].first) {
+      present.back().second = ahead[i].second;
+    } else {
+      present.push_back(ahead[i]);
+    }
+  }
+  return present;
+}
+
+OPENDDS_VECTOR(SequenceRange) ReorderWindow::missing_sequence_ranges() const
+{
+  OPENDDS_VECTOR(SequenceRange) missing;
+  if (!disjoint()) {
+    return missing;
+  }
+
+  const OPENDDS_VECTOR(SequenceRange) present = present_sequence_ranges();
+  for (size_t i = 1; i < present.size(); ++i) {
+    missing.push_back(SequenceRange(present[i - 1].second + 1, present[i].first.previous()));
+  }
+  return missing;
+}
+
+void ReorderWindow::dump() const
+{
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) ReorderWindow[%X]::dump included ranges of "
+                       "SequenceNumbers:\n", this));
+  const OPENDDS_VECTOR(SequenceRange) present = present_sequence_ranges();
+  for (size_t i = 0; i < present.size(); ++i) {
+    ACE_DEBUG((LM_DEBUG, "(%P|%t) ReorderWindow[%X]::dump\t%q-%q\n",
+               this, present[i].first.getValue(), present[i].second.getValue()));
+  }
+}
+
+void ReorderWindow::start(const SequenceRange& range)
+{
+  insert(range);
+
+  SampleVec discard;
+  take_held(range.second, discard);
+
+  OPENDDS_VECTOR(SequenceNumber) held;
+  if (held_count_) {
+    for (Value value = held_low_; value < held_low_ + static_cast<Value>(capacity_); ++value) {
+      if (test(held_, position(value))) {
+        held.push_back(value);
+      }
+    }
+  }
+  for (HeldMap::const_iterator it = held_overflow_.begin(); it != held_overflow_.end(); ++it) {
+    held.push_back(it->first);
+  }
+  for (size_t i = 0; i < held.size(); ++i) {
+    insert(held[i]);
+  }
+}
+
+void ReorderWindow::hold(const SequenceNumber& seq, const ReceivedDataSample& sample)
+{
+  const Value value = seq.getValue();
+  if (capacity_) {
+    if (!held_count_) {
+      held_low_ = empty_ ? value : std::min(value, cumulative_ + 1);
+    }
+    if (value >= held_low_ && value - held_low_ < static_cast<Value>(capacity_)) {
+      const size_t pos = position(value);
+      if (!test(held_, pos) && (held_overflow_.empty() || !held_overflow_.count(seq))) {
+        if (slots_.empty()) {
+          slots_.resize(capacity_);
+        }
+        slots_[pos] = sample;
+        set(held_, pos);
+        ++held_count_;
+      }
+      return;
+    }
+  }
+  held_overflow_.insert(std::make_pair(seq, sample));
+}
+
+void ReorderWindow::take_held(const SequenceNumber& seq, SampleVec& samples)
+{
+  const Value through = seq.getValue();
+  HeldMap::iterator it = held_overflow_.begin();
+  const HeldMap::iterator limit = held_overflow_.upper_bound(seq);
+
+  if (held_count_) {
+    const Value last = std::min(through, held_low_ + static_cast<Value>(capacity_) - 1);
+    for (Value value = held_low_; value <= last && held_count_; ++value) {
+      const size_t pos = position(value);
+      if (!test(held_, pos)) {
+        continue;
+      }
+      for (; it != limit && it->first.getValue() < value; held_overflow_.erase(it++)) {
+        samples.push_back(it->second);
+      }
+      samples.push_back(slots_[pos]);
+      slots_[pos].clear();
+      reset(held_, pos);
+      --held_count_;
+    }
+    if (held_low_ <= through) {
+      held_low_ = through + 1;
+    }
+  }
+
+  for (; it != limit; held_overflow_.erase(it++)) {
+    samples.push_back(it->second);
+  }
+}
+
+void ReorderWindow::erase_held(const DisjointSequence& seqs)
+{
+  if (seqs.empty()) {
+    return;
+  }
+
+  for (HeldMap::iterator pos = held_overflow_.lower_bound(seqs.low()),
+         limit = held_overflow_.upper_bound(seqs.high()); pos != limit;) {
+    if (seqs.contains(pos->first)) {
+      held_overflow_.erase(pos++);
+    } else {
+      ++pos;
+    }
+  }
+
+  if (held_count_) {
+    const Value first = std::max(seqs.low().getValue(), held_low_);
+    const Value last = std::min(seqs.high().getValue(), held_low_ + static_cast<Value>(capacity_) - 1);
+    for (Value value = first; value <= last && held_count_; ++value) {
+      const size_t pos = position(value);
+      if (test(held_, pos) && seqs.contains(value)) {
+        slots_[pos].clear();
+        reset(held_, pos);
+        --held_count_;
+      }
+    }
+  }
+}
+
+void ReorderWindow::clear_held()
+{
+  slots_.clear();
+  std::fill(held_.begin(), held_.end(), 0);
+  held_count_ = 0;
+  held_overflow_.clear();
+}
+
+bool ReorderWindow::mark(Value value)
+{
+  const size_t pos = position(value);
+  if (test(received_, pos)) {
+    return false;
+  }
+  set(received_, pos);
+  ++received_count_;
+  high_ = std::max(high_, value);
+  return true;
+}
+
+void ReorderWindow::advance(Value last)
+{
+  if (received_count_) {
+    if (last - cumulative_ >= static_cast<Value>(capacity_)) {
+      std::fill(received_.begin(), received_.end(), 0);
+      received_count_ = 0;
+    } else {
+      for (Value value = cumulative_ + 1; value <= last; ++value) {
+        const size_t pos = position(value);
+        if (test(received_, pos)) {
+          reset(received_, pos);
+          --received_count_;
+        }
+      }
+    }
+  }
+  cumulative_ = last;
+  high_ = std::max(high_, last);
+}
+
+void ReorderWindow::slide()
+{
+  for (;;) {
+    while (received_count_ && test(received_, position(cumulative_ + 1))) {
+      reset(received_, position(cumulative_ + 1));
+      --received_count_;
+      ++cumulative_;
+    }
+
+    if (overflow_.empty() || overflow_.low().getValue() > window_end()) {
+      return;
+    }
+
+    const SequenceRange range = overflow_.pop_front_range();
+    const Value first = range.first.getValue(), last = range.second.getValue();
+    if (first == cumulative_ + 1) {
+      advance(last);
+    } else {
+      const Value end = std::min(last, window_end());
+      for (Value value = first; value <= end; ++value) {
+        mark(value);
+      }
+      if (last > end) {
+        overflow_.insert(SequenceRange(end + 1, last));
+      }
+    }
+  }
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,155 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_RTPS_UDP_REORDERWINDOW_H
+#define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_REORDERWINDOW_H
+
+#include "Rtps_Udp_Export.h"
+
+#include <dds/DCPS/DisjointSequence.h>
+#include <dds/DCPS/PoolAllocator.h>
+#include <dds/DCPS/SequenceNumber.h>
+#include <dds/DCPS/transport/framework/ReceivedDataSample.h>
+
+#include <ace/CDR_Base.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * The sequence numbers received from one remote writer and the samples
+ * held until they can be delivered in order.
+ *
+ * Sequence numbers in the window of 'capacity' numbers above
+ * cumulative_ack() are tracked in a circular bitmap and held samples in a
+ * circular array of the same size, so the common cases of receiving,
+ * delivering, and NACKing recent data don't allocate or search a tree.
+ * Anything further ahead is kept in a DisjointSequence and a map and moved
+ * into the window as it advances.
+ *
+ * The queries on the received sequence numbers have the same meaning as
+ * those of DisjointSequence, except that the first number or range
+ * inserted sets the low end of the set: numbers below it are ignored.
+ */
+class OpenDDS_Rtps_Udp_Export ReorderWindow {
+public:
+  typedef OPENDDS_VECTOR(ReceivedDataSample) SampleVec;
+
+  /// 'capacity' is rounded up to a power of two of at least 32.  Zero keeps
+  /// everything in the DisjointSequence and map.
+  explicit ReorderWindow(size_t capacity = 0);
+
+  size_t capacity() const { return capacity_; }
+
+  bool empty() const { return empty_; }
+  SequenceNumber cumulative_ack() const;
+  SequenceNumber last_ack() const;
+  SequenceNumber high() const;
+  bool disjoint() const;
+  bool contains(const SequenceNumber& seq) const;
+
+  bool insert(const SequenceNumber& seq);
+  bool insert(const SequenceRange& range);
+  bool insert(const SequenceNumber& base, ACE_CDR::ULong num_bits, const ACE_CDR::Long bits[]);
+
+  /// See DisjointSequence::to_bitmap.  Bits in the window are read directly
+  /// from the window's bitmap.
+  bool to_bitmap(ACE_CDR::Long bitmap[],
+                 ACE_CDR::ULong length,
+                 ACE_CDR::ULong& num_bits,
+                 ACE_CDR::ULong& cumulative_bits_added,
+                 bool invert = false) const;
+
+  OPENDDS_VECTOR(SequenceRange) missing_sequence_ranges() const;
+  OPENDDS_VECTOR(SequenceRange) present_sequence_ranges() const;
+  void dump() const;
+
+  /// Start tracking received sequence numbers with 'range' received, which
+  /// discards the held samples in it and marks the rest as received.
+  /// Precondition: empty()
+  void start(const SequenceRange& range);
+
+  bool has_held() const { return held_count_ || !held_overflow_.empty(); }
+
+  /// Keep 'sample' until take_held() is called for its sequence number.
+  /// Only the first sample held for a sequence number is kept.
+  void hold(const SequenceNumber& seq, const ReceivedDataSample& sample);
+
+  /// Append the held samples at or below 'seq' to 'samples' in order and
+  /// stop holding them.
+  void take_held(const SequenceNumber& seq, SampleVec& samples);
+
+  /// Discard the held samples whose sequence numbers are in 'seqs'.
+  void erase_held(const DisjointSequence& seqs);
+
+  void clear_held();
+
+private:
+  typedef SequenceNumber::Value Value;
+  typedef OPENDDS_VECTOR(ACE_UINT32) Bits;
+  typedef OPENDDS_MAP(SequenceNumber, ReceivedDataSample) HeldMap;
+
+  size_t position(Value value) const
+  {
+    return static_cast<size_t>(value) & (capacity_ - 1);
+  }
+
+  static bool test(const Bits& bits, size_t pos)
+  {
+    return bits[pos >> 5] & (1u << (pos & 31));
+  }
+
+  static void set(Bits& bits, size_t pos)
+  {
+    bits[pos >> 5] |= 1u << (pos & 31);
+  }
+
+  static void reset(Bits& bits, size_t pos)
+  {
+    bits[pos >> 5] &= ~(1u << (pos & 31));
+  }
+
+  /// Highest sequence number tracked by the bitmap.
+  Value window_end() const
+  {
+    return cumulative_ + (capacity_ ? static_cast<Value>(capacity_) : 1);
+  }
+
+  bool in_window(Value value) const
+  {
+    return capacity_ && test(received_, position(value));
+  }
+
+  bool mark(Value value);
+  void advance(Value last);
+  void slide();
+
+  const size_t capacity_;
+
+  bool empty_;
+  Value low_;
+  Value cumulative_;
+  /// Highest sequence number in the window, or cumulative_.
+  Value high_;
+  Bits received_;
+  size_t received_count_;
+  DisjointSequence overflow_;
+
+  /// The held samples in slots_ are in [held_low_, held_low_ + capacity_).
+  Value held_low_;
+  Bits held_;
+  size_t held_count_;
+  SampleVec slots_;
+  HeldMap held_overflow_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_RTPS_UDP_REORDERWINDOW_H */
@@ -9,6 +9,7 @@
 #include "RtpsUdpInst.h"
 #include "RtpsUdpSendStrategy.h"
 #include "RtpsUdpReceiveStrategy.h"
+#include "DeliverSample.h"
 
 #include <dds/DCPS/LogAddr.h>
 #include <dds/DCPS/Definitions.h>
@@ -16,6 +17,7 @@
 #include <dds/DCPS/Logging.h>
 #include <dds/DCPS/NetworkResource.h>
 #include <dds/DCPS/Qos_Helper.h>
+#include <dds/DCPS/ServiceEventDispatcher.h>
 #include <dds/DCPS/transport/framework/TransportCustomizedElement.h>
 #include <dds/DCPS/transport/framework/TransportSendElement.h>
 #include <dds/DCPS/transport/framework/TransportSendControlElement.h>
@@ -109,6 +111,10 @@ RtpsUdpDataLink::RtpsUdpDataLink(const RtpsUdpTransport_rch& transport,
   receive_strategy_ = make_rch<RtpsUdpReceiveStrategy>(this, local_prefix, ref(TheServiceParticipant->get_thread_status_manager()));
   assign(local_prefix_, local_prefix);
 
+  for (size_t i = 0; i < config->receive_threads_; ++i) {
+    delivery_dispatchers_.push_back(make_rch<ServiceEventDispatcher>(1));
+  }
+
   this->job_queue(job_queue_);
 }
 
@@ -538,6 +544,73 @@ void RtpsUdpDataLink::filterBestEffortReaders(const ReceivedDataSample& ds, Repo
   } // else the writer is not associated with best effort readers
 }
 
+EventDispatcher_rch
+RtpsUdpDataLink::delivery_dispatcher(const ReceivedDataSample& sample) const
+{
+  const size_t threads = delivery_dispatchers_.size();
+  const size_t index = delivery_thread(sample.header_.publication_id_, threads);
+  return index < threads ? delivery_dispatchers_[index] : EventDispatcher_rch();
+}
+
+void
+RtpsUdpDataLink::dispatch_data_received(ReceivedDataSample& sample, const GUID_t& readerId)
+{
+  if (delivery_batch_.active()) {
+    delivery_batch_.add(*this, sample, readerId);
+    return;
+  }
+
+  const EventDispatcher_rch dispatcher = delivery_dispatcher(sample);
+  if (!dispatcher ||
+      !dispatcher->dispatch(make_rch<DeliverSample<RtpsUdpDataLink> >(rchandle_from(this), sample, readerId, static_cast<const RepoIdSet*>(0)))) {
+    data_received(sample, readerId);
+  }
+}
+
+void
+RtpsUdpDataLink::dispatch_data_received_include(ReceivedDataSample& sample, const RepoIdSet& incl)
+{
+  // Not collected into runs, but still after what was collected before it.
+  delivery_batch_.flush(*this);
+
+  const EventDispatcher_rch dispatcher = delivery_dispatcher(sample);
+  if (!dispatcher ||
+      !dispatcher->dispatch(make_rch<DeliverSample<RtpsUdpDataLink> >(rchandle_from(this), sample, GUID_UNKNOWN, &incl))) {
+    data_received_include(sample, incl);
+  }
+}
+
+void
+RtpsUdpDataLink::dispatch_data_received_batch(ReceivedDataSampleVec& samples, const GUID_t& readerId)
+{
+  if (samples.empty()) {
+    return;
+  }
+  const EventDispatcher_rch dispatcher = delivery_dispatcher(samples[0]);
+  if (dispatcher) {
+    // The event takes the samples.
+    const RcHandle<DeliverSamples<RtpsUdpDataLink> > event =
+      make_rch<DeliverSamples<RtpsUdpDataLink> >(rchandle_from(this), samples, readerId);
+    if (dispatcher->dispatch(event)) {
+      return;
+    }
+    samples = event->samples();
+  }
+  data_received_batch(samples, readerId);
+}
+
+void
+RtpsUdpDataLink::begin_receive_batch()
+{
+  delivery_batch_.begin();
+}
+
+void
+RtpsUdpDataLink::end_receive_batch()
+{
+  delivery_batch_.end(*this);
+}
+
 int
 RtpsUdpDataLink::make_reservation(const GUID_t& rpi,
                                   const GUID_t& lsi,
@@ -642,7 +715,9 @@ RtpsUdpDataLink::associated(const GUID_t& local_id, const GUID_t& remote_id,
       readers_of_writer_.insert(RtpsReaderMultiMap::value_type(remote_id, rr->second));
       g.release();
       add_on_start_callback(client, remote_id);
-      reader->add_writer(make_rch<WriterInfo>(remote_id, participant_discovered_at, participant_flags));
+      RtpsUdpInst_rch cfg = config();
+      reader->add_writer(make_rch<WriterInfo>(remote_id, participant_discovered_at, participant_flags,
+                                              cfg ? cfg->reorder_window_ : 0));
       associated = false;
     } else {
       invoke_on_start_callbacks(local_id, remote_id, true);
@@ -967,6 +1042,9 @@ RtpsUdpDataLink::stop_i()
 
   heartbeat_->disable();
   heartbeatchecker_->disable();
+  for (EventDispatcherVec::iterator it = delivery_dispatchers_.begin(); it != delivery_dispatchers_.end(); ++it) {
+    (*it)->shutdown(true);
+  }
   unicast_socket_.close();
   multicast_socket_.close();
 #ifdef ACE_HAS_IPV6
@@ -1639,7 +1717,7 @@ RtpsUdpDataLink::RtpsReader::pre_stop_helper()
   }
 
   for (WriterInfoMap::iterator it = remote_writers_.begin(); it != remote_writers_.end(); ++it) {
-    it->second->held_.clear();
+    it->second->window_.clear_held();
   }
 
   guard.release();
@@ -1695,7 +1773,7 @@ RtpsUdpDataLink::RtpsReader::process_data_i(const RTPS::DataSubmessage& data,
 
     writer->frags_.erase(seq);
 
-    if (writer->recvd_.empty()) {
+    if (writer->window_.empty()) {
       if (Transport_debug_level > 5) {
         ACE_DEBUG((LM_DEBUG,
                    ACE_TEXT("(%P|%t) RtpsUdpDataLink::process_data_i(DataSubmessage) -")
@@ -1706,9 +1784,9 @@ RtpsUdpDataLink::RtpsReader::process_data_i(const RTPS::DataSubmessage& data,
       }
       const ReceivedDataSample* sample =
         link->receive_strategy()->withhold_data_from(id_);
-      writer->held_.insert(std::make_pair(seq, *sample));
+      writer->window_.hold(seq, *sample);
 
-    } else if (writer->recvd_.contains(seq)) {
+    } else if (writer->window_.contains(seq)) {
       if (transport_debug.log_dropped_messages) {
         ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_data_i: %C -> %C duplicate sample\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
       }
@@ -1721,17 +1799,17 @@ RtpsUdpDataLink::RtpsReader::process_data_i(const RTPS::DataSubmessage& data,
       }
       link->receive_strategy()->withhold_data_from(id_);
 
-    } else if (!writer->held_.empty()) {
+    } else if (writer->window_.has_held()) {
       const ReceivedDataSample* sample =
         link->receive_strategy()->withhold_data_from(id_);
       if (Transport_debug_level > 5) {
         ACE_DEBUG((LM_DEBUG, "(%P|%t) RtpsUdpDataLink::process_data_i(DataSubmessage) WITHHOLD %q\n", seq.getValue()));
-        writer->recvd_.dump();
+        writer->window_.dump();
       }
-      writer->held_.insert(std::make_pair(seq, *sample));
-      writer->recvd_.insert(seq);
+      writer->window_.hold(seq, *sample);
+      writer->window_.insert(seq);
 
-    } else if (writer->recvd_.disjoint() || writer->recvd_.cumulative_ack() != seq.previous()) {
+    } else if (writer->window_.disjoint() || writer->window_.cumulative_ack() != seq.previous()) {
       if (Transport_debug_level > 5) {
         ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpDataLink::process_data_i(DataSubmessage) -")
                              ACE_TEXT(" data seq: %q from %C being WITHHELD from %C because it's EXPECTING more data\n"),
@@ -1741,8 +1819,8 @@ RtpsUdpDataLink::RtpsReader::process_data_i(const RTPS::DataSubmessage& data,
       }
       const ReceivedDataSample* sample =
         link->receive_strategy()->withhold_data_from(id_);
-      writer->held_.insert(std::make_pair(seq, *sample));
-      writer->recvd_.insert(seq);
+      writer->window_.hold(seq, *sample);
+      writer->window_.insert(seq);
 
     } else {
       if (Transport_debug_level > 5) {
@@ -1752,7 +1830,7 @@ RtpsUdpDataLink::RtpsReader::process_data_i(const RTPS::DataSubmessage& data,
                              LogGuid(src).c_str(),
                              LogGuid(id_).c_str()));
       }
-      writer->recvd_.insert(seq);
+      writer->window_.insert(seq);
       link->receive_strategy()->do_not_withhold_data_from(id_);
     }
 
@@ -1816,7 +1894,7 @@ RtpsUdpDataLink::RtpsReader::process_gap_i(const RTPS::GapSubmessage& gap,
 
   const WriterInfo_rch& writer = wi->second;
 
-  if (writer->recvd_.empty()) {
+  if (writer->window_.empty()) {
     if (transport_debug.log_dropped_messages) {
       ACE_DEBUG((LM_DEBUG, "(%P|%t) {transport_debug.log_dropped_messages} RtpsUdpDataLink::RtpsReader::process_gap_i: %C -> %C preassociation writer\n", LogGuid(src).c_str(), LogGuid(id_).c_str()));
     }
@@ -1827,11 +1905,11 @@ RtpsUdpDataLink::RtpsReader::process_gap_i(const RTPS::GapSubmessage& gap,
   const SequenceNumber base = to_opendds_seqnum(gap.gapList.bitmapBase);
 
   if (start < base) {
-    writer->recvd_.insert(SequenceRange(start, base.previous()));
+    writer->window_.insert(SequenceRange(start, base.previous()));
   } else if (start != base) {
     ACE_ERROR((LM_ERROR, "(%P|%t) RtpsUdpDataLink::RtpsReader::process_gap_i: ERROR - Incoming GAP has inverted start (%q) & base (%q) values, ignoring start value\n", start.getValue(), base.getValue()));
   }
-  writer->recvd_.insert(base, gap.gapList.numBits, gap.gapList.bitmap.get_buffer());
+  writer->window_.insert(base, gap.gapList.numBits, gap.gapList.bitmap.get_buffer());
 
   DisjointSequence gaps;
   if (start < base) {
@@ -1839,16 +1917,7 @@ RtpsUdpDataLink::RtpsReader::process_gap_i(const RTPS::GapSubmessage& gap,
   }
   gaps.insert(base, gap.gapList.numBits, gap.gapList.bitmap.get_buffer());
 
-  if (!gaps.empty()) {
-    for (WriterInfo::HeldMap::iterator pos = writer->held_.lower_bound(gaps.low()),
-           limit = writer->held_.upper_bound(gaps.high()); pos != limit;) {
-      if (gaps.contains(pos->first)) {
-        writer->held_.erase(pos++);
-      } else {
-        ++pos;
-      }
-    }
-  }
+  writer->window_.erase_held(gaps);
 
   const OPENDDS_VECTOR(SequenceRange) psr = gaps.present_sequence_ranges();
   for (OPENDDS_VECTOR(SequenceRange)::const_iterator pos = psr.begin(), limit = psr.end(); pos != limit; ++pos) {
@@ -1963,7 +2032,7 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_i(const RTPS::HeartBeatSubmessage
 
   // Only valid heartbeats (see spec) will be "fully" applied to writer info
   if (!(hb_first < 1 || hb_last < 0 || hb_last < hb_first.previous())) {
-    if (writer->recvd_.empty() && (directed || !writer->sends_directed_hb())) {
+    if (writer->window_.empty() && (directed || !writer->sends_directed_hb())) {
       OPENDDS_ASSERT(preassociation_writers_.count(writer));
       preassociation_writers_.erase(writer);
       if (transport_debug.log_progress) {
@@ -1972,19 +2041,13 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_i(const RTPS::HeartBeatSubmessage
       log_remote_counts("process_heartbeat_i");
 
       const SequenceRange sr(zero, hb_first.previous());
-      writer->recvd_.insert(sr);
-      while (!writer->held_.empty() && writer->held_.begin()->first <= sr.second) {
-        writer->held_.erase(writer->held_.begin());
-      }
-      for (WriterInfo::HeldMap::const_iterator it = writer->held_.begin(); it != writer->held_.end(); ++it) {
-        writer->recvd_.insert(it->first);
-      }
+      writer->window_.start(sr);
       link->receive_strategy()->remove_fragments(sr, writer->id_);
       first_ever_hb = true;
     }
 
     ACE_CDR::ULong cumulative_bits_added = 0;
-    if (!writer->recvd_.empty()) {
+    if (!writer->window_.empty()) {
       writer->hb_last_ = std::max(writer->hb_last_, hb_last);
       gather_ack_nacks_i(writer, link, !is_final, meta_submessages, cumulative_bits_added);
     }
@@ -2015,11 +2078,11 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_i(const RTPS::HeartBeatSubmessage
 bool
 RtpsUdpDataLink::WriterInfo::should_nack() const
 {
-  if (recvd_.empty() || (recvd_.disjoint() && recvd_.cumulative_ack() < hb_last_)) {
+  if (window_.empty() || (window_.disjoint() && window_.cumulative_ack() < hb_last_)) {
     return true;
   }
-  if (!recvd_.empty()) {
-    return recvd_.high() < hb_last_;
+  if (!window_.empty()) {
+    return window_.high() < hb_last_;
   }
   return false;
 }
@@ -2214,8 +2277,8 @@ RtpsUdpDataLink::RtpsReader::should_nack_fragments(const RcHandle<RtpsUdpDataLin
     return true;
   }
 
-  if (!info->recvd_.empty()) {
-    const SequenceRange range(info->recvd_.cumulative_ack() + 1, info->hb_last_);
+  if (!info->window_.empty()) {
+    const SequenceRange range(info->window_.cumulative_ack() + 1, info->hb_last_);
     if (link->receive_strategy()->has_fragments(range, info->id_)) {
       return true;
     }
@@ -2259,7 +2322,7 @@ RtpsUdpDataLink::RtpsReader::gather_preassociation_acknack_i(MetaSubmessageVec&
 {
   using namespace OpenDDS::RTPS;
 
-  OPENDDS_ASSERT(writer->recvd_.empty());
+  OPENDDS_ASSERT(writer->window_.empty());
   const CORBA::ULong num_bits = 0;
   const LongSeq8 bitmap;
   const EntityId_t reader_id = id_.entityId;
@@ -2298,7 +2361,7 @@ RtpsUdpDataLink::RtpsReader::gather_ack_nacks_i(const WriterInfo_rch& writer,
     const EntityId_t writer_id = writer->id_.entityId;
     MetaSubmessage meta_submessage(id_, writer->id_);
 
-    const DisjointSequence& recvd = writer->recvd_;
+    const ReorderWindow& recvd = writer->window_;
     const SequenceNumber& hb_high = writer->hb_last_;
     const SequenceNumber ack = recvd.empty() ? 1 : ++SequenceNumber(recvd.cumulative_ack());
     const SequenceNumber::Value ack_val = ack.getValue();
@@ -2374,7 +2437,7 @@ RtpsUdpDataLink::RtpsReader::gather_ack_nacks_i(const WriterInfo_rch& writer,
     }
   } else if (heartbeat_was_non_final) {
     using namespace OpenDDS::RTPS;
-    const DisjointSequence& recvd = writer->recvd_;
+    const ReorderWindow& recvd = writer->window_;
     const CORBA::ULong num_bits = 0;
     const LongSeq8 bitmap;
     const SequenceNumber ack = recvd.empty() ? 1 : ++SequenceNumber(recvd.cumulative_ack());
@@ -2676,12 +2739,23 @@ RtpsUdpDataLink::flush_send_queue(const MonotonicTimePoint& /*now*/)
 void
 RtpsUdpDataLink::flush_send_queue_i()
 {
+  RtpsUdpInst_rch cfg = config();
+  RtpsUdpSendStrategy::Batch batch;
+  RtpsUdpSendStrategy::Batch* const batch_ptr = (cfg && cfg->send_batching_) ? &batch : 0;
+
   for (size_t idx = 0; idx != fsq_vec_size_; ++idx) {
     dedup(fsq_vec_[idx]);
-    bundle_and_send_submessages(fsq_vec_[idx]);
+    bundle_and_send_submessages(fsq_vec_[idx], batch_ptr);
     fsq_vec_[idx].clear();
   }
   fsq_vec_size_ = 0;
+
+  if (!batch.empty()) {
+    RtpsUdpSendStrategy_rch ss = send_strategy();
+    if (ss) {
+      ss->send_batch(batch);
+    }
+  }
 }
 
 void
@@ -2755,7 +2829,8 @@ RtpsUdpDataLink::update_required_acknack_count(const GUID_t& local_id, const GUI
 }
 
 void
-RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages)
+RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages,
+                                             RtpsUdpSendStrategy::Batch* batch)
 {
   using namespace RTPS;
 
@@ -2873,7 +2948,11 @@ RtpsUdpDataLink::bundle_and_send_submessages(MetaSubmessageVec& meta_submessages
     }
     RtpsUdpSendStrategy_rch ss = send_strategy();
     if (ss) {
-      ss->send_rtps_control(rtps_message, *(mb_bundle.get()), bundles[i].proxy_.addrs());
+      if (batch) {
+        ss->queue_rtps_control(rtps_message, *(mb_bundle.get()), bundles[i].proxy_.addrs(), *batch);
+      } else {
+        ss->send_rtps_control(rtps_message, *(mb_bundle.get()), bundles[i].proxy_.addrs());
+      }
     }
   }
 }
@@ -2895,13 +2974,13 @@ RtpsUdpDataLink::RtpsReader::generate_nack_frags_i(MetaSubmessageVec& meta_subme
 
   // Populate frag_info with two possible sources of NackFrags:
   // 1. sequence #s in the reception gaps that we have partially received
-  OPENDDS_VECTOR(SequenceRange) missing = wi->recvd_.missing_sequence_ranges();
+  OPENDDS_VECTOR(SequenceRange) missing = wi->window_.missing_sequence_ranges();
   for (size_t i = 0; i < missing.size(); ++i) {
     link->receive_strategy()->has_fragments(missing[i], wi->id_, &frag_info);
   }
   // 1b. larger than the last received seq# but less than the heartbeat.lastSN
-  if (!wi->recvd_.empty() && wi->recvd_.high() < wi->hb_last_) {
-    const SequenceRange range(wi->recvd_.high() + 1, wi->hb_last_);
+  if (!wi->window_.empty() && wi->window_.high() < wi->hb_last_) {
+    const SequenceRange range(wi->window_.high() + 1, wi->hb_last_);
     link->receive_strategy()->has_fragments(range, wi->id_, &frag_info);
   }
   for (size_t i = 0; i < frag_info.size(); ++i) {
@@ -2912,9 +2991,9 @@ RtpsUdpDataLink::RtpsReader::generate_nack_frags_i(MetaSubmessageVec& meta_subme
     }
   }
 
-  // 2. sequence #s outside the recvd_ gaps for which we have a HeartbeatFrag
-  const iter_t low = wi->frags_.lower_bound(wi->recvd_.cumulative_ack()),
-              high = wi->frags_.upper_bound(wi->recvd_.last_ack()),
+  // 2. sequence #s outside the window_ gaps for which we have a HeartbeatFrag
+  const iter_t low = wi->frags_.lower_bound(wi->window_.cumulative_ack()),
+              high = wi->frags_.upper_bound(wi->window_.last_ack()),
                end = wi->frags_.end();
   for (iter_t iter = wi->frags_.begin(); iter != end; ++iter) {
     if (iter == low) {
@@ -3037,10 +3116,10 @@ RtpsUdpDataLink::RtpsReader::process_heartbeat_frag_i(const RTPS::HeartBeatFragS
 
   // If seq is outside the heartbeat range or we haven't completely received
   // it yet, send a NackFrag along with the AckNack.  The heartbeat range needs
-  // to be checked first because recvd_ contains the numbers below the
+  // to be checked first because window_ contains the numbers below the
   // heartbeat range (so that we don't NACK those).
   const SequenceNumber seq = to_opendds_seqnum(hb_frag.writerSN);
-  if (seq > writer->hb_last_ || !writer->recvd_.contains(seq)) {
+  if (seq > writer->hb_last_ || !writer->window_.contains(seq)) {
     writer->frags_[seq] = hb_frag.lastFragmentNum;
     ACE_CDR::ULong cumulative_bits_added = 0;
     gather_ack_nacks_i(writer, link, !(hb_frag.smHeader.flags & RTPS::FLAG_F), meta_submessages, cumulative_bits_added);
@@ -3506,6 +3585,16 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
   SingleSendBuffer::Proxy proxy(*send_buff_);
 
   size_t cumulative_send_count = 0;
+  size_t multicast_send_count = 0;
+  size_t suppressed_count = 0;
+
+  RtpsUdpInst_rch cfg = link->config();
+  const size_t multicast_threshold = cfg ? cfg->nak_multicast_threshold_ : 0;
+  const TimeDuration suppression = cfg ? cfg->nak_suppression_duration_ : TimeDuration::zero_value;
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+
+  // Forget the multicast repairs that no longer suppress requests.
+  multicast_repairs_.expire(now, suppression);
 
   for (ReaderInfoSet::const_iterator pos = readers_expecting_data_.begin(), limit = readers_expecting_data_.end();
        pos != limit; ++pos) {
@@ -3565,6 +3654,13 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
       continue;
     }
 
+    // The multicast addresses of the reader, or its unicast addresses if it has none.
+    AddrSet multicast_addrs;
+    {
+      ACE_Guard<ACE_Thread_Mutex> g(link->locators_lock_);
+      link->accumulate_addresses(id_, reader->id_, multicast_addrs, false);
+    }
+
     const SequenceNumber first_sn = std::max(non_durable_first_sn(proxy), reader->start_sn_);
     if (!reader->requests_.empty() &&
         reader->requests_.high() < first_sn) {
@@ -3582,11 +3678,15 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
         if (proxy.contains(seq, destination)) {
           if (destination == GUID_UNKNOWN) {
             // Not directed.
+            if (multicast_repairs_.repaired(seq, multicast_addrs)) {
+              // The request most likely crossed the repair.
+              ++suppressed_count;
+              continue;
+            }
             consolidated_requests.insert(seq);
             consolidated_request_readers[seq].insert(reader->id_);
             consolidated_recipients_unicast[seq].insert(addrs.begin(), addrs.end());
-            ACE_Guard<ACE_Thread_Mutex> g(link->locators_lock_);
-            link->accumulate_addresses(id_, reader->id_, consolidated_recipients_multicast[seq], false);
+            consolidated_recipients_multicast[seq].insert(multicast_addrs.begin(), multicast_addrs.end());
             continue;
           } else if (destination != reader->id_) {
             // Directed at another reader.
@@ -3630,8 +3730,7 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
           }
           consolidated_fragment_request_readers[seq].insert(reader->id_);
           consolidated_fragment_recipients_unicast[seq].insert(addrs.begin(), addrs.end());
-          ACE_Guard<ACE_Thread_Mutex> g(link->locators_lock_);
-          link->accumulate_addresses(id_, reader->id_, consolidated_fragment_recipients_multicast[seq], false);
+          consolidated_fragment_recipients_multicast[seq].insert(multicast_addrs.begin(), multicast_addrs.end());
           continue;
         } else if (destination != reader->id_) {
           // Directed at another reader.
@@ -3692,11 +3791,19 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
           consolidated_fragment_recipients_multicast[seq].insert(multi.begin(), multi.end());
           consolidated_fragment_request_readers[seq].insert(readers.begin(), readers.end());
         } else {
+          const bool use_multicast =
+            MulticastRepairs::use_multicast(multicast_threshold, readers.size(), remote_readers_.size());
           const RtpsUdpSendStrategy::OverrideToken ot =
-            link->send_strategy()->override_destinations(readers.size() * 2 > remote_readers_.size() ? multi : uni);
+            link->send_strategy()->override_destinations(use_multicast ? multi : uni);
 
           proxy.resend_i(SequenceRange(seq, seq));
           ++cumulative_send_count;
+          if (use_multicast && multi != uni) {
+            ++multicast_send_count;
+            if (!suppression.is_zero()) {
+              multicast_repairs_.insert(seq, multi, now);
+            }
+          }
         }
       }
     }
@@ -3706,19 +3813,29 @@ RtpsUdpDataLink::RtpsWriter::gather_nack_replies_i(MetaSubmessageVec& meta_subme
       const AddrSet& uni = consolidated_fragment_recipients_unicast[pos->first];
       const AddrSet& multi = consolidated_fragment_recipients_multicast[pos->first];
       const RepoIdSet& readers = consolidated_fragment_request_readers[pos->first];
+      const bool use_multicast =
+        MulticastRepairs::use_multicast(multicast_threshold, readers.size(), remote_readers_.size());
       const RtpsUdpSendStrategy::OverrideToken ot =
-        link->send_strategy()->override_destinations(readers.size() * 2 > remote_readers_.size() ? multi : uni);
+        link->send_strategy()->override_destinations(use_multicast ? multi : uni);
 
       proxy.resend_fragments_i(pos->first, pos->second, cumulative_send_count);
+      if (use_multicast && multi != uni) {
+        ++multicast_send_count;
+      }
     }
   }
 
-  if (cumulative_send_count) {
-    RtpsUdpInst_rch cfg = link->config();
-    if (cfg && link->transport_statistics_.count_messages()) {
-      ACE_GUARD(ACE_Thread_Mutex, g, link->transport_statistics_mutex_);
+  if ((cumulative_send_count || suppressed_count) && cfg && link->transport_statistics_.count_messages()) {
+    ACE_GUARD(ACE_Thread_Mutex, g, link->transport_statistics_mutex_);
+    if (cumulative_send_count) {
       link->transport_statistics_.writer_resend_count[id_] += static_cast<ACE_CDR::ULong>(cumulative_send_count);
     }
+    if (multicast_send_count) {
+      link->transport_statistics_.writer_multicast_resend_count[id_] += static_cast<ACE_CDR::ULong>(multicast_send_count);
+    }
+    if (suppressed_count) {
+      link->transport_statistics_.writer_nack_suppressed_count[id_] += static_cast<ACE_CDR::ULong>(suppressed_count);
+    }
   }
 
   // Gather the consolidated gaps.
@@ -4550,12 +4667,8 @@ RtpsUdpDataLink::RtpsReader::deliver_held_data(const GUID_t& src)
 
   const WriterInfoMap::iterator wi = remote_writers_.find(src);
   if (wi != remote_writers_.end()) {
-    const SequenceNumber ca = wi->second->recvd_.cumulative_ack();
-    const WriterInfo::HeldMap::iterator end = wi->second->held_.upper_bound(ca);
-    for (WriterInfo::HeldMap::iterator it = wi->second->held_.begin(); it != end; /*increment in loop body*/) {
-      to_deliver.push_back(it->second);
-      wi->second->held_.erase(it++);
-    }
+    const SequenceNumber ca = wi->second->window_.cumulative_ack();
+    wi->second->window_.take_held(ca, to_deliver);
   }
 
   const GUID_t dst = id_;
@@ -4570,7 +4683,7 @@ RtpsUdpDataLink::RtpsReader::deliver_held_data(const GUID_t& src)
                  it->header_.sequence_.getValue(),
                  reader.c_str()));
     }
-    link->data_received(*it, dst);
+    link->dispatch_data_received(*it, dst);
   }
 }
 
@@ -8,10 +8,14 @@
 
 #include "Rtps_Udp_Export.h"
 #include "BundlingCacheKey.h"
+#include "DeliverSample.h"
 #include "LocatorCacheKey.h"
+#include "MulticastRepairs.h"
+#include "ReorderWindow.h"
 #include "RtpsCustomizedElement.h"
 #include "RtpsUdpDataLink_rch.h"
 #include "RtpsUdpReceiveStrategy_rch.h"
+#include "RtpsUdpSendStrategy.h"
 #include "RtpsUdpSendStrategy_rch.h"
 #include "RtpsUdpTransport_rch.h"
 #include "TransactionalRtpsSendQueue.h"
@@ -172,6 +176,22 @@ public:
 
   void filterBestEffortReaders(const ReceivedDataSample& ds, RepoIdSet& selected, RepoIdSet& withheld);
 
+  /// Hand a received sample to the local readers, either directly or on the
+  /// delivery thread selected by its writer when receive_threads is set.
+  /// @see DataLink::data_received
+  void dispatch_data_received(ReceivedDataSample& sample, const GUID_t& readerId = GUID_UNKNOWN);
+  /// @see DataLink::data_received_include
+  void dispatch_data_received_include(ReceivedDataSample& sample, const RepoIdSet& incl);
+  /// Hand consecutive samples from one writer to the same reader to the
+  /// local readers with one dispatch.
+  /// @see DataLink::data_received_batch
+  void dispatch_data_received_batch(ReceivedDataSampleVec& samples, const GUID_t& readerId);
+
+  /// Between these, the samples dispatched by the receiving thread are
+  /// delivered in runs per reader, see DeliveryBatch.
+  void begin_receive_batch();
+  void end_receive_batch();
+
   int make_reservation(const GUID_t& remote_publication_id,
                        const GUID_t& local_subscription_id,
                        const TransportReceiveListener_wrch& receive_listener,
@@ -421,6 +441,16 @@ private:
     }
   };
 
+  /// Single-threaded dispatchers used to deliver samples to local readers,
+  /// empty when samples are delivered on the receiving thread.
+  typedef OPENDDS_VECTOR(EventDispatcher_rch) EventDispatcherVec;
+  EventDispatcherVec delivery_dispatchers_;
+
+  EventDispatcher_rch delivery_dispatcher(const ReceivedDataSample& sample) const;
+
+  /// Only used by the thread running the receive strategy.
+  DeliveryBatch<RtpsUdpDataLink> delivery_batch_;
+
   class RtpsWriter : public virtual RcObject {
   private:
     ReaderInfoMap remote_readers_;
@@ -440,6 +470,8 @@ private:
     ReaderInfoSet readers_expecting_heartbeat_;
     RcHandle<SingleSendBuffer> send_buff_;
     SequenceNumber max_sn_;
+    /// Multicast repairs sent within the last nak_suppression_duration.
+    MulticastRepairs multicast_repairs_;
     typedef OPENDDS_SET_CMP(TransportQueueElement*, TransportQueueElement::OrderBySequenceNumber) TqeSet;
     typedef OPENDDS_MULTIMAP(SequenceNumber, TransportQueueElement*) SnToTqeMap;
     SnToTqeMap elems_not_acked_;
@@ -588,9 +620,8 @@ private:
   struct WriterInfo : RcObject {
     const GUID_t id_;
     const MonotonicTime_t participant_discovered_at_;
-    DisjointSequence recvd_;
-    typedef OPENDDS_MAP(SequenceNumber, ReceivedDataSample) HeldMap;
-    HeldMap held_;
+    /// Received sequence numbers and the samples held for in-order delivery.
+    ReorderWindow window_;
     SequenceNumber hb_last_;
     OPENDDS_MAP(SequenceNumber, RTPS::FragmentNumber_t) frags_;
     CORBA::Long heartbeat_recvd_count_, hb_frag_recvd_count_;
@@ -598,9 +629,11 @@ private:
 
     WriterInfo(const GUID_t& id,
                const MonotonicTime_t& participant_discovered_at,
-               ACE_CDR::ULong participant_flags)
+               ACE_CDR::ULong participant_flags,
+               size_t reorder_window = 0)
       : id_(id)
       , participant_discovered_at_(participant_discovered_at)
+      , window_(reorder_window)
       , hb_last_(SequenceNumber::ZERO())
       , heartbeat_recvd_count_(0)
       , hb_frag_recvd_count_(0)
@@ -729,7 +762,8 @@ private:
 
   void queue_submessages(MetaSubmessageVec& meta_submessages);
   void update_required_acknack_count(const GUID_t& local_id, const GUID_t& remote_id, CORBA::Long current);
-  void bundle_and_send_submessages(MetaSubmessageVec& meta_submessages);
+  void bundle_and_send_submessages(MetaSubmessageVec& meta_submessages,
+                                   RtpsUdpSendStrategy::Batch* batch = 0);
 
   TransactionalRtpsSendQueue sq_;
   mutable ACE_Thread_Mutex fsq_mutex_;
@@ -12,6 +12,7 @@
 #include "RtpsUdpSendStrategy.h"
 
 #include <dds/DCPS/LogAddr.h>
+#include <dds/DCPS/debug.h>
 #include <dds/DCPS/NetworkResource.h>
 #include <dds/DCPS/Service_Participant.h>
 #include <dds/DCPS/transport/framework/TransportDefs.h>
@@ -45,6 +46,12 @@ RtpsUdpInst::RtpsUdpInst(const OPENDDS_STRING& name)
   , receive_address_duration_(5)
   , responsive_mode_(false)
   , send_delay_(0, 10 * 1000)
+  , send_batching_(false)
+  , receive_batch_size_(1)
+  , receive_threads_(0)
+  , reorder_window_(256)
+  , nak_multicast_threshold_(0)
+  , nak_suppression_duration_(0)
   , opendds_discovery_guid_(GUID_UNKNOWN)
   , multicast_group_address_(7401, "239.255.0.2")
   , local_address_(u_short(0), "0.0.0.0")
@@ -139,6 +146,26 @@ RtpsUdpInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("send_delay"),
                         send_delay_);
 
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("send_batching"), send_batching_, bool);
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_batch_size"), receive_batch_size_, size_t);
+  if (receive_batch_size_ > MAX_RECEIVE_BATCH_SIZE) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: RtpsUdpInst::load: "
+                 "receive_batch_size %B is larger than the maximum of %B, using the maximum\n",
+                 receive_batch_size_, size_t(MAX_RECEIVE_BATCH_SIZE)));
+    }
+    receive_batch_size_ = MAX_RECEIVE_BATCH_SIZE;
+  }
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("receive_threads"), receive_threads_, size_t);
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("reorder_window"), reorder_window_, size_t);
+
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("nak_multicast_threshold"), nak_multicast_threshold_, size_t);
+  GET_CONFIG_TIME_VALUE(cf, sect, ACE_TEXT("nak_suppression_duration"),
+                        nak_suppression_duration_);
+
   ACE_TString rtps_relay_address_s;
   GET_CONFIG_TSTRING_VALUE(cf, sect, ACE_TEXT("DataRtpsRelayAddress"),
                            rtps_relay_address_s);
@@ -187,6 +214,12 @@ RtpsUdpInst::dump_to_str() const
   ret += formatNameForDump("rcv_buffer_size") + to_dds_string(rcv_buffer_size_) + '\n';
   ret += formatNameForDump("ttl") + to_dds_string(ttl_) + '\n';
   ret += formatNameForDump("responsive_mode") + (responsive_mode_ ? "true" : "false") + '\n';
+  ret += formatNameForDump("send_batching") + (send_batching_ ? "true" : "false") + '\n';
+  ret += formatNameForDump("receive_batch_size") + to_dds_string(unsigned(receive_batch_size_)) + '\n';
+  ret += formatNameForDump("receive_threads") + to_dds_string(unsigned(receive_threads_)) + '\n';
+  ret += formatNameForDump("reorder_window") + to_dds_string(unsigned(reorder_window_)) + '\n';
+  ret += formatNameForDump("nak_multicast_threshold") + to_dds_string(unsigned(nak_multicast_threshold_)) + '\n';
+  ret += formatNameForDump("nak_suppression_duration") + nak_suppression_duration_.str() + '\n';
   return ret;
 }
 
@@ -50,6 +50,37 @@ public:
   bool responsive_mode_;
   TimeDuration send_delay_;
 
+  /// Send the bundles produced by one pass over the send queue with as few
+  /// system calls as possible (sendmmsg and UDP_SEGMENT, where available).
+  bool send_batching_;
+
+  /// Maximum number of datagrams read for each reactor wakeup using
+  /// recvmmsg.  Values less than 2 disable batched receiving.  Each
+  /// datagram gets its own preallocated receive buffer, so values above
+  /// MAX_RECEIVE_BATCH_SIZE are reduced to it.
+  size_t receive_batch_size_;
+  static const size_t MAX_RECEIVE_BATCH_SIZE = 64;
+
+  /// Number of threads used to deliver received samples to local readers.
+  /// Samples from the same writer are always delivered by the same thread.
+  /// Zero delivers samples on the thread that read them from the socket.
+  size_t receive_threads_;
+
+  /// Number of sequence numbers above the cumulative acknowledgement that
+  /// each reliable reader tracks, and holds samples for, in a circular
+  /// window for each remote writer.  Zero tracks them all in trees.
+  size_t reorder_window_;
+
+  /// Number of readers that must request the same sample within one
+  /// nak_response_delay for the sample to be resent once to their multicast
+  /// addresses instead of to each of them.  Zero uses multicast when more
+  /// than half of the associated readers requested it.
+  size_t nak_multicast_threshold_;
+
+  /// How long requests for a sample that was just resent to the requesting
+  /// reader's multicast address are ignored.  Zero never ignores them.
+  TimeDuration nak_suppression_duration_;
+
   virtual int load(ACE_Configuration_Heap& cf,
                    ACE_Configuration_Section_Key& sect);
 
@@ -31,7 +31,7 @@ namespace DCPS {
 RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link,
                                                const GuidPrefix_t& local_prefix,
                                                ThreadStatusManager& thread_status_manager)
-  : BaseReceiveStrategy(link->config(), BUFFER_COUNT)
+  : BaseReceiveStrategy(link->config(), receive_buffer_count(link))
   , link_(link)
   , last_received_()
   , recvd_sample_(0)
@@ -46,39 +46,98 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link,
   , encoded_submsg_(false)
 #endif
 {
-  // Since BUFFER_COUNT is 1, the index will always be 0
-  const size_t INDEX = 0;
+  for (size_t index = 0; index != receive_buffers_.size(); ++index) {
+    if (receive_buffers_[index] == 0) {
+      allocate_receive_buffer(index);
+    }
+  }
 
-  if (receive_buffers_[INDEX] == 0) {
-    ACE_NEW_MALLOC(
-      receive_buffers_[INDEX],
-      (ACE_Message_Block*) mb_allocator_.malloc(sizeof(ACE_Message_Block)),
-      ACE_Message_Block(
-        RECEIVE_DATA_BUFFER_SIZE,           // Buffer size
-        ACE_Message_Block::MB_DATA,         // Default
-        0,                                  // Start with no continuation
-        0,                                  // Let the constructor allocate
-        &data_allocator_,                   // Our buffer cache
-        &receive_lock_,                     // Our locking strategy
-        ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY, // Default
-        ACE_Time_Value::zero,               // Default
-        ACE_Time_Value::max_time,           // Default
-        &db_allocator_,                     // Our data block cache
-        &mb_allocator_                      // Our message block cache
-      ));
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  const size_t batch_size = receive_buffers_.size();
+  if (batch_size > 1) {
+    batch_headers_.resize(batch_size);
+    batch_iov_.resize(batch_size);
+    batch_addrs_.resize(batch_size);
+    batch_control_.resize(batch_size * BATCH_CONTROL_SIZE);
   }
+#endif
 
 #ifdef OPENDDS_SECURITY
   secure_prefix_.smHeader.submessageId = SUBMESSAGE_NONE;
 #endif
 }
 
+size_t
+RtpsUdpReceiveStrategy::receive_buffer_count(RtpsUdpDataLink* link)
+{
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  RtpsUdpInst_rch cfg = link->config();
+  if (cfg && cfg->receive_batch_size_ > BUFFER_COUNT) {
+    // The option can also be set through the API, bypassing load().
+    return cfg->receive_batch_size_ < RtpsUdpInst::MAX_RECEIVE_BATCH_SIZE ?
+      cfg->receive_batch_size_ : size_t(RtpsUdpInst::MAX_RECEIVE_BATCH_SIZE);
+  }
+#else
+  ACE_UNUSED_ARG(link);
+#endif
+  return BUFFER_COUNT;
+}
+
+bool
+RtpsUdpReceiveStrategy::allocate_receive_buffer(size_t index)
+{
+  ACE_NEW_MALLOC_RETURN(
+    receive_buffers_[index],
+    (ACE_Message_Block*) mb_allocator_.malloc(sizeof(ACE_Message_Block)),
+    ACE_Message_Block(
+      RECEIVE_DATA_BUFFER_SIZE,           // Buffer size
+      ACE_Message_Block::MB_DATA,         // Default
+      0,                                  // Start with no continuation
+      0,                                  // Let the constructor allocate
+      &data_allocator_,                   // Our buffer cache
+      &receive_lock_,                     // Our locking strategy
+      ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY, // Default
+      ACE_Time_Value::zero,               // Default
+      ACE_Time_Value::max_time,           // Default
+      &db_allocator_,                     // Our data block cache
+      &mb_allocator_                      // Our message block cache
+    ),
+    false);
+  return true;
+}
+
+bool
+RtpsUdpReceiveStrategy::release_receive_buffer_if_shared(size_t index)
+{
+  // If the buffer still has a reference count, we'll need to allocate a new one for the next read
+  if (receive_buffers_[index]->data_block()->reference_count() > 1) {
+
+    if (log_level >= LogLevel::Info) {
+      ACE_DEBUG((LM_INFO, "(%P|%t) INFO: RtpsUdpReceiveStrategy::handle_input: reallocating receive buffer %B based on reference count\n", index));
+    }
+
+    ACE_DES_FREE(
+      receive_buffers_[index],
+      mb_allocator_.free,
+      ACE_Message_Block);
+
+    return allocate_receive_buffer(index);
+  }
+  return true;
+}
+
 int
 RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 {
   ThreadStatusManager::Event ev(thread_status_manager_);
 
-  // Since BUFFER_COUNT is 1, the index will always be 0
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  if (receive_buffers_.size() > 1) {
+    return handle_input_batch(fd);
+  }
+#endif
+
+  // Without batching there is only one buffer so the index will always be 0
   const size_t INDEX = 0;
 
   ACE_Message_Block* const cur_rb = receive_buffers_[INDEX];
@@ -125,92 +184,181 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
     }
   }
 
+  {
+    const ScopedHeaderProcessing shp(*this);
+    process_message(*cur_rb, bytes_remaining, remote_address);
+  }
+
+  return release_receive_buffer_if_shared(INDEX) ? 0 : -1;
+}
+
+void
+RtpsUdpReceiveStrategy::process_message(ACE_Message_Block& cur_rb,
+                                        ssize_t bytes_remaining,
+                                        const ACE_INET_Addr& remote_address)
+{
   if (!pdu_remaining_) {
     receive_transport_header_.length_ = static_cast<ACE_UINT32>(bytes_remaining);
   }
 
-  receive_transport_header_ = *cur_rb;
+  receive_transport_header_ = cur_rb;
   if (!receive_transport_header_.valid()) {
-    cur_rb->reset();
+    cur_rb.reset();
     if (DCPS_debug_level > 0) {
       ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: RtpsUdpReceiveStrategy::handle_input: TransportHeader invalid.\n")));
     }
-    return 0;
+    return;
   }
 
   bytes_remaining = receive_transport_header_.length_;
   if (!check_header(receive_transport_header_)) {
-    return 0;
+    return;
   }
 
-  {
-    const ScopedHeaderProcessing shp(*this);
-    while (bytes_remaining > 0) {
-      data_sample_header_.pdu_remaining(bytes_remaining);
-      data_sample_header_ = *cur_rb;
-      bytes_remaining -= data_sample_header_.get_serialized_size();
-      if (!check_header(data_sample_header_)) {
-        return 0;
-      }
-      ReceivedDataSample rds = data_sample_header_.message_length() ? ReceivedDataSample(*cur_rb) : ReceivedDataSample();
-      if (data_sample_header_.into_received_data_sample(rds)) {
-
-        if (data_sample_header_.more_fragments() || receive_transport_header_.last_fragment()) {
-          VDBG((LM_DEBUG,"(%P|%t) DBG:   Attempt reassembly of fragments\n"));
+  while (bytes_remaining > 0) {
+    data_sample_header_.pdu_remaining(bytes_remaining);
+    data_sample_header_ = cur_rb;
+    bytes_remaining -= data_sample_header_.get_serialized_size();
+    if (!check_header(data_sample_header_)) {
+      return;
+    }
+    ReceivedDataSample rds = data_sample_header_.message_length() ? ReceivedDataSample(cur_rb) : ReceivedDataSample();
+    if (data_sample_header_.into_received_data_sample(rds)) {
 
-          if (reassemble(rds)) {
-            VDBG((LM_DEBUG,"(%P|%t) DBG:   Reassembled complete message\n"));
-            deliver_sample(rds, remote_address);
-          }
-          // If reassemble() returned false, it takes ownership of the data
-          // just like deliver_sample() does.
+      if (data_sample_header_.more_fragments() || receive_transport_header_.last_fragment()) {
+        VDBG((LM_DEBUG,"(%P|%t) DBG:   Attempt reassembly of fragments\n"));
 
-        } else {
+        if (reassemble(rds)) {
+          VDBG((LM_DEBUG,"(%P|%t) DBG:   Reassembled complete message\n"));
           deliver_sample(rds, remote_address);
         }
+        // If reassemble() returned false, it takes ownership of the data
+        // just like deliver_sample() does.
+
+      } else {
+        deliver_sample(rds, remote_address);
       }
-      cur_rb->rd_ptr(data_sample_header_.message_length());
-      bytes_remaining -= data_sample_header_.message_length();
+    }
+    cur_rb.rd_ptr(data_sample_header_.message_length());
+    bytes_remaining -= data_sample_header_.message_length();
+
+    // For the reassembly algorithm, the 'last_fragment_' header bit only
+    // applies to the first DataSampleHeader in the TransportHeader
+    receive_transport_header_.last_fragment(false);
+  }
+}
 
-      // For the reassembly algorithm, the 'last_fragment_' header bit only
-      // applies to the first DataSampleHeader in the TransportHeader
-      receive_transport_header_.last_fragment(false);
+#ifdef OPENDDS_RTPS_UDP_MMSG
+namespace {
+  ACE_INET_Addr local_address_from_control(const msghdr& hdr)
+  {
+    ACE_INET_Addr local_address;
+    for (cmsghdr* cm = CMSG_FIRSTHDR(&hdr); cm; cm = CMSG_NXTHDR(const_cast<msghdr*>(&hdr), cm)) {
+#ifdef ACE_RECVPKTINFO
+      if (cm->cmsg_level == IPPROTO_IP && cm->cmsg_type == ACE_RECVPKTINFO) {
+        in_pktinfo pktinfo;
+        std::memcpy(&pktinfo, CMSG_DATA(cm), sizeof pktinfo);
+        local_address.set(u_short(0), ACE_NTOHL(pktinfo.ipi_addr.s_addr));
+      }
+#endif
+#if defined ACE_HAS_IPV6 && defined ACE_RECVPKTINFO6
+      if (cm->cmsg_level == IPPROTO_IPV6 && cm->cmsg_type == IPV6_PKTINFO) {
+        in6_pktinfo pktinfo;
+        std::memcpy(&pktinfo, CMSG_DATA(cm), sizeof pktinfo);
+        local_address.set_address(reinterpret_cast<const char*>(&pktinfo.ipi6_addr), sizeof pktinfo.ipi6_addr, 0);
+      }
+#endif
     }
+    return local_address;
   }
+}
 
-  // If newly selected buffer index still has a reference count, we'll need to allocate a new one for the read
-  if (receive_buffers_[INDEX]->data_block()->reference_count() > 1) {
+int
+RtpsUdpReceiveStrategy::handle_input_batch(ACE_HANDLE fd)
+{
+  const size_t batch_size = receive_buffers_.size();
+  for (size_t idx = 0; idx != batch_size; ++idx) {
+    ACE_Message_Block* const rb = receive_buffers_[idx];
+    rb->reset();
+    batch_iov_[idx].iov_base = rb->wr_ptr();
+    batch_iov_[idx].iov_len = rb->space();
+    mmsghdr& mh = batch_headers_[idx];
+    std::memset(&mh, 0, sizeof mh);
+    mh.msg_hdr.msg_name = &batch_addrs_[idx];
+    mh.msg_hdr.msg_namelen = sizeof batch_addrs_[idx];
+    mh.msg_hdr.msg_iov = &batch_iov_[idx];
+    mh.msg_hdr.msg_iovlen = 1;
+    mh.msg_hdr.msg_control = &batch_control_[idx * BATCH_CONTROL_SIZE];
+    mh.msg_hdr.msg_controllen = BATCH_CONTROL_SIZE;
+  }
 
-    if (log_level >= LogLevel::Info) {
-      ACE_DEBUG((LM_INFO, "(%P|%t) INFO: RtpsUdpReceiveStrategy::handle_input: reallocating primary receive buffer based on reference count\n"));
+  const int received = ::recvmmsg(fd, &batch_headers_[0], static_cast<unsigned int>(batch_size), MSG_DONTWAIT, 0);
+  if (received < 0) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR) {
+      return 0;
     }
+    relink();
+    return -1;
+  }
 
-    ACE_DES_FREE(
-      receive_buffers_[INDEX],
-      mb_allocator_.free,
-      ACE_Message_Block);
+  RtpsUdpTransport_rch transport = link_->transport();
+  if (!transport) {
+    return 0;
+  }
 
-    ACE_NEW_MALLOC_RETURN(
-      receive_buffers_[INDEX],
-      (ACE_Message_Block*) mb_allocator_.malloc(sizeof(ACE_Message_Block)),
-      ACE_Message_Block(
-        RECEIVE_DATA_BUFFER_SIZE,           // Buffer size
-        ACE_Message_Block::MB_DATA,         // Default
-        0,                                  // Start with no continuation
-        0,                                  // Let the constructor allocate
-        &data_allocator_,                   // Our buffer cache
-        &receive_lock_,                     // Our locking strategy
-        ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY, // Default
-        ACE_Time_Value::zero,               // Default
-        ACE_Time_Value::max_time,           // Default
-        &db_allocator_,                     // Our data block cache
-        &mb_allocator_                      // Our message block cache
-      ),
-      -1);
+  if (received > 1 && transport->transport_statistics_.count_messages()) {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, g, transport->transport_statistics_mutex_, -1);
+    transport->transport_statistics_.recv_syscalls_saved += static_cast<CORBA::ULong>(received - 1);
+  }
+
+  {
+    // Responses generated by all datagrams in the batch are sent together,
+    // and each reader gets the samples it receives from a writer in one
+    // dispatch.
+    const ScopedHeaderProcessing shp(*this);
+    link_->begin_receive_batch();
+
+    for (int idx = 0; idx < received; ++idx) {
+      const msghdr& hdr = batch_headers_[idx].msg_hdr;
+      ACE_INET_Addr remote_address;
+      remote_address.set_addr(&batch_addrs_[idx], hdr.msg_namelen);
+      const ACE_INET_Addr local_address = local_address_from_control(hdr);
+
+      bool stop = false;
+      ssize_t bytes = process_received_bytes(&batch_iov_[idx], 1, static_cast<ssize_t>(batch_headers_[idx].msg_len),
+                                             remote_address, local_address,
+#ifdef OPENDDS_SECURITY
+                                             link_->get_ice_agent(), link_->get_ice_endpoint(),
+#endif
+                                             *transport, stop);
+      if (stop || bytes <= 0) {
+        continue;
+      }
+
+      remote_address_ = remote_address;
+      bytes = decode_received_bytes(&batch_iov_[idx], 1, bytes, remote_address, stop);
+      if (stop || bytes <= 0) {
+        continue;
+      }
+
+      ACE_Message_Block& rb = *receive_buffers_[idx];
+      rb.wr_ptr(bytes);
+      process_message(rb, bytes, remote_address);
+    }
+
+    // Before the receive buffers the samples were read into are reused.
+    link_->end_receive_batch();
+  }
+
+  for (int idx = 0; idx < received; ++idx) {
+    if (!release_receive_buffer_if_shared(idx)) {
+      return -1;
+    }
   }
 
   return 0;
 }
+#endif
 
 ssize_t
 RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
@@ -235,6 +383,26 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
     return ret;
   }
 
+  return process_received_bytes(iov, n, ret, remote_address, local_address,
+#ifdef OPENDDS_SECURITY
+                                ice_agent, endpoint,
+#endif
+                                tport, stop);
+}
+
+ssize_t
+RtpsUdpReceiveStrategy::process_received_bytes(iovec iov[],
+                                               int n,
+                                               ssize_t ret,
+                                               const ACE_INET_Addr& remote_address,
+                                               const ACE_INET_Addr& local_address,
+#ifdef OPENDDS_SECURITY
+                                               DCPS::RcHandle<ICE::Agent> ice_agent,
+                                               DCPS::WeakRcHandle<ICE::Endpoint> endpoint,
+#endif
+                                               RtpsUdpTransport& tport,
+                                               bool& stop)
+{
   if (remote_address.get_size() > remote_address.get_addr_size()) {
     ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RtpsUdpReceiveStrategy::receive_bytes_helper - invalid address size\n"));
     return 0;
@@ -257,6 +425,9 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
   ACE_ERROR((LM_ERROR, "ERROR: RtpsUdpReceiveStrategy::receive_bytes_helper potential STUN message "
              "received but this version of the ACE library doesn't support the local_address "
              "extension in ACE_SOCK_Dgram::recv\n"));
+  ACE_UNUSED_ARG(local_address);
+  ACE_UNUSED_ARG(ice_agent);
+  ACE_UNUSED_ARG(endpoint);
   ACE_UNUSED_ARG(stop);
   ACE_NOTSUP_RETURN(-1);
 # else
@@ -301,6 +472,7 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
   head->release();
 # endif
 #else
+  ACE_UNUSED_ARG(local_address);
   ACE_UNUSED_ARG(stop);
 #endif
 
@@ -369,11 +541,22 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
 #endif
   remote_address_ = remote_address;
 
-#ifdef OPENDDS_SECURITY
   if (stop) {
     return ret;
   }
 
+  return decode_received_bytes(iov, n, ret, remote_address, stop);
+}
+
+ssize_t
+RtpsUdpReceiveStrategy::decode_received_bytes(iovec iov[],
+                                              int n,
+                                              ssize_t ret,
+                                              const ACE_INET_Addr& remote_address,
+                                              bool& stop)
+{
+#ifdef OPENDDS_SECURITY
+
   using namespace DDS::Security;
   const ParticipantCryptoHandle receiver = link_->local_crypto_handle();
   if (ret > 0 && receiver != DDS::HANDLE_NIL) {
@@ -467,6 +650,11 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
     encoded_rtps_ = true;
     return plainLen;
   }
+#else
+  ACE_UNUSED_ARG(iov);
+  ACE_UNUSED_ARG(n);
+  ACE_UNUSED_ARG(remote_address);
+  ACE_UNUSED_ARG(stop);
 #endif
 
   return ret;
@@ -611,7 +799,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
             ACE_TEXT("calling DataLink::data_received for seq: %q to reader %C\n"),
             this, sample.header_.sequence_.getValue(), LogGuid(reader).c_str()));
         }
-        link_->data_received(sample, reader);
+        link_->dispatch_data_received(sample, reader);
       }
     } else {
       if (Transport_debug_level > 5) {
@@ -644,14 +832,14 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
               ACE_TEXT("calling DataLink::data_received for seq: %q TO ALL, no exclusion or inclusion\n"),
               this, sample.header_.sequence_.getValue()));
           }
-          link_->data_received(sample);
+          link_->dispatch_data_received(sample);
         } else {
           if (Transport_debug_level > 5) {
             ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpReceiveStrategy[%@]::deliver_sample_i - ")
               ACE_TEXT("calling DataLink::data_received_include for seq: %q to directedWriteReaders\n"),
               this, sample.header_.sequence_.getValue()));
           }
-          link_->data_received_include(sample, directedWriteReaders);
+          link_->dispatch_data_received_include(sample, directedWriteReaders);
         }
      } else {
         if (directedWriteReaders.empty()) {
@@ -660,7 +848,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
               ACE_TEXT("calling DataLink::data_received_include for seq: %q to readers_selected_\n"),
               this, sample.header_.sequence_.getValue()));
           }
-          link_->data_received_include(sample, readers_selected_);
+          link_->dispatch_data_received_include(sample, readers_selected_);
         } else {
           if (Transport_debug_level > 5) {
             ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpReceiveStrategy[%@]::deliver_sample_i - ")
@@ -668,7 +856,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
               this, sample.header_.sequence_.getValue()));
           }
           set_intersect(directedWriteReaders, readers_selected_, GUID_tKeyLessThan());
-          link_->data_received_include(sample, directedWriteReaders);
+          link_->dispatch_data_received_include(sample, directedWriteReaders);
         }
       }
     }
@@ -697,7 +885,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
       sample.header_.message_id_ = DATAWRITER_LIVELINESS;
       receiver_.fill_header(sample.header_);
       sample.header_.publication_id_.entityId = submessage.heartbeat_sm().writerId;
-      link_->data_received(sample);
+      link_->dispatch_data_received(sample);
     }
     break;
 
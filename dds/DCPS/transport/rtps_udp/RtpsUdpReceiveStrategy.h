@@ -11,6 +11,7 @@
 #include "Rtps_Udp_Export.h"
 #include "RtpsTransportHeader.h"
 #include "RtpsSampleHeader.h"
+#include "RtpsUdpSendStrategy.h"
 
 #include "dds/DCPS/transport/framework/TransportReceiveStrategy_T.h"
 
@@ -85,10 +86,52 @@ public:
                                       RtpsUdpTransport& tport,
                                       bool& stop);
 
+  /// The part of receive_bytes_helper() that runs after the datagram has
+  /// been read: counts RTPS messages and hands STUN messages to ICE.
+  static ssize_t process_received_bytes(iovec iov[],
+                                        int n,
+                                        ssize_t ret,
+                                        const ACE_INET_Addr& remote_address,
+                                        const ACE_INET_Addr& local_address,
+#ifdef OPENDDS_SECURITY
+                                        DCPS::RcHandle<ICE::Agent> agent,
+                                        DCPS::WeakRcHandle<ICE::Endpoint> endpoint,
+#endif
+                                        RtpsUdpTransport& tport,
+                                        bool& stop);
+
   virtual void begin_transport_header_processing();
   virtual void end_transport_header_processing();
 
 private:
+  static size_t receive_buffer_count(RtpsUdpDataLink* link);
+  bool allocate_receive_buffer(size_t index);
+  bool release_receive_buffer_if_shared(size_t index);
+
+  /// Parse the RTPS message in cur_rb and deliver its submessages.
+  void process_message(ACE_Message_Block& cur_rb,
+                       ssize_t bytes_remaining,
+                       const ACE_INET_Addr& remote_address);
+
+  /// Decode a received message protected with RTPS message protection.
+  ssize_t decode_received_bytes(iovec iov[],
+                                int n,
+                                ssize_t ret,
+                                const ACE_INET_Addr& remote_address,
+                                bool& stop);
+
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  /// Read up to receive_buffers_.size() datagrams with one recvmmsg call,
+  /// one datagram per receive buffer.
+  int handle_input_batch(ACE_HANDLE fd);
+
+  static const size_t BATCH_CONTROL_SIZE = 128;
+  OPENDDS_VECTOR(mmsghdr) batch_headers_;
+  OPENDDS_VECTOR(iovec) batch_iov_;
+  OPENDDS_VECTOR(sockaddr_storage) batch_addrs_;
+  OPENDDS_VECTOR(char) batch_control_;
+#endif
+
   bool getDirectedWriteReaders(RepoIdSet& directedWriteReaders, const RTPS::DataSubmessage& ds) const;
 
   const ACE_SOCK_Dgram& choose_recv_socket(ACE_HANDLE fd) const;
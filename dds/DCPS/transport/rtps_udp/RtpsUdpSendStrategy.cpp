@@ -22,6 +22,10 @@
 
 #include <cstring>
 
+#ifdef OPENDDS_RTPS_UDP_MMSG
+#  include <netinet/udp.h>
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -45,6 +49,9 @@ RtpsUdpSendStrategy::RtpsUdpSendStrategy(RtpsUdpDataLink* link,
                     rtps_header_data_, 0, 0, ACE_Message_Block::DONT_DELETE, 0),
     rtps_header_mb_(&rtps_header_db_, ACE_Message_Block::DONT_DELETE),
     network_is_unreachable_(false)
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  , gso_unsupported_(false)
+#endif
 {
   std::memcpy(rtps_message_.hdr.prefix, RTPS::PROTOCOL_RTPS, sizeof RTPS::PROTOCOL_RTPS);
   rtps_message_.hdr.version = OpenDDS::RTPS::PROTOCOLVERSION;
@@ -246,6 +253,295 @@ RtpsUdpSendStrategy::append_submessages(const RTPS::SubmessageSeq& submessages)
   }
 }
 
+void
+RtpsUdpSendStrategy::queue_rtps_control(RTPS::Message& message,
+                                        ACE_Message_Block& submessages,
+                                        const AddrSet& addrs,
+                                        Batch& batch)
+{
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, rtps_message_mutex_);
+    message.hdr = rtps_message_.hdr;
+  }
+
+  // The header block refers to rtps_header_data_ which doesn't change after
+  // construction, so the batch can hold on to it without a copy.
+  Message_Block_Ptr plain(new ACE_Message_Block(rtps_header_data_, RTPS::RTPSHDR_SZ));
+  plain->wr_ptr(RTPS::RTPSHDR_SZ);
+  plain->cont(submessages.duplicate());
+
+#ifdef OPENDDS_SECURITY
+  if (security_config()) {
+    const DDS::Security::CryptoTransform_var crypto = link_->security_config()->get_crypto_transform();
+    if (crypto) {
+      plain.reset(pre_send_packet(plain.get()));
+      if (!plain) {
+        VDBG((LM_DEBUG, "(%P|%t) RtpsUdpSendStrategy::queue_rtps_control () - "
+              "pre_send_packet returned NULL, dropping.\n"));
+        return;
+      }
+    }
+  }
+#endif
+
+  batch.resize(batch.size() + 1);
+  batch.back().message_ = Message_Block_Shared_Ptr(plain.release());
+  batch.back().destinations_ = addrs;
+}
+
+void
+RtpsUdpSendStrategy::send_batch(Batch& batch)
+{
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  bool use_mmsg = true;
+# ifdef OPENDDS_TESTING_FEATURES
+  {
+    // The MessageDropper decides per datagram, so let send_single_i handle it.
+    RtpsUdpTransport_rch transport = link_->transport();
+    use_mmsg = transport && !transport->message_dropper().drop_messages();
+  }
+# endif
+
+  if (use_mmsg) {
+    BatchDestMap ipv4_dests;
+# ifdef ACE_HAS_IPV6
+    BatchDestMap ipv6_dests;
+# endif
+    for (size_t idx = 0; idx != batch.size(); ++idx) {
+      const AddrSet& addrs = batch[idx].destinations_;
+      for (AddrSet::const_iterator pos = addrs.begin(), limit = addrs.end(); pos != limit; ++pos) {
+        if (!*pos) {
+          continue;
+        }
+# ifdef ACE_HAS_IPV6
+        if (pos->get_type() == AF_INET6) {
+          ipv6_dests[*pos].push_back(idx);
+          continue;
+        }
+# endif
+        ipv4_dests[*pos].push_back(idx);
+      }
+    }
+
+    send_batch_i(batch, link_->unicast_socket(), ipv4_dests);
+# ifdef ACE_HAS_IPV6
+    send_batch_i(batch, link_->ipv6_unicast_socket(), ipv6_dests);
+# endif
+    batch.clear();
+    return;
+  }
+#endif
+
+  for (Batch::const_iterator pos = batch.begin(), limit = batch.end(); pos != limit; ++pos) {
+    iovec iov[MAX_SEND_BLOCKS];
+    const int num_blocks = mb_to_iov(*pos->message_, iov);
+    const ssize_t result = send_multi_i(iov, num_blocks, pos->destinations_);
+    if (result < 0 && !network_is_unreachable_) {
+      const ACE_Log_Priority prio = shouldWarn(errno) ? LM_WARNING : LM_ERROR;
+      ACE_ERROR((prio, "(%P|%t) RtpsUdpSendStrategy::send_batch() - "
+        "failed to send RTPS control message\n"));
+    }
+  }
+  batch.clear();
+}
+
+void
+RtpsUdpSendStrategy::coalesce_batch(const OPENDDS_VECTOR(size_t)& bytes,
+                                    const OPENDDS_VECTOR(size_t)& blocks,
+                                    bool gso,
+                                    BatchSendVec& sends)
+{
+  for (size_t i = 0; i < bytes.size();) {
+    BatchSend send = { i, 1, 0 };
+    if (gso) {
+      const size_t segment = bytes[i];
+      size_t total = bytes[i];
+      size_t total_blocks = blocks[i];
+      while (i + send.count_ < bytes.size() && send.count_ < MAX_GSO_SEGMENTS) {
+        const size_t next = i + send.count_;
+        if (bytes[next] > segment || total + bytes[next] > UDP_MAX_MESSAGE_SIZE ||
+            total_blocks + blocks[next] > MAX_SEND_BLOCKS) {
+          break;
+        }
+        total += bytes[next];
+        total_blocks += blocks[next];
+        ++send.count_;
+        if (bytes[next] < segment) {
+          break;
+        }
+      }
+      if (send.count_ > 1) {
+        send.segment_size_ = segment;
+      }
+    }
+    sends.push_back(send);
+    i += send.count_;
+  }
+}
+
+#ifdef OPENDDS_RTPS_UDP_MMSG
+namespace {
+  /// One BatchSend to one destination handed to sendmmsg.
+  struct BatchEntry {
+    const NetworkAddress* addr_;
+    const OPENDDS_VECTOR(size_t)* messages_;
+    size_t first_;
+    size_t count_;
+    size_t segment_size_;
+    size_t iov_first_;
+    size_t iov_count_;
+  };
+}
+
+void
+RtpsUdpSendStrategy::send_batch_i(const Batch& batch,
+                                  const ACE_SOCK_Dgram& socket,
+                                  const BatchDestMap& by_dest)
+{
+  if (by_dest.empty()) {
+    return;
+  }
+
+  RtpsUdpTransport_rch transport = link_->transport();
+  if (!transport) {
+    return;
+  }
+
+  RtpsUdpInst_rch cfg = transport->config();
+  if (!cfg) {
+    return;
+  }
+
+  // Convert each message to iovecs once, no matter how many destinations.
+  OPENDDS_VECTOR(iovec) msg_iov;
+  OPENDDS_VECTOR(size_t) msg_iov_first(batch.size() + 1);
+  OPENDDS_VECTOR(size_t) msg_bytes(batch.size());
+  for (size_t idx = 0; idx != batch.size(); ++idx) {
+    iovec iov[MAX_SEND_BLOCKS];
+    const int num_blocks = mb_to_iov(*batch[idx].message_, iov);
+    msg_iov_first[idx] = msg_iov.size();
+    msg_bytes[idx] = 0;
+    for (int i = 0; i < num_blocks; ++i) {
+      msg_iov.push_back(iov[i]);
+      msg_bytes[idx] += iov[i].iov_len;
+    }
+  }
+  msg_iov_first[batch.size()] = msg_iov.size();
+
+#ifdef UDP_SEGMENT
+  const bool use_gso = !gso_unsupported_;
+#else
+  const bool use_gso = false;
+#endif
+
+  OPENDDS_VECTOR(BatchEntry) entries;
+  OPENDDS_VECTOR(iovec) iov;
+  OPENDDS_VECTOR(size_t) dest_bytes;
+  OPENDDS_VECTOR(size_t) dest_blocks;
+  BatchSendVec sends;
+  size_t datagrams = 0;
+  for (BatchDestMap::const_iterator dest = by_dest.begin(), limit = by_dest.end(); dest != limit; ++dest) {
+    const BatchIndexVec& messages = dest->second;
+    datagrams += messages.size();
+
+    dest_bytes.clear();
+    dest_blocks.clear();
+    for (size_t i = 0; i != messages.size(); ++i) {
+      dest_bytes.push_back(msg_bytes[messages[i]]);
+      dest_blocks.push_back(msg_iov_first[messages[i] + 1] - msg_iov_first[messages[i]]);
+    }
+    sends.clear();
+    coalesce_batch(dest_bytes, dest_blocks, use_gso, sends);
+
+    for (size_t s = 0; s != sends.size(); ++s) {
+      BatchEntry entry = { &dest->first, &messages, sends[s].first_, sends[s].count_,
+                           sends[s].segment_size_, iov.size(), 0 };
+      for (size_t j = entry.first_; j != entry.first_ + entry.count_; ++j) {
+        const size_t msg = messages[j];
+        iov.insert(iov.end(), msg_iov.begin() + msg_iov_first[msg], msg_iov.begin() + msg_iov_first[msg + 1]);
+      }
+      entry.iov_count_ = iov.size() - entry.iov_first_;
+      entries.push_back(entry);
+    }
+  }
+
+  OPENDDS_VECTOR(ACE_INET_Addr) addrs(entries.size());
+  OPENDDS_VECTOR(mmsghdr) headers(entries.size());
+#ifdef UDP_SEGMENT
+  const size_t cmsg_space = CMSG_SPACE(sizeof(ACE_UINT16));
+  OPENDDS_VECTOR(char) control(entries.size() * cmsg_space);
+#endif
+  for (size_t idx = 0; idx != entries.size(); ++idx) {
+    const BatchEntry& entry = entries[idx];
+    entry.addr_->to_addr(addrs[idx]);
+    msghdr& hdr = headers[idx].msg_hdr;
+    std::memset(&headers[idx], 0, sizeof headers[idx]);
+    hdr.msg_name = addrs[idx].get_addr();
+    hdr.msg_namelen = addrs[idx].get_size();
+    hdr.msg_iov = &iov[entry.iov_first_];
+    hdr.msg_iovlen = entry.iov_count_;
+#ifdef UDP_SEGMENT
+    if (entry.segment_size_) {
+      hdr.msg_control = &control[idx * cmsg_space];
+      hdr.msg_controllen = cmsg_space;
+      cmsghdr* const cm = CMSG_FIRSTHDR(&hdr);
+      cm->cmsg_level = SOL_UDP;
+      cm->cmsg_type = UDP_SEGMENT;
+      cm->cmsg_len = CMSG_LEN(sizeof(ACE_UINT16));
+      const ACE_UINT16 segment_size = static_cast<ACE_UINT16>(entry.segment_size_);
+      std::memcpy(CMSG_DATA(cm), &segment_size, sizeof segment_size);
+    }
+#endif
+  }
+
+  size_t syscalls = 0;
+  for (size_t pos = 0; pos < entries.size();) {
+    const int sent = ::sendmmsg(socket.get_handle(), &headers[pos],
+                                static_cast<unsigned int>(entries.size() - pos), 0);
+    ++syscalls;
+    if (sent > 0) {
+      if (transport->transport_statistics_.count_messages()) {
+        const NetworkAddress relay(cfg->rtps_relay_address());
+        ACE_GUARD(ACE_Thread_Mutex, g, transport->transport_statistics_mutex_);
+        for (size_t idx = pos; idx != pos + sent; ++idx) {
+          const BatchEntry& entry = entries[idx];
+          const InternalMessageCountKey key(*entry.addr_, MCK_RTPS, *entry.addr_ == relay);
+          for (size_t j = entry.first_; j != entry.first_ + entry.count_; ++j) {
+            transport->transport_statistics_.message_count[key].send(msg_bytes[(*entry.messages_)[j]]);
+          }
+        }
+      }
+      network_is_unreachable_ = false;
+      pos += sent;
+      continue;
+    }
+
+#ifdef UDP_SEGMENT
+    if (entries[pos].segment_size_ && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT)) {
+      // No GSO for this socket or device, don't try again.
+      gso_unsupported_ = true;
+    }
+#endif
+
+    // Fall back to one send per datagram for the entry that failed.  This also
+    // takes care of logging and counting the failure.
+    const BatchEntry& entry = entries[pos];
+    for (size_t j = entry.first_; j != entry.first_ + entry.count_; ++j) {
+      const size_t msg = (*entry.messages_)[j];
+      send_single_i(&msg_iov[msg_iov_first[msg]],
+                    static_cast<int>(msg_iov_first[msg + 1] - msg_iov_first[msg]), *entry.addr_);
+      ++syscalls;
+    }
+    ++pos;
+  }
+
+  if (datagrams > syscalls && transport->transport_statistics_.count_messages()) {
+    ACE_GUARD(ACE_Thread_Mutex, g, transport->transport_statistics_mutex_);
+    transport->transport_statistics_.send_syscalls_saved += static_cast<CORBA::ULong>(datagrams - syscalls);
+  }
+}
+#endif
+
 ssize_t
 RtpsUdpSendStrategy::send_multi_i(const iovec iov[], int n,
                                   const AddrSet& addrs)
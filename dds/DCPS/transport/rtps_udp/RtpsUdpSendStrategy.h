@@ -11,6 +11,7 @@
 
 #include <dds/DCPS/NetworkAddress.h>
 #include <dds/DCPS/AtomicBool.h>
+#include <dds/DCPS/Message_Block_Ptr.h>
 #include <dds/DCPS/transport/framework/TransportSendStrategy.h>
 #include <dds/DCPS/RTPS/MessageTypes.h>
 
@@ -20,6 +21,10 @@
 
 #include <ace/SOCK_Dgram.h>
 
+#if defined ACE_LINUX && defined MSG_WAITFORONE && !defined OPENDDS_SAFETY_PROFILE
+#  define OPENDDS_RTPS_UDP_MMSG
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -54,6 +59,48 @@ public:
                          const AddrSet& destinations);
   void append_submessages(const RTPS::SubmessageSeq& submessages);
 
+  /// A complete RTPS message (header and submessages) waiting to be sent
+  /// as part of a Batch.
+  struct BatchMessage {
+    Message_Block_Shared_Ptr message_;
+    AddrSet destinations_;
+  };
+  typedef OPENDDS_VECTOR(BatchMessage) Batch;
+
+  /// Like send_rtps_control() but the message is appended to the batch
+  /// instead of being sent.  Secure messages are encoded here.
+  void queue_rtps_control(RTPS::Message& message,
+                          ACE_Message_Block& submessages,
+                          const AddrSet& destinations,
+                          Batch& batch);
+
+  /// Send and clear the batch.  When the platform supports it, messages for
+  /// the same destination are coalesced into one datagram with
+  /// UDP_SEGMENT and all datagrams are handed to the kernel with sendmmsg.
+  void send_batch(Batch& batch);
+
+  /// A run of consecutive messages to one destination that is handed to
+  /// the kernel as one message: a single datagram, or when segment_size_
+  /// isn't zero, a UDP_SEGMENT send the kernel splits into count_ datagrams.
+  struct BatchSend {
+    size_t first_;
+    size_t count_;
+    size_t segment_size_;
+  };
+  typedef OPENDDS_VECTOR(BatchSend) BatchSendVec;
+
+  /// The kernel's limit on the number of segments in one UDP_SEGMENT send.
+  static const size_t MAX_GSO_SEGMENTS = 64;
+
+  /// Group the messages to one destination, given by their sizes in bytes
+  /// and in blocks, into sends.  Only the last message of a UDP_SEGMENT
+  /// send may be shorter than the first.  Without 'gso' every message is
+  /// sent by itself.
+  static void coalesce_batch(const OPENDDS_VECTOR(size_t)& bytes,
+                             const OPENDDS_VECTOR(size_t)& blocks,
+                             bool gso,
+                             BatchSendVec& sends);
+
 #if defined(OPENDDS_SECURITY)
   void encode_payload(const GUID_t& pub_id, Message_Block_Ptr& payload,
                       RTPS::SubmessageSeq& submessages);
@@ -96,6 +143,13 @@ private:
   ssize_t send_single_i(const iovec iov[], int n,
                         const NetworkAddress& addr);
 
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  typedef OPENDDS_VECTOR(size_t) BatchIndexVec;
+  typedef OPENDDS_MAP(NetworkAddress, BatchIndexVec) BatchDestMap;
+  void send_batch_i(const Batch& batch, const ACE_SOCK_Dgram& socket,
+                    const BatchDestMap& by_dest);
+#endif
+
 #ifdef OPENDDS_SECURITY
   ACE_Message_Block* pre_send_packet(const ACE_Message_Block* plain);
 
@@ -144,6 +198,9 @@ private:
   ACE_Message_Block rtps_header_mb_;
   ACE_Thread_Mutex rtps_header_mb_lock_;
   AtomicBool network_is_unreachable_;
+#ifdef OPENDDS_RTPS_UDP_MMSG
+  AtomicBool gso_unsupported_;
+#endif
 };
 
 } // namespace DCPS
@@ -38,7 +38,6 @@ ShmemDataLink::ShmemDataLink(const RcHandle<ShmemTransport>& transport)
              false) // is_active
   , send_strategy_(make_rch<ShmemSendStrategy>(this))
   , recv_strategy_(make_rch<ShmemReceiveStrategy>(this))
-  , peer_alloc_(0)
   , reactor_task_(transport->reactor_task())
 {
 }
@@ -71,13 +70,13 @@ ShmemDataLink::open(const std::string& peer_address)
   CloseHandle(fm);
 #endif
 
-  peer_alloc_ = new ShmemAllocator(name.c_str(), 0 /*lock_name*/
+  peer_pool_ = make_rch<ShmemPeerPool>(new ShmemAllocator(name.c_str(), 0 /*lock_name*/
 #ifdef OPENDDS_SHMEM_WINDOWS
     , &alloc_opts
 #endif
-    );
+    ));
 
-  if (-1 == peer_alloc_->find("Semaphore")) {
+  if (-1 == peer_pool_->alloc()->find("Semaphore")) {
     stop_i();
     ACE_ERROR_RETURN((LM_ERROR,
                       ACE_TEXT("(%P|%t) ERROR: ShmemDataLink::open: ")
@@ -219,6 +218,14 @@ ShmemDataLink::control_received(ReceivedDataSample& /*sample*/)
 {
 }
 
+void
+ShmemDataLink::pre_stop_i()
+{
+  DataLink::pre_stop_i();
+  // The send strategy's thread may be waiting for space in a ring.
+  send_strategy_->stop_waiting();
+}
+
 void
 ShmemDataLink::stop_i()
 {
@@ -231,18 +238,10 @@ ShmemDataLink::stop_i()
   }
 
   {
-    ACE_GUARD(ACE_Thread_Mutex, g, peer_alloc_mutex_);
-    if (peer_alloc_) {
-      // Calling release() has to be done with argument 1 (close),
-      // because with 1 ACE_Malloc_T will call release on the underlying
-      // shared memory pool
-      if (peer_alloc_->release(1 /*close*/) == -1) {
-        VDBG_LVL((LM_ERROR,
-                  "(%P|%t) ShmemDataLink::stop_i Release shared memory failed\n"), 1);
-      }
-      delete peer_alloc_;
-      peer_alloc_ = 0;
-    }
+    // The pool stays mapped while samples received over a ring still refer
+    // to it, see ShmemPeerPool.
+    ACE_GUARD(ACE_Thread_Mutex, g, peer_pool_mutex_);
+    peer_pool_.reset();
   }
 }
 
@@ -255,8 +254,15 @@ ShmemDataLink::transport() const
 ShmemAllocator*
 ShmemDataLink::peer_allocator()
 {
-  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, peer_alloc_mutex_, 0);
-  return peer_alloc_;
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, peer_pool_mutex_, 0);
+  return peer_pool_ ? peer_pool_->alloc() : 0;
+}
+
+ShmemPeerPool_rch
+ShmemDataLink::peer_pool()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, peer_pool_mutex_, ShmemPeerPool_rch());
+  return peer_pool_;
 }
 
 ShmemAllocator*
@@ -8,6 +8,7 @@
 
 #include "Shmem_Export.h"
 #include "ShmemAllocator.h"
+#include "ShmemPeerPool.h"
 #include "ShmemReceiveStrategy.h"
 #include "ShmemReceiveStrategy_rch.h"
 #include "ShmemSendStrategy.h"
@@ -70,8 +71,11 @@ public:
 
   ShmemAllocator* local_allocator();
   ShmemAllocator* peer_allocator();
+  /// Null once the link is stopped.
+  ShmemPeerPool_rch peer_pool();
 
-  void read() { recv_strategy_->read(); }
+  bool read() { return recv_strategy_->read(); }
+  ShmemSendStrategy_rch send_strategy() const { return send_strategy_; }
   void signal_semaphore();
   ShmemTransport_rch transport() const;
   ShmemInst_rch config() const;
@@ -80,6 +84,7 @@ protected:
   ShmemSendStrategy_rch send_strategy_;
   ShmemReceiveStrategy_rch recv_strategy_;
 
+  virtual void pre_stop_i();
   virtual void stop_i();
 
 private:
@@ -87,8 +92,8 @@ private:
   void resend_association_msgs(const MonotonicTimePoint& now);
 
   std::string peer_address_;
-  ShmemAllocator* peer_alloc_;
-  ACE_Thread_Mutex peer_alloc_mutex_;
+  ShmemPeerPool_rch peer_pool_;
+  ACE_Thread_Mutex peer_pool_mutex_;
   ReactorTask_rch reactor_task_;
 
   ACE_Thread_Mutex assoc_resends_mutex_;
@@ -25,6 +25,8 @@ ShmemInst::ShmemInst(const std::string& name)
   : TransportInst("shmem", name)
   , pool_size_(16 * 1024 * 1024)
   , datalink_control_size_(4 * 1024)
+  , ring_size_(0)
+  , ring_spin_count_(1000)
   , hostname_(get_fully_qualified_hostname())
   , association_resend_period_(default_association_resend_period)
 {
@@ -55,6 +57,8 @@ ShmemInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("pool_size"), pool_size_, size_t)
   GET_CONFIG_VALUE(cf, sect, ACE_TEXT("datalink_control_size"),
                    datalink_control_size_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("ring_size"), ring_size_, size_t)
+  GET_CONFIG_VALUE(cf, sect, ACE_TEXT("ring_spin_count"), ring_spin_count_, size_t)
   GET_CONFIG_TIME_VALUE(cf, sect,
     ACE_TEXT("association_resend_period"), association_resend_period_);
 
@@ -68,6 +72,8 @@ ShmemInst::dump_to_str() const
   os << TransportInst::dump_to_str();
   os << formatNameForDump("pool_size") << pool_size_ << "\n"
      << formatNameForDump("datalink_control_size") << datalink_control_size_ << "\n"
+     << formatNameForDump("ring_size") << ring_size_ << "\n"
+     << formatNameForDump("ring_spin_count") << ring_spin_count_ << "\n"
      << formatNameForDump("pool_name") << this->poolname_ << "\n"
      << formatNameForDump("host_name") << this->hostname_ << "\n"
      << formatNameForDump("association_resend_period") << association_resend_period_.str() << "\n";
@@ -35,6 +35,20 @@ public:
   /// Defaults to 4 kilobytes.
   size_t datalink_control_size_;
 
+  /// Size (in bytes, rounded up to a power of two) of the lock-free ring that
+  /// each writing process creates for its DataLink to this transport instance
+  /// if it also sets ring_size_.  The ring comes out of the writer's
+  /// shared-memory pool and samples are read directly from it.  Zero (the
+  /// default) uses the control area (datalink_control_size_) and a semaphore
+  /// post for each message instead.
+  size_t ring_size_;
+
+  /// Number of times the reading thread polls its rings, and a writer polls
+  /// a full ring, before blocking on a semaphore.  The reading thread adapts
+  /// its limit between 0 and this value depending on whether polling has been
+  /// finding data.  Only used when ring_size_ is set.  Defaults to 1000.
+  size_t ring_spin_count_;
+
   bool is_reliable() const { return true; }
 
   virtual size_t populate_locator(OpenDDS::DCPS::TransportLocator& trans_info, ConnectionInfoFlags flags) const;
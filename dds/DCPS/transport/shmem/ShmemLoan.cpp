@@ -0,0 +1,205 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ShmemLoan.h"
+
+#ifdef OPENDDS_SHMEM_RING
+
+#include <ace/Guard_T.h>
+#include <ace/Message_Block.h>
+
+#include <new>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+ShmemLoanPool::ShmemLoanPool(ShmemAllocator* alloc, size_t pool_size,
+                             const ShmemPeerPool_rch& peer_pool)
+  : alloc_(alloc)
+  , pool_size_(pool_size)
+  , peer_pool_(peer_pool)
+  , outstanding_(0)
+  , detached_(false)
+{
+}
+
+ACE_Message_Block*
+ShmemLoanPool::loan(size_t size, ACE_Lock* locking_strategy)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (!alloc_ || size > ACE_UINT32_MAX) {
+    return 0;
+  }
+
+  void* const mem = alloc_->malloc(sizeof(ShmemLoanHeader) + size);
+  if (!mem) {
+    return 0;
+  }
+
+  ShmemLoanHeader* const header = new (mem) ShmemLoanHeader;
+  header->refs_.store(1);
+  header->size_ = static_cast<ACE_UINT32>(size);
+
+  ACE_Message_Block* const mb = make_block(header, locking_strategy);
+  if (mb) {
+    loans_[header->data()] = header;
+  } else {
+    alloc_->free(header);
+  }
+  return mb;
+}
+
+bool
+ShmemLoanPool::acquire(const void* ptr, size_t len, ShmemRingLoanRef& ref)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (!alloc_ || loans_.empty()) {
+    return false;
+  }
+
+  const char* const begin = static_cast<const char*>(ptr);
+  Loans::iterator iter = loans_.upper_bound(begin);
+  if (iter == loans_.begin()) {
+    return false;
+  }
+  --iter;
+  ShmemLoanHeader* const header = iter->second;
+  if (begin + len > iter->first + header->size_) {
+    return false;
+  }
+
+  header->refs_.fetch_add(1, std::memory_order_relaxed);
+  ref.loan_offset_ = reinterpret_cast<char*>(header) - static_cast<char*>(alloc_->base_addr());
+  ref.data_begin_ = static_cast<ACE_UINT32>(begin - iter->first);
+  ref.data_length_ = static_cast<ACE_UINT32>(len);
+  return true;
+}
+
+void
+ShmemLoanPool::release(const ShmemRingLoanRef& ref)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ShmemLoanHeader* const header = alloc_ ? header_at(ref.loan_offset_) : 0;
+  if (header) {
+    release_i(header);
+  }
+}
+
+ACE_Message_Block*
+ShmemLoanPool::adopt(const ShmemRingLoanRef& ref)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (!alloc_) {
+    return 0;
+  }
+
+  ShmemLoanHeader* const header = header_at(ref.loan_offset_);
+  if (!header) {
+    return 0;
+  }
+  if (ref.data_begin_ + static_cast<size_t>(ref.data_length_) > header->size_) {
+    release_i(header);
+    return 0;
+  }
+
+  ACE_Message_Block* const mb = make_block(header, &db_lock_);
+  if (mb) {
+    mb->rd_ptr(ref.data_begin_);
+    mb->wr_ptr(ref.data_begin_ + ref.data_length_);
+  }
+  return mb;
+}
+
+ACE_Message_Block*
+ShmemLoanPool::make_block(ShmemLoanHeader* header, ACE_Lock* locking_strategy)
+{
+  // The data block frees its base, the start of the loan's data, using this
+  // object as its allocator strategy.
+  ACE_Allocator* const alloc = ACE_Allocator::instance();
+  ACE_Data_Block* db = 0;
+  ACE_NEW_MALLOC_RETURN(db,
+    static_cast<ACE_Data_Block*>(alloc->malloc(sizeof(ACE_Data_Block))),
+    ACE_Data_Block(header->size_, ACE_Message_Block::MB_DATA, header->data(),
+                   this, locking_strategy, 0, alloc), 0);
+  ++outstanding_;
+
+  ACE_Message_Block* mb = 0;
+  ACE_NEW_MALLOC_RETURN(mb,
+    static_cast<ACE_Message_Block*>(alloc->malloc(sizeof(ACE_Message_Block))),
+    ACE_Message_Block(db, 0, alloc), 0);
+  return mb;
+}
+
+ShmemLoanHeader*
+ShmemLoanPool::header_at(ACE_UINT64 offset)
+{
+  // The offset comes from the other process, the loan has to be entirely
+  // within the pool.
+  static const size_t header_size = sizeof(ShmemLoanHeader);
+  if (offset % sizeof(ACE_UINT32) || offset > pool_size_ ||
+      pool_size_ - static_cast<size_t>(offset) < header_size) {
+    return 0;
+  }
+  ShmemLoanHeader* const header = reinterpret_cast<ShmemLoanHeader*>(
+    static_cast<char*>(alloc_->base_addr()) + static_cast<size_t>(offset));
+  if (header->size_ > pool_size_ - static_cast<size_t>(offset) - header_size) {
+    return 0;
+  }
+  return header;
+}
+
+void
+ShmemLoanPool::release_i(ShmemLoanHeader* header)
+{
+  // Whichever process drops the last reference frees the loan, the pool's
+  // allocator uses a process-shared lock.
+  if (header->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    alloc_->free(header);
+  }
+}
+
+void
+ShmemLoanPool::detach()
+{
+  bool last;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    detached_ = true;
+    if (!peer_pool_) {
+      alloc_ = 0;
+      loans_.clear();
+    }
+    last = outstanding_ == 0;
+  }
+  if (last) {
+    delete this;
+  }
+}
+
+void
+ShmemLoanPool::free(void* ptr)
+{
+  bool last;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    if (alloc_) {
+      loans_.erase(static_cast<const char*>(ptr));
+      release_i(static_cast<ShmemLoanHeader*>(ptr) - 1);
+    }
+    last = --outstanding_ == 0 && detached_;
+  }
+  if (last) {
+    delete this;
+  }
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_SHMEM_RING */
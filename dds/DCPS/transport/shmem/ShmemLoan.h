@@ -0,0 +1,112 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMLOAN_H
+#define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMLOAN_H
+
+#include "Shmem_Export.h"
+#include "ShmemRing.h"
+
+#include <dds/DCPS/PoolAllocator.h>
+
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Malloc_Allocator.h>
+#include <ace/Thread_Mutex.h>
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Lock;
+class ACE_Message_Block;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+#ifdef OPENDDS_SHMEM_RING
+
+/**
+ * Precedes the data of a buffer loaned to a DataWriter, see
+ * ShmemTransport::loan_buffer.  Each process holding the buffer has a
+ * reference, the last one to release it frees it in the writer's pool.
+ */
+struct ShmemLoanHeader {
+  std::atomic<ACE_UINT32> refs_;
+  ACE_UINT32 size_;
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+/**
+ * Allocator strategy for the data blocks of loaned buffers in one pool.  The
+ * writer uses one for its own pool and each ring reader uses one for the
+ * writer's pool.  Data blocks can outlive the transport or link that owns the
+ * pool, the last one deletes this object once the owner calls detach().  A
+ * reader's loan pool keeps the writer's pool mapped until then, the writer's
+ * own pool is released with its transport so the remaining blocks are
+ * released without touching shared memory.
+ */
+class OpenDDS_Shmem_Export ShmemLoanPool : public ACE_New_Allocator {
+public:
+  /// pool_size is the size of the pool that alloc manages, references to
+  /// loans outside of it are rejected.
+  ShmemLoanPool(ShmemAllocator* alloc, size_t pool_size,
+                const ShmemPeerPool_rch& peer_pool = ShmemPeerPool_rch());
+
+  /// Allocate a loan of size bytes in the pool.  The returned message block
+  /// holds the only reference.
+  ACE_Message_Block* loan(size_t size, ACE_Lock* locking_strategy);
+
+  /// If [ptr, ptr + len) is within a loan made by this pool add a reference
+  /// for the reader and describe the range relative to the pool's base.
+  bool acquire(const void* ptr, size_t len, ShmemRingLoanRef& ref);
+
+  /// Drop the reference that acquire() added, when the record referring to
+  /// the loan wasn't sent or the reader can't deliver it.
+  void release(const ShmemRingLoanRef& ref);
+
+  /// Message block over a range of a loan from the writer's pool, taking over
+  /// the reference that the writer added for this reader.  Returns 0 if ref
+  /// doesn't refer to a loan in the pool, and also drops the reference if
+  /// only the range is outside of the loan.
+  ACE_Message_Block* adopt(const ShmemRingLoanRef& ref);
+
+  /// The owner no longer uses this object, and unless it's for a peer's pool
+  /// the pool is about to be unmapped.
+  void detach();
+
+  /// Called when a data block from loan() or adopt() is released.
+  void free(void* ptr);
+
+private:
+  ~ShmemLoanPool() {}
+
+  ACE_Message_Block* make_block(ShmemLoanHeader* header, ACE_Lock* locking_strategy);
+  ShmemLoanHeader* header_at(ACE_UINT64 offset);
+  void release_i(ShmemLoanHeader* header);
+
+  ACE_Thread_Mutex mutex_;
+  /// Locking strategy of the data blocks from adopt(), which can outlive the
+  /// link.
+  ACE_Lock_Adapter<ACE_Thread_Mutex> db_lock_;
+  ShmemAllocator* alloc_;
+  const size_t pool_size_;
+  ShmemPeerPool_rch peer_pool_;
+  size_t outstanding_;
+  bool detached_;
+
+  /// Loans made by this process, by the start of their data.
+  typedef OPENDDS_MAP(const char*, ShmemLoanHeader*) Loans;
+  Loans loans_;
+};
+
+#endif /* OPENDDS_SHMEM_RING */
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMLOAN_H */
@@ -0,0 +1,35 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ShmemPeerPool.h"
+
+#include <dds/DCPS/transport/framework/TransportDebug.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+ShmemPeerPool::ShmemPeerPool(ShmemAllocator* alloc)
+  : alloc_(alloc)
+{
+}
+
+ShmemPeerPool::~ShmemPeerPool()
+{
+  // Calling release() has to be done with argument 1 (close),
+  // because with 1 ACE_Malloc_T will call release on the underlying
+  // shared memory pool
+  if (alloc_->release(1 /*close*/) == -1) {
+    VDBG_LVL((LM_ERROR,
+              "(%P|%t) ShmemPeerPool::~ShmemPeerPool Release shared memory failed\n"), 1);
+  }
+  delete alloc_;
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,43 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMPEERPOOL_H
+#define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMPEERPOOL_H
+
+#include "Shmem_Export.h"
+#include "ShmemAllocator.h"
+
+#include <dds/DCPS/RcObject.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * The mapping of a peer's shared-memory pool.  It's released when the last
+ * reference is: the DataLink holds one until it stops and the ring reader
+ * and loan pool hold one for as long as data blocks they delivered point
+ * into the pool.
+ */
+class OpenDDS_Shmem_Export ShmemPeerPool : public RcObject {
+public:
+  explicit ShmemPeerPool(ShmemAllocator* alloc);
+  ~ShmemPeerPool();
+
+  ShmemAllocator* alloc() const { return alloc_; }
+
+private:
+  ShmemAllocator* const alloc_;
+};
+
+typedef RcHandle<ShmemPeerPool> ShmemPeerPool_rch;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMPEERPOOL_H */
@@ -9,6 +9,7 @@
 
 #include "ShmemDataLink.h"
 #include "ShmemInst.h"
+#include "ShmemLoan.h"
 #include "ShmemTransport.h"
 
 #include "dds/DCPS/transport/framework/TransportHeader.h"
@@ -20,23 +21,54 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+#ifdef OPENDDS_SHMEM_RING
+namespace {
+  ShmemRingLoanRef loan_ref(ShmemRingRecord& record)
+  {
+    ShmemRingLoanRef ref;
+    std::memcpy(&ref, record.data(), sizeof ref);
+    return ref;
+  }
+}
+#endif
+
 ShmemReceiveStrategy::ShmemReceiveStrategy(ShmemDataLink* link)
   : TransportReceiveStrategy<>(link->config())
   , link_(link)
   , current_data_(0)
   , partial_recv_remaining_(0)
   , partial_recv_ptr_(0)
+#ifdef OPENDDS_SHMEM_RING
+  , use_ring_(link->config()->ring_size_ != 0)
+  , ring_stopped_(false)
+  , peer_mode_(PEER_UNKNOWN)
+  , ring_reader_(0)
+  , loan_pool_(0)
+#endif
 {
 }
 
-void
+bool
 ShmemReceiveStrategy::read()
 {
+#ifdef OPENDDS_SHMEM_RING
+  if (use_ring_) {
+    switch (find_peer_mode()) {
+    case PEER_UNKNOWN:
+      return false;
+    case PEER_RING:
+      return read_ring();
+    case PEER_CONTROL:
+      break;
+    }
+  }
+#endif
+
   if (partial_recv_remaining_) {
     VDBG((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::read link %@ "
           "resuming partial recv\n", link_));
     handle_dds_input(ACE_INVALID_HANDLE);
-    return;
+    return true;
   }
 
   if (bound_name_.empty()) {
@@ -50,7 +82,7 @@ ShmemReceiveStrategy::read()
               "peer allocator not found, receive_bytes will close link\n",
               link_), 1);
     handle_dds_input(ACE_INVALID_HANDLE); // will return 0 to the TRecvStrateg.
-    return;
+    return false;
   }
 
   if (!current_data_) {
@@ -62,7 +94,7 @@ ShmemReceiveStrategy::read()
     if (!start) {
       start = current_data_;
     } else if (start == current_data_) {
-      return; // none found => don't call handle_dds_input()
+      return false; // none found => don't call handle_dds_input()
     }
     if (current_data_[1].status_ == ShmemData::EndOfAlloc) {
       current_data_ = reinterpret_cast<ShmemData*>(mem) - 1; // incremented by the for loop
@@ -75,8 +107,156 @@ ShmemReceiveStrategy::read()
   // If we get this far, current_data_ points to the first ShmemData::DataInUse.
   // handle_dds_input() will call our receive_bytes() to get the data.
   handle_dds_input(ACE_INVALID_HANDLE);
+  return true;
+}
+
+#ifdef OPENDDS_SHMEM_RING
+ShmemReceiveStrategy::PeerMode
+ShmemReceiveStrategy::find_peer_mode()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(ring_mutex_);
+  if (peer_mode_ != PEER_UNKNOWN || ring_stopped_) {
+    return peer_mode_;
+  }
+
+  // The writer creates its ring or control area when its side of the link
+  // starts, which one depends on whether it supports rings.
+  const ShmemPeerPool_rch pool = link_->peer_pool();
+  if (!pool) {
+    return peer_mode_;
+  }
+  const std::string local = link_->local_address();
+  void* mem = 0;
+  if (pool->alloc()->find(("Ring-" + local).c_str(), mem) == 0) {
+    ShmemRing* const ring = reinterpret_cast<ShmemRing*>(mem);
+    ring_reader_ = new ShmemRingReader(ring, pool);
+    loan_pool_ = new ShmemLoanPool(pool->alloc(), static_cast<size_t>(ring->pool_size_), pool);
+    peer_mode_ = PEER_RING;
+    VDBG((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::find_peer_mode link %@ "
+          "found ring of %u bytes\n", link_, ring->capacity_));
+  } else if (pool->alloc()->find(("Write-" + local).c_str(), mem) == 0) {
+    peer_mode_ = PEER_CONTROL;
+    VDBG((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::find_peer_mode link %@ "
+          "peer uses the control area\n", link_));
+  }
+  return peer_mode_;
+}
+
+bool
+ShmemReceiveStrategy::read_ring()
+{
+  bool found = false;
+  ACE_Guard<ACE_Thread_Mutex> guard(ring_mutex_);
+  while (ring_reader_) {
+    ShmemRingRecord* const record = ring_reader_->next();
+    if (!record) {
+      break;
+    }
+    found = true;
+
+    // loan_pool_ is created and detached along with ring_reader_.  The
+    // writer added a reference to the loan of an Indirect record for us,
+    // every path below either adopts it or drops it.
+    const bool indirect = (record->flags_ & ShmemRingRecord::Indirect) != 0;
+    ACE_Data_Block* const db = ring_reader_->data_block(*record);
+    if (!db) {
+      if (indirect) {
+        loan_pool_->release(loan_ref(*record));
+      }
+      ring_reader_->release(*record);
+      continue;
+    }
+    ACE_Message_Block* const loan = indirect ? loan_pool_->adopt(loan_ref(*record)) : 0;
+
+    // Releasing data blocks doesn't need ring_mutex_, but stop_i does.
+    guard.release();
+    deliver_ring_record(db, indirect, loan);
+    guard.acquire();
+  }
+  return found;
+}
+
+void
+ShmemReceiveStrategy::deliver_ring_record(ACE_Data_Block* db, bool indirect, ACE_Message_Block* loan_mb)
+{
+  Message_Block_Ptr loan(loan_mb);
+
+  // The samples are delivered without copying them out of shared memory.
+  // The record stays reserved until the last reference to its data block is
+  // released, which is normally right after the readers deserialize it.
+  ACE_Message_Block mb(db);
+  mb.wr_ptr(db->size());
+
+  // An Indirect record's last payload is a range of a loaned buffer in the
+  // writer's pool, which is chained after the rest of the last sample.
+  if (indirect) {
+    mb.rd_ptr(sizeof(ShmemRingLoanRef));
+    if (!loan) {
+      VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemReceiveStrategy::deliver_ring_record "
+                "link %@ invalid loan reference\n", link_), 0);
+      return;
+    }
+  }
+  const size_t loan_length = loan ? loan->length() : 0;
+
+  TransportHeader transport_header(mb);
+  if (!transport_header.valid() || transport_header.length_ < loan_length ||
+      transport_header.length_ - loan_length > mb.length()) {
+    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemReceiveStrategy::deliver_ring_record "
+              "link %@ invalid TransportHeader\n", link_), 0);
+    return;
+  }
+  mb.wr_ptr(mb.rd_ptr() + transport_header.length_ - loan_length);
+
+  while (mb.length()) {
+    if (DataSampleHeader::partial(mb)) {
+      VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemReceiveStrategy::deliver_ring_record "
+                "link %@ incomplete DataSampleHeader\n", link_), 0);
+      return;
+    }
+    DataSampleHeader sample_header(mb);
+    const ACE_UINT32 sample_length = sample_header.message_length();
+    ReceivedDataSample rds;
+    if (loan && sample_length == mb.length() + loan_length) {
+      if (mb.length()) {
+        mb.cont(loan.get());
+        rds = ReceivedDataSample(mb);
+        mb.cont(0);
+      } else {
+        rds = ReceivedDataSample(*loan);
+      }
+      loan.reset();
+      mb.rd_ptr(mb.wr_ptr());
+    } else if (sample_length > mb.length()) {
+      VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemReceiveStrategy::deliver_ring_record "
+                "link %@ sample length %u exceeds record\n", link_, sample_length), 0);
+      return;
+    } else {
+      char* const end = mb.wr_ptr();
+      mb.wr_ptr(mb.rd_ptr() + sample_length);
+      if (sample_length) {
+        rds = ReceivedDataSample(mb);
+      }
+      mb.rd_ptr(mb.wr_ptr());
+      mb.wr_ptr(end);
+    }
+
+    if (sample_header.into_received_data_sample(rds)) {
+      if (sample_header.more_fragments() || transport_header.last_fragment()) {
+        if (reassemble(rds)) {
+          deliver_sample(rds, ACE_INET_Addr());
+        }
+      } else {
+        deliver_sample(rds, ACE_INET_Addr());
+      }
+    }
+    // See TransportReceiveStrategy::handle_dds_input
+    transport_header.last_fragment(false);
+  }
 }
 
+#endif
+
 ssize_t
 ShmemReceiveStrategy::receive_bytes(iovec iov[],
                                     int n,
@@ -205,6 +385,27 @@ ShmemReceiveStrategy::start_i()
 void
 ShmemReceiveStrategy::stop_i()
 {
+#ifdef OPENDDS_SHMEM_RING
+  // Samples already delivered keep the peer's pool mapped, see ShmemPeerPool.
+  ACE_Guard<ACE_Thread_Mutex> guard(ring_mutex_);
+  ring_stopped_ = true;
+  if (ring_reader_) {
+    // Records that weren't read won't be delivered, but the loans they refer
+    // to still have a reference for this reader.
+    while (ShmemRingRecord* const record = ring_reader_->next()) {
+      if (record->flags_ & ShmemRingRecord::Indirect) {
+        loan_pool_->release(loan_ref(*record));
+      }
+      ring_reader_->release(*record);
+    }
+    ring_reader_->detach();
+    ring_reader_ = 0;
+  }
+  if (loan_pool_) {
+    loan_pool_->detach();
+    loan_pool_ = 0;
+  }
+#endif
 }
 
 } // namespace DCPS
@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMRECEIVESTRATEGY_H
 
 #include "Shmem_Export.h"
+#include "ShmemRing.h"
 
 #include "ace/INET_Addr.h"
 
@@ -20,6 +21,7 @@ namespace OpenDDS {
 namespace DCPS {
 
 class ShmemDataLink;
+class ShmemLoanPool;
 struct ShmemData;
 
 class OpenDDS_Shmem_Export ShmemReceiveStrategy
@@ -27,7 +29,8 @@ class OpenDDS_Shmem_Export ShmemReceiveStrategy
 public:
   explicit ShmemReceiveStrategy(ShmemDataLink* link);
 
-  void read();
+  /// Returns true if any data was found.
+  bool read();
 
 protected:
   virtual ssize_t receive_bytes(iovec iov[],
@@ -49,6 +52,31 @@ private:
   size_t partial_recv_remaining_;
   const char* partial_recv_ptr_;
   ACE_Thread_Mutex mutex_;
+
+#ifdef OPENDDS_SHMEM_RING
+  enum PeerMode {
+    PEER_UNKNOWN,
+    /// The peer found our "Wakeup" and writes to a ring.
+    PEER_RING,
+    /// The peer writes to the control area, it's built without rings.
+    PEER_CONTROL
+  };
+  PeerMode find_peer_mode();
+  bool read_ring();
+  void deliver_ring_record(ACE_Data_Block* db, bool indirect, ACE_Message_Block* loan);
+
+  const bool use_ring_;
+  bool ring_stopped_;
+  /// Only used when use_ring_ is set, protected by ring_mutex_.
+  PeerMode peer_mode_;
+  /// Protects peer_mode_, ring_reader_, and loan_pool_.  The two objects
+  /// delete themselves once they are detached and the last data block from
+  /// them is released.
+  ACE_Thread_Mutex ring_mutex_;
+  ShmemRingReader* ring_reader_;
+  /// Loaned payloads referenced by Indirect records, in the peer's pool.
+  ShmemLoanPool* loan_pool_;
+#endif
 };
 
 } // namespace DCPS
@@ -0,0 +1,329 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ShmemRing.h"
+
+#ifdef OPENDDS_SHMEM_RING
+
+#include <ace/Guard_T.h>
+#include <ace/Message_Block.h>
+
+#include <algorithm>
+#include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+  ACE_sema_t ace_sema(ShmemSharedSemaphore* sem)
+  {
+    // See ShmemTransport::configure_i
+    ACE_sema_t ace_sema;
+    std::memset(&ace_sema, 0, sizeof ace_sema);
+    ace_sema.sema_ = sem;
+#ifdef OPENDDS_SHMEM_UNIX_EMULATE_SEM_TIMEOUT
+    ace_sema.lock_ = PTHREAD_MUTEX_INITIALIZER;
+    ace_sema.count_nonzero_ = PTHREAD_COND_INITIALIZER;
+#endif
+    return ace_sema;
+  }
+
+  /// Tell the CPU that this thread is polling.
+  void cpu_relax()
+  {
+#if defined __GNUC__ && (defined __i386__ || defined __x86_64__)
+    __builtin_ia32_pause();
+#elif defined __GNUC__ && defined __aarch64__
+    __asm__ __volatile__("yield");
+#endif
+  }
+}
+
+bool ShmemRing::init(ACE_UINT32 capacity, ACE_UINT64 pool_size)
+{
+  head_.store(0);
+  tail_.store(0);
+  capacity_ = capacity;
+  pool_size_ = pool_size;
+  writer_waiting_.store(0);
+  return ::sem_init(&space_, 1 /*process shared*/, 0 /*initial count*/) == 0;
+}
+
+void ShmemRing::fini()
+{
+  ::sem_destroy(&space_);
+}
+
+void shmem_ring_wake(ShmemWakeup& wakeup, ACE_sema_t& semaphore)
+{
+  // Pairs with the reader storing sleeping_ before checking the rings again,
+  // so either it sees the new head or we see that it's sleeping.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (wakeup.sleeping_.load(std::memory_order_relaxed) == 0 || wakeup.sleeping_.exchange(0) == 0) {
+    return;
+  }
+  ACE_OS::sema_post(&semaphore);
+}
+
+ShmemRingSpin::ShmemRingSpin(size_t max_spins)
+  : max_(max_spins)
+  , limit_(max_spins)
+  , spins_(0)
+{
+}
+
+void
+ShmemRingSpin::found()
+{
+  if (spins_) {
+    limit_ = std::min(limit_ * 2, max_);
+    spins_ = 0;
+  }
+}
+
+bool
+ShmemRingSpin::spin()
+{
+  if (spins_ < limit_) {
+    ++spins_;
+    cpu_relax();
+    return true;
+  }
+  // Keep polling at least once so found() can raise the limit again.
+  limit_ = std::max(limit_ / 2, std::min(max_, size_t(1)));
+  spins_ = 0;
+  return false;
+}
+
+ShmemRingWriter::ShmemRingWriter()
+  : ring_(0)
+  , reserved_head_(0)
+  , needed_(0)
+  , stopped_(false)
+{
+}
+
+ACE_UINT32
+ShmemRingWriter::space(ACE_UINT32 head) const
+{
+  return ring_->capacity_ - (head - ring_->tail_.load(std::memory_order_acquire));
+}
+
+bool
+ShmemRingWriter::fits(size_t data_size) const
+{
+  // Checking data_size first keeps record_size from overflowing.
+  return data_size < ring_->capacity_ &&
+    ShmemRingRecord::record_size(data_size) <= ring_->capacity_;
+}
+
+ShmemRingRecord*
+ShmemRingWriter::reserve(size_t data_size)
+{
+  if (!fits(data_size)) {
+    return 0;
+  }
+
+  const ACE_UINT32 capacity = ring_->capacity_;
+  const ACE_UINT32 record_size = ShmemRingRecord::record_size(data_size);
+  ACE_UINT32 head = ring_->head_.load(std::memory_order_relaxed);
+  const ACE_UINT32 to_end = capacity - (head & (capacity - 1));
+  const ACE_UINT32 needed = record_size <= to_end ? record_size : to_end + record_size;
+  if (space(head) < needed) {
+    needed_ = needed;
+    return 0;
+  }
+  needed_ = 0;
+
+  if (record_size > to_end) {
+    ShmemRingRecord* const padding =
+      reinterpret_cast<ShmemRingRecord*>(ring_->data() + (head & (capacity - 1)));
+    padding->size_ = to_end;
+    padding->flags_ = ShmemRingRecord::Padding;
+    head += to_end;
+  }
+
+  ShmemRingRecord* const record =
+    reinterpret_cast<ShmemRingRecord*>(ring_->data() + (head & (capacity - 1)));
+  record->size_ = record_size;
+  record->flags_ = 0;
+  reserved_head_ = head + record_size;
+  return record;
+}
+
+bool
+ShmemRingWriter::wait_for_space(size_t spin_count)
+{
+  const ACE_UINT32 head = ring_->head_.load(std::memory_order_relaxed);
+  for (size_t i = 0; space(head) < needed_; ++i) {
+    if (stopped_) {
+      return false;
+    }
+    if (i < spin_count) {
+      cpu_relax();
+      continue;
+    }
+
+    // Announce that we're waiting, then check again so a release that
+    // didn't see the announcement can't be missed.  See advance_tail_i.
+    ring_->writer_waiting_.store(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (space(head) >= needed_ || stopped_) {
+      ring_->writer_waiting_.store(0);
+      continue;
+    }
+    // Posts can be left over from an earlier wait, so this loops to check
+    // again after each one.
+    ACE_sema_t sema = ace_sema(&ring_->space_);
+    ACE_OS::sema_wait(&sema);
+    ring_->writer_waiting_.store(0);
+  }
+  return true;
+}
+
+void
+ShmemRingWriter::stop()
+{
+  stopped_ = true;
+  if (ring_) {
+    ::sem_post(&ring_->space_);
+  }
+}
+
+void
+ShmemRingWriter::publish()
+{
+  ring_->head_.store(reserved_head_, std::memory_order_release);
+}
+
+ShmemRingReader::ShmemRingReader(ShmemRing* ring, const ShmemPeerPool_rch& pool)
+  : ring_(ring)
+  , pool_(pool)
+  , read_pos_(ring->tail_.load(std::memory_order_acquire))
+  , outstanding_(0)
+{
+}
+
+ShmemRingReader::~ShmemRingReader()
+{
+}
+
+ShmemRingRecord*
+ShmemRingReader::next()
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (!ring_) {
+    return 0;
+  }
+
+  const ACE_UINT32 head = ring_->head_.load(std::memory_order_acquire);
+  const ACE_UINT32 mask = ring_->capacity_ - 1;
+  while (read_pos_ != head) {
+    ShmemRingRecord* const record =
+      reinterpret_cast<ShmemRingRecord*>(ring_->data() + (read_pos_ & mask));
+    read_pos_ += record->size_;
+    if (!(record->flags_ & ShmemRingRecord::Padding)) {
+      return record;
+    }
+    release_i(*record);
+  }
+  return 0;
+}
+
+ACE_Data_Block*
+ShmemRingReader::data_block(ShmemRingRecord& record)
+{
+  ACE_Allocator* const alloc = ACE_Allocator::instance();
+  ACE_Data_Block* db = 0;
+  ACE_NEW_MALLOC_RETURN(db,
+    static_cast<ACE_Data_Block*>(alloc->malloc(sizeof(ACE_Data_Block))),
+    ACE_Data_Block(record.data_size(), ACE_Message_Block::MB_DATA, record.data(),
+                   this, &db_lock_, 0, alloc), 0);
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  ++outstanding_;
+  return db;
+}
+
+void
+ShmemRingReader::release(ShmemRingRecord& record)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  release_i(record);
+}
+
+void
+ShmemRingReader::release_i(ShmemRingRecord& record)
+{
+  if (ring_) {
+    record.flags_ |= ShmemRingRecord::Released;
+    advance_tail_i();
+  }
+}
+
+void
+ShmemRingReader::advance_tail_i()
+{
+  // Records can be released out of order, the tail only moves past the
+  // released ones at the front.
+  const ACE_UINT32 mask = ring_->capacity_ - 1;
+  const ACE_UINT32 start = ring_->tail_.load(std::memory_order_relaxed);
+  ACE_UINT32 tail = start;
+  while (tail != read_pos_) {
+    const ShmemRingRecord* const record =
+      reinterpret_cast<const ShmemRingRecord*>(ring_->data() + (tail & mask));
+    if (!(record->flags_ & ShmemRingRecord::Released)) {
+      break;
+    }
+    tail += record->size_;
+  }
+  if (tail == start) {
+    return;
+  }
+
+  ring_->tail_.store(tail, std::memory_order_release);
+  // Pairs with the writer storing writer_waiting_ before checking for space
+  // again, see ShmemRingWriter::wait_for_space.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (ring_->writer_waiting_.load(std::memory_order_relaxed) && ring_->writer_waiting_.exchange(0)) {
+    ::sem_post(&ring_->space_);
+  }
+}
+
+void
+ShmemRingReader::detach()
+{
+  bool last;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    ring_ = 0;
+    last = outstanding_ == 0;
+  }
+  if (last) {
+    delete this;
+  }
+}
+
+void
+ShmemRingReader::free(void* ptr)
+{
+  bool last;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    release_i(reinterpret_cast<ShmemRingRecord*>(ptr)[-1]);
+    last = --outstanding_ == 0 && !ring_;
+  }
+  if (last) {
+    delete this;
+  }
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_SHMEM_RING */
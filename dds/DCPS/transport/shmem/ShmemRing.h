@@ -0,0 +1,260 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMRING_H
+#define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMRING_H
+
+#include "Shmem_Export.h"
+#include "ShmemAllocator.h"
+#include "ShmemPeerPool.h"
+
+#include <ace/Basic_Types.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Malloc_Allocator.h>
+#include <ace/OS_NS_Thread.h>
+#include <ace/Thread_Mutex.h>
+
+#if defined OPENDDS_SHMEM_UNIX && defined ACE_HAS_CPP11
+#  define OPENDDS_SHMEM_RING
+#  include <atomic>
+#endif
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Data_Block;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+#ifdef OPENDDS_SHMEM_RING
+
+/*
+ * The structures below are placed in shared memory and used by two processes,
+ * so they only contain fixed-size integers, lock-free atomics, and
+ * process-shared semaphores.
+ */
+
+/**
+ * Bound as "Wakeup" in the pool of a transport that receives using rings.
+ * Writers in other processes create a ring of ring_size_ bytes for each
+ * DataLink to that transport and only post the transport's semaphore when
+ * the reading thread has announced that it is going to sleep.
+ */
+struct ShmemWakeup {
+  /// Nonzero while the reading thread is (about to be) blocked on the
+  /// semaphore.
+  std::atomic<ACE_UINT32> sleeping_;
+  ACE_UINT32 ring_size_;
+};
+
+/**
+ * Single-producer/single-consumer byte ring, bound as "Ring-<reader address>"
+ * in the writer's pool and followed by capacity_ bytes of ShmemRingRecords.
+ * Positions are free-running byte counts, capacity_ is a power of two.
+ */
+struct ShmemRing {
+  enum { CACHE_LINE = 64 };
+
+  /// Bytes published by the writer.
+  std::atomic<ACE_UINT32> head_;
+  char pad_head_[CACHE_LINE - sizeof(std::atomic<ACE_UINT32>)];
+
+  /// Bytes the reader has finished with.
+  std::atomic<ACE_UINT32> tail_;
+  char pad_tail_[CACHE_LINE - sizeof(std::atomic<ACE_UINT32>)];
+
+  ACE_UINT32 capacity_;
+  /// Nonzero while the writer is (about to be) blocked on space_.
+  std::atomic<ACE_UINT32> writer_waiting_;
+  /// Posted by the reader when it frees space that the writer waits for.
+  ShmemSharedSemaphore space_;
+  /// Size of the writer's pool, the offsets of loaned buffers in Indirect
+  /// records are checked against it.
+  ACE_UINT64 pool_size_;
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+
+  bool init(ACE_UINT32 capacity, ACE_UINT64 pool_size);
+  void fini();
+
+  static size_t allocation_size(ACE_UINT32 capacity)
+  {
+    return sizeof(ShmemRing) + capacity;
+  }
+
+  /// Round a configured ring size to a usable capacity.
+  static ACE_UINT32 capacity_for(size_t requested)
+  {
+    ACE_UINT32 capacity = MIN_CAPACITY;
+    while (capacity < requested && capacity < MAX_CAPACITY) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  static const ACE_UINT32 MIN_CAPACITY = 4096;
+  static const ACE_UINT32 MAX_CAPACITY = 1u << 30;
+};
+
+/**
+ * Each record holds one marshaled TransportHeader followed by the samples it
+ * describes.  Records never wrap around the end of the ring, a Padding record
+ * fills the space that's left instead.
+ */
+struct ShmemRingRecord {
+  enum {
+    ALIGN = 8,
+    Padding = 1,
+    Released = 2,
+    /// The data starts with a ShmemRingLoanRef and the last sample's payload
+    /// is in the writer's pool instead of the record, see ShmemLoanPool.
+    Indirect = 4
+  };
+
+  /// Size of the record including this header, a multiple of ALIGN.
+  ACE_UINT32 size_;
+  /// Written by the writer before publishing, then only by the reader.
+  ACE_UINT32 flags_;
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+  size_t data_size() const { return size_ - sizeof *this; }
+
+  static ACE_UINT32 record_size(size_t data_size)
+  {
+    return static_cast<ACE_UINT32>((sizeof(ShmemRingRecord) + data_size + ALIGN - 1) & ~size_t(ALIGN - 1));
+  }
+};
+
+/// Location of a range of a loaned buffer in the writer's pool.
+struct ShmemRingLoanRef {
+  /// Offset of the ShmemLoanHeader from the pool's base address.
+  ACE_UINT64 loan_offset_;
+  /// Range of the loan's data that the record refers to.
+  ACE_UINT32 data_begin_;
+  ACE_UINT32 data_length_;
+};
+
+/// Wake the thread blocked on 'semaphore' if it has announced it is sleeping.
+OpenDDS_Shmem_Export void shmem_ring_wake(ShmemWakeup& wakeup, ACE_sema_t& semaphore);
+
+/**
+ * Limits how many times a thread polls for work before it blocks.  The
+ * limit doubles, up to the configured maximum, each time polling finds work
+ * and halves each time it doesn't, so an idle peer costs little CPU time.
+ */
+class OpenDDS_Shmem_Export ShmemRingSpin {
+public:
+  explicit ShmemRingSpin(size_t max_spins);
+
+  /// Polling found work.
+  void found();
+
+  /// Polling found nothing.  Returns true, after pausing the CPU briefly,
+  /// if the thread should poll again instead of blocking.
+  bool spin();
+
+  size_t limit() const { return limit_; }
+
+private:
+  const size_t max_;
+  size_t limit_;
+  size_t spins_;
+};
+
+/**
+ * The writing side of a ring.  Only one thread at a time may use it, but
+ * stop() may be called from any thread.
+ */
+class OpenDDS_Shmem_Export ShmemRingWriter {
+public:
+  ShmemRingWriter();
+
+  void attach(ShmemRing* ring) { ring_ = ring; }
+  ShmemRing* ring() const { return ring_; }
+
+  /// If a record with data_size bytes of data fits in an empty ring.
+  bool fits(size_t data_size) const;
+
+  /// Reserve a record with data_size bytes of data.  Returns 0 without
+  /// blocking if the record doesn't fit or the ring is too full for it.
+  ShmemRingRecord* reserve(size_t data_size);
+
+  /// Make the record from the last reserve() visible to the reader.
+  void publish();
+
+  /// Block until the reader has released enough records for the record
+  /// that the last reserve() couldn't make, polling the ring up to
+  /// spin_count times first.  Returns false if stop() was called.
+  bool wait_for_space(size_t spin_count);
+
+  /// Make wait_for_space() return false from now on.
+  void stop();
+
+private:
+  ACE_UINT32 space(ACE_UINT32 head) const;
+
+  ShmemRing* ring_;
+  /// The position after the reserved record.
+  ACE_UINT32 reserved_head_;
+  /// Space the last reserve() needed but didn't find.
+  ACE_UINT32 needed_;
+  std::atomic<bool> stopped_;
+};
+
+/**
+ * The reading side of a ring.  Records are read in place, the data blocks
+ * made over them release the record once they are freed.  This is also the
+ * allocator strategy of those data blocks, so it's allocated on the heap and
+ * deletes itself once it's been detached from the ring and the last data
+ * block is freed.  It holds a reference to the writer's pool until then.
+ */
+class OpenDDS_Shmem_Export ShmemRingReader : public ACE_New_Allocator {
+public:
+  ShmemRingReader(ShmemRing* ring, const ShmemPeerPool_rch& pool);
+
+  /// The next record published by the writer, skipping padding, or 0.
+  /// Only the reading thread calls this.
+  ShmemRingRecord* next();
+
+  /// A data block over a record from next(), the record is released when
+  /// the last reference to the data block is.
+  ACE_Data_Block* data_block(ShmemRingRecord& record);
+
+  /// Release a record from next() that data_block() wasn't called for.
+  void release(ShmemRingRecord& record);
+
+  /// The link stopped reading from the ring.  Data blocks already made stay
+  /// valid but no longer touch the ring when they are freed.
+  void detach();
+
+  /// Called when a data block from data_block() is released.
+  void free(void* ptr);
+
+private:
+  ~ShmemRingReader();
+
+  void release_i(ShmemRingRecord& record);
+  void advance_tail_i();
+
+  ACE_Thread_Mutex mutex_;
+  ACE_Lock_Adapter<ACE_Thread_Mutex> db_lock_;
+  ShmemRing* ring_;
+  ShmemPeerPool_rch pool_;
+  /// Position of the next record to read, the records between the ring's
+  /// tail_ and here are being read or delivered.
+  ACE_UINT32 read_pos_;
+  size_t outstanding_;
+};
+
+#endif /* OPENDDS_SHMEM_RING */
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMRING_H */
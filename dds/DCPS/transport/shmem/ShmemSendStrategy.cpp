@@ -8,24 +8,62 @@
 #include "ShmemSendStrategy.h"
 #include "ShmemDataLink.h"
 #include "ShmemInst.h"
+#include "ShmemLoan.h"
+#include "ShmemSynchResource.h"
+#include "ShmemTransport.h"
 
 #include "dds/DCPS/transport/framework/NullSynchStrategy.h"
+#include "dds/DCPS/transport/framework/PerConnectionSynchStrategy.h"
 
 #include <cstring>
+#include <new>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  // A full ring is backpressure, the thread of a PerConnectionSynch sends
+  // the queued messages once the reader makes space.
+  bool may_use_ring(ShmemDataLink* link)
+  {
+#ifdef OPENDDS_SHMEM_RING
+    return link->config()->ring_size_ != 0;
+#else
+    ACE_UNUSED_ARG(link);
+    return false;
+#endif
+  }
+
+  ThreadSynchResource* synch_resource(ShmemDataLink* link)
+  {
+    return may_use_ring(link) ? new ShmemSynchResource(*link) : 0;
+  }
+
+  ThreadSynchStrategy_rch synch_strategy(ShmemDataLink* link)
+  {
+    if (may_use_ring(link)) {
+      return make_rch<PerConnectionSynchStrategy>();
+    }
+    return make_rch<NullSynchStrategy>();
+  }
+}
+
 ShmemSendStrategy::ShmemSendStrategy(ShmemDataLink* link)
   : TransportSendStrategy(0, link->impl(),
-                          0,  // synch_resource
+                          synch_resource(link),
                           link->transport_priority(),
-                          make_rch<NullSynchStrategy>())
+                          synch_strategy(link))
   , link_(link)
   , current_data_(0)
   , datalink_control_size_(link->config()->datalink_control_size_)
+#ifdef OPENDDS_SHMEM_RING
+  , use_ring_(link->config()->ring_size_ != 0)
+  , peer_wakeup_(0)
+  , ring_spin_count_(link->config()->ring_spin_count_)
+  , loan_pool_(0)
+#endif
 {
 #ifdef OPENDDS_SHMEM_UNIX
   memset(&peer_semaphore_, 0, sizeof(peer_semaphore_));
@@ -35,25 +73,23 @@ ShmemSendStrategy::ShmemSendStrategy(ShmemDataLink* link)
 bool
 ShmemSendStrategy::start_i()
 {
-  bound_name_ = "Write-" + link_->peer_address();
   ShmemAllocator* alloc = link_->local_allocator();
-
-  const size_t n_elems = datalink_control_size_ / sizeof(ShmemData),
-    extra = datalink_control_size_ % sizeof(ShmemData);
-
+  ShmemAllocator* peer = link_->peer_allocator();
   void* mem = 0;
-  if (alloc == 0 || (mem = alloc->calloc(datalink_control_size_)) == 0) {
-    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
-              "to allocate %B bytes for control\n", link_, datalink_control_size_), 0);
+
+#ifdef OPENDDS_SHMEM_RING
+  // The receiving side binds "Wakeup" if it can read from rings, if not or
+  // if this side doesn't use rings the control area is used.
+  if (use_ring_ && peer && peer->find("Wakeup", mem) == 0) {
+    if (!start_ring(alloc, *reinterpret_cast<ShmemWakeup*>(mem))) {
+      return false;
+    }
+  } else
+#endif
+  if (!start_control(alloc)) {
     return false;
   }
 
-  ShmemData* data = reinterpret_cast<ShmemData*>(mem);
-  const size_t limit = (extra >= sizeof(int)) ? n_elems : (n_elems - 1);
-  data[limit].status_ = ShmemData::EndOfAlloc;
-  alloc->bind(bound_name_.c_str(), mem);
-
-  ShmemAllocator* peer = link_->peer_allocator();
   peer->find("Semaphore", mem);
   ShmemSharedSemaphore* sem = reinterpret_cast<ShmemSharedSemaphore*>(mem);
 #if defined OPENDDS_SHMEM_WINDOWS
@@ -73,6 +109,151 @@ ShmemSendStrategy::start_i()
   return true;
 }
 
+bool
+ShmemSendStrategy::start_control(ShmemAllocator* alloc)
+{
+  bound_name_ = "Write-" + link_->peer_address();
+
+  const size_t n_elems = datalink_control_size_ / sizeof(ShmemData),
+    extra = datalink_control_size_ % sizeof(ShmemData);
+
+  void* mem = 0;
+  if (alloc == 0 || (mem = alloc->calloc(datalink_control_size_)) == 0) {
+    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
+              "to allocate %B bytes for control\n", link_, datalink_control_size_), 0);
+    return false;
+  }
+
+  ShmemData* data = reinterpret_cast<ShmemData*>(mem);
+  const size_t limit = (extra >= sizeof(int)) ? n_elems : (n_elems - 1);
+  data[limit].status_ = ShmemData::EndOfAlloc;
+  alloc->bind(bound_name_.c_str(), mem);
+  return true;
+}
+
+#ifdef OPENDDS_SHMEM_RING
+bool
+ShmemSendStrategy::start_ring(ShmemAllocator* alloc, ShmemWakeup& peer_wakeup)
+{
+  bound_name_ = "Ring-" + link_->peer_address();
+
+  const ACE_UINT32 capacity = peer_wakeup.ring_size_;
+  const size_t size = ShmemRing::allocation_size(capacity);
+  void* mem = 0;
+  if (alloc == 0 || (mem = alloc->malloc(size)) == 0) {
+    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
+              "to allocate %B bytes for ring\n", link_, size), 0);
+    return false;
+  }
+
+  ShmemRing* const ring = new (mem) ShmemRing;
+  if (!ring->init(capacity, link_->config()->pool_size_)) {
+    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
+              "to create the ring's semaphore\n", link_), 0);
+    alloc->free(mem);
+    return false;
+  }
+  alloc->bind(bound_name_.c_str(), mem);
+  ring_writer_.attach(ring);
+  peer_wakeup_ = &peer_wakeup;
+  ShmemTransport_rch transport = link_->transport();
+  loan_pool_ = transport ? transport->loan_pool() : 0;
+
+  VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemSendStrategy for link %@ "
+            "created ring of %u bytes\n", link_, capacity), 2);
+  return true;
+}
+
+ssize_t
+ShmemSendStrategy::send_ring_i(const iovec iov[], int n)
+{
+  size_t data_size = 0;
+  for (int i = 0; i < n; ++i) {
+    data_size += iov[i].iov_len;
+  }
+
+  // If the last sample's payload is a loaned buffer the reader maps it from
+  // our pool, only the headers and any other payloads are copied.
+  ShmemRingLoanRef loan_ref;
+  const bool indirect = loan_pool_ && n > 1 &&
+    loan_pool_->acquire(iov[n - 1].iov_base, iov[n - 1].iov_len, loan_ref);
+  const int n_copy = indirect ? n - 1 : n;
+  const size_t record_data_size = indirect
+    ? sizeof loan_ref + data_size - iov[n - 1].iov_len : data_size;
+
+  if (!ring_writer_.fits(record_data_size)) {
+    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ "
+              "message of %B bytes doesn't fit in the ring\n",
+              link_, data_size), 0);
+    if (indirect) {
+      loan_pool_->release(loan_ref);
+    }
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  // The send strategy serializes calls to send_bytes_i, so this is the only
+  // thread writing to the ring.  A full ring is backpressure, like a full
+  // socket buffer: the message is sent again once wait_for_ring_space()
+  // returns, and messages sent until then are queued.
+  ShmemRingRecord* const record = ring_writer_.reserve(record_data_size);
+  if (!record) {
+    VDBG((LM_DEBUG, "(%P|%t) ShmemSendStrategy for link %@ "
+          "ring is full, message of %B bytes is queued\n", link_, data_size));
+    if (indirect) {
+      loan_pool_->release(loan_ref);
+    }
+    errno = ENOBUFS;
+    return -1;
+  }
+
+  record->flags_ = indirect ? ShmemRingRecord::Indirect : 0;
+  char* iter = record->data();
+  if (indirect) {
+    std::memcpy(iter, &loan_ref, sizeof loan_ref);
+    iter += sizeof loan_ref;
+  }
+  for (int i = 0; i < n_copy; ++i) {
+    std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
+    iter += iov[i].iov_len;
+  }
+
+  ring_writer_.publish();
+  shmem_ring_wake(*peer_wakeup_, peer_semaphore_);
+
+  return data_size;
+}
+#endif
+
+bool
+ShmemSendStrategy::wait_for_ring_space()
+{
+#ifdef OPENDDS_SHMEM_RING
+  if (ring_writer_.ring()) {
+    return ring_writer_.wait_for_space(ring_spin_count_);
+  }
+#endif
+  return false;
+}
+
+void
+ShmemSendStrategy::stop_waiting()
+{
+#ifdef OPENDDS_SHMEM_RING
+  ring_writer_.stop();
+#endif
+}
+
+ssize_t
+ShmemSendStrategy::send_bytes(const iovec iov[], int n, int& bp)
+{
+  // Only a full ring reports ENOBUFS.
+  errno = 0;
+  const ssize_t result = send_bytes_i(iov, n);
+  bp = result == -1 && errno == ENOBUFS;
+  return result;
+}
+
 ssize_t
 ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
 {
@@ -91,6 +272,12 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
     return -1;
   }
 
+#ifdef OPENDDS_SHMEM_RING
+  if (ring_writer_.ring()) {
+    return send_ring_i(iov, n);
+  }
+#endif
+
   //FUTURE: use the ShmemTransport object to see if we already have the
   //        same payload data available in the pool (from other DataLinks),
   //        and if so, add a refcount to the start of the "from_pool" allocation
@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMSENDSTRATEGY_H
 
 #include "Shmem_Export.h"
+#include "ShmemRing.h"
 
 #include "dds/DCPS/transport/framework/TransportSendStrategy.h"
 
@@ -23,6 +24,7 @@ namespace DCPS {
 
 class ShmemDataLink;
 class ShmemInst;
+class ShmemLoanPool;
 struct ShmemData;
 typedef RcHandle<ShmemInst> ShmemInst_rch;
 
@@ -34,15 +36,39 @@ public:
   virtual bool start_i();
   virtual void stop_i();
 
+  /// Block until the ring has space for the message that didn't fit, see
+  /// ShmemSynchResource.  Returns false if the link is stopping.
+  bool wait_for_ring_space();
+  /// Make wait_for_ring_space() return false.
+  void stop_waiting();
+
 protected:
+  virtual ssize_t send_bytes(const iovec iov[], int n, int& bp);
   virtual ssize_t send_bytes_i(const iovec iov[], int n);
 
 private:
+  bool start_control(ShmemAllocator* alloc);
+
   ShmemDataLink* link_;
   std::string bound_name_;
   ACE_sema_t peer_semaphore_;
   ShmemData* current_data_;
   const size_t datalink_control_size_;
+
+#ifdef OPENDDS_SHMEM_RING
+  bool start_ring(ShmemAllocator* alloc, ShmemWakeup& peer_wakeup);
+  ssize_t send_ring_i(const iovec iov[], int n);
+
+  /// Rings are only used if both transports set ShmemInst::ring_size_.
+  const bool use_ring_;
+  /// Attached when the peer receives using a ring.
+  ShmemRingWriter ring_writer_;
+  ShmemWakeup* peer_wakeup_;
+  /// See ShmemInst::ring_spin_count_
+  const size_t ring_spin_count_;
+  /// Loaned payloads are sent by reference, see ShmemTransport::loan_buffer
+  ShmemLoanPool* loan_pool_;
+#endif
 };
 
 } // namespace DCPS
@@ -0,0 +1,41 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "ShmemSynchResource.h"
+#include "ShmemDataLink.h"
+#include "ShmemSendStrategy.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+ShmemSynchResource::ShmemSynchResource(ShmemDataLink& link)
+  : link_(link)
+{
+}
+
+ShmemSynchResource::~ShmemSynchResource()
+{
+}
+
+int
+ShmemSynchResource::wait_to_unclog()
+{
+  const ShmemSendStrategy_rch strategy = link_.send_strategy();
+  return strategy && strategy->wait_for_ring_space() ? 0 : -1;
+}
+
+void
+ShmemSynchResource::notify_lost_on_backpressure_timeout()
+{
+  // The wait for space in the ring has no timeout, the reader is in the
+  // same host and frees records as its samples are released.
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -0,0 +1,43 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMSYNCHRESOURCE_H
+#define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMSYNCHRESOURCE_H
+
+#include "Shmem_Export.h"
+
+#include <dds/DCPS/transport/framework/ThreadSynchResource.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class ShmemDataLink;
+
+/**
+ * Lets the send strategy's thread wait for the reader to make space in a
+ * full ring.  Until it does, messages are queued by the send strategy.
+ */
+class OpenDDS_Shmem_Export ShmemSynchResource : public ThreadSynchResource {
+public:
+  explicit ShmemSynchResource(ShmemDataLink& link);
+  virtual ~ShmemSynchResource();
+
+  virtual int wait_to_unclog();
+
+protected:
+  virtual void notify_lost_on_backpressure_timeout();
+
+private:
+  ShmemDataLink& link_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMSYNCHRESOURCE_H */
@@ -6,6 +6,8 @@
 #include "ShmemTransport.h"
 
 #include "ShmemInst.h"
+#include "ShmemLoan.h"
+#include "ShmemRing.h"
 #include "ShmemSendStrategy.h"
 #include "ShmemReceiveStrategy.h"
 
@@ -17,8 +19,10 @@
 
 #include <ace/Log_Msg.h>
 
+#include <algorithm>
 #include <sstream>
 #include <cstring>
+#include <new>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -27,6 +31,8 @@ namespace DCPS {
 
 ShmemTransport::ShmemTransport(const ShmemInst_rch& inst)
   : TransportImpl(inst)
+  , links_changed_(false)
+  , loan_pool_(0)
 {
   if (!(configure_i(inst) && open())) {
     throw Transport::UnableToCreate();
@@ -39,6 +45,20 @@ ShmemTransport::config() const
   return dynamic_rchandle_cast<ShmemInst>(TransportImpl::config());
 }
 
+ACE_Message_Block*
+ShmemTransport::loan_buffer(size_t size, ACE_Lock* locking_strategy)
+{
+#ifdef OPENDDS_SHMEM_RING
+  if (loan_pool_ && !is_shut_down()) {
+    return loan_pool_->loan(size, locking_strategy);
+  }
+#else
+  ACE_UNUSED_ARG(size);
+  ACE_UNUSED_ARG(locking_strategy);
+#endif
+  return 0;
+}
+
 ShmemDataLink_rch
 ShmemTransport::make_datalink(const std::string& remote_address)
 {
@@ -59,6 +79,7 @@ ShmemTransport::make_datalink(const std::string& remote_address)
     }
     return ShmemDataLink_rch();
   }
+  links_changed_ = true;
 
   return link;
 }
@@ -198,7 +219,32 @@ ShmemTransport::configure_i(const ShmemInst_rch& config)
                      false);
   }
 
-  read_task_.reset(new ReadTask(this, ace_sema));
+  ShmemWakeup* wakeup = 0;
+  if (config->ring_size_) {
+#  ifdef OPENDDS_SHMEM_RING
+    mem = alloc_->malloc(sizeof(ShmemWakeup));
+    if (mem == 0) {
+      if (log_level >= LogLevel::Error) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: ShmemTransport::configure_i: failed to allocate"
+                   " space for ring wakeup in shared memory!\n"));
+      }
+      return false;
+    }
+    wakeup = new (mem) ShmemWakeup;
+    wakeup->sleeping_.store(0);
+    wakeup->ring_size_ = ShmemRing::capacity_for(config->ring_size_);
+    // Writers in other processes look for this to decide to use rings.
+    alloc_->bind("Wakeup", wakeup);
+    loan_pool_ = new ShmemLoanPool(alloc_.get(), config->pool_size_);
+#  else
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: ShmemTransport::configure_i: "
+                 "ring_size is not supported on this platform, ignoring it\n"));
+    }
+#  endif
+  }
+
+  read_task_.reset(new ReadTask(this, ace_sema, wakeup, config->ring_spin_count_));
 
   VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemTransport %@ configured with address %C\n",
             this, config->poolname().c_str()), 1);
@@ -225,9 +271,21 @@ ShmemTransport::shutdown_i()
     it->second->transport_shutdown();
   }
   links_.clear();
+  links_changed_ = true;
+  // The reading thread has stopped
+  read_links_.clear();
 
   read_task_.reset();
 
+#ifdef OPENDDS_SHMEM_RING
+  if (loan_pool_) {
+    // Loaned buffers still held by the application are no longer backed by
+    // the pool once it's released.
+    loan_pool_->detach();
+    loan_pool_ = 0;
+  }
+#endif
+
   if (alloc_) {
 #ifndef OPENDDS_SHMEM_UNSUPPORTED
     void* mem = 0;
@@ -288,6 +346,9 @@ ShmemTransport::release_datalink(DataLink* link)
 
       link->stop();
       links_.erase(it);
+      links_changed_ = true;
+      // Let the reading thread drop its reference.
+      signal_semaphore();
       return;
     }
   }
@@ -297,10 +358,13 @@ ShmemTransport::release_datalink(DataLink* link)
             link), 1);
 }
 
-ShmemTransport::ReadTask::ReadTask(ShmemTransport* outer, ACE_sema_t semaphore)
+ShmemTransport::ReadTask::ReadTask(ShmemTransport* outer, ACE_sema_t semaphore,
+                                   ShmemWakeup* wakeup, size_t spin_count)
   : outer_(outer)
   , semaphore_(semaphore)
   , stopped_(false)
+  , wakeup_(wakeup)
+  , spin_count_(spin_count)
 {
   activate();
 }
@@ -310,6 +374,11 @@ ShmemTransport::ReadTask::svc()
 {
   ThreadStatusManager::Start s(TheServiceParticipant->get_thread_status_manager(), "ShmemTransport");
 
+  if (wakeup_) {
+    run_rings();
+    return 0;
+  }
+
   while (!stopped_) {
     ACE_OS::sema_wait(&semaphore_);
     if (stopped_) {
@@ -320,6 +389,38 @@ ShmemTransport::ReadTask::svc()
   return 0;
 }
 
+void
+ShmemTransport::ReadTask::run_rings()
+{
+#ifdef OPENDDS_SHMEM_RING
+  // Writers using rings only post the semaphore when we've announced that
+  // we're sleeping, writers using the control area always post it.  Polling
+  // for a while first saves both sides the system calls when samples arrive
+  // close together.
+  ShmemRingSpin spin(spin_count_);
+  while (!stopped_) {
+    if (outer_->read_from_links()) {
+      spin.found();
+      continue;
+    }
+    if (spin.spin()) {
+      continue;
+    }
+
+    // Announce that we're going to sleep, then check again so a writer that
+    // didn't see the announcement can't be missed.
+    wakeup_->sleeping_.store(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (outer_->read_from_links() || stopped_) {
+      wakeup_->sleeping_.store(0);
+      continue;
+    }
+    ACE_OS::sema_wait(&semaphore_);
+    wakeup_->sleeping_.store(0);
+  }
+#endif
+}
+
 void
 ShmemTransport::ReadTask::stop()
 {
@@ -341,28 +442,34 @@ ShmemTransport::ReadTask::signal_semaphore()
   ACE_OS::sema_post(&semaphore_);
 }
 
-void
+bool
 ShmemTransport::read_from_links()
 {
-  std::vector<ShmemDataLink_rch> dl_copies;
-  {
+  // Only the reading thread calls this, so it keeps its own copy of the
+  // links instead of copying them each time.
+  if (links_changed_) {
     GuardType guard(links_lock_);
-    typedef ShmemDataLinkMap::iterator iter_t;
-    for (iter_t it = links_.begin(); it != links_.end(); ++it) {
-      dl_copies.push_back(it->second);
+    links_changed_ = false;
+    read_links_.clear();
+    read_links_.reserve(links_.size());
+    for (ShmemDataLinkMap::iterator it = links_.begin(); it != links_.end(); ++it) {
+      read_links_.push_back(it->second);
     }
   }
 
-  typedef std::vector<ShmemDataLink_rch>::iterator dl_iter_t;
-  for (dl_iter_t dl_it = dl_copies.begin(); !is_shut_down() && dl_it != dl_copies.end(); ++dl_it) {
-    dl_it->in()->read();
+  bool found = false;
+  for (ShmemDataLinkVec::iterator it = read_links_.begin(); !is_shut_down() && it != read_links_.end(); ++it) {
+    if ((*it)->read()) {
+      found = true;
+    }
   }
+  return found;
 }
 
 void
 ShmemTransport::signal_semaphore()
 {
-  if (is_shut_down()) {
+  if (is_shut_down() || !read_task_) {
     return;
   }
   read_task_->signal_semaphore();
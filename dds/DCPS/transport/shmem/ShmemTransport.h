@@ -23,6 +23,8 @@ namespace OpenDDS {
 namespace DCPS {
 
 class ShmemInst;
+class ShmemLoanPool;
+struct ShmemWakeup;
 
 class OpenDDS_Shmem_Export ShmemTransport : public TransportImpl {
 public:
@@ -35,6 +37,13 @@ public:
 
   ShmemInst_rch config() const;
 
+  /// Null unless ring_size is configured.
+  ShmemLoanPool* loan_pool() const { return loan_pool_; }
+
+  /// Buffers from the shared memory pool that are sent over rings by
+  /// reference instead of being copied.
+  virtual ACE_Message_Block* loan_buffer(size_t size, ACE_Lock* locking_strategy);
+
 protected:
   virtual AcceptConnectResult connect_datalink(const RemoteTransport& remote,
                                                const ConnectionAttribs& attribs,
@@ -67,7 +76,7 @@ private:
 
   std::pair<std::string, std::string> blob_to_key(const TransportBLOB& blob);
 
-  void read_from_links(); // callback from ReadTask
+  bool read_from_links(); // callback from ReadTask, true if data was found
 
   typedef ACE_Thread_Mutex LockType;
   typedef ACE_Guard<LockType> GuardType;
@@ -79,19 +88,34 @@ private:
   typedef OPENDDS_MAP(std::string, ShmemDataLink_rch) ShmemDataLinkMap;
   ShmemDataLinkMap links_;
 
+  /// Set when links_ changes, the reading thread then copies it to
+  /// read_links_ which only it uses.
+  AtomicBool links_changed_;
+  typedef OPENDDS_VECTOR(ShmemDataLink_rch) ShmemDataLinkVec;
+  ShmemDataLinkVec read_links_;
+
   unique_ptr<ShmemAllocator> alloc_;
+  ShmemLoanPool* loan_pool_;
 
   class ReadTask : public ACE_Task_Base {
   public:
-    ReadTask(ShmemTransport* outer, ACE_sema_t semaphore);
+    ReadTask(ShmemTransport* outer, ACE_sema_t semaphore, ShmemWakeup* wakeup,
+             size_t spin_count);
     int svc();
     void stop();
     void signal_semaphore();
 
   private:
+    /// Read until no link has data, poll for a while, then block on the
+    /// semaphore.
+    void run_rings();
+
     ShmemTransport* outer_;
     ACE_sema_t semaphore_;
     AtomicBool stopped_;
+    ShmemWakeup* wakeup_;
+    /// See ShmemInst::ring_spin_count_
+    const size_t spin_count_;
   };
   unique_ptr<ReadTask> read_task_;
 };
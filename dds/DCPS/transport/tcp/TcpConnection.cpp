@@ -110,7 +110,17 @@ OpenDDS::DCPS::TcpConnection::disconnect()
     this->link_->drop_pending_request_acks();
   }
 
+  const ACE_HANDLE handle = this->peer().get_handle();
   this->peer().close();
+
+  if (this->link_ && handle != ACE_INVALID_HANDLE) {
+    // The socket can't be reading from the packets of its zero copy sends
+    // anymore.
+    TcpSendStrategy_rch send_strategy = this->link_->send_strategy();
+    if (send_strategy) {
+      send_strategy->zerocopy_closed(handle);
+    }
+  }
 }
 
 int
@@ -49,6 +49,15 @@ OpenDDS::DCPS::TcpInst::load(ACE_Configuration_Heap& cf,
   GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("enable_nagle_algorithm"),
                    this->enable_nagle_algorithm_, bool)
 
+  GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("send_coalesce_bytes"),
+                   this->send_coalesce_bytes_, size_t)
+
+  GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("enable_cork"),
+                   this->enable_cork_, bool)
+
+  GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("zerocopy_threshold"),
+                   this->zerocopy_threshold_, size_t)
+
   GET_CONFIG_VALUE(cf, trans_sect, ACE_TEXT("conn_retry_initial_delay"),
                    this->conn_retry_initial_delay_, int)
 
@@ -79,6 +88,9 @@ OpenDDS::DCPS::TcpInst::dump_to_str() const
   os << formatNameForDump("local_address")                 << this->local_address_string() << std::endl;
   os << formatNameForDump("pub_address")                   << this->pub_address_str_ << std::endl;
   os << formatNameForDump("enable_nagle_algorithm")        << (this->enable_nagle_algorithm_ ? "true" : "false") << std::endl;
+  os << formatNameForDump("send_coalesce_bytes")           << this->send_coalesce_bytes_ << std::endl;
+  os << formatNameForDump("enable_cork")                   << (this->enable_cork_ ? "true" : "false") << std::endl;
+  os << formatNameForDump("zerocopy_threshold")            << this->zerocopy_threshold_ << std::endl;
   os << formatNameForDump("conn_retry_initial_delay")      << this->conn_retry_initial_delay_ << std::endl;
   os << formatNameForDump("conn_retry_backoff_multiplier") << this->conn_retry_backoff_multiplier_ << std::endl;
   os << formatNameForDump("conn_retry_attempts")           << this->conn_retry_attempts_ << std::endl;
@@ -49,6 +49,22 @@ public:
 
   bool enable_nagle_algorithm_;
 
+  /// The number of bytes of queued samples that may be coalesced into one
+  /// vectored write when the queue is drained after backpressure.  Zero,
+  /// the default, limits those writes like any other packet.  Values below
+  /// optimum_packet_size_ are treated as optimum_packet_size_.
+  size_t send_coalesce_bytes_;
+
+  /// Set TCP_CORK (TCP_NOPUSH where that is what's available) on the socket
+  /// while queued samples are being drained so that the kernel only sends
+  /// full segments until the queue is empty.  The default is false.
+  bool enable_cork_;
+
+  /// Packets of at least this many bytes are sent with MSG_ZEROCOPY where
+  /// supported (Linux).  The sent data is held until the kernel reports
+  /// the send complete.  Zero, the default, disables zero copy sends.
+  size_t zerocopy_threshold_;
+
   /// The initial retry delay in milliseconds.
   /// The first connection retry will be when the loss of connection
   /// is detected.  The second try will be after this delay.
@@ -13,6 +13,9 @@ ACE_INLINE
 OpenDDS::DCPS::TcpInst::TcpInst(const OPENDDS_STRING& name)
   : TransportInst("tcp", name),
     enable_nagle_algorithm_(false),
+    send_coalesce_bytes_(0),
+    enable_cork_(false),
+    zerocopy_threshold_(0),
     conn_retry_initial_delay_(500),
     conn_retry_backoff_multiplier_(2.0),
     conn_retry_attempts_(3),
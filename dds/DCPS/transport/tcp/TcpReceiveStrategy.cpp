@@ -39,8 +39,8 @@ OpenDDS::DCPS::TcpReceiveStrategy::receive_bytes(
   iovec iov[],
   int   n,
   ACE_INET_Addr& /*remote_address*/,
-  ACE_HANDLE /*fd*/,
-  bool& /*stop*/)
+  ACE_HANDLE fd,
+  bool& stop)
 {
   DBG_ENTRY_LVL("TcpReceiveStrategy", "receive_bytes", 6);
 
@@ -50,7 +50,25 @@ OpenDDS::DCPS::TcpReceiveStrategy::receive_bytes(
     return 0;
   }
 
-  return connection->peer().recvv(iov, n);
+  const ssize_t result = connection->peer().recvv(iov, n);
+
+#ifdef ACE_LINUX
+  if (result == -1 && (errno == EWOULDBLOCK || errno == EAGAIN)) {
+    // Zero copy send completions are queued on the socket's error queue,
+    // which makes it readable without any data to receive.  That must not
+    // be mistaken for a failed connection.
+    TcpSendStrategy_rch send_strategy = connection->send_strategy();
+    if (send_strategy && send_strategy->reap_zerocopy_completions(fd)) {
+      stop = true;
+      return 0;
+    }
+  }
+#else
+  ACE_UNUSED_ARG(fd);
+  ACE_UNUSED_ARG(stop);
+#endif
+
+  return result;
 }
 
 void
@@ -16,6 +16,29 @@
 #include "dds/DCPS/ReactorTask.h"
 #include "dds/DCPS/transport/framework/ReactorSynchStrategy.h"
 
+#include "ace/os_include/netinet/os_tcp.h"
+#include "ace/Guard_T.h"
+#include "ace/OS_NS_sys_socket.h"
+
+#ifdef ACE_LINUX
+#  include <linux/errqueue.h>
+#  if defined MSG_ZEROCOPY && defined SO_ZEROCOPY && defined SO_EE_ORIGIN_ZEROCOPY
+#    define OPENDDS_TCP_ZEROCOPY
+#  endif
+#endif
+
+#if defined TCP_CORK
+#  define OPENDDS_TCP_CORK TCP_CORK
+#elif defined TCP_NOPUSH
+#  define OPENDDS_TCP_CORK TCP_NOPUSH
+#endif
+
+namespace {
+  /// Past this many uncompleted zero copy sends on a socket, send normally
+  /// until the kernel catches up.
+  const size_t MAX_ZEROCOPY_PENDING = 1024;
+}
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 OpenDDS::DCPS::TcpSendStrategy::TcpSendStrategy(
@@ -29,9 +52,21 @@ OpenDDS::DCPS::TcpSendStrategy::TcpSendStrategy(
                           make_rch<ReactorSynchStrategy>(this,task->get_reactor()))
   , link_(link)
   , reactor_task_(task)
+  , send_coalesce_bytes_(0)
+  , enable_cork_(false)
+  , zerocopy_threshold_(0)
+  , corked_handle_(ACE_INVALID_HANDLE)
+  , zerocopy_enabled_(false)
 {
   DBG_ENTRY_LVL("TcpSendStrategy","TcpSendStrategy",6);
 
+  TransportImpl_rch impl = link.impl();
+  TcpInst_rch cfg = impl ? dynamic_rchandle_cast<TcpInst>(impl->config()) : TcpInst_rch();
+  if (cfg) {
+    send_coalesce_bytes_ = cfg->send_coalesce_bytes_;
+    enable_cork_ = cfg->enable_cork_;
+    zerocopy_threshold_ = cfg->zerocopy_threshold_;
+  }
 }
 
 OpenDDS::DCPS::TcpSendStrategy::~TcpSendStrategy()
@@ -103,7 +138,10 @@ OpenDDS::DCPS::TcpSendStrategy::send_bytes_i(const iovec iov[], int n)
 
   if (!connection)
     return -1;
-  ssize_t result = connection->peer().sendv(iov, n);
+  ssize_t result = -1;
+  if (!send_zerocopy(connection->peer().get_handle(), iov, n, result)) {
+    result = connection->peer().sendv(iov, n);
+  }
   if (DCPS_debug_level > 4)
     ACE_DEBUG((LM_DEBUG, "(%P|%t) TcpSendStrategy::send_bytes_i sent %d bytes\n", result));
 
@@ -125,6 +163,9 @@ void
 OpenDDS::DCPS::TcpSendStrategy::stop_i()
 {
   DBG_ENTRY_LVL("TcpSendStrategy","stop_i",6);
+  ACE_Guard<ACE_Thread_Mutex> guard(zerocopy_mutex_);
+  zerocopy_sends_.release_all();
+  zerocopy_enabled_ = false;
 }
 
 void
@@ -143,4 +184,187 @@ OpenDDS::DCPS::TcpSendStrategy::terminate_send_if_suspended()
   this->clear(MODE_TERMINATED, MODE_SUSPEND);
 }
 
+OpenDDS::DCPS::ThreadSynchWorker::WorkOutcome
+OpenDDS::DCPS::TcpSendStrategy::perform_work()
+{
+  if (!enable_cork_) {
+    return TransportSendStrategy::perform_work();
+  }
+
+  // Keep partial segments in the kernel until the queue has been drained.
+  const ACE_HANDLE handle = get_handle();
+  if (handle != corked_handle_) {
+    set_cork(handle, true);
+  }
+
+  const WorkOutcome outcome = TransportSendStrategy::perform_work();
+
+  if (outcome != WORK_OUTCOME_MORE_TO_DO) {
+    set_cork(handle, false);
+  }
+  return outcome;
+}
+
+void
+OpenDDS::DCPS::TcpSendStrategy::set_cork(ACE_HANDLE handle, bool cork)
+{
+#ifdef OPENDDS_TCP_CORK
+  if (handle == ACE_INVALID_HANDLE) {
+    return;
+  }
+  int opt = cork;
+  if (ACE_OS::setsockopt(handle, IPPROTO_TCP, OPENDDS_TCP_CORK,
+                         reinterpret_cast<const char*>(&opt), sizeof opt) == -1) {
+    if (DCPS_debug_level > 0) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: TcpSendStrategy::set_cork: "
+                 "failed to %C handle %d: %m\n", cork ? "cork" : "uncork", handle));
+    }
+    return;
+  }
+  corked_handle_ = cork ? handle : ACE_INVALID_HANDLE;
+#else
+  ACE_UNUSED_ARG(handle);
+  ACE_UNUSED_ARG(cork);
+#endif
+}
+
+bool
+OpenDDS::DCPS::TcpSendStrategy::send_zerocopy(ACE_HANDLE handle, const iovec iov[], int n, ssize_t& result)
+{
+#ifdef OPENDDS_TCP_ZEROCOPY
+  // Only packets whose blocks can be held until the send completes qualify.
+  const ACE_Message_Block* const packet = packet_being_sent();
+  if (!zerocopy_threshold_ || !packet || n <= 0 || iov[0].iov_base != packet->rd_ptr()) {
+    return false;
+  }
+
+  size_t length = 0;
+  for (int i = 0; i < n; ++i) {
+    length += iov[i].iov_len;
+  }
+  if (length < zerocopy_threshold_) {
+    return false;
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(zerocopy_mutex_);
+
+  if (handle != zerocopy_sends_.handle()) {
+    // A new connection.  What is held for the old one is released when
+    // that is closed.
+    zerocopy_sends_.open(handle);
+    int one = 1;
+    zerocopy_enabled_ = ACE_OS::setsockopt(handle, SOL_SOCKET, SO_ZEROCOPY,
+                                           reinterpret_cast<const char*>(&one), sizeof one) == 0;
+    if (!zerocopy_enabled_ && DCPS_debug_level > 0) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: TcpSendStrategy::send_zerocopy: "
+                 "SO_ZEROCOPY not available on handle %d: %m\n", handle));
+    }
+  }
+
+  if (!zerocopy_enabled_) {
+    return false;
+  }
+
+  if (zerocopy_sends_.pending()) {
+    reap_zerocopy_i(handle);
+  }
+  if (!zerocopy_enabled_ || zerocopy_sends_.pending() >= MAX_ZEROCOPY_PENDING) {
+    return false;
+  }
+
+  msghdr msg = msghdr();
+  msg.msg_iov = const_cast<iovec*>(iov);
+  msg.msg_iovlen = n;
+  result = ::sendmsg(handle, &msg, MSG_ZEROCOPY);
+  if (result < 0) {
+    // ENOBUFS means the socket can't pin any more pages right now.
+    return errno != ENOBUFS;
+  }
+
+  if (result > 0) {
+    // The kernel reads from the packet's blocks until the send completes.
+    zerocopy_sends_.sent(packet);
+  }
+  return true;
+#else
+  ACE_UNUSED_ARG(handle);
+  ACE_UNUSED_ARG(iov);
+  ACE_UNUSED_ARG(n);
+  ACE_UNUSED_ARG(result);
+  return false;
+#endif
+}
+
+bool
+OpenDDS::DCPS::TcpSendStrategy::reap_zerocopy_completions(ACE_HANDLE handle)
+{
+  if (!zerocopy_threshold_) {
+    return false;
+  }
+  ACE_Guard<ACE_Thread_Mutex> guard(zerocopy_mutex_);
+  if (handle == ACE_INVALID_HANDLE || handle != zerocopy_sends_.handle()) {
+    return false;
+  }
+  return reap_zerocopy_i(handle);
+}
+
+void
+OpenDDS::DCPS::TcpSendStrategy::zerocopy_closed(ACE_HANDLE handle)
+{
+  if (!zerocopy_threshold_) {
+    return;
+  }
+  ACE_Guard<ACE_Thread_Mutex> guard(zerocopy_mutex_);
+  zerocopy_sends_.closed(handle);
+}
+
+bool
+OpenDDS::DCPS::TcpSendStrategy::reap_zerocopy_i(ACE_HANDLE handle)
+{
+  bool reaped = false;
+#ifdef OPENDDS_TCP_ZEROCOPY
+  for (;;) {
+    char control[128];
+    msghdr msg = msghdr();
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof control;
+    if (::recvmsg(handle, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+      break;
+    }
+    reaped = true;
+
+    for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+      const bool recverr = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+#  ifdef IPV6_RECVERR
+        || (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)
+#  endif
+        ;
+      if (!recverr) {
+        continue;
+      }
+      const sock_extended_err* const err = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cm));
+      if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+
+      if (zerocopy_enabled_ && (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)) {
+        // The kernel copied the data anyway (loopback, or a device without
+        // scatter-gather), so zero copy only adds the completion overhead.
+        zerocopy_enabled_ = false;
+        if (DCPS_debug_level > 4) {
+          ACE_DEBUG((LM_DEBUG, "(%P|%t) TcpSendStrategy::reap_zerocopy_i: "
+                     "zero copy sends on handle %d were copied, sending normally\n", handle));
+        }
+      }
+
+      // The completed sends are the ids in [ee_info, ee_data].
+      zerocopy_sends_.completed(err->ee_info, err->ee_data);
+    }
+  }
+#else
+  ACE_UNUSED_ARG(handle);
+#endif
+  return reaped;
+}
+
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
@@ -12,8 +12,12 @@
 #include "TcpDataLink_rch.h"
 #include "TcpInst_rch.h"
 #include "TcpConnection_rch.h"
+#include "TcpZerocopySends.h"
 #include "dds/DCPS/transport/framework/TransportSendStrategy.h"
 #include "dds/DCPS/ReactorTask_rch.h"
+#include "dds/DCPS/PoolAllocator.h"
+
+#include "ace/Thread_Mutex.h"
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -42,6 +46,18 @@ public:
   virtual void schedule_output();
   virtual void terminate_send_if_suspended();
 
+  /// Cork the socket, if configured, while the queue is drained.
+  virtual WorkOutcome perform_work();
+
+  /// Release the packets of the zero copy sends on 'handle' that the
+  /// kernel has completed.  Returns true if the socket's error queue
+  /// had anything to read, which also makes the socket readable.
+  bool reap_zerocopy_completions(ACE_HANDLE handle);
+
+  /// The connection closed 'handle', so release the packets of the zero
+  /// copy sends that were made on it.
+  void zerocopy_closed(ACE_HANDLE handle);
+
 protected:
 
   virtual ssize_t send_bytes(const iovec iov[], int n, int& bp);
@@ -54,9 +70,33 @@ protected:
 
   virtual void stop_i();
   virtual void add_delayed_notification(TransportQueueElement* element);
+
+  virtual size_t coalesce_budget() const { return send_coalesce_bytes_; }
+
 private:
+  void set_cork(ACE_HANDLE handle, bool cork);
+
+  /// Send with MSG_ZEROCOPY if this send qualifies.  Returns false if the
+  /// caller should send normally instead.
+  bool send_zerocopy(ACE_HANDLE handle, const iovec iov[], int n, ssize_t& result);
+  bool reap_zerocopy_i(ACE_HANDLE handle);
+
   TcpDataLink& link_;
   ReactorTask_rch reactor_task_;
+
+  size_t send_coalesce_bytes_;
+  bool enable_cork_;
+  size_t zerocopy_threshold_;
+
+  /// The handle currently corked, used only by the reactor thread.
+  ACE_HANDLE corked_handle_;
+
+  /// Protects the zero copy state, which is used by both the sending
+  /// thread and the reactor thread.
+  ACE_Thread_Mutex zerocopy_mutex_;
+  /// If zero copy sends are used on zerocopy_sends_.handle().
+  bool zerocopy_enabled_;
+  TcpZerocopySends zerocopy_sends_;
 };
 
 } // namespace DCPS
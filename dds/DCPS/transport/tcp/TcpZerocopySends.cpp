@@ -0,0 +1,135 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "TcpZerocopySends.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+TcpZerocopySends::TcpZerocopySends()
+  : handle_(ACE_INVALID_HANDLE)
+  , next_(0)
+{
+}
+
+TcpZerocopySends::~TcpZerocopySends()
+{
+  release_all();
+}
+
+void
+TcpZerocopySends::open(ACE_HANDLE handle)
+{
+  if (handle == handle_) {
+    return;
+  }
+
+  // A socket that is reused must have been closed, whether or not closed()
+  // was called for it.
+  const RetiredMap::iterator reused = retired_.find(handle);
+  if (reused != retired_.end()) {
+    release(reused->second);
+    retired_.erase(reused);
+  }
+
+  if (!pending_.empty()) {
+    retired_[handle_].swap(pending_);
+  }
+  handle_ = handle;
+  next_ = 0;
+}
+
+void
+TcpZerocopySends::sent(const ACE_Message_Block* packet)
+{
+  pending_[next_++] = packet->duplicate();
+}
+
+void
+TcpZerocopySends::completed(ACE_UINT32 first, ACE_UINT32 last)
+{
+  // The ids wrap around, so the range is measured from 'first'.
+  const ACE_UINT32 span = last - first;
+  if (span < pending_.size()) {
+    for (ACE_UINT32 id = first; ; ++id) {
+      const PendingMap::iterator pos = pending_.find(id);
+      if (pos != pending_.end()) {
+        pos->second->release();
+        pending_.erase(pos);
+      }
+      if (id == last) {
+        break;
+      }
+    }
+    return;
+  }
+
+  for (PendingMap::iterator pos = pending_.begin(); pos != pending_.end();) {
+    if (ACE_UINT32(pos->first - first) <= span) {
+      pos->second->release();
+      pending_.erase(pos++);
+    } else {
+      ++pos;
+    }
+  }
+}
+
+void
+TcpZerocopySends::closed(ACE_HANDLE handle)
+{
+  if (handle == ACE_INVALID_HANDLE) {
+    return;
+  }
+
+  const RetiredMap::iterator pos = retired_.find(handle);
+  if (pos != retired_.end()) {
+    release(pos->second);
+    retired_.erase(pos);
+  }
+
+  if (handle == handle_) {
+    release(pending_);
+    handle_ = ACE_INVALID_HANDLE;
+    next_ = 0;
+  }
+}
+
+void
+TcpZerocopySends::release_all()
+{
+  for (RetiredMap::iterator pos = retired_.begin(); pos != retired_.end(); ++pos) {
+    release(pos->second);
+  }
+  retired_.clear();
+  release(pending_);
+  handle_ = ACE_INVALID_HANDLE;
+  next_ = 0;
+}
+
+size_t
+TcpZerocopySends::retired() const
+{
+  size_t count = 0;
+  for (RetiredMap::const_iterator pos = retired_.begin(); pos != retired_.end(); ++pos) {
+    count += pos->second.size();
+  }
+  return count;
+}
+
+void
+TcpZerocopySends::release(PendingMap& pending)
+{
+  for (PendingMap::iterator pos = pending.begin(); pos != pending.end(); ++pos) {
+    pos->second->release();
+  }
+  pending.clear();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
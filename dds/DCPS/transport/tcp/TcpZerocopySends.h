@@ -0,0 +1,75 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_TCP_TCPZEROCOPYSENDS_H
+#define OPENDDS_DCPS_TRANSPORT_TCP_TCPZEROCOPYSENDS_H
+
+#include "Tcp_export.h"
+
+#include <dds/DCPS/PoolAllocator.h>
+
+#include <ace/Basic_Types.h>
+#include <ace/Message_Block.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * The packets of the MSG_ZEROCOPY sends that the kernel may still be
+ * reading from, see the zerocopy_threshold option of TcpInst.  The kernel
+ * numbers the zero copy sends on a socket from zero and reports their
+ * completion as ranges of those ids.
+ */
+class OpenDDS_Tcp_Export TcpZerocopySends {
+public:
+  TcpZerocopySends();
+  ~TcpZerocopySends();
+
+  /// The socket sends are being made on.
+  ACE_HANDLE handle() const { return handle_; }
+
+  /// Make the sends on 'handle'.  What is held for the previous socket is
+  /// kept until closed() is called for it, since it may still be sending.
+  void open(ACE_HANDLE handle);
+
+  /// Hold a duplicate of 'packet' for the next zero copy send on handle().
+  void sent(const ACE_Message_Block* packet);
+
+  /// Release the sends on handle() with ids in [first, last].
+  void completed(ACE_UINT32 first, ACE_UINT32 last);
+
+  /// 'handle' was closed, so nothing it sent can be read anymore.
+  void closed(ACE_HANDLE handle);
+
+  /// Release everything and forget handle().
+  void release_all();
+
+  /// The sends on handle() that haven't completed.
+  size_t pending() const { return pending_.size(); }
+
+  /// The sends held for sockets that were replaced but not closed yet.
+  size_t retired() const;
+
+private:
+  typedef OPENDDS_MAP(ACE_UINT32, ACE_Message_Block*) PendingMap;
+  typedef OPENDDS_MAP(ACE_HANDLE, PendingMap) RetiredMap;
+
+  static void release(PendingMap& pending);
+
+  ACE_HANDLE handle_;
+  /// The id the kernel will give the next zero copy send on handle_.
+  ACE_UINT32 next_;
+  PendingMap pending_;
+  RetiredMap retired_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_TCP_TCPZEROCOPYSENDS_H */
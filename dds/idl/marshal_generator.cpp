@@ -22,6 +22,7 @@
 #include <iostream>
 #include <cctype>
 #include <map>
+#include <algorithm>
 
 #define OPENDDS_IDL_STR(X) #X
 
@@ -1552,6 +1553,86 @@ namespace {
       break;
     }
   }
+
+  /**
+   * Returns true if the C++ representation of a value of 'type' has exactly
+   * the bytes of its CDR encoding in native byte order, provided the value
+   * starts at a position aligned to 'max_align'. In that case 'size' is the
+   * size of the representation (which has no padding) and 'max_align' is the
+   * largest alignment of any member. Only @final structs of integer and
+   * floating point members and arrays of them qualify.
+   */
+  bool memcpy_layout(AST_Type* type, size_t& size, size_t& max_align)
+  {
+    type = resolveActualType(type);
+    switch (type->node_type()) {
+    case AST_Decl::NT_pre_defined: {
+      AST_PredefinedType* p = dynamic_cast<AST_PredefinedType*>(type);
+      switch (p->pt()) {
+      case AST_PredefinedType::PT_char:
+      case AST_PredefinedType::PT_octet:
+#if OPENDDS_HAS_EXPLICIT_INTS
+      case AST_PredefinedType::PT_uint8:
+      case AST_PredefinedType::PT_int8:
+#endif
+        size = max_align = 1;
+        return true;
+      case AST_PredefinedType::PT_short:
+      case AST_PredefinedType::PT_ushort:
+        size = max_align = 2;
+        return true;
+      case AST_PredefinedType::PT_long:
+      case AST_PredefinedType::PT_ulong:
+      case AST_PredefinedType::PT_float:
+        size = max_align = 4;
+        return true;
+      case AST_PredefinedType::PT_longlong:
+      case AST_PredefinedType::PT_ulonglong:
+      case AST_PredefinedType::PT_double:
+        size = max_align = 8;
+        return true;
+      default:
+        // bool may only hold 0 or 1, and the C++ sizes of wchar and long
+        // double don't match CDR.
+        return false;
+      }
+    }
+    case AST_Decl::NT_array: {
+      AST_Array* const array_node = dynamic_cast<AST_Array*>(type);
+      AST_Type* const base = resolveActualType(array_node->base_type());
+      // Arrays of non-primitives have a DHEADER in XCDR2.
+      if (base->node_type() != AST_Decl::NT_pre_defined || !memcpy_layout(base, size, max_align)) {
+        return false;
+      }
+      size *= array_element_count(array_node);
+      return true;
+    }
+    case AST_Decl::NT_struct: {
+      AST_Structure* const struct_node = dynamic_cast<AST_Structure*>(type);
+      if (be_global->extensibility(struct_node) != extensibilitykind_final) {
+        return false;
+      }
+      size = 0;
+      max_align = 1;
+      const Fields fields(struct_node);
+      const Fields::Iterator fields_end = fields.end();
+      for (Fields::Iterator i = fields.begin(); i != fields_end; ++i) {
+        size_t field_size, field_align;
+        if (be_global->is_optional(*i) || be_global->is_external(*i)
+            || !memcpy_layout((*i)->field_type(), field_size, field_align)
+            || size % field_align) {
+          return false;
+        }
+        size += field_size;
+        max_align = (std::max)(max_align, field_align);
+      }
+      // Trailing padding would make sizeof larger than the encoding.
+      return size && size % max_align == 0;
+    }
+    default:
+      return false;
+    }
+  }
 }
 
 bool marshal_generator::gen_typedef(AST_Typedef* node, UTL_ScopedName* name, AST_Type* base, const char*)
@@ -2381,6 +2462,20 @@ namespace {
     return true;
   }
 
+  /// Returns true if the generated serialization of node can copy the whole
+  /// struct at once (see memcpy_layout).
+  bool use_memcpy_layout(AST_Structure* node, FieldFilter field_type, const RtpsFieldCustomizer& rtpsCustom,
+                         size_t& size, size_t& max_align, size_t& first_align)
+  {
+    if (field_type != FieldFilter_All || !rtpsCustom.cst_.empty() || !rtpsCustom.intro_.line_vec.empty()
+        || !memcpy_layout(node, size, max_align)) {
+      return false;
+    }
+    size_t first_size;
+    const Fields fields(node);
+    return memcpy_layout((*fields.begin())->field_type(), first_size, first_align);
+  }
+
   bool generate_struct_deserialization(
     AST_Structure* node, FieldFilter field_type)
   {
@@ -2413,6 +2508,10 @@ namespace {
     const bool is_mutable = exten == extensibilitykind_mutable;
     const bool is_appendable = exten == extensibilitykind_appendable;
 
+    size_t memcpy_size, memcpy_align, memcpy_first_align;
+    const bool use_memcpy = use_memcpy_layout(node, field_type, rtpsCustom,
+                                              memcpy_size, memcpy_align, memcpy_first_align);
+
     {
       Function extraction("operator>>", "bool");
       extraction.addArg("strm", "Serializer&");
@@ -2425,6 +2524,17 @@ namespace {
       be_global->impl_ <<
         "  const Encoding& encoding = strm.encoding();\n"
         "  ACE_UNUSED_ARG(encoding);\n";
+      if (use_memcpy) {
+        be_global->impl_ <<
+          "  if (!strm.swap_bytes() && sizeof stru == " << memcpy_size << ") {\n"
+          "    if (!strm.align_r(" << memcpy_first_align << ")) {\n"
+          "      return false;\n"
+          "    }\n"
+          "    if (strm.is_aligned_r(" << memcpy_align << ")) {\n"
+          "      return strm.read_octet_array(reinterpret_cast<ACE_CDR::Octet*>(&stru), " << memcpy_size << ");\n"
+          "    }\n"
+          "  }\n";
+      }
       if (is_appendable) {
         be_global->impl_ <<
           "  bool reached_end_of_struct = false;\n"
@@ -2672,6 +2782,10 @@ namespace {
     const bool not_final = exten != extensibilitykind_final;
     const bool is_mutable = exten == extensibilitykind_mutable;
 
+    size_t memcpy_size, memcpy_align, memcpy_first_align;
+    const bool use_memcpy = use_memcpy_layout(node, field_type, rtpsCustom,
+                                              memcpy_size, memcpy_align, memcpy_first_align);
+
     {
       Function serialized_size("serialized_size", "void");
       serialized_size.addArg("encoding", "const Encoding&");
@@ -2679,6 +2793,18 @@ namespace {
       serialized_size.addArg("stru", const_cpp_name);
       serialized_size.endArgs();
 
+      if (use_memcpy) {
+        be_global->impl_ <<
+          "  ACE_UNUSED_ARG(stru);\n"
+          "  encoding.align(size, " << memcpy_first_align << ");\n"
+          "  size_t aligned = size;\n"
+          "  encoding.align(aligned, " << memcpy_align << ");\n"
+          "  if (aligned == size) {\n"
+          "    size += " << memcpy_size << ";\n"
+          "    return;\n"
+          "  }\n";
+      }
+
       if (is_mutable) {
         /*
          * For parameter lists this is used to hold the total size while
@@ -2731,6 +2857,17 @@ namespace {
       be_global->impl_ <<
         "  const Encoding& encoding = strm.encoding();\n"
         "  ACE_UNUSED_ARG(encoding);\n";
+      if (use_memcpy) {
+        be_global->impl_ <<
+          "  if (!strm.swap_bytes() && sizeof stru == " << memcpy_size << ") {\n"
+          "    if (!strm.align_w(" << memcpy_first_align << ")) {\n"
+          "      return false;\n"
+          "    }\n"
+          "    if (strm.is_aligned_w(" << memcpy_align << ")) {\n"
+          "      return strm.write_octet_array(reinterpret_cast<const ACE_CDR::Octet*>(&stru), " << memcpy_size << ");\n"
+          "    }\n"
+          "  }\n";
+      }
       marshal_generator::generate_dheader_code(
         "    serialized_size(encoding, total_size, stru);\n"
         "    if (!strm.write_delimiter(total_size)) {\n"
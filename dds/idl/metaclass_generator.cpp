@@ -98,6 +98,32 @@ namespace {
     }
   }
 
+  void
+  gen_field_getFieldReader(AST_Field* field)
+  {
+    const bool use_cxx11 = be_global->language_mapping() == BE_GlobalData::LANGMAP_CXX11;
+    const Classification cls = classify(field->field_type());
+    const std::string member = std::string(use_cxx11 ? "_" : "") + field->local_name()->get_string();
+    const std::string idl_name = canonical_name(field);
+    // Enums are read as the names of their enumerators, and wide strings and
+    // fixed don't convert to Value the same way in both mappings, so those
+    // are left to getValue.
+    if ((cls & CL_SCALAR) && !(cls & (CL_ENUM | CL_WIDE | CL_FIXED))) {
+      be_global->impl_ <<
+        "    if (std::strcmp(field, \"" << idl_name << "\") == 0) {\n"
+        "      return make_member_reader(&T::" << member << ");\n"
+        "    }\n";
+    } else if (cls & CL_STRUCTURE) {
+      const size_t n = idl_name.size() + 1 /* 1 for the dot */;
+      const std::string fieldType = scoped(field->field_type()->name());
+      be_global->impl_ <<
+        "    if (std::strncmp(field, \"" << idl_name << ".\", " << n << ") == 0) {\n"
+        "      return make_nested_reader(&T::" << member << ", getMetaStruct<" << fieldType
+        << ">().getFieldReader(field + " << n << "));\n"
+        "    }\n";
+    }
+  }
+
   void
   gen_field_createQC(AST_Field* field)
   {
@@ -324,6 +350,13 @@ namespace {
       "    " << exception <<
       "  }\n\n";
     if (struct_node) {
+      be_global->impl_ <<
+        "  FieldReader::Ptr getFieldReader(const char* field) const\n"
+        "  {\n";
+      std::for_each(fields.begin(), fields.end(), gen_field_getFieldReader);
+      be_global->impl_ <<
+        "    return MetaStruct::getFieldReader(field);\n"
+        "  }\n\n";
       marshal_generator::gen_field_getValueFromSerialized(struct_node, clazz);
     } else {
       be_global->impl_ <<
@@ -33,7 +33,18 @@ DRPeriodicMonitorImpl::report() {
   if (!CORBA::is_nil(this->dr_per_writer_.in())) {
     DataReaderPeriodicReport report;
     report.dr_id   = dr_->get_guid();
-    //report.associations = dr_->
+    LatencyPercentilesSeq percentiles;
+    dr_->get_latency_percentiles(percentiles);
+    report.associations.length(percentiles.length());
+    for (CORBA::ULong i = 0; i < percentiles.length(); ++i) {
+      DataReaderAssociationPeriodic& assoc = report.associations[i];
+      assoc.dw_id = percentiles[i].publication;
+      assoc.samples_available = 0;
+      assoc.latency_count = percentiles[i].n;
+      assoc.latency_p50 = percentiles[i].p50;
+      assoc.latency_p99 = percentiles[i].p99;
+      assoc.latency_p99_99 = percentiles[i].p99_99;
+    }
     this->dr_per_writer_->write(report, DDS::HANDLE_NIL);
   }
 }
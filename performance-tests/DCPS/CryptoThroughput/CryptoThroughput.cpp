@@ -0,0 +1,161 @@
+#include <dds/DCPS/LocalObject.h>
+#include <dds/DCPS/TimeTypes.h>
+#include <dds/DCPS/security/CryptoBuiltInImpl.h>
+
+#include <dds/DdsSecurityParamsC.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/Thread_Manager.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace DDS::Security;
+using OpenDDS::DCPS::MonotonicTimePoint;
+using OpenDDS::DCPS::TimeDuration;
+using OpenDDS::Security::CryptoBuiltInImpl;
+
+namespace {
+
+struct FakeSharedSecret
+  : OpenDDS::DCPS::LocalObject<SharedSecretHandle> {
+
+  DDS::OctetSeq* challenge1() { return new DDS::OctetSeq; }
+  DDS::OctetSeq* challenge2() { return new DDS::OctetSeq; }
+  DDS::OctetSeq* sharedSecret() { return new DDS::OctetSeq; }
+};
+
+struct Plugins {
+  CryptoBuiltInImpl sender;
+  CryptoBuiltInImpl receiver;
+  FakeSharedSecret shared_secret;
+  size_t payloads;
+  size_t payload_size;
+};
+
+struct Endpoints {
+  Plugins* plugins;
+  DatawriterCryptoHandle local_writer;
+  DatareaderCryptoHandle local_reader;
+  DatawriterCryptoHandle remote_writer;
+};
+
+bool create_endpoints(Endpoints& ep, ParticipantCryptoHandle remote_participant)
+{
+  CryptoKeyFactory& sender_kf = ep.plugins->sender;
+  CryptoKeyExchange& sender_kx = ep.plugins->sender;
+  CryptoKeyFactory& receiver_kf = ep.plugins->receiver;
+  CryptoKeyExchange& receiver_kx = ep.plugins->receiver;
+
+  DDS::PropertySeq no_properties;
+  EndpointSecurityAttributes esa = {{false, false, false, false}, false, true, false,
+    PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED, no_properties};
+  SecurityException ex;
+
+  ep.local_writer = sender_kf.register_local_datawriter(0, no_properties, esa, ex);
+  ep.local_reader = receiver_kf.register_local_datareader(0, no_properties, esa, ex);
+  ep.remote_writer = receiver_kf.register_matched_remote_datawriter(
+    ep.local_reader, remote_participant, &ep.plugins->shared_secret, ex);
+
+  DatawriterCryptoTokenSeq tokens;
+  return ep.local_writer != DDS::HANDLE_NIL && ep.remote_writer != DDS::HANDLE_NIL
+    && sender_kx.create_local_datawriter_crypto_tokens(tokens, ep.local_writer, ep.remote_writer, ex)
+    && receiver_kx.set_remote_datawriter_crypto_tokens(ep.local_reader, ep.remote_writer, tokens, ex);
+}
+
+ACE_THR_FUNC_RETURN run(void* arg)
+{
+  const Endpoints& ep = *static_cast<Endpoints*>(arg);
+  CryptoTransform& sender_ct = ep.plugins->sender;
+  CryptoTransform& receiver_ct = ep.plugins->receiver;
+
+  DDS::OctetSeq plain(static_cast<CORBA::ULong>(ep.plugins->payload_size));
+  plain.length(plain.maximum());
+  for (CORBA::ULong i = 0; i < plain.length(); ++i) {
+    plain[i] = static_cast<CORBA::Octet>(i);
+  }
+
+  DDS::OctetSeq encoded, decoded, inline_qos;
+  SecurityException ex;
+  for (size_t i = 0; i < ep.plugins->payloads; ++i) {
+    if (!sender_ct.encode_serialized_payload(encoded, inline_qos, plain, ep.local_writer, ex)
+        || !receiver_ct.decode_serialized_payload(decoded, encoded, inline_qos,
+                                                  ep.local_reader, ep.remote_writer, ex)
+        || decoded.length() != plain.length()) {
+      std::printf("failed: %s\n", ex.message.in());
+      break;
+    }
+  }
+  return 0;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  size_t threads = 4;
+  size_t payloads = 100000;
+  size_t payload_size = 1024;
+  bool one_writer = false;
+
+  ACE_Arg_Shifter args(argc, argv);
+  while (args.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = args.get_the_parameter(ACE_TEXT("-t")))) {
+      threads = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-n")))) {
+      payloads = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-s")))) {
+      payload_size = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if (args.cur_arg_strncasecmp(ACE_TEXT("-w")) == 0) {
+      one_writer = true;
+      args.consume_arg();
+    } else {
+      args.ignore_arg();
+    }
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+
+  Plugins plugins;
+  plugins.payloads = payloads;
+  plugins.payload_size = payload_size;
+
+  CryptoKeyFactory& receiver_kf = plugins.receiver;
+  SecurityException ex;
+  const ParticipantCryptoHandle remote_participant =
+    receiver_kf.register_matched_remote_participant(0, 1, 2, &plugins.shared_secret, ex);
+
+  std::vector<Endpoints> endpoints(one_writer ? 1 : threads);
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    endpoints[i].plugins = &plugins;
+    if (!create_endpoints(endpoints[i], remote_participant)) {
+      std::printf("failed to create endpoints\n");
+      return 1;
+    }
+  }
+
+  ACE_Thread_Manager tm;
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < threads; ++i) {
+    tm.spawn(run, &endpoints[one_writer ? 0 : i]);
+  }
+  tm.wait();
+  const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+
+  const double us = elapsed / TimeDuration(0, 1);
+  const double total = static_cast<double>(threads) * payloads;
+  std::printf("threads: %lu writers: %lu payloads/thread: %lu size: %lu\n",
+              static_cast<unsigned long>(threads), static_cast<unsigned long>(endpoints.size()),
+              static_cast<unsigned long>(payloads), static_cast<unsigned long>(payload_size));
+  std::printf("%.3f us/payload (encode + decode), %.1f MB/s\n",
+              us / total, us > 0 ? total * payload_size / us : 0.0);
+
+  return 0;
+}
@@ -0,0 +1,276 @@
+#include "DiscoveryScaleTypeSupportImpl.h"
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/RTPS/RtpsDiscovery.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/TimeTypes.h>
+#include <dds/DCPS/WaitSet.h>
+#include <dds/DCPS/transport/framework/TransportRegistry.h>
+#include <dds/DCPS/transport/rtps_udp/RtpsUdpInst.h>
+#include <dds/DCPS/StaticIncludes.h>
+#ifdef ACE_AS_STATIC_LIBS
+#  include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+
+#include <cstdio>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+size_t participants = 10;
+size_t writers = 50;
+size_t readers = 50;
+size_t topics = 10;
+size_t partitions = 4;
+
+struct Endpoint {
+  size_t participant;
+  size_t topic;
+  size_t partition;
+};
+
+typedef std::map<std::pair<size_t, size_t>, CORBA::Long> ReaderCounts;
+
+String partition_name(size_t partition)
+{
+  char buf[32];
+  std::sprintf(buf, "partition %lu", static_cast<unsigned long>(partition));
+  return buf;
+}
+
+// Endpoint k of a participant uses topic k % topics, and the partitions are
+// spread so each participant uses all of them.
+Endpoint endpoint(size_t participant, size_t k)
+{
+  const Endpoint e = { participant, k % topics, (participant + k / topics) % partitions };
+  return e;
+}
+
+// Wait until the DataWriter is matched with 'current' DataReaders and has
+// been matched with 'total' since it was created.  The total tells a new
+// set of matches apart from an old set of the same size.
+void wait_for_writer(DDS::DataWriter_var dw, CORBA::Long current, CORBA::Long total)
+{
+  DDS::StatusCondition_var condition = dw->get_statuscondition();
+  condition->set_enabled_statuses(DDS::PUBLICATION_MATCHED_STATUS);
+  DDS::WaitSet_var ws = new DDS::WaitSet;
+  ws->attach_condition(condition);
+  const DDS::Duration_t forever = { DDS::DURATION_INFINITE_SEC, DDS::DURATION_INFINITE_NSEC };
+  DDS::PublicationMatchedStatus status;
+  while (dw->get_publication_matched_status(status) == DDS::RETCODE_OK &&
+         (status.current_count != current || status.total_count < total)) {
+    DDS::ConditionSeq conditions;
+    ws->wait(conditions, forever);
+  }
+  ws->detach_condition(condition);
+}
+
+// Wait until every DataWriter matches every DataReader of its topic and
+// partition, in every participant including its own.  If 'new_matches' each
+// of those is counted as a new match.
+void wait_for_writers(const std::vector<DDS::DataWriter_var>& dws,
+                      const std::vector<Endpoint>& dw_endpoints,
+                      const ReaderCounts& counts,
+                      std::vector<CORBA::Long>& totals,
+                      bool new_matches)
+{
+  for (size_t i = 0; i < dws.size(); ++i) {
+    const ReaderCounts::const_iterator it =
+      counts.find(std::make_pair(dw_endpoints[i].topic, dw_endpoints[i].partition));
+    const CORBA::Long current = it == counts.end() ? 0 : it->second;
+    if (new_matches) {
+      totals[i] += current;
+    }
+    wait_for_writer(dws[i], current, totals[i]);
+  }
+}
+
+void report(const char* phase, const TimeDuration& elapsed, size_t endpoints)
+{
+  std::printf("%s: %.3f ms, %.3f us/endpoint\n", phase,
+              elapsed / TimeDuration(0, 1000),
+              endpoints ? elapsed / TimeDuration(0, 1) / endpoints : 0.0);
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  DDS::DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+  DDS::DomainId_t domain = 114;
+  ACE_Arg_Shifter args(argc, argv);
+  while (args.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = args.get_the_parameter(ACE_TEXT("-p")))) {
+      participants = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-w")))) {
+      writers = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-r")))) {
+      readers = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-t")))) {
+      topics = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-n")))) {
+      partitions = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-d")))) {
+      domain = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else {
+      args.ignore_arg();
+    }
+  }
+  if (topics == 0) {
+    topics = 1;
+  }
+  if (partitions == 0) {
+    partitions = 1;
+  }
+
+  // Every participant sends SPDP to the unicast port of every other
+  // participant on the loopback interface, and SEDP and the transport only
+  // use unicast, so the benchmark doesn't depend on multicast.
+  OpenDDS::RTPS::RtpsDiscovery_rch disc = make_rch<OpenDDS::RTPS::RtpsDiscovery>("DiscoveryScale");
+  disc->sedp_multicast(false);
+  disc->sedp_local_address(ACE_INET_Addr("127.0.0.1:0"));
+  OpenDDS::RTPS::RtpsDiscovery::AddrVec send_addrs;
+  for (size_t i = 0; i < participants; ++i) {
+    char addr[32];
+    std::sprintf(addr, "127.0.0.1:%lu", static_cast<unsigned long>(
+      disc->pb() + disc->dg() * domain + disc->d1() + disc->pg() * i));
+    send_addrs.push_back(addr);
+  }
+  disc->spdp_send_addrs(send_addrs);
+  TheServiceParticipant->add_discovery(static_rchandle_cast<Discovery>(disc));
+  TheServiceParticipant->set_repo_domain(domain, disc->key());
+
+  std::vector<DDS::DomainParticipant_var> dps;
+  std::vector<std::vector<DDS::Topic_var> > dp_topics(participants);
+  std::vector<std::vector<DDS::Publisher_var> > pubs(participants);
+  std::vector<std::vector<DDS::Subscriber_var> > subs(participants);
+  for (size_t i = 0; i < participants; ++i) {
+    char name[32];
+    std::sprintf(name, "DiscoveryScale_%lu", static_cast<unsigned long>(i));
+    TransportInst_rch inst = TheTransportRegistry->create_inst(name, "rtps_udp");
+    RcHandle<RtpsUdpInst> rtps_inst = static_rchandle_cast<RtpsUdpInst>(inst);
+    rtps_inst->use_multicast_ = false;
+    rtps_inst->local_address(NetworkAddress("127.0.0.1:0"));
+    TransportConfig_rch config = TheTransportRegistry->create_config(name);
+    config->instances_.push_back(inst);
+
+    DDS::DomainParticipant_var dp = dpf->create_participant(domain, PARTICIPANT_QOS_DEFAULT, 0, 0);
+    if (!dp) {
+      ACE_ERROR_RETURN((LM_ERROR, "(%P|%t) ERROR: create_participant %lu failed\n",
+                        static_cast<unsigned long>(i)), 1);
+    }
+    TheTransportRegistry->bind_config(config, dp);
+    dps.push_back(dp);
+
+    DiscoveryScale::SampleTypeSupport_var ts = new DiscoveryScale::SampleTypeSupportImpl;
+    ts->register_type(dp, "");
+    CORBA::String_var type_name = ts->get_type_name();
+    for (size_t t = 0; t < topics; ++t) {
+      char topic_name[32];
+      std::sprintf(topic_name, "Topic %lu", static_cast<unsigned long>(t));
+      dp_topics[i].push_back(dp->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT, 0, 0));
+    }
+
+    for (size_t p = 0; p < partitions; ++p) {
+      DDS::PublisherQos pub_qos;
+      dp->get_default_publisher_qos(pub_qos);
+      pub_qos.partition.name.length(1);
+      pub_qos.partition.name[0] = partition_name(p).c_str();
+      pubs[i].push_back(dp->create_publisher(pub_qos, 0, 0));
+
+      DDS::SubscriberQos sub_qos;
+      dp->get_default_subscriber_qos(sub_qos);
+      sub_qos.partition.name.length(1);
+      sub_qos.partition.name[0] = partition_name(p).c_str();
+      subs[i].push_back(dp->create_subscriber(sub_qos, 0, 0));
+    }
+  }
+
+  // Creating the endpoints and matching them.
+  std::vector<DDS::DataWriter_var> dws;
+  std::vector<Endpoint> dw_endpoints;
+  std::vector<DDS::DataReader_var> drs;
+  std::vector<Endpoint> dr_endpoints;
+  ReaderCounts counts;
+  const MonotonicTimePoint match_start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < participants; ++i) {
+    for (size_t k = 0; k < writers; ++k) {
+      const Endpoint e = endpoint(i, k);
+      dws.push_back(pubs[i][e.partition]->create_datawriter(dp_topics[i][e.topic], DATAWRITER_QOS_DEFAULT, 0, 0));
+      dw_endpoints.push_back(e);
+    }
+    for (size_t k = 0; k < readers; ++k) {
+      const Endpoint e = endpoint(i, k);
+      drs.push_back(subs[i][e.partition]->create_datareader(dp_topics[i][e.topic], DATAREADER_QOS_DEFAULT, 0, 0));
+      dr_endpoints.push_back(e);
+      ++counts[std::make_pair(e.topic, e.partition)];
+    }
+  }
+  std::vector<CORBA::Long> totals(dws.size());
+  wait_for_writers(dws, dw_endpoints, counts, totals, true);
+  const TimeDuration match_time = MonotonicTimePoint::now() - match_start;
+
+  // Every Subscriber moves to the next partition.
+  counts.clear();
+  for (size_t i = 0; i < dr_endpoints.size(); ++i) {
+    dr_endpoints[i].partition = (dr_endpoints[i].partition + 1) % partitions;
+    ++counts[std::make_pair(dr_endpoints[i].topic, dr_endpoints[i].partition)];
+  }
+  const MonotonicTimePoint qos_start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < participants; ++i) {
+    for (size_t p = 0; p < partitions; ++p) {
+      DDS::SubscriberQos sub_qos;
+      subs[i][p]->get_qos(sub_qos);
+      sub_qos.partition.name[0] = partition_name((p + 1) % partitions).c_str();
+      subs[i][p]->set_qos(sub_qos);
+    }
+  }
+  wait_for_writers(dws, dw_endpoints, counts, totals, partitions > 1);
+  const TimeDuration qos_time = MonotonicTimePoint::now() - qos_start;
+
+  // The DataReaders of the first half of the participants are deleted.
+  const size_t removed_participants = participants / 2;
+  counts.clear();
+  for (size_t i = removed_participants * readers; i < dr_endpoints.size(); ++i) {
+    ++counts[std::make_pair(dr_endpoints[i].topic, dr_endpoints[i].partition)];
+  }
+  const MonotonicTimePoint remove_start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < removed_participants * readers; ++i) {
+    DDS::Subscriber_var sub = drs[i]->get_subscriber();
+    sub->delete_datareader(drs[i]);
+  }
+  wait_for_writers(dws, dw_endpoints, counts, totals, false);
+  const TimeDuration remove_time = MonotonicTimePoint::now() - remove_start;
+
+  std::printf("participants: %lu writers: %lu readers: %lu topics: %lu partitions: %lu\n",
+              static_cast<unsigned long>(participants), static_cast<unsigned long>(dws.size()),
+              static_cast<unsigned long>(drs.size()), static_cast<unsigned long>(topics),
+              static_cast<unsigned long>(partitions));
+  report("match", match_time, dws.size() + drs.size());
+  report("partition change", qos_time, drs.size());
+  report("remove", remove_time, removed_participants * readers);
+
+  for (size_t i = 0; i < dps.size(); ++i) {
+    dps[i]->delete_contained_entities();
+    dpf->delete_participant(dps[i]);
+  }
+  TheServiceParticipant->shutdown();
+
+  return 0;
+}
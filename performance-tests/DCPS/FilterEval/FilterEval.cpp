@@ -0,0 +1,117 @@
+#include "FilterEvalTypeSupportImpl.h"
+
+#include <dds/DCPS/FilterEvaluator.h>
+#include <dds/DCPS/Message_Block_Ptr.h>
+#include <dds/DCPS/RcHandle_T.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+const char* const filters[] = {
+  "id = %0",
+  "value > %0 AND seq < 1000000",
+  "seq BETWEEN %0 AND 1000000 OR name LIKE 'sample%'",
+  "MOD(seq, 7) = %0",
+};
+
+ACE_Message_Block* serialize(const Encoding& enc, const FilterEval::Sample& sample)
+{
+  const EncapsulationHeader encapsulation(enc, APPENDABLE);
+  size_t sz = EncapsulationHeader::serialized_size;
+  serialized_size(enc, sz, sample);
+  Message_Block_Ptr mb(new ACE_Message_Block(sz));
+  Serializer ser(mb.get(), enc);
+  if (!(ser << encapsulation) || !(ser << sample)) {
+    return 0;
+  }
+  return mb.release();
+}
+
+double ns_per_eval(const TimeDuration& duration, double evals)
+{
+  return duration / TimeDuration(0, 1) * 1000.0 / evals;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  size_t readers = 1000;
+  size_t samples = 1000;
+
+  ACE_Arg_Shifter args(argc, argv);
+  while (args.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = args.get_the_parameter(ACE_TEXT("-r")))) {
+      readers = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-s")))) {
+      samples = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else {
+      args.ignore_arg();
+    }
+  }
+
+  const Encoding enc(Encoding::KIND_XCDR2);
+  FilterEval::SampleTypeSupportImpl type_support;
+
+  std::vector<FilterEval::Sample> data(samples);
+  std::vector<ACE_Message_Block*> serialized(samples);
+  for (size_t i = 0; i < samples; ++i) {
+    data[i].id = static_cast<CORBA::Long>(i % readers);
+    data[i].seq = static_cast<CORBA::Long>(i);
+    data[i].value = i * 0.5;
+    data[i].name = i % 2 ? "sample" : "other";
+    serialized[i] = serialize(enc, data[i]);
+  }
+
+  for (size_t f = 0; f < sizeof filters / sizeof filters[0]; ++f) {
+    std::vector<RcHandle<FilterEvaluator> > evaluators;
+    std::vector<DDS::StringSeq> params(readers);
+    for (size_t r = 0; r < readers; ++r) {
+      evaluators.push_back(make_rch<FilterEvaluator>(filters[f], false));
+      params[r].length(1);
+      char buffer[32];
+      std::sprintf(buffer, "%lu", static_cast<unsigned long>(r % 7));
+      params[r][0] = buffer;
+    }
+
+    size_t matched = 0;
+    const MonotonicTimePoint start = MonotonicTimePoint::now();
+    for (size_t i = 0; i < samples; ++i) {
+      for (size_t r = 0; r < readers; ++r) {
+        matched += evaluators[r]->eval(data[i], params[r]);
+      }
+    }
+    const MonotonicTimePoint middle = MonotonicTimePoint::now();
+    for (size_t i = 0; i < samples; ++i) {
+      for (size_t r = 0; r < readers; ++r) {
+        matched += evaluators[r]->eval(serialized[i], enc, type_support, params[r]);
+      }
+    }
+    const MonotonicTimePoint end = MonotonicTimePoint::now();
+
+    const double evals = static_cast<double>(samples * readers);
+    std::cout << filters[f] << "\n"
+              << "  deserialized: " << ns_per_eval(middle - start, evals) << " ns/eval\n"
+              << "  serialized:   " << ns_per_eval(end - middle, evals) << " ns/eval\n"
+              << "  matched: " << matched << std::endl;
+  }
+
+  for (size_t i = 0; i < samples; ++i) {
+    ACE_Message_Block::release(serialized[i]);
+  }
+
+  return EXIT_SUCCESS;
+}
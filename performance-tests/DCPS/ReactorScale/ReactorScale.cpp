@@ -0,0 +1,151 @@
+#include <dds/DCPS/Atomic.h>
+#include <dds/DCPS/ReactorTask.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/ThreadStatusManager.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Event_Handler.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_Thread.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/Pipe.h>
+#include <ace/Reactor.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+Atomic<size_t> dispatched(0);
+
+class PipeHandler : public ACE_Event_Handler {
+public:
+  explicit PipeHandler(ACE_HANDLE handle)
+    : handle_(handle)
+  {}
+
+  ACE_HANDLE get_handle() const { return handle_; }
+
+  int handle_input(ACE_HANDLE)
+  {
+    char c;
+    if (ACE_OS::read(handle_, &c, 1) == 1) {
+      ++dispatched;
+    }
+    return 0;
+  }
+
+private:
+  ACE_HANDLE handle_;
+};
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  size_t handles = 10000;
+  size_t events = 100000;
+  size_t batch = 100;
+  String type = "select";
+
+  ACE_Arg_Shifter args(argc, argv);
+  while (args.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = args.get_the_parameter(ACE_TEXT("-n")))) {
+      handles = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-e")))) {
+      events = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-b")))) {
+      batch = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-t")))) {
+      type = ACE_TEXT_ALWAYS_CHAR(arg);
+      args.consume_arg();
+    } else {
+      args.ignore_arg();
+    }
+  }
+  if (batch == 0 || batch > handles) {
+    batch = handles;
+  }
+
+  TheServiceParticipant->reactor_type(type);
+  ThreadStatusManager tsm;
+  ReactorTask reactor_task(false);
+  reactor_task.open_reactor_task(0, &tsm, "ReactorScale");
+  ACE_Reactor* const reactor = reactor_task.get_reactor();
+
+  std::vector<ACE_Pipe*> pipes;
+  std::vector<PipeHandler*> handlers;
+  pipes.reserve(handles);
+  handlers.reserve(handles);
+  const MonotonicTimePoint register_start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < handles; ++i) {
+    ACE_Pipe* const pipe = new ACE_Pipe;
+    if (pipe->open() != 0) {
+      delete pipe;
+      std::printf("could only open %lu pipes\n", static_cast<unsigned long>(pipes.size()));
+      break;
+    }
+    PipeHandler* const handler = new PipeHandler(pipe->read_handle());
+    if (reactor->register_handler(handler, ACE_Event_Handler::READ_MASK) != 0) {
+      pipe->close();
+      delete pipe;
+      delete handler;
+      std::printf("%s reactor could only register %lu handles\n",
+                  type.c_str(), static_cast<unsigned long>(handlers.size()));
+      break;
+    }
+    pipes.push_back(pipe);
+    handlers.push_back(handler);
+  }
+  const TimeDuration register_time = MonotonicTimePoint::now() - register_start;
+
+  if (batch > handlers.size()) {
+    batch = handlers.size();
+  }
+
+  // Each batch writes to a different set of handles spread over all of them,
+  // then waits for the reactor to dispatch every one.
+  size_t sent = 0;
+  size_t next = 0;
+  const size_t stride = handlers.empty() ? 1 : handlers.size() / batch;
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  while (batch && sent < events) {
+    for (size_t i = 0; i < batch; ++i) {
+      const char c = 0;
+      ACE_OS::write(pipes[(next + i * stride) % pipes.size()]->write_handle(), &c, 1);
+    }
+    ++next;
+    sent += batch;
+    while (dispatched.load() < sent) {
+      ACE_OS::thr_yield();
+    }
+  }
+  const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+
+  std::printf("reactor: %s handles: %lu events: %lu batch: %lu\n", type.c_str(),
+              static_cast<unsigned long>(handlers.size()), static_cast<unsigned long>(sent),
+              static_cast<unsigned long>(batch));
+  std::printf("register: %.3f us/handle\n",
+              handlers.empty() ? 0.0 : register_time / TimeDuration(0, 1) / handlers.size());
+  std::printf("dispatch: %.3f us/event, %.3f us/batch\n",
+              sent ? elapsed / TimeDuration(0, 1) / sent : 0.0,
+              sent ? elapsed / TimeDuration(0, 1) * batch / sent : 0.0);
+
+  for (size_t i = 0; i < handlers.size(); ++i) {
+    reactor->remove_handler(handlers[i], ACE_Event_Handler::ALL_EVENTS_MASK | ACE_Event_Handler::DONT_CALL);
+    delete handlers[i];
+    pipes[i]->close();
+    delete pipes[i];
+  }
+  reactor_task.stop();
+
+  return 0;
+}
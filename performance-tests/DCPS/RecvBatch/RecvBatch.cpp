@@ -0,0 +1,135 @@
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/ACE.h>
+#include <ace/Arg_Shifter.h>
+#include <ace/Handle_Set.h>
+#include <ace/INET_Addr.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/SOCK_Dgram.h>
+
+#include <cstdio>
+#include <vector>
+
+#if defined ACE_LINUX && defined MSG_WAITFORONE
+#  define RECV_BATCH_MMSG
+#endif
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+const size_t BUFFER_SIZE = 65536;
+
+// Wait for the socket to be readable like the reactor does before each
+// call to handle_input.
+bool wait_readable(ACE_HANDLE handle)
+{
+  ACE_Handle_Set set;
+  set.set_bit(handle);
+  ACE_Time_Value timeout(0, 100000);
+  return ACE::select(static_cast<int>(handle) + 1, set, &timeout) > 0;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  size_t size = 64;
+  size_t batch = 32;
+  size_t burst = 2000;
+  size_t rounds = 200;
+
+  ACE_Arg_Shifter args(argc, argv);
+  while (args.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = args.get_the_parameter(ACE_TEXT("-s")))) {
+      size = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-b")))) {
+      batch = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-n")))) {
+      burst = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-i")))) {
+      rounds = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else {
+      args.ignore_arg();
+    }
+  }
+  if (batch == 0) {
+    batch = 1;
+  }
+#ifndef RECV_BATCH_MMSG
+  if (batch > 1) {
+    std::printf("recvmmsg is not available, using -b 1\n");
+    batch = 1;
+  }
+#endif
+
+  ACE_INET_Addr local(u_short(0), "127.0.0.1");
+  ACE_SOCK_Dgram receiver(local);
+  ACE_SOCK_Dgram sender(ACE_INET_Addr(u_short(0), "127.0.0.1"));
+  receiver.get_local_addr(local);
+  int rcvbuf = 64 * 1024 * 1024;
+  receiver.set_option(SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof rcvbuf);
+  receiver.enable(ACE_NONBLOCK);
+
+  std::vector<char> out(size, 'x');
+  std::vector<std::vector<char> > buffers(batch, std::vector<char>(BUFFER_SIZE));
+#ifdef RECV_BATCH_MMSG
+  std::vector<mmsghdr> headers(batch);
+  std::vector<iovec> iov(batch);
+  std::vector<sockaddr_storage> from(batch);
+#endif
+
+  size_t received = 0;
+  size_t wakeups = 0;
+  TimeDuration elapsed;
+  for (size_t round = 0; round < rounds; ++round) {
+    // Queue a burst in the receiver's socket buffer and time draining it.
+    for (size_t i = 0; i < burst; ++i) {
+      sender.send(&out[0], size, local);
+    }
+
+    const size_t expected = received + burst;
+    const MonotonicTimePoint start = MonotonicTimePoint::now();
+    while (received < expected && wait_readable(receiver.get_handle())) {
+      ++wakeups;
+      if (batch == 1) {
+        ACE_INET_Addr remote;
+        if (receiver.recv(&buffers[0][0], BUFFER_SIZE, remote) > 0) {
+          ++received;
+        }
+        continue;
+      }
+#ifdef RECV_BATCH_MMSG
+      for (size_t i = 0; i < batch; ++i) {
+        iov[i].iov_base = &buffers[i][0];
+        iov[i].iov_len = BUFFER_SIZE;
+        headers[i].msg_hdr = msghdr();
+        headers[i].msg_hdr.msg_name = &from[i];
+        headers[i].msg_hdr.msg_namelen = sizeof from[i];
+        headers[i].msg_hdr.msg_iov = &iov[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+      }
+      const int count = ::recvmmsg(receiver.get_handle(), &headers[0],
+                                   static_cast<unsigned int>(batch), MSG_DONTWAIT, 0);
+      if (count > 0) {
+        received += count;
+      }
+#endif
+    }
+    elapsed += MonotonicTimePoint::now() - start;
+  }
+
+  const double seconds = elapsed / TimeDuration(1, 0);
+  std::printf("size: %lu batch: %lu received: %lu of %lu wakeups: %lu datagrams per second: %.0f\n",
+              static_cast<unsigned long>(size), static_cast<unsigned long>(batch),
+              static_cast<unsigned long>(received), static_cast<unsigned long>(burst * rounds),
+              static_cast<unsigned long>(wakeups), seconds > 0 ? received / seconds : 0.0);
+
+  return received == burst * rounds ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include <dds/DCPS/ConfigStoreImpl.h>
+#include <dds/DCPS/DisjointSequence.h>
+#include <dds/DCPS/Message_Block_Ptr.h>
+#include <dds/DCPS/TimeTypes.h>
+#include <dds/DCPS/transport/framework/MessageDropper.h>
+#include <dds/DCPS/transport/framework/TransportSendBuffer.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Message_Block.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+size_t samples = 10000;
+size_t readers = 10;
+double loss = 0.1;
+double loss_per_byte = 0;
+size_t size = 256;
+size_t rounds = 100;
+size_t depth = SingleSendBuffer::UNLIMITED;
+
+void insert(SingleSendBuffer& buffer, SequenceNumber seq)
+{
+  TransportSendStrategy::QueueType queue;
+  Message_Block_Ptr chain(new ACE_Message_Block(size));
+  chain->wr_ptr(size);
+  buffer.insert(seq, &queue, chain.get());
+}
+
+double ns_per(size_t count, const TimeDuration& elapsed)
+{
+  return count ? elapsed / TimeDuration(0, 1) * 1000 / static_cast<double>(count) : 0.0;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  ACE_Arg_Shifter args(argc, argv);
+  while (args.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = args.get_the_parameter(ACE_TEXT("-n")))) {
+      samples = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-r")))) {
+      readers = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-b")))) {
+      loss = ACE_OS::strtod(arg, 0);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-m")))) {
+      loss_per_byte = ACE_OS::strtod(arg, 0);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-s")))) {
+      size = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-i")))) {
+      rounds = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-d")))) {
+      depth = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else {
+      args.ignore_arg();
+    }
+  }
+  if (samples < 10) {
+    samples = 10;
+  }
+
+  RcHandle<ConfigStoreImpl> config_store = make_rch<ConfigStoreImpl>();
+  config_store->set_boolean("BENCH_DROP_MESSAGES", true);
+  config_store->set_float64("BENCH_DROP_MESSAGES_M", loss_per_byte);
+  config_store->set_float64("BENCH_DROP_MESSAGES_B", loss);
+  MessageDropper dropper;
+  dropper.reload(config_store, "BENCH");
+
+  std::printf("samples: %lu readers: %lu loss: %g loss per byte: %g size: %lu rounds: %lu depth: %lu\n",
+              static_cast<unsigned long>(samples), static_cast<unsigned long>(readers),
+              loss, loss_per_byte, static_cast<unsigned long>(size),
+              static_cast<unsigned long>(rounds), static_cast<unsigned long>(depth));
+
+  SingleSendBuffer buffer(depth, 1);
+  SequenceNumber low;
+  SequenceNumber next;
+  for (size_t i = 0; i < samples; ++i) {
+    insert(buffer, next++);
+  }
+
+  const size_t slide = samples / 10;
+  size_t requested = 0;
+  size_t found = 0;
+  size_t released = 0;
+  TimeDuration nack_time;
+  TimeDuration slide_time;
+  std::vector<DisjointSequence> lost(readers);
+
+  for (size_t round = 0; round < rounds; ++round) {
+    for (size_t r = 0; r < readers; ++r) {
+      lost[r].reset();
+      for (SequenceNumber seq = low; seq < next; ++seq) {
+        if (dropper.should_drop(static_cast<ssize_t>(size))) {
+          lost[r].insert(seq);
+        }
+      }
+    }
+
+    const MonotonicTimePoint nack_start = MonotonicTimePoint::now();
+    {
+      SingleSendBuffer::Proxy proxy(buffer);
+      for (size_t r = 0; r < readers; ++r) {
+        const OPENDDS_VECTOR(SequenceRange) ranges = lost[r].present_sequence_ranges();
+        for (size_t i = 0; i < ranges.size(); ++i) {
+          for (SequenceNumber seq = ranges[i].first; seq <= ranges[i].second; ++seq) {
+            GUID_t destination;
+            if (proxy.contains(seq, destination) && !proxy.has_frags(seq)) {
+              ++found;
+            }
+            ++requested;
+          }
+        }
+      }
+    }
+    nack_time += MonotonicTimePoint::now() - nack_start;
+
+    const MonotonicTimePoint slide_start = MonotonicTimePoint::now();
+    for (size_t i = 0; i < slide; ++i) {
+      buffer.release_acked(low++);
+      insert(buffer, next++);
+    }
+    slide_time += MonotonicTimePoint::now() - slide_start;
+    released += slide;
+  }
+
+  std::printf("nack lookups %lu (%lu buffered) %9.1f ns each\n",
+              static_cast<unsigned long>(requested), static_cast<unsigned long>(found),
+              ns_per(requested, nack_time));
+  std::printf("release and insert %lu %9.1f ns each\n",
+              static_cast<unsigned long>(released), ns_per(released, slide_time));
+
+  // A depth smaller than the number of samples ages off the oldest ones.
+  return found == requested || (depth != SingleSendBuffer::UNLIMITED && depth < samples) ? 0 : 1;
+}
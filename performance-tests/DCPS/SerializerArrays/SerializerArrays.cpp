@@ -0,0 +1,153 @@
+#include <dds/DCPS/ByteSwap.h>
+#include <dds/DCPS/Message_Block_Ptr.h>
+#include <dds/DCPS/Serializer.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Arg_Shifter.h>
+#include <ace/Message_Block.h>
+#include <ace/OS_main.h>
+#include <ace/OS_NS_stdlib.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+size_t elements = 4096;
+size_t iterations = 10000;
+size_t block = 0;
+
+ACE_Message_Block* make_chain(size_t bytes)
+{
+  if (block == 0) {
+    return new ACE_Message_Block(bytes);
+  }
+  ACE_Message_Block* const head = new ACE_Message_Block(block);
+  ACE_Message_Block* tail = head;
+  for (size_t total = block; total < bytes; total += block) {
+    tail->cont(new ACE_Message_Block(block));
+    tail = tail->cont();
+  }
+  return head;
+}
+
+void reset_chain(ACE_Message_Block* chain)
+{
+  for (ACE_Message_Block* mb = chain; mb; mb = mb->cont()) {
+    mb->reset();
+  }
+}
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<ACE_CDR::UShort> {
+  static const char* name() { return "ushort"; }
+  static bool write(Serializer& s, const ACE_CDR::UShort* x, ACE_CDR::ULong n) { return s.write_ushort_array(x, n); }
+  static bool read(Serializer& s, ACE_CDR::UShort* x, ACE_CDR::ULong n) { return s.read_ushort_array(x, n); }
+};
+
+template <>
+struct Ops<ACE_CDR::ULong> {
+  static const char* name() { return "ulong"; }
+  static bool write(Serializer& s, const ACE_CDR::ULong* x, ACE_CDR::ULong n) { return s.write_ulong_array(x, n); }
+  static bool read(Serializer& s, ACE_CDR::ULong* x, ACE_CDR::ULong n) { return s.read_ulong_array(x, n); }
+};
+
+template <>
+struct Ops<ACE_CDR::Double> {
+  static const char* name() { return "double"; }
+  static bool write(Serializer& s, const ACE_CDR::Double* x, ACE_CDR::ULong n) { return s.write_double_array(x, n); }
+  static bool read(Serializer& s, ACE_CDR::Double* x, ACE_CDR::ULong n) { return s.read_double_array(x, n); }
+};
+
+double mb_per_sec(size_t bytes, const TimeDuration& elapsed)
+{
+  const double us = elapsed / TimeDuration(0, 1);
+  return us > 0 ? static_cast<double>(bytes) * iterations / us : 0.0;
+}
+
+template <typename T>
+bool run(Endianness endianness)
+{
+  const ACE_CDR::ULong n = static_cast<ACE_CDR::ULong>(elements);
+  const size_t bytes = sizeof(T) * elements;
+  std::vector<T> in(elements), out(elements);
+  for (size_t i = 0; i < elements; ++i) {
+    in[i] = static_cast<T>(i * 3 + 1);
+  }
+
+  Message_Block_Ptr chain(make_chain(bytes));
+  const Encoding encoding(Encoding::KIND_XCDR2, endianness);
+
+  const MonotonicTimePoint write_start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    reset_chain(chain.get());
+    Serializer ser(chain.get(), encoding);
+    if (!Ops<T>::write(ser, &in[0], n)) {
+      std::printf("%s: write failed\n", Ops<T>::name());
+      return false;
+    }
+  }
+  const TimeDuration write_time = MonotonicTimePoint::now() - write_start;
+
+  const MonotonicTimePoint read_start = MonotonicTimePoint::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    Serializer ser(chain.get(), encoding);
+    if (!Ops<T>::read(ser, &out[0], n)) {
+      std::printf("%s: read failed\n", Ops<T>::name());
+      return false;
+    }
+  }
+  const TimeDuration read_time = MonotonicTimePoint::now() - read_start;
+
+  if (in != out) {
+    std::printf("%s: values read don't match\n", Ops<T>::name());
+    return false;
+  }
+
+  std::printf("%-7s %-10s write %9.1f MB/s  read %9.1f MB/s\n", Ops<T>::name(),
+              endianness == ENDIAN_NATIVE ? "native" : "swapped",
+              mb_per_sec(bytes, write_time), mb_per_sec(bytes, read_time));
+  return true;
+}
+
+template <typename T>
+bool run_both()
+{
+  return run<T>(ENDIAN_NATIVE) && run<T>(ENDIAN_NONNATIVE);
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  ACE_Arg_Shifter args(argc, argv);
+  while (args.is_anything_left()) {
+    const ACE_TCHAR* arg = 0;
+    if ((arg = args.get_the_parameter(ACE_TEXT("-n")))) {
+      elements = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-i")))) {
+      iterations = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else if ((arg = args.get_the_parameter(ACE_TEXT("-b")))) {
+      block = ACE_OS::atoi(arg);
+      args.consume_arg();
+    } else {
+      args.ignore_arg();
+    }
+  }
+  if (elements == 0) {
+    elements = 1;
+  }
+
+  std::printf("elements: %lu iterations: %lu block: %lu swap kernel: %s\n",
+              static_cast<unsigned long>(elements), static_cast<unsigned long>(iterations),
+              static_cast<unsigned long>(block), swap_copy_array_kernel());
+
+  return run_both<ACE_CDR::UShort>() && run_both<ACE_CDR::ULong>() && run_both<ACE_CDR::Double>() ? 0 : 1;
+}
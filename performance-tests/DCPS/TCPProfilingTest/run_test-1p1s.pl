@@ -25,6 +25,9 @@ $pub_writer_id=0;
 # (possibly allocated by not yet queue by the transport because of greedy read).
 $num_samples=$num_msgs_btwn_rec + 20;
 
+# The transport configuration, such as tcp_coalesce.ini or tcp_zerocopy.ini
+$config = (@ARGV > 0) ? $ARGV[0] : "tcp.ini";
+
 $dcpsrepo_ior = "repo.ior";
 
 unlink $dcpsrepo_ior;
@@ -35,7 +38,7 @@ $DCPSREPO = PerlDDS::create_process ("$ENV{DDS_ROOT}/bin/DCPSInfoRepo",
 
 print $DCPSREPO->CommandLine(), "\n";
 
-$sub_parameters = "-DcpsBit 0 -p $num_writers"
+$sub_parameters = "-DCPSConfigFile $config -DcpsBit 0 -p $num_writers"
 #              . " -DCPSDebugLevel 6"
               . " -i $num_msgs_btwn_rec"
               . " -n $num_messages -d $data_size"
@@ -49,7 +52,7 @@ print $Subscriber->CommandLine(), "\n";
 
 
 #NOTE: above 1000 queue samples does not give any better performance.
-$pub_parameters = "-DcpsBit 0 -p 1 -i $pub_writer_id"
+$pub_parameters = "-DCPSConfigFile $config -DcpsBit 0 -p 1 -i $pub_writer_id"
 #              . " -DCPSDebugLevel 6"
               . " -n $num_messages -d $data_size"
               . " -msi 2000 -mxs 2000";
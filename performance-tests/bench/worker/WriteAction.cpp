@@ -14,6 +14,8 @@ WriteAction::WriteAction(ACE_Proactor& proactor)
 , last_scheduled_time_(0, 0)
 , max_count_(0)
 , new_key_count_(0)
+, key_count_(0)
+, key_base_(0)
 , new_key_probability_(0)
 , instance_(0)
 , filter_class_start_value_(0)
@@ -73,6 +75,14 @@ bool WriteAction::init(const ActionConfig& config, ActionReport& report, Builder
   }
   new_key_count_ = new_key_count;
 
+  size_t key_count = 0;
+  auto key_count_prop = get_property(config.params, "key_count", Builder::PVK_ULL);
+  if (key_count_prop) {
+    key_count = static_cast<size_t>(key_count_prop->value.ull_prop());
+  }
+  key_count_ = key_count;
+  key_base_ = data_.id.low;
+
   bool relative_scheduling = false;
   auto manual_rescheduling_prop = get_property(config.params, "relative_scheduling", Builder::PVK_ULL);
   if (manual_rescheduling_prop) {
@@ -198,7 +208,9 @@ void WriteAction::do_write()
   if (started_ && !stopped_) {
     if (max_count_ == 0 || data_.msg_count < max_count_) {
       ++(data_.msg_count);
-      if ((new_key_count_ != 0 && (data_.msg_count % new_key_count_) == 0)
+      if (key_count_ != 0) {
+        data_.id.low = key_base_ + (data_.msg_count % key_count_);
+      } else if ((new_key_count_ != 0 && (data_.msg_count % new_key_count_) == 0)
           || (new_key_probability_ != 0 && mt_() <= new_key_probability_)) {
         data_.id.high = mt_();
         data_.id.low = mt_();
@@ -30,6 +30,8 @@ protected:
   ACE_Time_Value last_scheduled_time_;
   size_t max_count_;
   size_t new_key_count_;
+  size_t key_count_;
+  uint64_t key_base_;
   uint64_t new_key_probability_;
   DDS::InstanceHandle_t instance_;
   std::shared_ptr<ACE_Handler> handler_;
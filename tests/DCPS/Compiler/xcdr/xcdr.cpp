@@ -1946,6 +1946,75 @@ TEST(IdVsDeclOrder, test)
   serializer_test<IdVsDeclOrder>(xcdr2, id_vs_decl_order_expected);
 }
 
+// MemcpyLayout ===============================================================
+
+template <>
+void expect_values_equal<MemcpyLayoutOuter, MemcpyLayoutOuter>(
+  const MemcpyLayoutOuter& a, const MemcpyLayoutOuter& b)
+{
+  EXPECT_EQ(a.octet_field, b.octet_field);
+  EXPECT_EQ(a.inner.long_long_field, b.inner.long_long_field);
+  EXPECT_EQ(a.inner.long_field, b.inner.long_field);
+  expect_arrays_are_equal(a.inner.short_array, b.inner.short_array);
+  expect_arrays_are_equal(a.inner.octet_array, b.inner.octet_array);
+}
+
+template <>
+void set_values<MemcpyLayoutOuter>(MemcpyLayoutOuter& value)
+{
+  value.octet_field = 0x01;
+  value.inner.long_long_field = ACE_INT64_LITERAL(0x0102030405060708);
+  value.inner.long_field = 0x11121314;
+  value.inner.short_array[0] = 0x2122;
+  value.inner.short_array[1] = 0x2324;
+  for (CORBA::Octet i = 0; i < 8; ++i) {
+    value.inner.octet_array[i] = 0x31 + i;
+  }
+}
+
+struct MemcpyLayoutXcdr2BE {
+  STREAM_DATA
+};
+
+const unsigned char MemcpyLayoutXcdr2BE::expected[] = {
+  0x01, (0), (0), (0), // +4 octet_field = 4
+  0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, // +8 long_long_field = 12
+  0x11, 0x12, 0x13, 0x14, // +4 long_field = 16
+  0x21, 0x22, 0x23, 0x24, // +4 short_array = 20
+  0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38 // +8 octet_array = 28
+};
+
+const unsigned MemcpyLayoutXcdr2BE::layout[] = {1,1,1,1,8,4,2,2,1,1,1,1,1,1,1,1};
+
+const unsigned char memcpy_layout_xcdr1_expected[] = {
+  0x01, (0), (0), (0), (0), (0), (0), (0), // +8 octet_field = 8
+  0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, // +8 long_long_field = 16
+  0x11, 0x12, 0x13, 0x14, // +4 long_field = 20
+  0x21, 0x22, 0x23, 0x24, // +4 short_array = 24
+  0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38 // +8 octet_array = 32
+};
+
+TEST(MemcpyLayout, Xcdr1)
+{
+  MemcpyLayoutOuter value;
+  set_values(value);
+  EXPECT_EQ(serialized_size(xcdr1, value), sizeof memcpy_layout_xcdr1_expected);
+  serializer_test<MemcpyLayoutOuter>(xcdr1, memcpy_layout_xcdr1_expected);
+}
+
+TEST(MemcpyLayout, Xcdr2)
+{
+  MemcpyLayoutOuter value;
+  set_values(value);
+  EXPECT_EQ(serialized_size(xcdr2, value), sizeof MemcpyLayoutXcdr2BE::expected);
+  serializer_test<MemcpyLayoutOuter>(xcdr2, MemcpyLayoutXcdr2BE::expected);
+}
+
+TEST(MemcpyLayout, Xcdr2LE)
+{
+  test_little_endian<MemcpyLayoutOuter, MemcpyLayoutXcdr2BE>();
+}
+
 // KeyOnly Serialization ======================================================
 
 template <typename Type>
@@ -25,6 +25,21 @@ bool check_rc(DDS::ReturnCode_t rc, const char* what)
   return false;
 }
 
+template <typename MessageType>
+DDS::InstanceHandle_t write_plain(DDS::DataWriter_ptr data_writer, const MessageType& msg)
+{
+  typedef typename OpenDDS::DCPS::DDSTraits<MessageType>::DataWriterType DataWriterType;
+  typename DataWriterType::_var_type mdw = DataWriterType::_narrow(data_writer);
+  if (check_rc(mdw->write(msg, DDS::HANDLE_NIL), "write (plain) failed")) {
+    return DDS::HANDLE_NIL;
+  }
+  const DDS::InstanceHandle_t handle = mdw->lookup_instance(msg);
+  if (handle == DDS::HANDLE_NIL) {
+    ACE_ERROR((LM_ERROR, "publisher (%P|%t) ERROR: lookup_instance (plain) failed\n"));
+  }
+  return handle;
+}
+
 int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
 {
   // Production apps should check the return values.
@@ -39,14 +54,17 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
   ACE_Argv_Type_Converter conv(argc, argv);
   char** const argva = conv.get_ASCII_argv();
   bool dynamic = false;
+  bool keyed = false;
   for (int i = 1; i < argc; ++i) {
     if (0 == std::strcmp("-dynamic", argva[i])) {
       dynamic = true;
-      break;
+    } else if (0 == std::strcmp("-keyed", argva[i])) {
+      keyed = true;
     }
   }
 
-  ACE_DEBUG((LM_DEBUG, "Testing %C language binding\n", dynamic ? "dynamic" : "plain"));
+  ACE_DEBUG((LM_DEBUG, "Testing %C language binding with %C\n",
+             dynamic ? "dynamic" : "plain", keyed ? "a keyed type" : "an unkeyed type"));
 
   DDS::DomainParticipant_var participant =
     domain_participant_factory->create_participant(HelloWorld::HELLO_WORLD_DOMAIN,
@@ -54,7 +72,10 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
                                                    0,
                                                    0);
 
-  HelloWorld::MessageTypeSupport_var type_support = new HelloWorld::MessageTypeSupportImpl();
+  OpenDDS::DCPS::TypeSupportImpl* const type_support = keyed ?
+    static_cast<OpenDDS::DCPS::TypeSupportImpl*>(new HelloWorld::KeyedMessageTypeSupportImpl()) :
+    new HelloWorld::MessageTypeSupportImpl();
+  DDS::TypeSupport_var type_support_var = type_support;
   CORBA::String_var type_name = type_support->get_type_name();
   DDS::DynamicType_var dt;
 
@@ -70,7 +91,7 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
     }
   }
 
-  DDS::Topic_var topic = participant->create_topic(HelloWorld::MESSAGE_TOPIC_NAME,
+  DDS::Topic_var topic = participant->create_topic(keyed ? HelloWorld::KEYED_MESSAGE_TOPIC_NAME : HelloWorld::MESSAGE_TOPIC_NAME,
                                                    type_name,
                                                    TOPIC_QOS_DEFAULT,
                                                    0,
@@ -87,24 +108,67 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
 
   distributed_condition_set->wait_for(HelloWorld::PUBLISHER, HelloWorld::SUBSCRIBER, HelloWorld::SUBSCRIBER_READY);
 
+  // The value is the only member of Message and follows the key in KeyedMessage.
+  const DDS::MemberId value_id = keyed ? 1 : 0;
+  DDS::InstanceHandle_t handle = DDS::HANDLE_NIL;
+  CORBA::Long key = 0;
+
   if (dynamic) {
     DDS::DynamicDataWriter_var ddw = DDS::DynamicDataWriter::_narrow(data_writer);
     DDS::DynamicData_var dd = DDS::DynamicDataFactory::get_instance()->create_data(dt);
-    if (check_rc(dd->set_string_value(0, HelloWorld::MESSAGE_EXAMPLE_VALUE), "set_string_value failed")) {
+    if (keyed && check_rc(dd->set_int32_value(0, HelloWorld::KEYED_MESSAGE_ID), "set_int32_value failed")) {
+      return 1;
+    }
+    if (check_rc(dd->set_string_value(value_id, HelloWorld::MESSAGE_EXAMPLE_VALUE), "set_string_value failed")) {
       return 1;
     }
     if (check_rc(ddw->write(dd, DDS::HANDLE_NIL), "write (dynamic) failed")) {
       return 1;
     }
+    handle = ddw->lookup_instance(dd);
+    if (handle == DDS::HANDLE_NIL) {
+      ACE_ERROR((LM_ERROR, "publisher (%P|%t) ERROR: lookup_instance (dynamic) failed\n"));
+      return 1;
+    }
+    if (keyed) {
+      DDS::DynamicData_ptr key_holder = 0;
+      if (check_rc(ddw->get_key_value(key_holder, handle), "get_key_value (dynamic) failed")) {
+        return 1;
+      }
+      DDS::DynamicData_var key_holder_var = key_holder;
+      if (check_rc(key_holder->get_int32_value(key, 0), "get_int32_value failed")) {
+        return 1;
+      }
+    }
+  } else if (keyed) {
+    HelloWorld::KeyedMessage msg;
+    msg.id = HelloWorld::KEYED_MESSAGE_ID;
+    msg.value = HelloWorld::MESSAGE_EXAMPLE_VALUE;
+    handle = write_plain(data_writer, msg);
+    if (handle == DDS::HANDLE_NIL) {
+      return 1;
+    }
+    HelloWorld::KeyedMessageDataWriter_var kmdw = HelloWorld::KeyedMessageDataWriter::_narrow(data_writer);
+    HelloWorld::KeyedMessage key_holder;
+    if (check_rc(kmdw->get_key_value(key_holder, handle), "get_key_value (plain) failed")) {
+      return 1;
+    }
+    key = key_holder.id;
   } else {
-    HelloWorld::MessageDataWriter_var mdw = HelloWorld::MessageDataWriter::_narrow(data_writer);
     HelloWorld::Message msg;
     msg.value = HelloWorld::MESSAGE_EXAMPLE_VALUE;
-    if (check_rc(mdw->write(msg, DDS::HANDLE_NIL), "write (plain) failed")) {
+    handle = write_plain(data_writer, msg);
+    if (handle == DDS::HANDLE_NIL) {
       return 1;
     }
   }
 
+  if (keyed && key != HelloWorld::KEYED_MESSAGE_ID) {
+    ACE_ERROR((LM_ERROR, "publisher (%P|%t) ERROR: get_key_value returned %d, expected %d\n",
+               key, HelloWorld::KEYED_MESSAGE_ID));
+    return 1;
+  }
+
   distributed_condition_set->wait_for(HelloWorld::PUBLISHER, HelloWorld::SUBSCRIBER, HelloWorld::SUBSCRIBER_DONE);
 
   participant->delete_contained_entities();
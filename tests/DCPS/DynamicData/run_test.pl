@@ -17,9 +17,11 @@ $test->setup_discovery();
 
 my $dyn;
 $test->flag('dyn', \$dyn);
+# The key index only matters for a keyed type, so test it with KeyedMessage.
+my $opts = $test->flag('key_index') ? '-DCPSInstanceKeyIndex 1 -keyed ' : '';
 
-$test->process('subscriber', 'subscriber', $dyn eq 'dr' ? '-dynamic' : '');
-$test->process('publisher', 'publisher', $dyn eq 'dw' ? '-dynamic' : '');
+$test->process('subscriber', 'subscriber', $opts . ($dyn eq 'dr' ? '-dynamic' : ''));
+$test->process('publisher', 'publisher', $opts . ($dyn eq 'dw' ? '-dynamic' : ''));
 
 rmtree './DCS';
 
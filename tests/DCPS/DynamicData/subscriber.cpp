@@ -14,7 +14,8 @@
 
 #include <ace/Argv_Type_Converter.h>
 
-void read_dynamic(DDS::DataReader_var& dr, bool& done, bool& got_message);
+void read_dynamic(DDS::DataReader_var& dr, DDS::MemberId value_id, bool& done, bool& got_message);
+template <typename MessageType>
 void read_plain(DDS::DataReader_var& dr, bool& done, bool& got_message);
 
 int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
@@ -31,14 +32,17 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
   ACE_Argv_Type_Converter conv(argc, argv);
   char** const argva = conv.get_ASCII_argv();
   bool dynamic = false;
+  bool keyed = false;
   for (int i = 1; i < argc; ++i) {
     if (0 == std::strcmp("-dynamic", argva[i])) {
       dynamic = true;
-      break;
+    } else if (0 == std::strcmp("-keyed", argva[i])) {
+      keyed = true;
     }
   }
 
-  ACE_DEBUG((LM_DEBUG, "Testing %C language binding\n", dynamic ? "dynamic" : "plain"));
+  ACE_DEBUG((LM_DEBUG, "Testing %C language binding with %C\n",
+             dynamic ? "dynamic" : "plain", keyed ? "a keyed type" : "an unkeyed type"));
 
   DDS::DomainParticipant_var participant =
     domain_participant_factory->create_participant(HelloWorld::HELLO_WORLD_DOMAIN,
@@ -46,7 +50,10 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
                                                    0,
                                                    0);
 
-  HelloWorld::MessageTypeSupport_var type_support = new HelloWorld::MessageTypeSupportImpl;
+  OpenDDS::DCPS::TypeSupportImpl* const type_support = keyed ?
+    static_cast<OpenDDS::DCPS::TypeSupportImpl*>(new HelloWorld::KeyedMessageTypeSupportImpl) :
+    new HelloWorld::MessageTypeSupportImpl;
+  DDS::TypeSupport_var type_support_var = type_support;
   CORBA::String_var type_name = type_support->get_type_name ();
 
   if (dynamic) {
@@ -57,7 +64,7 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
     type_support->register_type(participant, type_name);
   }
 
-  DDS::Topic_var topic = participant->create_topic(HelloWorld::MESSAGE_TOPIC_NAME,
+  DDS::Topic_var topic = participant->create_topic(keyed ? HelloWorld::KEYED_MESSAGE_TOPIC_NAME : HelloWorld::MESSAGE_TOPIC_NAME,
                                                    type_name,
                                                    TOPIC_QOS_DEFAULT,
                                                    0,
@@ -93,9 +100,12 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
     wait_set->wait(conditions, timeout);
 
     if (dynamic) {
-      read_dynamic(data_reader, done, got_message);
+      // The value is the only member of Message and follows the key in KeyedMessage.
+      read_dynamic(data_reader, keyed ? 1 : 0, done, got_message);
+    } else if (keyed) {
+      read_plain<HelloWorld::KeyedMessage>(data_reader, done, got_message);
     } else {
-      read_plain(data_reader, done, got_message);
+      read_plain<HelloWorld::Message>(data_reader, done, got_message);
     }
 
     if (done) {
@@ -117,10 +127,13 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
   return 0;
 }
 
+template <typename MessageType>
 void read_plain(DDS::DataReader_var& data_reader, bool& done, bool& got_message)
 {
-  HelloWorld::MessageDataReader_var message_data_reader = HelloWorld::MessageDataReader::_narrow(data_reader);
-  HelloWorld::MessageSeq messages;
+  typedef OpenDDS::DCPS::DDSTraits<MessageType> Traits;
+  typedef typename Traits::DataReaderType DataReaderType;
+  typename DataReaderType::_var_type message_data_reader = DataReaderType::_narrow(data_reader);
+  typename Traits::MessageSequenceType messages;
   DDS::SampleInfoSeq infos;
   message_data_reader->take(messages, infos, DDS::LENGTH_UNLIMITED,
                             DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
@@ -135,7 +148,7 @@ void read_plain(DDS::DataReader_var& data_reader, bool& done, bool& got_message)
   }
 }
 
-void read_dynamic(DDS::DataReader_var& data_reader, bool& done, bool& got_message)
+void read_dynamic(DDS::DataReader_var& data_reader, DDS::MemberId value_id, bool& done, bool& got_message)
 {
   DDS::DynamicDataReader_var ddr = DDS::DynamicDataReader::_narrow(data_reader);
   DDS::DynamicDataSeq messages;
@@ -144,7 +157,7 @@ void read_dynamic(DDS::DataReader_var& data_reader, bool& done, bool& got_messag
             DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
   for (unsigned int idx = 0; idx != messages.length(); ++idx) {
     CORBA::String_var str;
-    messages[idx]->get_string_value(str, 0);
+    messages[idx]->get_string_value(str, value_id);
     if (!strcmp(str.in(), HelloWorld::MESSAGE_EXAMPLE_VALUE)) {
       got_message = true;
     }
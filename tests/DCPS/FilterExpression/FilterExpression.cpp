@@ -139,7 +139,9 @@ bool testEval() {
                                          "durability_service.history_depth > %0",
                                          "durability_service.service_cleanup_delay.sec = 0 AND durability_service.service_cleanup_delay.nanosec >= 10",
                                          "durability_service.service_cleanup_delay.sec < durability_service.service_cleanup_delay.nanosec",
-                                         "MOD(durability_service.history_depth,3) = 0"
+                                         "MOD(durability_service.history_depth,3) = 0",
+                                         "name = 'Bob' OR durability_service.history_depth >= 15",
+                                         "NOT name = 'Bob' AND durability_service.history_depth BETWEEN 10 AND 20"
     };
 
     static const char* filters_fail[] = {"name LIKE 'ZZ%'",
@@ -147,7 +149,9 @@ bool testEval() {
                                          "durability_service.history_depth < %0",
                                          "durability_service.service_cleanup_delay.sec = 0 AND durability_service.service_cleanup_delay.nanosec BETWEEN 3 AND 5",
                                          "durability_service.service_cleanup_delay.sec = durability_service.service_cleanup_delay.nanosec",
-                                         "MOD(durability_service.history_depth,4) = 0"};
+                                         "MOD(durability_service.history_depth,4) = 0",
+                                         "name = 'Adam' AND NOT durability_service.history_depth = 15",
+                                         "name = 'Bob' OR durability_service.history_depth NOT BETWEEN 10 AND 20"};
 
     std::cout << std::boolalpha;
     TBTDTypeSupportImpl tsStat;
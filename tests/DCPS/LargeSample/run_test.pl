@@ -34,6 +34,9 @@ elsif ($test->flag('multicast_async')) {
   push(@common_pub_opts, "-DCPSConfigFile", "pub_multicast_async.ini");
   push(@sub_opts, "-DCPSConfigFile", "multicast.ini");
 }
+elsif ($test->flag('tcp_send_modes')) {
+  push(@common_opts, "-DCPSConfigFile", "tcp_send_modes.ini");
+}
 elsif ($test->flag('rtps')) {
   $is_rtps = 1;
   push(@common_opts,
@@ -32,6 +32,12 @@ if ($test->flag('thread_per')) {
     $thread_per_connection = " -p ";
 }
 
+# Run the transports on the epoll-based reactor instead of select
+my $reactor_type = "";
+if ($test->flag('dev_poll')) {
+    $reactor_type = " -DCPSReactorType dev_poll";
+}
+
 my $flag_found = 1;
 if ($test->flag('udp')) {
     $pub_opts .= " -DCPSConfigFile pub_udp.ini";
@@ -119,10 +125,25 @@ elsif ($test->flag('shmem')) {
     $pub_opts .= " -DCPSConfigFile shmem.ini";
     $sub_opts .= " -DCPSConfigFile shmem.ini";
 }
+elsif ($test->flag('shmem_ring')) {
+    $pub_opts .= " -DCPSConfigFile shmem_ring.ini";
+    $sub_opts .= " -DCPSConfigFile shmem_ring.ini";
+}
+elsif ($test->flag('shmem_ring_pub')) {
+    # Rings need both sides, so the publisher's ring reader gets the
+    # subscriber's messages from the control area.
+    $pub_opts .= " -DCPSConfigFile shmem_ring.ini";
+    $sub_opts .= " -DCPSConfigFile shmem.ini";
+}
+elsif ($test->flag('shmem_ring_sub')) {
+    # The subscriber's ring reader gets the samples from the control area
+    $pub_opts .= " -DCPSConfigFile shmem.ini";
+    $sub_opts .= " -DCPSConfigFile shmem_ring.ini";
+}
 elsif ($test->flag('all')) {
     @original_ARGV = grep { $_ ne 'all' } @original_ARGV;
     my @tests = ('', qw/udp multicast default_tcp default_udp default_multicast
-                        nobits stack shmem
+                        nobits stack shmem shmem_ring shmem_ring_pub shmem_ring_sub
                         rtps rtps_disc rtps_unicast rtps_disc_tcp/);
     push(@tests, 'ipv6') if new PerlACE::ConfigList->check_config('IPV6');
     for my $test (@tests) {
@@ -138,7 +159,8 @@ else {
 
 $test->report_unused_flags(!$flag_found);
 
-$pub_opts .= $thread_per_connection;
+$pub_opts .= $thread_per_connection . $reactor_type;
+$sub_opts .= $reactor_type;
 
 $test->setup_discovery("-ORBDebugLevel 1 -ORBLogFile DCPSInfoRepo.log " .
                        "$repo_bit_opt") unless $is_rtps_disc;
@@ -108,6 +108,18 @@ bool check(const T& lhs, const T& rhs, const char* name, ACE_Message_Block* amb,
   return true;
 }
 
+// The reader FilterEvaluator uses must read the same Value as getValue
+bool checkReader(const MetaStruct& ms, const void* stru, const char* name)
+{
+  const Value expected = ms.getValue(stru, name);
+  const Value actual = ms.getFieldReader(name)->read(stru);
+  if (actual.type_ != expected.type_ || !(actual == expected)) {
+    std::cout << "ERROR: FieldReader of " << name << " does not match getValue" << std::endl;
+    return false;
+  }
+  return true;
+}
+
 template<size_t N, size_t M>
 void fill_2d(short (&arr)[N][M])
 {
@@ -196,7 +208,13 @@ bool run_test_i(Encoding::Kind e)
     && checkVal(tgt.astra[0], src.astra[0], "astra[0]")
     && checkVal(tgt.astra[1], src.astra[1], "astra[1]")
     && checkVal(tgt.astra[2], src.astra[2], "astra[2]")
-    && check(tgt.s, src.s, "s", data.get(), Value::VAL_STRING, meta, &Value::s_, e);
+    && check(tgt.s, src.s, "s", data.get(), Value::VAL_STRING, meta, &Value::s_, e)
+    && checkReader(meta, &src, "a.s")
+    && checkReader(meta, &src, "a.l")
+    && checkReader(meta, &src, "a.w")
+    && checkReader(meta, &src, "a.c")
+    && checkReader(meta, &src, "e")
+    && checkReader(meta, &src, "s");
 }
 
 Encoding::Kind encodings[] = {
@@ -0,0 +1,267 @@
+#include "SedpRematchTypeSupportImpl.h"
+
+#include <tests/Utils/StatusMatching.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/StaticIncludes.h>
+#include <dds/DCPS/transport/framework/TransportRegistry.h>
+#ifdef ACE_AS_STATIC_LIBS
+#  include <dds/DCPS/RTPS/RtpsDiscovery.h>
+#  include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
+
+#include <ace/OS_NS_unistd.h>
+
+#include <cstring>
+
+namespace {
+
+const char PARTITION_A[] = "A";
+const char PARTITION_B[] = "B";
+const char USER_DATA[] = "changed";
+
+// How long to wait for a change that doesn't show up in the matched status.
+const int POLL_ATTEMPTS = 300;
+const ACE_Time_Value POLL_INTERVAL(0, 100000);
+
+bool check(bool condition, const char* what)
+{
+  if (!condition) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: %C\n", what));
+  }
+  return condition;
+}
+
+bool set_partition(DDS::Publisher_var pub, const char* partition)
+{
+  DDS::PublisherQos qos;
+  pub->get_qos(qos);
+  qos.partition.name.length(1);
+  qos.partition.name[0] = partition;
+  return check(pub->set_qos(qos) == DDS::RETCODE_OK, "Publisher set_qos failed");
+}
+
+bool set_partition(DDS::Subscriber_var sub, const char* partition)
+{
+  DDS::SubscriberQos qos;
+  sub->get_qos(qos);
+  qos.partition.name.length(1);
+  qos.partition.name[0] = partition;
+  return check(sub->set_qos(qos) == DDS::RETCODE_OK, "Subscriber set_qos failed");
+}
+
+bool set_deadline(DDS::DataReader_var dr, CORBA::Long sec)
+{
+  DDS::DataReaderQos qos;
+  dr->get_qos(qos);
+  qos.deadline.period.sec = sec;
+  qos.deadline.period.nanosec = sec == DDS::DURATION_INFINITE_SEC ? DDS::DURATION_INFINITE_NSEC : 0;
+  return check(dr->set_qos(qos) == DDS::RETCODE_OK, "DataReader set_qos failed");
+}
+
+bool set_user_data(DDS::DataReader_var dr, const char* value)
+{
+  DDS::DataReaderQos qos;
+  dr->get_qos(qos);
+  const CORBA::ULong length = static_cast<CORBA::ULong>(std::strlen(value));
+  qos.user_data.value.length(length);
+  std::memcpy(qos.user_data.value.get_buffer(), value, length);
+  return check(dr->set_qos(qos) == DDS::RETCODE_OK, "DataReader set_qos failed");
+}
+
+bool wait_for_user_data(DDS::DataWriter_var dw, const char* value)
+{
+  const CORBA::ULong length = static_cast<CORBA::ULong>(std::strlen(value));
+  for (int i = 0; i < POLL_ATTEMPTS; ++i) {
+    DDS::InstanceHandleSeq handles;
+    if (dw->get_matched_subscriptions(handles) == DDS::RETCODE_OK && handles.length() == 1) {
+      DDS::SubscriptionBuiltinTopicData data;
+      if (dw->get_matched_subscription_data(data, handles[0]) == DDS::RETCODE_OK &&
+          data.user_data.value.length() == length &&
+          std::memcmp(data.user_data.value.get_buffer(), value, length) == 0) {
+        return true;
+      }
+    }
+    ACE_OS::sleep(POLL_INTERVAL);
+  }
+  return check(false, "DataWriter didn't see the DataReader's user_data");
+}
+
+bool wait_for_incompatible(DDS::DataWriter_var dw)
+{
+  for (int i = 0; i < POLL_ATTEMPTS; ++i) {
+    DDS::OfferedIncompatibleQosStatus status;
+    if (dw->get_offered_incompatible_qos_status(status) == DDS::RETCODE_OK &&
+        status.total_count > 0) {
+      return check(status.last_policy_id == DDS::DEADLINE_QOS_POLICY_ID,
+                   "DataWriter reported the wrong incompatible policy");
+    }
+    ACE_OS::sleep(POLL_INTERVAL);
+  }
+  return check(false, "DataWriter didn't report the incompatible DEADLINE");
+}
+
+bool check_total(DDS::DataWriter_var dw, CORBA::Long current, CORBA::Long total)
+{
+  DDS::PublicationMatchedStatus status;
+  if (!check(dw->get_publication_matched_status(status) == DDS::RETCODE_OK,
+             "get_publication_matched_status failed")) {
+    return false;
+  }
+  if (status.current_count != current || status.total_count != total) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriter matched %d (total %d), expected %d (total %d)\n",
+               status.current_count, status.total_count, current, total));
+    return false;
+  }
+  return true;
+}
+
+bool check_total(DDS::DataReader_var dr, CORBA::Long current, CORBA::Long total)
+{
+  DDS::SubscriptionMatchedStatus status;
+  if (!check(dr->get_subscription_matched_status(status) == DDS::RETCODE_OK,
+             "get_subscription_matched_status failed")) {
+    return false;
+  }
+  if (status.current_count != current || status.total_count != total) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataReader matched %d (total %d), expected %d (total %d)\n",
+               status.current_count, status.total_count, current, total));
+    return false;
+  }
+  return true;
+}
+
+DDS::Topic_var create_topic(DDS::DomainParticipant_var participant)
+{
+  SedpRematch::SampleTypeSupport_var ts = new SedpRematch::SampleTypeSupportImpl;
+  ts->register_type(participant, "");
+  CORBA::String_var type_name = ts->get_type_name();
+  return participant->create_topic(SedpRematch::SAMPLE_TOPIC_NAME, type_name,
+                                   TOPIC_QOS_DEFAULT, 0, 0);
+}
+
+DDS::Subscriber_var create_subscriber(DDS::DomainParticipant_var participant, const char* partition)
+{
+  DDS::SubscriberQos qos;
+  participant->get_default_subscriber_qos(qos);
+  qos.partition.name.length(1);
+  qos.partition.name[0] = partition;
+  return participant->create_subscriber(qos, 0, 0);
+}
+
+bool run(DDS::DomainParticipant_var pub_participant, DDS::DomainParticipant_var sub_participant)
+{
+  DDS::Topic_var pub_topic = create_topic(pub_participant);
+  DDS::PublisherQos pub_qos;
+  pub_participant->get_default_publisher_qos(pub_qos);
+  pub_qos.partition.name.length(1);
+  pub_qos.partition.name[0] = PARTITION_A;
+  DDS::Publisher_var pub = pub_participant->create_publisher(pub_qos, 0, 0);
+  DDS::DataWriter_var dw = pub->create_datawriter(pub_topic, DATAWRITER_QOS_DEFAULT, 0, 0);
+
+  DDS::Topic_var sub_topic = create_topic(sub_participant);
+  DDS::Subscriber_var sub = create_subscriber(sub_participant, PARTITION_A);
+  DDS::DataReader_var dr = sub->create_datareader(sub_topic, DATAREADER_QOS_DEFAULT, 0, 0);
+
+  if (!check(dw && dr, "failed to create the endpoints")) {
+    return false;
+  }
+
+  Utils::wait_match(dw, 1);
+  Utils::wait_match(dr, 1);
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) matched\n"));
+
+  // A policy that doesn't affect matching leaves the association alone.
+  if (!set_user_data(dr, USER_DATA) || !wait_for_user_data(dw, USER_DATA) || !check_total(dw, 1, 1)) {
+    return false;
+  }
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) user_data changed\n"));
+
+  // The discovered DataReader's partition.
+  if (!set_partition(sub, PARTITION_B)) {
+    return false;
+  }
+  Utils::wait_match(dw, 0);
+  if (!set_partition(sub, PARTITION_A)) {
+    return false;
+  }
+  Utils::wait_match(dw, 1);
+  if (!check_total(dw, 1, 2)) {
+    return false;
+  }
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) subscriber partition changed\n"));
+
+  // The discovered DataReader's deadline.  Breaking the association doesn't
+  // report incompatible QoS, but evaluating the unmatched pair again does.
+  if (!set_deadline(dr, 10)) {
+    return false;
+  }
+  Utils::wait_match(dw, 0);
+  if (!set_deadline(dr, 20) || !wait_for_incompatible(dw) ||
+      !set_deadline(dr, DDS::DURATION_INFINITE_SEC)) {
+    return false;
+  }
+  Utils::wait_match(dw, 1);
+  if (!check_total(dw, 1, 3)) {
+    return false;
+  }
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) deadline changed\n"));
+
+  // The discovered DataWriter's partition.
+  if (!set_partition(pub, PARTITION_B)) {
+    return false;
+  }
+  Utils::wait_match(dr, 0);
+  if (!set_partition(pub, PARTITION_A)) {
+    return false;
+  }
+  Utils::wait_match(dr, 1);
+  Utils::wait_match(dw, 1);
+  if (!check_total(dr, 1, 4) || !check_total(dw, 1, 4)) {
+    return false;
+  }
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) publisher partition changed\n"));
+
+  // Removing a DataReader that never matched doesn't touch the association,
+  // removing the matched one does.
+  DDS::Subscriber_var other_sub = create_subscriber(sub_participant, PARTITION_B);
+  DDS::DataReader_var other_dr = other_sub->create_datareader(sub_topic, DATAREADER_QOS_DEFAULT, 0, 0);
+  if (!check(other_dr, "failed to create the second DataReader")) {
+    return false;
+  }
+  other_sub->delete_datareader(other_dr);
+  sub->delete_datareader(dr);
+  Utils::wait_match(dw, 0);
+  if (!check_total(dw, 0, 4)) {
+    return false;
+  }
+  ACE_DEBUG((LM_DEBUG, "(%P|%t) readers removed\n"));
+
+  return true;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  DDS::DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+  DDS::DomainParticipant_var pub_participant =
+    dpf->create_participant(SedpRematch::SEDP_REMATCH_DOMAIN, PARTICIPANT_QOS_DEFAULT, 0, 0);
+  TheTransportRegistry->bind_config("pub_part", pub_participant);
+
+  DDS::DomainParticipant_var sub_participant =
+    dpf->create_participant(SedpRematch::SEDP_REMATCH_DOMAIN, PARTICIPANT_QOS_DEFAULT, 0, 0);
+  TheTransportRegistry->bind_config("sub_part", sub_participant);
+
+  const bool ok = run(pub_participant, sub_participant);
+
+  pub_participant->delete_contained_entities();
+  dpf->delete_participant(pub_participant);
+  sub_participant->delete_contained_entities();
+  dpf->delete_participant(sub_participant);
+  TheServiceParticipant->shutdown();
+
+  return ok ? 0 : 1;
+}
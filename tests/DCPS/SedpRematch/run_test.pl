@@ -0,0 +1,22 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+# will manually set -DCPSConfigFile
+$test->{add_transport_config} = 0;
+$test->report_unused_flags();
+
+$test->process('SedpRematch', 'SedpRematch', '-DCPSConfigFile rtps.ini');
+$test->start_process('SedpRematch');
+
+exit $test->finish(120);
@@ -0,0 +1,156 @@
+// -*- C++ -*-
+#include "ShmemLoanTypeSupportImpl.h"
+
+#include <tests/Utils/DistributedConditionSet.h>
+
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/StaticIncludes.h>
+#ifdef ACE_AS_STATIC_LIBS
+#  include <dds/DCPS/transport/shmem/Shmem.h>
+#endif
+
+#include <ace/Arg_Shifter.h>
+
+typedef OpenDDS::DCPS::DataWriterImpl_T<ShmemLoan::Sample> SampleDataWriterImpl;
+typedef OpenDDS::DCPS::LoanedSample<ShmemLoan::Sample> LoanedSample;
+
+const CORBA::ULong SAMPLES = 1000;
+
+void fill(ShmemLoan::Sample& sample, CORBA::ULong seq)
+{
+  sample.id = 1;
+  sample.seq = seq;
+  for (CORBA::ULong i = 0; i < ShmemLoan::PAYLOAD_SIZE; ++i) {
+    sample.payload[i] = static_cast<CORBA::Octet>(seq + i);
+  }
+}
+
+bool write_loaned(SampleDataWriterImpl* writer)
+{
+  ShmemLoan::Sample sample;
+  for (CORBA::ULong seq = 0; seq < SAMPLES; ++seq) {
+    LoanedSample loan;
+    DDS::ReturnCode_t ret = writer->loan_sample(loan);
+    if (ret != DDS::RETCODE_OK || !loan.valid()) {
+      ACE_ERROR((LM_ERROR, "ERROR: loan_sample %u returned %C\n",
+                 seq, OpenDDS::DCPS::retcode_to_string(ret)));
+      return false;
+    }
+
+    // Loans that are given back without writing them are freed too.
+    if (seq % 10 == 0) {
+      loan.reset();
+      ret = writer->loan_sample(loan);
+      if (ret != DDS::RETCODE_OK) {
+        ACE_ERROR((LM_ERROR, "ERROR: loan_sample %u after reset returned %C\n",
+                   seq, OpenDDS::DCPS::retcode_to_string(ret)));
+        return false;
+      }
+    }
+
+    fill(sample, seq);
+    ret = writer->write_loaned(sample, loan, DDS::HANDLE_NIL);
+    if (ret != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR, "ERROR: write_loaned %u returned %C\n",
+                 seq, OpenDDS::DCPS::retcode_to_string(ret)));
+      return false;
+    }
+    if (loan.valid()) {
+      ACE_ERROR((LM_ERROR, "ERROR: write_loaned %u didn't take the loan\n", seq));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool write_copied(SampleDataWriterImpl* writer)
+{
+  LoanedSample loan;
+  DDS::ReturnCode_t ret = writer->loan_sample(loan);
+  if (ret != DDS::RETCODE_UNSUPPORTED || loan.valid()) {
+    ACE_ERROR((LM_ERROR, "ERROR: loan_sample without a ring returned %C\n",
+               OpenDDS::DCPS::retcode_to_string(ret)));
+    return false;
+  }
+
+  ShmemLoan::Sample sample;
+  fill(sample, 0);
+  ret = writer->write_loaned(sample, loan, DDS::HANDLE_NIL);
+  if (ret != DDS::RETCODE_BAD_PARAMETER) {
+    ACE_ERROR((LM_ERROR, "ERROR: write_loaned without a loan returned %C\n",
+               OpenDDS::DCPS::retcode_to_string(ret)));
+    return false;
+  }
+
+  for (CORBA::ULong seq = 0; seq < SAMPLES; ++seq) {
+    fill(sample, seq);
+    ret = writer->write(sample, DDS::HANDLE_NIL);
+    if (ret != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR, "ERROR: write %u returned %C\n",
+                 seq, OpenDDS::DCPS::retcode_to_string(ret)));
+      return false;
+    }
+  }
+  return true;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR *argv[])
+{
+  DistributedConditionSet_rch distributed_condition_set =
+    OpenDDS::DCPS::make_rch<FileBasedDistributedConditionSet>();
+
+  DDS::DomainParticipantFactory_var domain_participant_factory = TheParticipantFactoryWithArgs(argc, argv);
+
+  bool ring = true;
+  ACE_Arg_Shifter shifter(argc, argv);
+  while (shifter.is_anything_left()) {
+    if (shifter.cur_arg_strncasecmp(ACE_TEXT("-no_ring")) == 0) {
+      ring = false;
+      shifter.consume_arg();
+    } else {
+      shifter.ignore_arg();
+    }
+  }
+
+  DDS::DomainParticipant_var participant =
+    domain_participant_factory->create_participant(ShmemLoan::SHMEM_LOAN_DOMAIN,
+                                                   PARTICIPANT_QOS_DEFAULT,
+                                                   0,
+                                                   0);
+
+  ShmemLoan::SampleTypeSupport_var type_support = new ShmemLoan::SampleTypeSupportImpl();
+  type_support->register_type(participant, "");
+  CORBA::String_var type_name = type_support->get_type_name();
+
+  DDS::Topic_var topic = participant->create_topic(ShmemLoan::SAMPLE_TOPIC_NAME,
+                                                   type_name,
+                                                   TOPIC_QOS_DEFAULT,
+                                                   0,
+                                                   0);
+
+  DDS::Publisher_var publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                                               0,
+                                                               0);
+
+  DDS::DataWriter_var data_writer = publisher->create_datawriter(topic,
+                                                                 DATAWRITER_QOS_DEFAULT,
+                                                                 0,
+                                                                 0);
+
+  SampleDataWriterImpl* const writer = dynamic_cast<SampleDataWriterImpl*>(data_writer.in());
+
+  distributed_condition_set->wait_for(ShmemLoan::PUBLISHER, ShmemLoan::SUBSCRIBER, ShmemLoan::SUBSCRIBER_READY);
+
+  const bool ok = ring ? write_loaned(writer) : write_copied(writer);
+
+  if (ok) {
+    distributed_condition_set->wait_for(ShmemLoan::PUBLISHER, ShmemLoan::SUBSCRIBER, ShmemLoan::SUBSCRIBER_DONE);
+  }
+
+  participant->delete_contained_entities();
+  domain_participant_factory->delete_participant(participant);
+  TheServiceParticipant->shutdown();
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+eval '(exit $?0)' && eval 'exec perl -S $0 ${1+"$@"}'
+    & eval 'exec perl -S $0 $argv:q'
+    if 0;
+
+# -*- perl -*-
+
+use Env (DDS_ROOT);
+use lib "$DDS_ROOT/bin";
+use Env (ACE_ROOT);
+use lib "$ACE_ROOT/bin";
+use PerlDDS::Run_Test;
+use File::Path;
+use strict;
+
+my $test = new PerlDDS::TestFramework();
+# will manually set -DCPSConfigFile
+$test->{add_transport_config} = 0;
+
+my $pub_opts = '-DCPSConfigFile ring.ini';
+my $sub_opts = '-DCPSConfigFile ring.ini';
+if ($test->flag('no_ring')) {
+    $pub_opts = '-DCPSConfigFile no_ring.ini -no_ring';
+    $sub_opts = '-DCPSConfigFile no_ring.ini';
+}
+$test->report_unused_flags();
+
+$test->setup_discovery();
+
+$test->process('subscriber', 'subscriber', $sub_opts);
+$test->process('publisher', 'publisher', $pub_opts);
+
+rmtree './DCS';
+
+$test->start_process('publisher');
+$test->start_process('subscriber');
+
+exit $test->finish(120);
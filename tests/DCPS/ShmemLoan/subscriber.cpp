@@ -0,0 +1,113 @@
+// -*- C++ -*-
+#include "ShmemLoanTypeSupportImpl.h"
+
+#include <tests/Utils/DistributedConditionSet.h>
+#include <tests/Utils/StatusMatching.h>
+
+#include <dds/DCPS/Service_Participant.h>
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/StaticIncludes.h>
+#ifdef ACE_AS_STATIC_LIBS
+#  include <dds/DCPS/transport/shmem/Shmem.h>
+#endif
+
+const CORBA::ULong SAMPLES = 1000;
+
+bool check(const ShmemLoan::Sample& sample, CORBA::ULong expected_seq)
+{
+  if (sample.id != 1 || sample.seq != expected_seq) {
+    ACE_ERROR((LM_ERROR, "ERROR: received id %d seq %u, expected seq %u\n",
+               sample.id, sample.seq, expected_seq));
+    return false;
+  }
+  for (CORBA::ULong i = 0; i < ShmemLoan::PAYLOAD_SIZE; ++i) {
+    if (sample.payload[i] != static_cast<CORBA::Octet>(sample.seq + i)) {
+      ACE_ERROR((LM_ERROR, "ERROR: payload of seq %u differs at %u\n", sample.seq, i));
+      return false;
+    }
+  }
+  return true;
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  DistributedConditionSet_rch distributed_condition_set =
+    OpenDDS::DCPS::make_rch<FileBasedDistributedConditionSet>();
+
+  DDS::DomainParticipantFactory_var domain_participant_factory = TheParticipantFactoryWithArgs(argc, argv);
+  DDS::DomainParticipant_var participant =
+    domain_participant_factory->create_participant(ShmemLoan::SHMEM_LOAN_DOMAIN,
+                                                   PARTICIPANT_QOS_DEFAULT,
+                                                   0,
+                                                   0);
+
+  ShmemLoan::SampleTypeSupport_var type_support = new ShmemLoan::SampleTypeSupportImpl;
+  type_support->register_type(participant, "");
+  CORBA::String_var type_name = type_support->get_type_name();
+
+  DDS::Topic_var topic = participant->create_topic(ShmemLoan::SAMPLE_TOPIC_NAME,
+                                                   type_name,
+                                                   TOPIC_QOS_DEFAULT,
+                                                   0,
+                                                   0);
+
+  DDS::Subscriber_var subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT,
+                                                                  0,
+                                                                  0);
+
+  DDS::DataReaderQos data_reader_qos;
+  subscriber->get_default_datareader_qos(data_reader_qos);
+  data_reader_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+  data_reader_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+
+  DDS::DataReader_var data_reader = subscriber->create_datareader(topic,
+                                                                  data_reader_qos,
+                                                                  0,
+                                                                  0);
+
+  ShmemLoan::SampleDataReader_var sample_data_reader = ShmemLoan::SampleDataReader::_narrow(data_reader);
+
+  Utils::wait_match(data_reader, 1);
+  distributed_condition_set->post(ShmemLoan::SUBSCRIBER, ShmemLoan::SUBSCRIBER_READY);
+
+  DDS::ReadCondition_var read_condition =
+    data_reader->create_readcondition(DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
+
+  DDS::WaitSet_var wait_set = new DDS::WaitSet;
+  wait_set->attach_condition(read_condition);
+
+  bool ok = true;
+  CORBA::ULong received = 0;
+  while (ok && received < SAMPLES) {
+    DDS::ConditionSeq conditions;
+    const DDS::Duration_t timeout = { 30, 0 };
+    if (wait_set->wait(conditions, timeout) != DDS::RETCODE_OK) {
+      ACE_ERROR((LM_ERROR, "ERROR: timed out after %u samples\n", received));
+      ok = false;
+      break;
+    }
+
+    ShmemLoan::SampleSeq samples;
+    DDS::SampleInfoSeq infos;
+    sample_data_reader->take(samples, infos, DDS::LENGTH_UNLIMITED,
+                             DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
+    for (CORBA::ULong idx = 0; ok && idx != samples.length(); ++idx) {
+      if (infos[idx].valid_data) {
+        ok = check(samples[idx], received++);
+      }
+    }
+  }
+
+  if (ok) {
+    ACE_DEBUG((LM_DEBUG, "received %u samples\n", received));
+    distributed_condition_set->post(ShmemLoan::SUBSCRIBER, ShmemLoan::SUBSCRIBER_DONE);
+  }
+
+  wait_set->detach_condition(read_condition);
+
+  participant->delete_contained_entities();
+  domain_participant_factory->delete_participant(participant);
+  TheServiceParticipant->shutdown();
+
+  return ok ? 0 : 1;
+}
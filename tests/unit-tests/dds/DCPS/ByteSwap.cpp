@@ -0,0 +1,57 @@
+#include <dds/DCPS/ByteSwap.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  void check_swap_copy(size_t size)
+  {
+    char from[16 * 100 + 1];
+    char to[16 * 100 + 2];
+    for (size_t i = 0; i < sizeof from; ++i) {
+      from[i] = static_cast<char>(i * 7 + 1);
+    }
+    // Every count and unaligned pointers exercise both the vector kernel and
+    // the elements left over for the scalar code.
+    for (size_t count = 0; count <= 100; ++count) {
+      std::memset(to, 0x55, sizeof to);
+      swap_copy_array(to + 1, from + 1, size, count);
+      for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+          ASSERT_EQ(from[1 + i * size + size - 1 - j], to[1 + i * size + j])
+            << "size " << size << " count " << count << " element " << i;
+        }
+      }
+      EXPECT_EQ(0x55, to[0]);
+      EXPECT_EQ(0x55, to[1 + count * size]);
+    }
+  }
+}
+
+TEST(dds_DCPS_ByteSwap, swap_copy_array_2)
+{
+  check_swap_copy(2);
+}
+
+TEST(dds_DCPS_ByteSwap, swap_copy_array_4)
+{
+  check_swap_copy(4);
+}
+
+TEST(dds_DCPS_ByteSwap, swap_copy_array_8)
+{
+  check_swap_copy(8);
+}
+
+TEST(dds_DCPS_ByteSwap, swap_copy_array_16)
+{
+  check_swap_copy(16);
+}
+
+TEST(dds_DCPS_ByteSwap, swap_copy_array_kernel)
+{
+  EXPECT_TRUE(swap_copy_array_kernel() != 0);
+}
@@ -0,0 +1,452 @@
+#include <dds/DCPS/Definitions.h>
+
+#if !defined OPENDDS_NO_CONTENT_FILTERED_TOPIC && !defined OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
+
+#include <dds/DCPS/ContentFilterIndex.h>
+#include <dds/DCPS/FilterEvaluator.h>
+#include <dds/DCPS/GuidUtils.h>
+#include <dds/DCPS/Sample.h>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct TestData {
+    ACE_CDR::Long x;
+    ACE_CDR::Long y;
+    std::string s;
+    double d;
+  };
+
+  struct TestMeta : MetaStruct {
+    Value getValue(const void* stru, const char* field) const
+    {
+      const TestData& data = *static_cast<const TestData*>(stru);
+      const std::string name(field);
+      if (name == "x") {
+        return Value(data.x);
+      } else if (name == "y") {
+        return Value(data.y);
+      } else if (name == "s") {
+        return Value(data.s);
+      } else if (name == "d") {
+        return Value(data.d);
+      }
+      throw std::runtime_error("unknown field " + name);
+    }
+
+    Value getValue(Serializer&, const char*, const TypeSupportImpl*) const
+    {
+      throw std::runtime_error("not serialized");
+    }
+
+    ComparatorBase::Ptr create_qc_comparator(const char*, ComparatorBase::Ptr) const
+    {
+      return ComparatorBase::Ptr();
+    }
+
+#ifndef OPENDDS_NO_MULTI_TOPIC
+    size_t numDcpsKeys() const { return 0; }
+    bool compare(const void*, const void*, const char*) const { return false; }
+    const char** getFieldNames() const
+    {
+      static const char* names[] = {"x", "y", "s", "d", 0};
+      return names;
+    }
+    void assign(void*, const char*, const void*, const char*, const MetaStruct&) const {}
+    const void* getRawField(const void*, const char*) const { return 0; }
+    void* allocate() const { return 0; }
+    void deallocate(void*) const {}
+#endif
+  };
+
+}
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+namespace OpenDDS {
+namespace DCPS {
+  template <>
+  const MetaStruct& getMetaStruct<TestData>()
+  {
+    static const TestMeta meta;
+    return meta;
+  }
+}
+}
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+namespace {
+  /// Counts how often a filter is evaluated, as opposed to answered from
+  /// the index.
+  class TestSample : public Sample {
+  public:
+    TestSample(ACE_CDR::Long x, ACE_CDR::Long y = 0, const std::string& s = "", double d = 0)
+      : Sample(ReadOnly, Full)
+      , evals_(0)
+    {
+      data_.x = x;
+      data_.y = y;
+      data_.s = s;
+      data_.d = d;
+    }
+
+    bool serialize(Serializer&) const { return false; }
+    bool deserialize(Serializer&) { return false; }
+    size_t serialized_size(const Encoding&) const { return 0; }
+    bool compare(const Sample&) const { return false; }
+    bool serialize_key(ACE_Message_Block&) const { return false; }
+    bool to_message_block(ACE_Message_Block&) const { return false; }
+    bool from_message_block(const ACE_Message_Block&) { return false; }
+    Sample_rch copy(Mutability, Extent) const { return Sample_rch(); }
+#ifndef OPENDDS_SAFETY_PROFILE
+    DDS::DynamicData_var get_dynamic_data(DDS::DynamicType_ptr) const { return 0; }
+#endif
+    const void* native_data() const { return &data_; }
+
+    bool eval(FilterEvaluator& evaluator, const DDS::StringSeq& params) const
+    {
+      ++evals_;
+      return evaluator.eval(data_, params);
+    }
+
+    Value get_field_value(const char* field) const
+    {
+      return getMetaStruct<TestData>().getValue(&data_, field);
+    }
+
+    mutable int evals_;
+
+  private:
+    TestData data_;
+  };
+
+  GUID_t reader(unsigned char n)
+  {
+    GUID_t guid = GUID_UNKNOWN;
+    guid.entityId.entityKey[2] = n;
+    return guid;
+  }
+
+  DDS::StringSeq params(const char* p0, const char* p1 = 0)
+  {
+    DDS::StringSeq seq;
+    seq.length(p1 ? 2 : 1);
+    seq[0] = p0;
+    if (p1) {
+      seq[1] = p1;
+    }
+    return seq;
+  }
+
+  RcHandle<FilterEvaluator> filter(const char* expression)
+  {
+    return make_rch<FilterEvaluator>(expression, false);
+  }
+
+  /// The readers that the sample passes the filter of, by their number.
+  std::set<int> passed(ContentFilterIndex& index, const Sample& sample)
+  {
+    GuidSet pass;
+    index.filter(sample, pass);
+    std::set<int> result;
+    for (GuidSet::const_iterator iter = pass.begin(); iter != pass.end(); ++iter) {
+      result.insert(iter->entityId.entityKey[2]);
+    }
+    return result;
+  }
+
+  /// The readers that the sample is filtered out for, by their number.
+  std::set<int> filtered(ContentFilterIndex& index, const Sample& sample)
+  {
+    GuidSet pass;
+    index.filter(sample, pass);
+    GUIDSeq filter_out;
+    index.exclude(pass, filter_out);
+    std::set<int> result;
+    for (CORBA::ULong i = 0; i < filter_out.length(); ++i) {
+      result.insert(filter_out[i].entityId.entityKey[2]);
+    }
+    EXPECT_EQ(result.size(), filter_out.length());
+    return result;
+  }
+
+  std::set<int> readers(int a = 0, int b = 0, int c = 0)
+  {
+    std::set<int> result;
+    if (a) result.insert(a);
+    if (b) result.insert(b);
+    if (c) result.insert(c);
+    return result;
+  }
+
+  /// Three readers using 'expression' with parameters 1, 2 and 3.
+  void insert_three(ContentFilterIndex& index, const char* expression)
+  {
+    const RcHandle<FilterEvaluator> eval = filter(expression);
+    index.insert(reader(1), eval, params("1"));
+    index.insert(reader(2), eval, params("2"));
+    index.insert(reader(3), eval, params("3"));
+  }
+}
+
+TEST(dds_DCPS_ContentFilterIndex, equality)
+{
+  ContentFilterIndex index;
+  EXPECT_TRUE(index.empty());
+  const RcHandle<FilterEvaluator> eval = filter("x = %0");
+  index.insert(reader(1), eval, params("1"));
+  index.insert(reader(2), eval, params("2"));
+  index.insert(reader(3), eval, params("2"));
+  EXPECT_FALSE(index.empty());
+
+  TestSample two(2);
+  EXPECT_EQ(filtered(index, two), readers(1));
+  TestSample one(1);
+  EXPECT_EQ(filtered(index, one), readers(2, 3));
+  TestSample four(4);
+  EXPECT_EQ(filtered(index, four), readers(1, 2, 3));
+
+  // Answered from the index without evaluating the filter
+  EXPECT_EQ(two.evals_, 0);
+  EXPECT_EQ(one.evals_, 0);
+  EXPECT_EQ(four.evals_, 0);
+
+  EXPECT_EQ(passed(index, two), readers(2, 3));
+  EXPECT_EQ(passed(index, four), readers());
+  EXPECT_EQ(index.size(), 3u);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, not_equal)
+{
+  ContentFilterIndex index;
+  insert_three(index, "x <> %0");
+  TestSample two(2);
+  EXPECT_EQ(filtered(index, two), readers(2));
+  EXPECT_EQ(two.evals_, 0);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, ranges)
+{
+  TestSample two(2);
+
+  {
+    ContentFilterIndex index;
+    insert_three(index, "x < %0");
+    EXPECT_EQ(filtered(index, two), readers(1, 2));
+  }
+  {
+    ContentFilterIndex index;
+    insert_three(index, "x <= %0");
+    EXPECT_EQ(filtered(index, two), readers(1));
+  }
+  {
+    ContentFilterIndex index;
+    insert_three(index, "x > %0");
+    EXPECT_EQ(filtered(index, two), readers(2, 3));
+  }
+  {
+    ContentFilterIndex index;
+    insert_three(index, "x >= %0");
+    EXPECT_EQ(filtered(index, two), readers(3));
+  }
+  {
+    // The parameter on the left is the same as "x < %0"
+    ContentFilterIndex index;
+    insert_three(index, "%0 > x");
+    EXPECT_EQ(filtered(index, two), readers(1, 2));
+  }
+
+  EXPECT_EQ(two.evals_, 0);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, nan)
+{
+  // The index has to agree with FilterEvaluator when the field is NaN.
+  static const char* const expressions[] = {
+    "d = %0", "d <> %0", "d < %0", "d <= %0", "d > %0", "d >= %0",
+    "%0 < d", "%0 >= d"
+  };
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double values[] = {nan, 1, 1.5, -nan};
+  const char* const reader_params[] = {"1", "2"};
+
+  for (size_t e = 0; e < sizeof expressions / sizeof expressions[0]; ++e) {
+    ContentFilterIndex index;
+    const RcHandle<FilterEvaluator> eval = filter(expressions[e]);
+    for (int r = 0; r < 2; ++r) {
+      index.insert(reader(r + 1), eval, params(reader_params[r]));
+    }
+
+    for (size_t v = 0; v < sizeof values / sizeof values[0]; ++v) {
+      TestSample sample(0, 0, "", values[v]);
+      std::set<int> expected;
+      for (int r = 0; r < 2; ++r) {
+        TestData data;
+        data.d = values[v];
+        if (!eval->eval(data, params(reader_params[r]))) {
+          expected.insert(r + 1);
+        }
+      }
+      EXPECT_EQ(filtered(index, sample), expected)
+        << expressions[e] << " with d = " << values[v];
+      EXPECT_EQ(sample.evals_, 0);
+    }
+  }
+}
+
+TEST(dds_DCPS_ContentFilterIndex, string_field)
+{
+  ContentFilterIndex index;
+  const RcHandle<FilterEvaluator> eval = filter("s = %0");
+  index.insert(reader(1), eval, params("abc"));
+  index.insert(reader(2), eval, params("def"));
+
+  TestSample sample(0, 0, "def");
+  EXPECT_EQ(filtered(index, sample), readers(1));
+  EXPECT_EQ(sample.evals_, 0);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, not_indexable)
+{
+  ContentFilterIndex index;
+  const RcHandle<FilterEvaluator> eval = filter("x > 1 AND y = %0");
+  index.insert(reader(1), eval, params("5"));
+  index.insert(reader(2), eval, params("6"));
+
+  TestSample sample(2, 5);
+  EXPECT_EQ(filtered(index, sample), readers(2));
+  EXPECT_EQ(sample.evals_, 2);
+
+  TestSample small(1, 5);
+  EXPECT_EQ(filtered(index, small), readers(1, 2));
+  EXPECT_EQ(small.evals_, 2);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, other_parameter)
+{
+  ContentFilterIndex index;
+  const RcHandle<FilterEvaluator> eval = filter("x = %1");
+  index.insert(reader(1), eval, params("9", "2"));
+  index.insert(reader(2), eval, params("2", "9"));
+
+  TestSample sample(2);
+  EXPECT_EQ(filtered(index, sample), readers(2));
+  EXPECT_EQ(sample.evals_, 0);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, unconvertible_parameter)
+{
+  // A parameter that can't be converted to the field's type is left out of
+  // the index and evaluated, which fails like it does without the index.
+  ContentFilterIndex index;
+  const RcHandle<FilterEvaluator> eval = filter("x = %0");
+  index.insert(reader(1), eval, params("2"));
+  index.insert(reader(2), eval, params("two"));
+
+  TestSample sample(2);
+  EXPECT_THROW(filtered(index, sample), std::runtime_error);
+  EXPECT_EQ(sample.evals_, 1);
+
+  index.update_params(reader(2), params("3"));
+  TestSample again(2);
+  EXPECT_EQ(filtered(index, again), readers(2));
+  EXPECT_EQ(again.evals_, 0);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, mixed_filters)
+{
+  ContentFilterIndex index;
+  const RcHandle<FilterEvaluator> indexed = filter("x = %0");
+  const RcHandle<FilterEvaluator> evaluated = filter("y > %0 OR x = 0");
+  index.insert(reader(1), indexed, params("2"));
+  index.insert(reader(2), indexed, params("3"));
+  index.insert(reader(3), evaluated, params("4"));
+
+  TestSample sample(2, 5);
+  EXPECT_EQ(filtered(index, sample), readers(2));
+  EXPECT_EQ(sample.evals_, 1);
+}
+
+TEST(dds_DCPS_ContentFilterIndex, add_remove)
+{
+  ContentFilterIndex index;
+  insert_three(index, "x = %0");
+  TestSample two(2);
+  EXPECT_EQ(filtered(index, two), readers(1, 3));
+
+  index.erase(reader(1));
+  EXPECT_EQ(filtered(index, two), readers(3));
+
+  // Erasing a reader that isn't there does nothing
+  index.erase(reader(1));
+  index.erase(reader(9));
+  EXPECT_EQ(filtered(index, two), readers(3));
+
+  // Added after the index was built
+  const RcHandle<FilterEvaluator> eval = filter("x = %0");
+  index.insert(reader(4), eval, params("1"));
+  EXPECT_EQ(filtered(index, two), readers(3, 4));
+
+  index.erase(reader(2));
+  index.erase(reader(3));
+  index.erase(reader(4));
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(filtered(index, two), readers());
+}
+
+TEST(dds_DCPS_ContentFilterIndex, update_filter)
+{
+  ContentFilterIndex index;
+  insert_three(index, "x = %0");
+  TestSample two(2);
+  EXPECT_EQ(filtered(index, two), readers(1, 3));
+
+  // Inserting a reader again replaces its filter
+  index.insert(reader(1), filter("x > %0"), params("1"));
+  EXPECT_EQ(filtered(index, two), readers(3));
+
+  index.insert(reader(3), filter("x > %0 AND y = 0"), params("5"));
+  EXPECT_EQ(filtered(index, two), readers(3));
+
+  index.erase(reader(1));
+  index.erase(reader(2));
+  index.erase(reader(3));
+  EXPECT_TRUE(index.empty());
+}
+
+TEST(dds_DCPS_ContentFilterIndex, update_params)
+{
+  ContentFilterIndex index;
+  insert_three(index, "x < %0");
+  TestSample two(2);
+  EXPECT_EQ(filtered(index, two), readers(1, 2));
+
+  index.update_params(reader(1), params("5"));
+  EXPECT_EQ(filtered(index, two), readers(2));
+
+  index.update_params(reader(3), params("0"));
+  EXPECT_EQ(filtered(index, two), readers(2, 3));
+
+  // Readers that aren't in the index are ignored
+  index.update_params(reader(9), params("0"));
+  EXPECT_EQ(filtered(index, two), readers(2, 3));
+  EXPECT_EQ(two.evals_, 0);
+
+  // Parameters of a filter that isn't indexed
+  ContentFilterIndex evaluated;
+  const RcHandle<FilterEvaluator> eval = filter("x = 2 AND y < %0");
+  evaluated.insert(reader(1), eval, params("1"));
+  TestSample sample(2, 3);
+  EXPECT_EQ(filtered(evaluated, sample), readers(1));
+  evaluated.update_params(reader(1), params("4"));
+  EXPECT_EQ(filtered(evaluated, sample), readers());
+  EXPECT_EQ(sample.evals_, 2);
+}
+
+#endif
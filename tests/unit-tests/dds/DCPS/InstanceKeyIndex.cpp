@@ -0,0 +1,152 @@
+#include <dds/DCPS/InstanceKeyIndex.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct Key {
+    ACE_CDR::ULong value_;
+  };
+
+  void serialized_size(const Encoding& encoding, size_t& size, const Key&)
+  {
+    primitive_serialized_size_ulong(encoding, size);
+  }
+
+  bool operator<<(Serializer& ser, const Key& key)
+  {
+    return ser << key.value_;
+  }
+
+  void set_key(ACE_Message_Block& mb, ACE_CDR::ULong value)
+  {
+    const Key key = {value};
+    ASSERT_TRUE(serialize_instance_key(mb, key));
+  }
+}
+
+TEST(dds_DCPS_InstanceKeyIndex, serialize_instance_key)
+{
+  ACE_Message_Block mb(1);
+  set_key(mb, 0x01020304);
+  ASSERT_EQ(mb.length(), 4u);
+  EXPECT_EQ(mb.rd_ptr()[0], 1);
+  EXPECT_EQ(mb.rd_ptr()[3], 4);
+}
+
+TEST(dds_DCPS_InstanceKeyIndex, insert_find_erase)
+{
+  InstanceKeyIndex index;
+  ACE_Message_Block mb(4);
+
+  set_key(mb, 7);
+  EXPECT_EQ(index.find(mb), DDS::HANDLE_NIL);
+  EXPECT_TRUE(index.insert(mb, 1));
+  EXPECT_FALSE(index.insert(mb, 2));
+  EXPECT_EQ(index.find(mb), 1);
+
+  set_key(mb, 8);
+  EXPECT_FALSE(index.insert(mb, 1));
+  EXPECT_TRUE(index.insert(mb, 2));
+  EXPECT_EQ(index.find(mb), 2);
+  EXPECT_EQ(index.size(), 2u);
+
+  const String* key = index.key(1);
+  ASSERT_TRUE(key);
+  EXPECT_EQ(key->size(), 4u);
+  EXPECT_EQ((*key)[3], 7);
+
+  EXPECT_TRUE(index.erase(1));
+  EXPECT_FALSE(index.erase(1));
+  EXPECT_FALSE(index.key(1));
+  set_key(mb, 7);
+  EXPECT_EQ(index.find(mb), DDS::HANDLE_NIL);
+  set_key(mb, 8);
+  EXPECT_EQ(index.find(mb), 2);
+}
+
+TEST(dds_DCPS_InstanceKeyIndex, many)
+{
+  InstanceKeyIndex index;
+  ACE_Message_Block mb(4);
+  const ACE_CDR::ULong count = 10000;
+
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    set_key(mb, i * 31);
+    ASSERT_TRUE(index.insert(mb, i + 1));
+  }
+  ASSERT_EQ(index.size(), count);
+
+  // Erase every third instance, which moves entries in the table
+  for (ACE_CDR::ULong i = 0; i < count; i += 3) {
+    ASSERT_TRUE(index.erase(i + 1));
+  }
+
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    set_key(mb, i * 31);
+    EXPECT_EQ(index.find(mb), i % 3 ? DDS::InstanceHandle_t(i + 1) : DDS::HANDLE_NIL);
+  }
+
+  // next visits the remaining instances in the order they were inserted
+  ACE_CDR::ULong visited = 0;
+  DDS::InstanceHandle_t prev = DDS::HANDLE_NIL;
+  for (DDS::InstanceHandle_t h = index.next(DDS::HANDLE_NIL); h != DDS::HANDLE_NIL; h = index.next(h)) {
+    EXPECT_GT(h, prev);
+    prev = h;
+    ++visited;
+  }
+  EXPECT_EQ(visited, index.size());
+  EXPECT_EQ(index.next(1), DDS::HANDLE_NIL);
+}
+
+TEST(dds_DCPS_InstanceKeyIndex, next)
+{
+  InstanceKeyIndex index;
+  ACE_Message_Block mb(4);
+  EXPECT_EQ(index.next(DDS::HANDLE_NIL), DDS::HANDLE_NIL);
+
+  // Handles can be reused, so they aren't inserted in order
+  const DDS::InstanceHandle_t handles[] = {5, 2, 9, 1};
+  for (ACE_CDR::ULong i = 0; i < 4; ++i) {
+    set_key(mb, i);
+    ASSERT_TRUE(index.insert(mb, handles[i]));
+  }
+  EXPECT_EQ(index.next(DDS::HANDLE_NIL), 5);
+  EXPECT_EQ(index.next(5), 2);
+  EXPECT_EQ(index.next(2), 9);
+  EXPECT_EQ(index.next(9), 1);
+  EXPECT_EQ(index.next(1), DDS::HANDLE_NIL);
+  EXPECT_EQ(index.next(3), DDS::HANDLE_NIL);
+
+  // Erasing the current instance after getting the next one, which moves
+  // the last entry into the erased one, visits all of them
+  int visited = 0;
+  DDS::InstanceHandle_t handle = index.next(DDS::HANDLE_NIL);
+  while (handle != DDS::HANDLE_NIL) {
+    const DDS::InstanceHandle_t next = index.next(handle);
+    EXPECT_TRUE(index.erase(handle));
+    handle = next;
+    ++visited;
+  }
+  EXPECT_EQ(visited, 4);
+  EXPECT_EQ(index.size(), 0u);
+  EXPECT_EQ(index.next(DDS::HANDLE_NIL), DDS::HANDLE_NIL);
+
+  // Erasing from the middle
+  for (ACE_CDR::ULong i = 0; i < 4; ++i) {
+    set_key(mb, i);
+    ASSERT_TRUE(index.insert(mb, handles[i]));
+  }
+  EXPECT_TRUE(index.erase(2));
+  EXPECT_EQ(index.next(5), 9);
+  EXPECT_TRUE(index.erase(5));
+  EXPECT_EQ(index.next(DDS::HANDLE_NIL), 9);
+  set_key(mb, 7);
+  ASSERT_TRUE(index.insert(mb, 2));
+  EXPECT_EQ(index.next(1), 2);
+  EXPECT_EQ(index.next(2), DDS::HANDLE_NIL);
+  const String* key = index.key(2);
+  ASSERT_TRUE(key);
+  EXPECT_EQ((*key)[3], 7);
+}
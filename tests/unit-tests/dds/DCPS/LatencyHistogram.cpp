@@ -0,0 +1,98 @@
+#include <dds/DCPS/LatencyHistogram.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_LatencyHistogram, bucket_index)
+{
+  for (ACE_UINT64 usec = 0; usec < LatencyHistogram::SUB_BUCKETS; ++usec) {
+    EXPECT_EQ(usec, LatencyHistogram::bucket_index(usec));
+  }
+
+  // Every value is counted by a bucket whose limit is at or above it and
+  // within 1/16 of it.
+  const size_t bucket_count = LatencyHistogram::BUCKET_COUNT;
+  size_t last = 0;
+  for (ACE_UINT64 usec = 1; usec < (ACE_UINT64(1) << 36); usec = usec * 9 / 8 + 1) {
+    const size_t index = LatencyHistogram::bucket_index(usec);
+    EXPECT_LE(last, index);
+    EXPECT_LT(index, bucket_count);
+    const ACE_UINT64 limit = LatencyHistogram::bucket_limit(index);
+    EXPECT_LE(usec, limit);
+    EXPECT_LE(limit - usec, usec / 16 + 1);
+    if (index > 0) {
+      EXPECT_LT(LatencyHistogram::bucket_limit(index - 1), usec);
+    }
+    last = index;
+  }
+
+  EXPECT_EQ(bucket_count - 1, LatencyHistogram::bucket_index(ACE_UINT64(1) << 40));
+}
+
+TEST(dds_DCPS_LatencyHistogram, percentile)
+{
+  LatencyHistogram histogram;
+  LatencyHistogram::Snapshot snapshot;
+  histogram.snapshot(snapshot);
+  EXPECT_EQ(0u, snapshot.total);
+  EXPECT_EQ(TimeDuration::zero_value, snapshot.percentile(0.5));
+
+  // 1ms to 10ms in 1us steps
+  for (suseconds_t usec = 1000; usec < 10000; ++usec) {
+    histogram.record(TimeDuration(0, usec));
+  }
+  histogram.record(TimeDuration(2));
+
+  histogram.snapshot(snapshot);
+  EXPECT_EQ(9001u, snapshot.total);
+  const double p50 = static_cast<double>(snapshot.percentile(0.5).value().usec());
+  EXPECT_GE(p50, 5500);
+  EXPECT_LE(p50, 5500 * 17 / 16);
+  const double p99 = static_cast<double>(snapshot.percentile(0.99).value().usec());
+  EXPECT_GE(p99, 9910);
+  EXPECT_LE(p99, 9910 * 17 / 16);
+  EXPECT_GE(snapshot.percentile(1), TimeDuration(2));
+  EXPECT_LE(snapshot.percentile(1), TimeDuration(2, 125000));
+
+  LatencyHistogram other;
+  other.record(TimeDuration(-1));
+  LatencyHistogram::Snapshot other_snapshot;
+  other.snapshot(other_snapshot);
+  EXPECT_EQ(1u, other_snapshot.counts[0]);
+
+  histogram.reset();
+  histogram.snapshot(snapshot);
+  EXPECT_EQ(0u, snapshot.total);
+}
+
+TEST(dds_DCPS_LatencyHistogram, moments)
+{
+  LatencyHistogram histogram;
+  LatencyHistogram::Snapshot snapshot;
+  double mean = 1;
+  double variance = 1;
+  histogram.snapshot(snapshot);
+  snapshot.moments(mean, variance);
+  EXPECT_EQ(0, mean);
+  EXPECT_EQ(0, variance);
+
+  // Below 32us every latency has its own bucket.
+  histogram.record(TimeDuration(0, 10));
+  histogram.record(TimeDuration(0, 20));
+  histogram.snapshot(snapshot);
+  snapshot.moments(mean, variance);
+  EXPECT_NEAR(15e-6, mean, 1e-12);
+  EXPECT_NEAR(25e-12, variance, 1e-15);
+
+  // 1ms to 10ms in 1us steps
+  histogram.reset();
+  for (suseconds_t usec = 1000; usec < 10000; ++usec) {
+    histogram.record(TimeDuration(0, usec));
+  }
+  histogram.snapshot(snapshot);
+  snapshot.moments(mean, variance);
+  EXPECT_NEAR(5.4995e-3, mean, 5.4995e-3 / 16);
+  // The variance of a uniform distribution over 9ms
+  EXPECT_NEAR(6.75e-6, variance, 6.75e-6 / 8);
+}
@@ -41,4 +41,43 @@ TEST(dds_DCPS_SafetyProfilePool, maintest)
   test_malloc();
   test_mallocs();
 }
+
+TEST(dds_DCPS_SafetyProfilePool, thread_cache)
+{
+  SafetyProfilePool pool;
+  pool.configure_pool(64 * 1024, sizeof(void*), 8);
+
+  // First allocation refills the magazine from the main pool
+  void* const p1 = pool.malloc(24);
+  EXPECT_TRUE(p1);
+  SafetyProfilePool::CacheStats stats = pool.cache_stats();
+  EXPECT_EQ(stats.misses_, 1u);
+
+  // Freed block is reused by the next allocation of the same size class
+  pool.free(p1);
+  void* const p2 = pool.malloc(30);
+  EXPECT_EQ(p1, p2);
+
+  // Allocations larger than the cached sizes bypass the cache
+  void* const big = pool.malloc(SafetyProfilePool::MAX_CACHED_SIZE * 2);
+  EXPECT_TRUE(big);
+  pool.free(big);
+
+  // Overflowing the magazine returns half of it to the main pool
+  void* blocks[20];
+  for (int i = 0; i < 20; ++i) {
+    blocks[i] = pool.malloc(24);
+    EXPECT_TRUE(blocks[i]);
+  }
+  for (int i = 0; i < 20; ++i) {
+    pool.free(blocks[i]);
+  }
+  pool.free(p2);
+
+  stats = pool.cache_stats();
+  EXPECT_GT(stats.hits_, 0u);
+  EXPECT_GT(stats.misses_, 1u);
+  EXPECT_LE(stats.cached_blocks_hwm_, 8u);
+  EXPECT_GT(stats.cached_blocks_hwm_, 0u);
+}
 #endif
@@ -859,3 +859,48 @@ TEST(dds_DCPS_Serializer, read_parameter_id_xcdr2)
   EXPECT_FALSE(must_understand);
   ASSERT_TRUE(ser.skip(size));
 }
+
+TEST(dds_DCPS_Serializer, Serializer_swap_array_across_blocks)
+{
+  // Blocks whose sizes aren't multiples of the element sizes make elements
+  // straddle the block boundaries.
+  OpenDDS::DCPS::Message_Block_Ptr amb(new ACE_Message_Block(30));
+  amb->cont(new ACE_Message_Block(7));
+  amb->cont()->cont(new ACE_Message_Block(400));
+
+  const Encoding enc(Encoding::KIND_UNALIGNED_CDR, ENDIAN_NONNATIVE);
+  Serializer ser(amb.get(), enc);
+
+  ACE_CDR::UShort shorts[11];
+  ACE_CDR::ULong longs[37];
+  ACE_CDR::Double doubles[21];
+  for (ACE_CDR::ULong i = 0; i < 11; ++i) {
+    shorts[i] = static_cast<ACE_CDR::UShort>(0x0102 * (i + 1));
+  }
+  for (ACE_CDR::ULong i = 0; i < 37; ++i) {
+    longs[i] = 0x01020304 * (i + 1);
+  }
+  for (ACE_CDR::ULong i = 0; i < 21; ++i) {
+    doubles[i] = 0.12345 * (i + 1);
+  }
+  ASSERT_TRUE(ser.write_ushort_array(shorts, 11));
+  ASSERT_TRUE(ser.write_ulong_array(longs, 37));
+  ASSERT_TRUE(ser.write_double_array(doubles, 21));
+
+  // The first element is in the first block in the opposite byte order.
+  ACE_CDR::UShort first = 0;
+  std::memcpy(&first, amb->rd_ptr(), sizeof first);
+  EXPECT_EQ(0x0201, first);
+
+  Serializer rser(amb.get(), enc);
+  ACE_CDR::UShort shorts_out[11];
+  ACE_CDR::ULong longs_out[37];
+  ACE_CDR::Double doubles_out[21];
+  ASSERT_TRUE(rser.read_ushort_array(shorts_out, 11));
+  ASSERT_TRUE(rser.read_ulong_array(longs_out, 37));
+  ASSERT_TRUE(rser.read_double_array(doubles_out, 21));
+  EXPECT_EQ(ser.wpos(), rser.rpos());
+  EXPECT_EQ(0, std::memcmp(shorts, shorts_out, sizeof shorts));
+  EXPECT_EQ(0, std::memcmp(longs, longs_out, sizeof longs));
+  EXPECT_EQ(0, std::memcmp(doubles, doubles_out, sizeof doubles));
+}
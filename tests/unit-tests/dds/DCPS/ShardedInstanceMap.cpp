@@ -0,0 +1,110 @@
+#include <dds/DCPS/ShardedInstanceMap.h>
+
+#include <ace/Thread_Manager.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct Instance : RcObject {
+    explicit Instance(DDS::InstanceHandle_t handle) : handle_(handle) {}
+    const DDS::InstanceHandle_t handle_;
+  };
+  typedef RcHandle<Instance> Instance_rch;
+  typedef ShardedInstanceMap_T<Instance_rch> Map;
+
+  const DDS::InstanceHandle_t handles_per_thread = 1000;
+
+  struct Worker {
+    Map* map_;
+    DDS::InstanceHandle_t first_;
+    bool ok_;
+  };
+
+  ACE_THR_FUNC_RETURN work(void* arg)
+  {
+    Worker& worker = *static_cast<Worker*>(arg);
+    const DDS::InstanceHandle_t end = worker.first_ + handles_per_thread;
+    for (DDS::InstanceHandle_t handle = worker.first_; handle != end; ++handle) {
+      worker.ok_ = worker.map_->insert(handle, make_rch<Instance>(handle)) && worker.ok_;
+    }
+    for (DDS::InstanceHandle_t handle = worker.first_; handle != end; ++handle) {
+      const Instance_rch instance = worker.map_->find(handle);
+      worker.ok_ = instance && instance->handle_ == handle && worker.ok_;
+      if (handle % 2) {
+        worker.map_->erase(handle);
+      }
+    }
+    return 0;
+  }
+}
+
+TEST(dds_DCPS_ShardedInstanceMap, insert_find_erase)
+{
+  Map map(4);
+  EXPECT_EQ(4u, map.shard_count());
+
+  EXPECT_FALSE(map.find(1));
+  const Instance_rch one = make_rch<Instance>(1);
+  EXPECT_TRUE(map.insert(1, one));
+  EXPECT_FALSE(map.insert(1, make_rch<Instance>(1)));
+  EXPECT_EQ(one, map.find(1));
+
+  // Handles in other shards and in the same shard are independent.
+  const Instance_rch two = make_rch<Instance>(2);
+  const Instance_rch five = make_rch<Instance>(5);
+  EXPECT_EQ(map.shard_index(1), map.shard_index(5));
+  EXPECT_NE(map.shard_index(1), map.shard_index(2));
+  EXPECT_TRUE(map.insert(2, two));
+  EXPECT_TRUE(map.insert(5, five));
+  EXPECT_EQ(two, map.find(2));
+  EXPECT_EQ(five, map.find(5));
+
+  map.erase(1);
+  EXPECT_FALSE(map.find(1));
+  EXPECT_EQ(five, map.find(5));
+  map.erase(1);
+  EXPECT_TRUE(map.insert(1, one));
+  EXPECT_EQ(one, map.find(1));
+}
+
+TEST(dds_DCPS_ShardedInstanceMap, one_shard)
+{
+  Map map(0);
+  EXPECT_EQ(1u, map.shard_count());
+  EXPECT_TRUE(map.insert(3, make_rch<Instance>(3)));
+  EXPECT_TRUE(map.insert(4, make_rch<Instance>(4)));
+  EXPECT_EQ(3, map.find(3)->handle_);
+  EXPECT_EQ(4, map.find(4)->handle_);
+}
+
+TEST(dds_DCPS_ShardedInstanceMap, threads)
+{
+  Map map(8);
+  const int thread_count = 4;
+  Worker workers[thread_count];
+  for (int i = 0; i < thread_count; ++i) {
+    const Worker worker = {&map, 1 + i * handles_per_thread, true};
+    workers[i] = worker;
+  }
+
+  ACE_Thread_Manager manager;
+  for (int i = 0; i < thread_count; ++i) {
+    ASSERT_NE(-1, manager.spawn(work, &workers[i]));
+  }
+  manager.wait();
+
+  for (int i = 0; i < thread_count; ++i) {
+    EXPECT_TRUE(workers[i].ok_);
+  }
+  for (DDS::InstanceHandle_t handle = 1; handle <= thread_count * handles_per_thread; ++handle) {
+    const Instance_rch instance = map.find(handle);
+    if (handle % 2) {
+      EXPECT_FALSE(instance);
+    } else {
+      ASSERT_TRUE(instance);
+      EXPECT_EQ(handle, instance->handle_);
+    }
+  }
+}
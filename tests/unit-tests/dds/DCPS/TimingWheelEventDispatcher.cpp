@@ -0,0 +1,178 @@
+/*
+ *
+ *
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/TimingWheelEventDispatcher.h>
+
+#include <dds/DCPS/ConditionVariable.h>
+#include <dds/DCPS/ServiceEventDispatcher.h>
+#include <dds/DCPS/ThreadStatusManager.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+class TestEvent : public EventBase {
+public:
+  TestEvent() : cv_(mutex_), call_count_(0), cancel_count_(0) {}
+
+  void handle_event()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    ++call_count_;
+    last_call_ = MonotonicTimePoint::now();
+    cv_.notify_all();
+  }
+
+  void handle_cancel()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    ++cancel_count_;
+  }
+
+  size_t call_count()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    return call_count_;
+  }
+
+  size_t cancel_count()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    return cancel_count_;
+  }
+
+  MonotonicTimePoint last_call()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    return last_call_;
+  }
+
+  void wait(size_t target)
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    while (call_count_ < target) {
+      cv_.wait(tsm_);
+    }
+  }
+
+private:
+  ACE_Thread_Mutex mutex_;
+  ConditionVariable<ACE_Thread_Mutex> cv_;
+  ThreadStatusManager tsm_;
+  size_t call_count_;
+  size_t cancel_count_;
+  MonotonicTimePoint last_call_;
+};
+
+RcHandle<TimingWheelEventDispatcher> make_wheel(const TimeDuration& tick)
+{
+  return make_rch<TimingWheelEventDispatcher>(make_rch<ServiceEventDispatcher>(1), tick);
+}
+
+} // (anonymous) namespace
+
+TEST(dds_DCPS_TimingWheelEventDispatcher, Dispatch)
+{
+  RcHandle<TestEvent> test_event = make_rch<TestEvent>();
+  RcHandle<TimingWheelEventDispatcher> dispatcher = make_wheel(TimeDuration::from_msec(10));
+
+  EXPECT_TRUE(dispatcher->dispatch(test_event));
+  EXPECT_TRUE(dispatcher->dispatch(test_event));
+
+  test_event->wait(2u);
+  dispatcher->shutdown();
+
+  EXPECT_EQ(test_event->call_count(), 2u);
+}
+
+TEST(dds_DCPS_TimingWheelEventDispatcher, ScheduleNotEarly)
+{
+  RcHandle<TestEvent> near_event = make_rch<TestEvent>();
+  RcHandle<TestEvent> wheel_event = make_rch<TestEvent>();
+  RcHandle<TimingWheelEventDispatcher> dispatcher = make_wheel(TimeDuration::from_msec(10));
+
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  EXPECT_GT(dispatcher->schedule(near_event, now + TimeDuration::from_msec(3)), 0);
+  EXPECT_GT(dispatcher->schedule(wheel_event, now + TimeDuration::from_msec(45)), 0);
+  EXPECT_EQ(dispatcher->size(), 2u);
+
+  near_event->wait(1u);
+  wheel_event->wait(1u);
+  dispatcher->shutdown();
+
+  EXPECT_GE(near_event->last_call(), now + TimeDuration::from_msec(3));
+  EXPECT_GE(wheel_event->last_call(), now + TimeDuration::from_msec(45));
+  EXPECT_EQ(dispatcher->size(), 0u);
+}
+
+TEST(dds_DCPS_TimingWheelEventDispatcher, ScheduleAcrossLevels)
+{
+  RcHandle<TestEvent> test_event = make_rch<TestEvent>();
+  RcHandle<TimingWheelEventDispatcher> dispatcher = make_wheel(TimeDuration::from_msec(1));
+
+  // With a 1ms tick, anything beyond 256ms is scheduled on the second level
+  // and has to be cascaded before it is expired.
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_GT(dispatcher->schedule(test_event, now + TimeDuration::from_msec(i * 4)), 0);
+  }
+
+  test_event->wait(100u);
+  dispatcher->shutdown();
+
+  EXPECT_GE(test_event->last_call(), now + TimeDuration::from_msec(396));
+  EXPECT_EQ(test_event->call_count(), 100u);
+}
+
+TEST(dds_DCPS_TimingWheelEventDispatcher, Cancel)
+{
+  RcHandle<TestEvent> test_event = make_rch<TestEvent>();
+  RcHandle<TimingWheelEventDispatcher> dispatcher = make_wheel(TimeDuration::from_msec(10));
+
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  const long t1 = dispatcher->schedule(test_event, now + TimeDuration::from_msec(90));
+  const long t2 = dispatcher->schedule(test_event, now + TimeDuration::from_msec(50));
+  /*long t3 =*/ dispatcher->schedule(test_event, now + TimeDuration::from_msec(70));
+  const long t4 = dispatcher->schedule(test_event, now + TimeDuration(3600));
+
+  EXPECT_EQ(dispatcher->cancel(t1), 1u);
+  EXPECT_EQ(dispatcher->cancel(t2), 1u);
+  EXPECT_EQ(dispatcher->cancel(t4), 1u);
+  EXPECT_EQ(dispatcher->cancel(t4), 0u);
+  EXPECT_EQ(test_event->cancel_count(), 3u);
+
+  test_event->wait(1u);
+  EXPECT_GE(test_event->last_call(), now + TimeDuration::from_msec(70));
+
+  // The id of an expired timer must not cancel the timer reusing its slot.
+  const long t5 = dispatcher->schedule(test_event, now + TimeDuration(3600));
+  EXPECT_NE(t5, t2);
+  EXPECT_EQ(dispatcher->cancel(t2), 0u);
+  EXPECT_EQ(dispatcher->size(), 1u);
+
+  dispatcher->shutdown();
+  EXPECT_EQ(test_event->call_count(), 1u);
+}
+
+TEST(dds_DCPS_TimingWheelEventDispatcher, Shutdown)
+{
+  RcHandle<TestEvent> test_event = make_rch<TestEvent>();
+  RcHandle<TimingWheelEventDispatcher> dispatcher = make_wheel(TimeDuration::from_msec(10));
+
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  dispatcher->schedule(test_event, now + TimeDuration(60));
+  dispatcher->schedule(test_event, now + TimeDuration(3600));
+  dispatcher->shutdown();
+
+  EXPECT_EQ(test_event->cancel_count(), 2u);
+  EXPECT_FALSE(dispatcher->dispatch(test_event));
+  EXPECT_EQ(-1, dispatcher->schedule(test_event, now));
+  EXPECT_EQ(0u, dispatcher->cancel(1));
+  EXPECT_EQ(test_event->call_count(), 0u);
+}
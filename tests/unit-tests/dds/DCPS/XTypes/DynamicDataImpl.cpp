@@ -9,6 +9,8 @@
 #include <dds/DCPS/XTypes/DynamicDataFactory.h>
 #include <dds/DCPS/XTypes/DynamicDataImpl.h>
 
+#include <cstring>
+
 using namespace OpenDDS;
 using namespace DynamicDataImpl;
 
@@ -3639,4 +3641,213 @@ TEST(dds_DCPS_XTypes_DynamicDataImpl, String_As_Enum)
   EXPECT_EQ(DDS::RETCODE_OK, data.get_int32_value(eval, MID_my_enum));
   EXPECT_EQ(static_cast<int>(E_UINT64), eval);
 }
+
+void set_flat_struct(XTypes::DynamicDataImpl& data)
+{
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_int32_value(0, 0x01020304));
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_boolean_value(1, true));
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_byte_value(2, 0xab));
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_int16_value(3, 0x0506));
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_int64_value(4, 0x0708090a0b0c0d0eLL));
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_char8_value(5, 'x'));
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_float64_value(6, 1.0));
+  EXPECT_EQ(DDS::RETCODE_OK, data.set_uint16_value(7, 0x1112));
+}
+
+const unsigned char flat_struct_be[] = {
+  0x01,0x02,0x03,0x04, // +4=4 k
+  0x01, // +1=5 flag
+  0xab, // +1=6 b
+  0x05,0x06, // +2=8 s
+  0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e, // +8=16 ll
+  'x', // +1=17 c
+  (0),(0),(0),0x3f,0xf0,0x00,0x00,0x00,0x00,0x00,0x00, // +(3)+8=28 d
+  0x11,0x12 // +2=30 us
+};
+
+const unsigned char flat_struct_le[] = {
+  0x04,0x03,0x02,0x01, // +4=4 k
+  0x01, // +1=5 flag
+  0xab, // +1=6 b
+  0x06,0x05, // +2=8 s
+  0x0e,0x0d,0x0c,0x0b,0x0a,0x09,0x08,0x07, // +8=16 ll
+  'x', // +1=17 c
+  (0),(0),(0),0x00,0x00,0x00,0x00,0x00,0x00,0xf0,0x3f, // +(3)+8=28 d
+  0x12,0x11 // +2=30 us
+};
+
+TEST(dds_DCPS_XTypes_DynamicDataImpl, Final_FlatStruct)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::DynamicDataImpl_FinalFlatStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::DynamicDataImpl_FinalFlatStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_NE(it, type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  EXPECT_TRUE(dt);
+
+  XTypes::DynamicDataImpl data(dt);
+  set_flat_struct(data);
+  // Wrong interface and wrong Id
+  EXPECT_EQ(DDS::RETCODE_ERROR, data.set_uint32_value(0, 1));
+  EXPECT_EQ(DDS::RETCODE_ERROR, data.set_int32_value(8, 1));
+
+  CORBA::Long key = 0;
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_int32_value(key, 0));
+  EXPECT_EQ(0x01020304, key);
+  CORBA::Boolean flag = false;
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_boolean_value(flag, 1));
+  EXPECT_TRUE(flag);
+  CORBA::Char c = 0;
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_char8_value(c, 5));
+  EXPECT_EQ('x', c);
+  CORBA::Double d = 0;
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_float64_value(d, 6));
+  EXPECT_EQ(1.0, d);
+  CORBA::Short s = 0;
+  EXPECT_EQ(DDS::RETCODE_ERROR, data.get_int16_value(s, 7));
+  EXPECT_EQ(8u, data.get_item_count());
+
+  // Both byte orders, one of which is the buffer itself.
+  assert_serialized_data(64, data, flat_struct_be);
+  assert_serialized_data(64, data, flat_struct_le, DCPS::Encoding(DCPS::Encoding::KIND_XCDR2, DCPS::ENDIAN_LITTLE));
+  EXPECT_EQ(sizeof flat_struct_be, DCPS::serialized_size(xcdr2, data));
+
+  // Starting at an offset that isn't 4-aligned changes the padding.
+  {
+    ACE_Message_Block buffer(64);
+    DCPS::Serializer ser(&buffer, xcdr2);
+    ASSERT_TRUE(ser << ACE_OutputCDR::from_octet(0xee));
+    ASSERT_TRUE(ser << data);
+    EXPECT_EQ(sizeof flat_struct_be + 4, buffer.length());
+    size_t size = 1;
+    DCPS::serialized_size(xcdr2, size, data);
+    EXPECT_EQ(buffer.length(), size);
+  }
+
+  // Only the key.
+  {
+    EXPECT_EQ(4u, DCPS::serialized_size(xcdr2, DCPS::KeyOnly<const XTypes::DynamicDataImpl>(data)));
+    ACE_Message_Block buffer(64);
+    DCPS::Serializer ser(&buffer, xcdr2);
+    EXPECT_TRUE(ser << DCPS::KeyOnly<const XTypes::DynamicDataImpl>(data));
+    static const unsigned char expected_buffer[] = {0x01, 0x02, 0x03, 0x04};
+    EXPECT_PRED_FORMAT2(assert_DataView, expected_buffer, buffer);
+  }
+
+  // A clone has its own copy of the buffer.
+  DDS::DynamicData_var copy = data.clone();
+  EXPECT_EQ(DDS::RETCODE_OK, data.clear_value(4));
+  CORBA::LongLong ll = 1;
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_int64_value(ll, 4));
+  EXPECT_EQ(0, ll);
+  XTypes::DynamicDataImpl* const copy_impl = dynamic_cast<XTypes::DynamicDataImpl*>(copy.in());
+  ASSERT_TRUE(copy_impl);
+  assert_serialized_data(64, *copy_impl, flat_struct_be);
+
+  // Moving the members to the maps doesn't change the value.
+  DDS::DynamicData_var member;
+  EXPECT_EQ(DDS::RETCODE_OK, copy->get_complex_value(member, 7));
+  assert_serialized_data(64, *copy_impl, flat_struct_be);
+  EXPECT_EQ(DDS::RETCODE_OK, copy->get_int64_value(ll, 4));
+  EXPECT_EQ(0x0708090a0b0c0d0eLL, ll);
+
+  EXPECT_EQ(DDS::RETCODE_OK, data.clear_all_values());
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_int32_value(key, 0));
+  EXPECT_EQ(0, key);
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataImpl, FlatStruct_Xcdr1)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::DynamicDataImpl_FinalFlatStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::DynamicDataImpl_FinalFlatStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_NE(it, type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  EXPECT_TRUE(dt);
+
+  XTypes::DynamicDataImpl data(dt);
+  set_flat_struct(data);
+
+  // Structs can't be serialized as XCDR1 yet, and failing leaves the value
+  // alone.
+  size_t size = 0;
+  EXPECT_FALSE(DCPS::serialized_size(xcdr1, size, data));
+  ACE_Message_Block buffer(64);
+  DCPS::Serializer ser(&buffer, xcdr1);
+  EXPECT_FALSE(ser << data);
+
+  assert_serialized_data(64, data, flat_struct_be);
+  CORBA::LongLong ll = 0;
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_int64_value(ll, 4));
+  EXPECT_EQ(0x0708090a0b0c0d0eLL, ll);
+}
+
+#ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
+TEST(dds_DCPS_XTypes_DynamicDataImpl, FlatStruct_SimpleValue)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::DynamicDataImpl_FinalFlatStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::DynamicDataImpl_FinalFlatStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_NE(it, type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  EXPECT_TRUE(dt);
+
+  XTypes::DynamicDataImpl data(dt);
+  set_flat_struct(data);
+
+  // Content filters read the members straight from the buffer.
+  DCPS::Value value(0);
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_simple_value(value, 0));
+  EXPECT_EQ(DCPS::Value::VAL_INT, value.type_);
+  EXPECT_EQ(0x01020304, value.i_);
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_simple_value(value, 1));
+  EXPECT_EQ(DCPS::Value::VAL_BOOL, value.type_);
+  EXPECT_TRUE(value.b_);
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_simple_value(value, 4));
+  EXPECT_EQ(DCPS::Value::VAL_I64, value.type_);
+  EXPECT_EQ(0x0708090a0b0c0d0eLL, value.l_);
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_simple_value(value, 5));
+  EXPECT_EQ(DCPS::Value::VAL_CHAR, value.type_);
+  EXPECT_EQ('x', value.c_);
+  EXPECT_EQ(DDS::RETCODE_OK, data.get_simple_value(value, 6));
+  EXPECT_EQ(DCPS::Value::VAL_FLOAT, value.type_);
+  EXPECT_EQ(1.0, value.f_);
+  // Like with the member maps, DCPS::Value has no 16-bit integers.
+  EXPECT_EQ(DDS::RETCODE_ERROR, data.get_simple_value(value, 3));
+  EXPECT_EQ(DDS::RETCODE_ERROR, data.get_simple_value(value, 8));
+}
+#endif
+
+TEST(dds_DCPS_XTypes_DynamicDataImpl, Appendable_FlatStruct)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::DynamicDataImpl_AppendableFlatStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::DynamicDataImpl_AppendableFlatStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_NE(it, type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  EXPECT_TRUE(dt);
+
+  XTypes::DynamicDataImpl data(dt);
+  set_flat_struct(data);
+
+  unsigned char appendable_be[4 + sizeof flat_struct_be] = {0x00, 0x00, 0x00, 0x1e}; // DHEADER
+  std::memcpy(appendable_be + 4, flat_struct_be, sizeof flat_struct_be);
+  assert_serialized_data(64, data, appendable_be);
+
+  unsigned char appendable_le[4 + sizeof flat_struct_le] = {0x1e, 0x00, 0x00, 0x00}; // DHEADER
+  std::memcpy(appendable_le + 4, flat_struct_le, sizeof flat_struct_le);
+  assert_serialized_data(64, data, appendable_le, DCPS::Encoding(DCPS::Encoding::KIND_XCDR2, DCPS::ENDIAN_LITTLE));
+}
 #endif // OPENDDS_SAFETY_PROFILE
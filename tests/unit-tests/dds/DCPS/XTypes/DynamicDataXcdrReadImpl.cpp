@@ -1342,6 +1342,65 @@ TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Mutable_SkipNestedMembers)
   EXPECT_EQ(expected.outer.s, s_val);
 }
 
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Mutable_ReadMembersOutOfOrder)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::MutableStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::MutableStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_TRUE(it != type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+
+  unsigned char mutable_struct[] = {
+    0x00,0x00,0x00,0x39, // +4=4 dheader
+    0x00,0x00,0x00,0x00, 'a',(0),(0),(0), // +5+(3)=12 c
+    /////////// outer (FinalNestedStructOuter) ///////////
+    0x40,0x00,0x00,0x01, 0x00,0x00,0x00,0x0e, // +8=20 Emheader & nextint
+    0x12,0x34,0x56,0x78, // +4=24 l
+    0x00,0x00,0x00,0x04, 0x7f,0xff,0xff,0xff, // +8=32 inner.l
+    0x43,0x21,(0),(0), // +2+(2)=36 s
+    ////////////////////////////////////////////////////////
+    0x10,0x00,0x00,0x02, 0x00,0x0a,(0),(0), // +6+(2)=44 s
+    /////////// inner (FinalNestedUnionInner) ////////////
+    0x30,0x00,0x00,0x03, // +4=48 Emheader
+    0x00,0x00,0x00,0x01, // +4=52 discriminator
+    0xff,0xff,0xff,0xff, // +4=56 ul
+    ////////////////////////////////////////////////////////
+    0x00,0x00,0x00,0x04, 0x11 // +5=61 i
+  };
+
+  ACE_Message_Block msg(128);
+  msg.copy((const char*)mutable_struct, sizeof(mutable_struct));
+  XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
+
+  for (int pass = 0; pass < 2; ++pass) {
+    ACE_CDR::Int8 i;
+    ASSERT_RC_OK(data.get_int8_value(i, 4));
+    EXPECT_EQ(0x11, i);
+    ACE_CDR::Char8 c;
+    ASSERT_RC_OK(data.get_char8_value(c, 0));
+    EXPECT_EQ('a', c);
+    ACE_CDR::Short s;
+    ASSERT_RC_OK(data.get_int16_value(s, 2));
+    EXPECT_EQ(0x000a, s);
+
+    DDS::DynamicData_var outer;
+    ASSERT_RC_OK(data.get_complex_value(outer, 1));
+    ASSERT_RC_OK(outer->get_int16_value(s, 2));
+    EXPECT_EQ(0x4321, s);
+    ACE_CDR::Long l;
+    ASSERT_RC_OK(outer->get_int32_value(l, 0));
+    EXPECT_EQ(0x12345678, l);
+  }
+
+  // A member that isn't in the sample is still reported as missing after
+  // the rest of the sample has been indexed.
+  ACE_CDR::Long l;
+  EXPECT_NE(DDS::RETCODE_OK, data.get_int32_value(l, 99));
+}
+
 TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Mutable_ReadRecursiveStruct)
 {
   const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::Node_xtag>();
@@ -3087,6 +3146,71 @@ TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Final_SkipNestedMembers)
   EXPECT_EQ(expected.i, i);
 }
 
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Final_ReadMembersOutOfOrder)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::FinalStruct_xtag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<DCPS::FinalStruct_xtag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  EXPECT_TRUE(it != type_map.end());
+
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+
+  unsigned char final_struct[] = {
+    'a',(0),(0),(0), // +4=4 c
+    /////////// outer (AppendableNestedStructOuter) ///////////
+    0x00,0x00,0x00,0x12, // +4=8 dheader
+    0x12,0x34,0x56,0x78, // +4=12 ul
+    0x00,0x00,0x00,0x08, 0x20,0x00,0x00,0x00, 0x7f,0xff,0xff,0xff, // +12=24 inner.l
+    0x43,0x21, // +2=26 us
+    ////////////////////////////////////////////////////////
+    0x00,0x0a, // +2=28 s
+    /////////// inner (AppendableNestedUnionInner) ////////////
+    0x00,0x00,0x00,0x08, // +4=32 dheader
+    0x00,0x00,0x00,0x01, // +4=36 discriminator
+    0xff,0xff,0xff,0xff, // +4=40 ul
+    ////////////////////////////////////////////////////////
+    0x11 // +1=41 i
+  };
+
+  ACE_Message_Block msg(128);
+  msg.copy((const char*)final_struct, sizeof(final_struct));
+  XTypes::DynamicDataXcdrReadImpl data(&msg, xcdr2, dt);
+
+  // Member offsets found by one read are reused by the following reads, so
+  // reading backward or reading the same member again must see the same values.
+  for (int pass = 0; pass < 2; ++pass) {
+    ACE_CDR::Int8 i;
+    ASSERT_RC_OK(data.get_int8_value(i, 4));
+    EXPECT_EQ(0x11, i);
+    ACE_CDR::Short s;
+    ASSERT_RC_OK(data.get_int16_value(s, 2));
+    EXPECT_EQ(0x000a, s);
+    ACE_CDR::Char8 c;
+    ASSERT_RC_OK(data.get_char8_value(c, 0));
+    EXPECT_EQ('a', c);
+
+    DDS::DynamicData_var outer;
+    ASSERT_RC_OK(data.get_complex_value(outer, 1));
+    ACE_CDR::UShort us;
+    ASSERT_RC_OK(outer->get_uint16_value(us, 2));
+    EXPECT_EQ(0x4321, us);
+    ACE_CDR::ULong ul;
+    ASSERT_RC_OK(outer->get_uint32_value(ul, 0));
+    EXPECT_EQ(0x12345678u, ul);
+    DDS::DynamicData_var inner;
+    ASSERT_RC_OK(outer->get_complex_value(inner, 1));
+    ACE_CDR::Long l;
+    ASSERT_RC_OK(inner->get_int32_value(l, 0));
+    EXPECT_EQ(0x7fffffff, l);
+
+    ASSERT_RC_OK(data.get_complex_value(inner, 3));
+    ASSERT_RC_OK(inner->get_uint32_value(ul, 1));
+    EXPECT_EQ(0xffffffffu, ul);
+  }
+}
+
 TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Final_SkipNestedMembersXCDR1)
 {
   const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<DCPS::FinalStructXCDR1_xtag>();
@@ -3998,3 +3998,42 @@ TEST(dds_DCPS_XTypes_TypeAssignability, UnionTypeTest_NotAssignable)
   b10.member_seq.append(mb10_1);
   EXPECT_FALSE(test.assignable(TypeObject(MinimalTypeObject(a10)), TypeObject(MinimalTypeObject(b10))));
 }
+
+TEST(dds_DCPS_XTypes_TypeAssignability, RememberedResults)
+{
+  TypeLookupService_rch tls = make_rch<TypeLookupService>();
+  TypeAssignability test(tls);
+  TypeAssignability test_imn(tls);
+  test_imn.set_ignore_member_names(true);
+
+  MinimalStructType a, b;
+  a.struct_flags = IS_APPENDABLE;
+  b.struct_flags = a.struct_flags;
+  a.member_seq.append(MinimalStructMember(CommonStructMember(1, StructMemberFlag(), TypeIdentifier(TK_INT32)),
+                                          MinimalMemberDetail("m1")));
+  b.member_seq.append(MinimalStructMember(CommonStructMember(1, StructMemberFlag(), TypeIdentifier(TK_INT32)),
+                                          MinimalMemberDetail("not_m1")));
+  EquivalenceHash hash;
+  get_equivalence_hash(hash);
+  const TypeIdentifier ta = make(EK_MINIMAL, hash);
+  get_equivalence_hash(hash);
+  const TypeIdentifier tb = make(EK_MINIMAL, hash);
+
+  // Not assignable while the type objects are missing, which isn't remembered
+  // once they are added.
+  EXPECT_FALSE(test_imn.assignable(ta, tb));
+  test_imn.insert_entry(ta, TypeObject(MinimalTypeObject(a)));
+  test_imn.insert_entry(tb, TypeObject(MinimalTypeObject(b)));
+  EXPECT_EQ(0u, tls->assignability_stats().entries);
+
+  EXPECT_TRUE(test_imn.assignable(ta, tb));
+  EXPECT_TRUE(test_imn.assignable(ta, tb));
+  // The member names only match when they are ignored.
+  EXPECT_FALSE(test.assignable(ta, tb));
+  EXPECT_FALSE(test.assignable(ta, tb));
+
+  const TypeLookupService::AssignabilityStats stats = tls->assignability_stats();
+  EXPECT_EQ(2u, stats.hits);
+  EXPECT_EQ(3u, stats.misses);
+  EXPECT_EQ(2u, stats.entries);
+}
@@ -190,3 +190,35 @@ TEST(dds_DCPS_transport_framework_ReceivedDataSample, modifiers)
   Message_Block_Ptr data(rds2.data());
   EXPECT_TRUE(check(data->rd_ptr(), data->length(), sizeof buffer1));
 }
+
+TEST(dds_DCPS_transport_framework_ReceivedDataSample, detach_data)
+{
+  ACE_Message_Block mb1(32), mb2(64);
+  char buffer1[32], buffer2[64];
+  fill(buffer1);
+  fill(buffer2, sizeof buffer1);
+  mb1.copy(buffer1, sizeof buffer1);
+  mb2.copy(buffer2, sizeof buffer2);
+  mb1.cont(&mb2);
+
+  ReceivedDataSample rds(mb1);
+  EXPECT_EQ(2, mb1.data_block()->reference_count());
+  EXPECT_EQ(2, mb2.data_block()->reference_count());
+
+  rds.detach_data();
+  EXPECT_EQ(1, mb1.data_block()->reference_count());
+  EXPECT_EQ(1, mb2.data_block()->reference_count());
+  EXPECT_TRUE(rds.has_data());
+  EXPECT_EQ(sizeof buffer1 + sizeof buffer2, rds.data_length());
+
+  // The receive buffer can be reused without changing the sample.
+  mb1.reset();
+  mb1.copy(buffer2, sizeof buffer1);
+  const DDS::OctetSeq seq(rds.copy_data());
+  EXPECT_TRUE(check(reinterpret_cast<const char*>(seq.get_buffer()), seq.length(),
+                    sizeof buffer1 + sizeof buffer2));
+
+  ReceivedDataSample empty;
+  empty.detach_data();
+  EXPECT_FALSE(empty.has_data());
+}
@@ -0,0 +1,210 @@
+#include <dds/DCPS/transport/framework/TransportSendBuffer.h>
+
+#include <dds/DCPS/DisjointSequence.h>
+#include <dds/DCPS/Message_Block_Ptr.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  void insert(SingleSendBuffer& buffer, SequenceNumber::Value seq)
+  {
+    TransportSendStrategy::QueueType queue;
+    Message_Block_Ptr chain(new ACE_Message_Block(8));
+    buffer.insert(seq, &queue, chain.get());
+  }
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendBuffer, insert_and_release)
+{
+  SingleSendBuffer buffer(SingleSendBuffer::UNLIMITED, 1);
+  for (SequenceNumber::Value seq = 5; seq <= 10; ++seq) {
+    insert(buffer, seq);
+  }
+  for (SequenceNumber::Value seq = 1; seq < 5; ++seq) {
+    insert(buffer, seq);
+  }
+
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(1), proxy.low());
+    EXPECT_EQ(SequenceNumber(10), proxy.high());
+    EXPECT_TRUE(proxy.contains(5));
+    EXPECT_FALSE(proxy.contains(11));
+  }
+
+  buffer.release_acked(5);
+  buffer.release_acked(1);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(2), proxy.low());
+    EXPECT_FALSE(proxy.contains(5));
+    EXPECT_TRUE(proxy.contains(6));
+  }
+
+  // Far enough ahead that the older samples move out of the ring
+  insert(buffer, 500);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(2), proxy.low());
+    EXPECT_EQ(SequenceNumber(500), proxy.high());
+    for (SequenceNumber::Value seq = 2; seq <= 10; ++seq) {
+      EXPECT_EQ(seq != 5, proxy.contains(seq)) << seq;
+    }
+    EXPECT_FALSE(proxy.contains(499));
+    EXPECT_TRUE(proxy.contains(500));
+  }
+
+  SingleSendBuffer::BufferVec removed;
+  buffer.remove_acked(500, removed);
+  ASSERT_EQ(1u, removed.size());
+  delete removed[0].first;
+  Message_Block_Ptr to_release(removed[0].second);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(10), proxy.high());
+  }
+
+  // Below what has been released
+  insert(buffer, 400);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_FALSE(proxy.contains(400));
+  }
+
+  buffer.release_all();
+  SingleSendBuffer::Proxy proxy(buffer);
+  EXPECT_TRUE(proxy.empty());
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendBuffer, capacity)
+{
+  SingleSendBuffer buffer(4, 1);
+  for (SequenceNumber::Value seq = 1; seq <= 6; ++seq) {
+    insert(buffer, seq);
+  }
+
+  SingleSendBuffer::Proxy proxy(buffer);
+  EXPECT_EQ(SequenceNumber(3), proxy.low());
+  EXPECT_EQ(SequenceNumber(6), proxy.high());
+  EXPECT_FALSE(proxy.contains(2));
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendBuffer, capacity_older_than_ring)
+{
+  SingleSendBuffer buffer(4, 1);
+  for (SequenceNumber::Value seq = 1; seq <= 4; ++seq) {
+    insert(buffer, seq);
+  }
+  buffer.release_acked(4);
+  buffer.release_acked(2);
+  buffer.release_acked(3);
+
+  // 1 is still buffered after the ring moves past it
+  insert(buffer, 5);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(1), proxy.low());
+    EXPECT_EQ(SequenceNumber(5), proxy.high());
+    EXPECT_TRUE(proxy.contains(1));
+    EXPECT_FALSE(proxy.contains(2));
+    EXPECT_TRUE(proxy.contains(5));
+  }
+
+  for (SequenceNumber::Value seq = 6; seq <= 10; ++seq) {
+    insert(buffer, seq);
+  }
+  SingleSendBuffer::Proxy proxy(buffer);
+  EXPECT_EQ(SequenceNumber(7), proxy.low());
+  EXPECT_EQ(SequenceNumber(10), proxy.high());
+  EXPECT_FALSE(proxy.contains(1));
+  EXPECT_FALSE(proxy.contains(6));
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendBuffer, unlimited_older_than_ring)
+{
+  SingleSendBuffer buffer(SingleSendBuffer::UNLIMITED, 1);
+  for (SequenceNumber::Value seq = 1; seq <= 1000; ++seq) {
+    insert(buffer, seq);
+  }
+  for (SequenceNumber::Value seq = 999; seq >= 1; seq -= 2) {
+    buffer.release_acked(seq);
+  }
+
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(2), proxy.low());
+    EXPECT_EQ(SequenceNumber(1000), proxy.high());
+    for (SequenceNumber::Value seq = 1; seq <= 1000; ++seq) {
+      EXPECT_EQ(seq % 2 == 0, proxy.contains(seq)) << seq;
+    }
+  }
+
+  buffer.release_acked(1000);
+  buffer.release_acked(2);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(4), proxy.low());
+    EXPECT_EQ(SequenceNumber(998), proxy.high());
+  }
+
+  for (SequenceNumber::Value seq = 4; seq < 1000; seq += 2) {
+    buffer.release_acked(seq);
+  }
+  SingleSendBuffer::Proxy proxy(buffer);
+  EXPECT_TRUE(proxy.empty());
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendBuffer, out_of_order)
+{
+  SingleSendBuffer buffer(SingleSendBuffer::UNLIMITED, 1);
+  insert(buffer, 10);
+  insert(buffer, 20);
+  insert(buffer, 15);
+  insert(buffer, 12);
+
+  buffer.release_acked(10);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(12), proxy.low());
+  }
+  buffer.release_acked(12);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(15), proxy.low());
+    EXPECT_EQ(SequenceNumber(20), proxy.high());
+  }
+  buffer.release_acked(20);
+  {
+    SingleSendBuffer::Proxy proxy(buffer);
+    EXPECT_EQ(SequenceNumber(15), proxy.low());
+    EXPECT_EQ(SequenceNumber(15), proxy.high());
+  }
+  buffer.release_acked(15);
+  SingleSendBuffer::Proxy proxy(buffer);
+  EXPECT_TRUE(proxy.empty());
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendBuffer, resend_gaps)
+{
+  SingleSendBuffer buffer(SingleSendBuffer::UNLIMITED, 1);
+  for (SequenceNumber::Value seq = 10; seq <= 20; ++seq) {
+    insert(buffer, seq);
+  }
+  buffer.release_acked(10);
+  buffer.release_acked(15);
+
+  // Nothing requested is buffered so nothing is sent.
+  SingleSendBuffer::Proxy proxy(buffer);
+  DisjointSequence gaps;
+  EXPECT_FALSE(proxy.resend_i(SequenceRange(5, 10), &gaps));
+  EXPECT_TRUE(proxy.resend_i(SequenceRange(15, 15), &gaps));
+  EXPECT_FALSE(proxy.resend_i(SequenceRange(21, 30), &gaps));
+
+  OPENDDS_VECTOR(SequenceRange) expected;
+  expected.push_back(SequenceRange(5, 10));
+  expected.push_back(SequenceRange(15, 15));
+  expected.push_back(SequenceRange(21, 30));
+  EXPECT_EQ(expected, gaps.present_sequence_ranges());
+}
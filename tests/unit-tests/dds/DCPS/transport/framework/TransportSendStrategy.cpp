@@ -0,0 +1,32 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/framework/TransportSendStrategy.h>
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_transport_framework_TransportSendStrategy, coalesce_fits_budget)
+{
+  EXPECT_TRUE(TransportSendStrategy::coalesce_fits(1000, 600, 3, 400, 2, 5000));
+  EXPECT_FALSE(TransportSendStrategy::coalesce_fits(1000, 600, 3, 401, 2, 5000));
+  EXPECT_TRUE(TransportSendStrategy::coalesce_fits(1000, 0, 1, 1000, 2, 5000));
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendStrategy, coalesce_fits_space)
+{
+  // An element that would have to be fragmented waits for the next packet.
+  EXPECT_TRUE(TransportSendStrategy::coalesce_fits(65536, 600, 3, 400, 2, 400));
+  EXPECT_FALSE(TransportSendStrategy::coalesce_fits(65536, 600, 3, 400, 2, 399));
+}
+
+TEST(dds_DCPS_transport_framework_TransportSendStrategy, coalesce_fits_blocks)
+{
+  // The packet has to go out in one vectored write.
+  const size_t max_blocks = MAX_SEND_BLOCKS;
+  EXPECT_TRUE(TransportSendStrategy::coalesce_fits(65536, 600, max_blocks - 2, 10, 2, 5000));
+  EXPECT_FALSE(TransportSendStrategy::coalesce_fits(65536, 600, max_blocks - 1, 10, 2, 5000));
+}
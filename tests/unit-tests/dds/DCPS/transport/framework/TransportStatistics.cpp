@@ -8,6 +8,8 @@ TEST(dds_DCPS_transport_framework_InternalTransportStatistics, ctor)
 {
   InternalTransportStatistics uut("a transport");
   EXPECT_FALSE(uut.count_messages());
+  EXPECT_EQ(uut.send_syscalls_saved, 0u);
+  EXPECT_EQ(uut.recv_syscalls_saved, 0u);
 }
 
 TEST(dds_DCPS_transport_framework_InternalTransportStatistics, reload)
@@ -20,3 +22,29 @@ TEST(dds_DCPS_transport_framework_InternalTransportStatistics, reload)
 
   EXPECT_TRUE(uut.count_messages());
 }
+
+TEST(dds_DCPS_transport_framework_InternalTransportStatistics, append)
+{
+  InternalTransportStatistics uut("a transport");
+  uut.send_syscalls_saved = 5;
+  uut.recv_syscalls_saved = 7;
+  uut.writer_multicast_resend_count[GUID_UNKNOWN] = 3;
+  uut.writer_nack_suppressed_count[GUID_UNKNOWN] = 4;
+
+  TransportStatisticsSequence seq;
+  append(seq, uut);
+  ASSERT_EQ(seq.length(), 1u);
+  EXPECT_STREQ(seq[0].transport.in(), "a transport");
+  EXPECT_EQ(seq[0].send_syscalls_saved, 5u);
+  EXPECT_EQ(seq[0].recv_syscalls_saved, 7u);
+  ASSERT_EQ(seq[0].writer_multicast_resend_count.length(), 1u);
+  EXPECT_EQ(seq[0].writer_multicast_resend_count[0].count, 3u);
+  ASSERT_EQ(seq[0].writer_nack_suppressed_count.length(), 1u);
+  EXPECT_EQ(seq[0].writer_nack_suppressed_count[0].count, 4u);
+
+  uut.clear();
+  EXPECT_EQ(uut.send_syscalls_saved, 0u);
+  EXPECT_EQ(uut.recv_syscalls_saved, 0u);
+  EXPECT_TRUE(uut.writer_multicast_resend_count.empty());
+  EXPECT_TRUE(uut.writer_nack_suppressed_count.empty());
+}
@@ -0,0 +1,256 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/DeliverSample.h>
+
+#include <dds/DCPS/ConditionVariable.h>
+#include <dds/DCPS/ServiceEventDispatcher.h>
+#include <dds/DCPS/ThreadStatusManager.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  class TestLink : public virtual RcObject {
+  public:
+    TestLink() : cv_(mutex_) {}
+
+    int data_received(ReceivedDataSample& sample, const GUID_t& reader)
+    {
+      record(sample, reader);
+      return 0;
+    }
+
+    void data_received_include(ReceivedDataSample& sample, const RepoIdSet& incl)
+    {
+      record(sample, incl.empty() ? GUID_UNKNOWN : *incl.begin());
+    }
+
+    void data_received_batch(ReceivedDataSampleVec& samples, const GUID_t& reader)
+    {
+      for (ReceivedDataSampleVec::iterator it = samples.begin(); it != samples.end(); ++it) {
+        record(*it, reader);
+      }
+      runs_.push_back(samples.size());
+    }
+
+    void dispatch_data_received_batch(ReceivedDataSampleVec& samples, const GUID_t& reader)
+    {
+      data_received_batch(samples, reader);
+    }
+
+    void wait(size_t count)
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+      while (sequences_.size() < count) {
+        cv_.wait(tsm_);
+      }
+    }
+
+    OPENDDS_VECTOR(SequenceNumber) sequences_;
+    OPENDDS_VECTOR(GUID_t) readers_;
+    OPENDDS_VECTOR(DDS::OctetSeq) data_;
+    OPENDDS_VECTOR(size_t) runs_;
+
+  private:
+    void record(const ReceivedDataSample& sample, const GUID_t& reader)
+    {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+      sequences_.push_back(sample.header_.sequence_);
+      readers_.push_back(reader);
+      data_.push_back(sample.copy_data());
+      cv_.notify_all();
+    }
+
+    ACE_Thread_Mutex mutex_;
+    ConditionVariable<ACE_Thread_Mutex> cv_;
+    ThreadStatusManager tsm_;
+  };
+
+  typedef DeliverSample<TestLink> TestDeliverSample;
+  typedef DeliverSamples<TestLink> TestDeliverSamples;
+
+  GUID_t make_guid(unsigned char key, const EntityId_t& entity)
+  {
+    GUID_t guid = GUID_UNKNOWN;
+    guid.guidPrefix[11] = key;
+    guid.entityId = entity;
+    return guid;
+  }
+
+  const EntityId_t user_writer = {{0x00, 0x00, 0x01}, ENTITYKIND_USER_WRITER_WITH_KEY};
+  const EntityId_t user_reader = {{0x00, 0x00, 0x02}, ENTITYKIND_USER_READER_WITH_KEY};
+
+  ReceivedDataSample make_sample(ACE_Message_Block& buffer, unsigned char writer, SequenceNumber::Value seq)
+  {
+    ReceivedDataSample sample(buffer);
+    sample.header_.publication_id_ = make_guid(writer, user_writer);
+    sample.header_.sequence_ = SequenceNumber(seq);
+    return sample;
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_DeliverSample, delivery_thread)
+{
+  const GUID_t writer = make_guid(1, user_writer);
+  EXPECT_EQ(0u, delivery_thread(writer, 0));
+  EXPECT_EQ(0u, delivery_thread(writer, 1));
+  const size_t index = delivery_thread(writer, 4);
+  EXPECT_LT(index, 4u);
+  EXPECT_EQ(index, delivery_thread(writer, 4));
+
+  // Discovery is delivered on the receiving thread.
+  const GUID_t sedp = make_guid(1, ENTITYID_SEDP_BUILTIN_PUBLICATIONS_WRITER);
+  EXPECT_EQ(4u, delivery_thread(sedp, 4));
+}
+
+TEST(dds_DCPS_transport_rtps_udp_DeliverSample, dispatch)
+{
+  RcHandle<TestLink> link = make_rch<TestLink>();
+  EventDispatcher_rch dispatcher = make_rch<ServiceEventDispatcher>(1);
+
+  // One receive buffer reused for every datagram, like
+  // RtpsUdpReceiveStrategy.
+  ACE_Message_Block buffer(64);
+  const GUID_t reader = make_guid(2, user_reader);
+  RepoIdSet incl;
+  incl.insert(reader);
+
+  const size_t count = 10;
+  for (size_t i = 0; i < count; ++i) {
+    buffer.reset();
+    for (size_t j = 0; j < 16; ++j) {
+      *buffer.wr_ptr() = static_cast<char>(i);
+      buffer.wr_ptr(1);
+    }
+
+    ReceivedDataSample sample(buffer);
+    sample.header_.publication_id_ = make_guid(1, user_writer);
+    sample.header_.sequence_ = SequenceNumber(static_cast<SequenceNumber::Value>(i + 1));
+    RcHandle<TestDeliverSample> event = make_rch<TestDeliverSample>(
+      link, sample, reader, (i % 2) ? &incl : static_cast<const RepoIdSet*>(0));
+    sample.clear();
+
+    // Only the datagram's own reference is left, so the next read can reuse
+    // the buffer instead of allocating a new one.
+    EXPECT_EQ(1, buffer.data_block()->reference_count());
+    EXPECT_TRUE(dispatcher->dispatch(event));
+  }
+
+  link->wait(count);
+  dispatcher->shutdown();
+
+  ASSERT_EQ(count, link->sequences_.size());
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(SequenceNumber(static_cast<SequenceNumber::Value>(i + 1)), link->sequences_[i]);
+    EXPECT_EQ(reader, link->readers_[i]);
+    ASSERT_EQ(16u, link->data_[i].length());
+    for (size_t j = 0; j < 16; ++j) {
+      EXPECT_EQ(static_cast<CORBA::Octet>(i), link->data_[i][static_cast<CORBA::ULong>(j)]);
+    }
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_DeliverSample, link_gone)
+{
+  RcHandle<TestLink> link = make_rch<TestLink>();
+  ACE_Message_Block buffer(8);
+  buffer.wr_ptr(8);
+  ReceivedDataSample sample(buffer);
+  RcHandle<TestDeliverSample> event = make_rch<TestDeliverSample>(
+    link, sample, GUID_UNKNOWN, static_cast<const RepoIdSet*>(0));
+  link.reset();
+  // Delivery after the link was released does nothing.
+  static_cast<EventBase&>(*event).handle_event();
+  EXPECT_EQ(8u, event->sample().data_length());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_DeliverSample, delivery_batch)
+{
+  TestLink link;
+  DeliveryBatch<TestLink> batch;
+  ACE_Message_Block buffer(8);
+  buffer.wr_ptr(8);
+  const GUID_t reader = make_guid(2, user_reader);
+  const GUID_t other_reader = make_guid(3, user_reader);
+
+  EXPECT_FALSE(batch.active());
+  batch.begin();
+  EXPECT_TRUE(batch.active());
+
+  // A run ends when the writer or the reader changes.
+  batch.add(link, make_sample(buffer, 1, 1), reader);
+  batch.add(link, make_sample(buffer, 1, 2), reader);
+  batch.add(link, make_sample(buffer, 1, 3), reader);
+  EXPECT_TRUE(link.sequences_.empty());
+  batch.add(link, make_sample(buffer, 4, 1), reader);
+  batch.add(link, make_sample(buffer, 1, 4), other_reader);
+  batch.add(link, make_sample(buffer, 1, 5), GUID_UNKNOWN);
+  batch.add(link, make_sample(buffer, 1, 6), GUID_UNKNOWN);
+
+  // Something that isn't collected is delivered after what was.
+  batch.flush(link);
+  ASSERT_EQ(4u, link.runs_.size());
+  batch.add(link, make_sample(buffer, 1, 7), GUID_UNKNOWN);
+  batch.end(link);
+  EXPECT_FALSE(batch.active());
+
+  const size_t runs[] = {3, 1, 1, 2, 1};
+  ASSERT_EQ(sizeof runs / sizeof runs[0], link.runs_.size());
+  for (size_t i = 0; i < link.runs_.size(); ++i) {
+    EXPECT_EQ(runs[i], link.runs_[i]);
+  }
+
+  const SequenceNumber::Value sequences[] = {1, 2, 3, 1, 4, 5, 6, 7};
+  ASSERT_EQ(sizeof sequences / sizeof sequences[0], link.sequences_.size());
+  for (size_t i = 0; i < link.sequences_.size(); ++i) {
+    EXPECT_EQ(SequenceNumber(sequences[i]), link.sequences_[i]);
+  }
+  EXPECT_EQ(reader, link.readers_[3]);
+  EXPECT_EQ(other_reader, link.readers_[4]);
+  EXPECT_EQ(GUID_UNKNOWN, link.readers_[5]);
+
+  // Ending an empty batch delivers nothing.
+  batch.begin();
+  batch.end(link);
+  EXPECT_EQ(sizeof runs / sizeof runs[0], link.runs_.size());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_DeliverSample, dispatch_run)
+{
+  RcHandle<TestLink> link = make_rch<TestLink>();
+  EventDispatcher_rch dispatcher = make_rch<ServiceEventDispatcher>(1);
+  ACE_Message_Block buffer(16);
+  for (size_t j = 0; j < 16; ++j) {
+    *buffer.wr_ptr() = 7;
+    buffer.wr_ptr(1);
+  }
+  const GUID_t reader = make_guid(2, user_reader);
+
+  ReceivedDataSampleVec run;
+  for (SequenceNumber::Value seq = 1; seq <= 5; ++seq) {
+    run.push_back(make_sample(buffer, 1, seq));
+  }
+  RcHandle<TestDeliverSamples> event = make_rch<TestDeliverSamples>(link, run, reader);
+
+  // The event took the samples and copied them out of the receive buffer.
+  EXPECT_TRUE(run.empty());
+  EXPECT_EQ(5u, event->samples().size());
+  EXPECT_EQ(1, buffer.data_block()->reference_count());
+
+  EXPECT_TRUE(dispatcher->dispatch(event));
+  link->wait(5);
+  dispatcher->shutdown();
+
+  ASSERT_EQ(1u, link->runs_.size());
+  EXPECT_EQ(5u, link->runs_[0]);
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(SequenceNumber(static_cast<SequenceNumber::Value>(i + 1)), link->sequences_[i]);
+    EXPECT_EQ(reader, link->readers_[i]);
+    ASSERT_EQ(16u, link->data_[i].length());
+    EXPECT_EQ(7, link->data_[i][0]);
+  }
+}
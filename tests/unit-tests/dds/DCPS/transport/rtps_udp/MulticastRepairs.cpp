@@ -0,0 +1,80 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/MulticastRepairs.h>
+
+using namespace OpenDDS::DCPS;
+
+TEST(dds_DCPS_transport_rtps_udp_MulticastRepairs, use_multicast_majority)
+{
+  EXPECT_FALSE(MulticastRepairs::use_multicast(0, 1, 4));
+  EXPECT_FALSE(MulticastRepairs::use_multicast(0, 2, 4));
+  EXPECT_TRUE(MulticastRepairs::use_multicast(0, 3, 4));
+  EXPECT_TRUE(MulticastRepairs::use_multicast(0, 1, 1));
+}
+
+TEST(dds_DCPS_transport_rtps_udp_MulticastRepairs, use_multicast_threshold)
+{
+  EXPECT_FALSE(MulticastRepairs::use_multicast(3, 2, 4));
+  EXPECT_TRUE(MulticastRepairs::use_multicast(3, 3, 100));
+  EXPECT_TRUE(MulticastRepairs::use_multicast(3, 4, 4));
+  EXPECT_TRUE(MulticastRepairs::use_multicast(1, 1, 100));
+}
+
+TEST(dds_DCPS_transport_rtps_udp_MulticastRepairs, repaired)
+{
+  AddrSet group;
+  group.insert(NetworkAddress(7401, "239.255.0.2"));
+  AddrSet both(group);
+  both.insert(NetworkAddress(7402, "239.255.0.3"));
+  AddrSet other;
+  other.insert(NetworkAddress(7402, "239.255.0.3"));
+
+  MulticastRepairs repairs;
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  repairs.insert(5, group, now);
+
+  EXPECT_TRUE(repairs.repaired(5, group));
+  EXPECT_FALSE(repairs.repaired(6, group));
+  // Only if every address of the reader was covered.
+  EXPECT_FALSE(repairs.repaired(5, both));
+  EXPECT_FALSE(repairs.repaired(5, other));
+  EXPECT_FALSE(repairs.repaired(5, AddrSet()));
+
+  // A later repair of the same sample replaces the addresses.
+  repairs.insert(5, both, now);
+  EXPECT_TRUE(repairs.repaired(5, both));
+  EXPECT_TRUE(repairs.repaired(5, other));
+  EXPECT_EQ(1u, repairs.size());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_MulticastRepairs, expire)
+{
+  AddrSet group;
+  group.insert(NetworkAddress(7401, "239.255.0.2"));
+
+  MulticastRepairs repairs;
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  const TimeDuration suppression = TimeDuration::from_msec(100);
+  repairs.insert(1, group, start);
+  repairs.insert(2, group, start + TimeDuration::from_msec(50));
+
+  repairs.expire(start + TimeDuration::from_msec(99), suppression);
+  EXPECT_EQ(2u, repairs.size());
+
+  repairs.expire(start + suppression, suppression);
+  EXPECT_FALSE(repairs.repaired(1, group));
+  EXPECT_TRUE(repairs.repaired(2, group));
+
+  repairs.expire(start + TimeDuration::from_msec(150), suppression);
+  EXPECT_TRUE(repairs.empty());
+
+  // A zero duration doesn't suppress anything.
+  repairs.insert(3, group, start);
+  repairs.expire(start, TimeDuration::zero_value);
+  EXPECT_TRUE(repairs.empty());
+}
@@ -0,0 +1,153 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/ReorderWindow.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  ReceivedDataSample make_sample(SequenceNumber::Value seq)
+  {
+    ReceivedDataSample sample;
+    sample.header_.sequence_ = seq;
+    return sample;
+  }
+
+  // Apply the same inserts to a ReorderWindow and a DisjointSequence and
+  // compare the queries used by the RTPS reader.
+  void expect_same(const ReorderWindow& window, const DisjointSequence& expected)
+  {
+    ASSERT_EQ(expected.empty(), window.empty());
+    if (expected.empty()) {
+      return;
+    }
+    EXPECT_EQ(expected.cumulative_ack(), window.cumulative_ack());
+    EXPECT_EQ(expected.high(), window.high());
+    EXPECT_EQ(expected.disjoint(), window.disjoint());
+    EXPECT_EQ(expected.last_ack(), window.last_ack());
+    EXPECT_EQ(expected.present_sequence_ranges(), window.present_sequence_ranges());
+    EXPECT_EQ(expected.missing_sequence_ranges(), window.missing_sequence_ranges());
+    for (SequenceNumber::Value v = 0; v <= expected.high().getValue() + 1; ++v) {
+      EXPECT_EQ(expected.contains(v), window.contains(v)) << v;
+    }
+
+    for (int invert = 0; invert < 2; ++invert) {
+      ACE_CDR::Long expected_bits[8], bits[8];
+      ACE_CDR::ULong expected_num_bits = 0, num_bits = 0;
+      ACE_CDR::ULong expected_added = 0, added = 0;
+      const bool expected_fits = expected.to_bitmap(expected_bits, 8, expected_num_bits, expected_added, invert);
+      EXPECT_EQ(expected_fits, window.to_bitmap(bits, 8, num_bits, added, invert));
+      EXPECT_EQ(expected_num_bits, num_bits);
+      EXPECT_EQ(expected_added, added);
+      for (ACE_CDR::ULong i = 0; i < num_bits; ++i) {
+        const ACE_CDR::ULong mask = 1u << (31 - i % 32);
+        EXPECT_EQ(static_cast<ACE_CDR::ULong>(expected_bits[i / 32]) & mask,
+                  static_cast<ACE_CDR::ULong>(bits[i / 32]) & mask) << i;
+      }
+    }
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_ReorderWindow, capacity)
+{
+  EXPECT_EQ(0u, ReorderWindow().capacity());
+  EXPECT_EQ(32u, ReorderWindow(1).capacity());
+  EXPECT_EQ(64u, ReorderWindow(33).capacity());
+  EXPECT_EQ(256u, ReorderWindow(256).capacity());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_ReorderWindow, matches_DisjointSequence)
+{
+  const size_t capacities[] = {0, 32, 64};
+  for (size_t c = 0; c < sizeof capacities / sizeof capacities[0]; ++c) {
+    ReorderWindow window(capacities[c]);
+    DisjointSequence expected;
+
+    window.insert(SequenceRange(0, 10));
+    expected.insert(SequenceRange(0, 10));
+    expect_same(window, expected);
+
+    // In the window, past it, and then filling the gaps.
+    const SequenceNumber::Value singles[] = {12, 14, 13, 50, 90, 200, 11, 15, 16};
+    for (size_t i = 0; i < sizeof singles / sizeof singles[0]; ++i) {
+      EXPECT_EQ(expected.insert(singles[i]), window.insert(singles[i]));
+      expect_same(window, expected);
+    }
+
+    // Ranges that straddle the end of the window and the cumulative ack.
+    EXPECT_EQ(expected.insert(SequenceRange(60, 100)), window.insert(SequenceRange(60, 100)));
+    expect_same(window, expected);
+    EXPECT_EQ(expected.insert(SequenceRange(17, 40)), window.insert(SequenceRange(17, 40)));
+    expect_same(window, expected);
+    EXPECT_EQ(expected.insert(SequenceRange(30, 150)), window.insert(SequenceRange(30, 150)));
+    expect_same(window, expected);
+
+    // RTPS bitmap, as used by GAP
+    const ACE_CDR::Long bits[] = {static_cast<ACE_CDR::Long>(0xA0000001), 0x1};
+    EXPECT_EQ(expected.insert(180, 64, bits), window.insert(180, 64, bits));
+    expect_same(window, expected);
+
+    // A duplicate is not inserted again.
+    EXPECT_FALSE(window.insert(182));
+    EXPECT_FALSE(window.insert(5));
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_ReorderWindow, held_samples)
+{
+  ReorderWindow window(32);
+
+  // Held before the first heartbeat: 3 and 4 are discarded by start.
+  window.hold(5, make_sample(5));
+  window.hold(3, make_sample(3));
+  window.hold(4, make_sample(4));
+  window.start(SequenceRange(0, 4));
+  EXPECT_TRUE(window.has_held());
+  EXPECT_TRUE(window.contains(5));
+  EXPECT_EQ(SequenceNumber(5), window.cumulative_ack());
+
+  // 7 is in the window, 100 is not.
+  window.hold(7, make_sample(7));
+  window.insert(7);
+  window.hold(100, make_sample(100));
+  window.insert(100);
+
+  ReorderWindow::SampleVec samples;
+  window.take_held(window.cumulative_ack(), samples);
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ(SequenceNumber(5), samples[0].header_.sequence_);
+
+  // A GAP for 6 releases 7.
+  DisjointSequence gap;
+  gap.insert(6);
+  window.insert(6);
+  window.erase_held(gap);
+  samples.clear();
+  window.take_held(window.cumulative_ack(), samples);
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ(SequenceNumber(7), samples[0].header_.sequence_);
+  EXPECT_TRUE(window.has_held());
+
+  // Filling 8..99 moves the cumulative ack past 100.
+  for (SequenceNumber::Value v = 8; v < 100; ++v) {
+    window.hold(v, make_sample(v));
+    window.insert(v);
+  }
+  EXPECT_EQ(SequenceNumber(100), window.cumulative_ack());
+  EXPECT_FALSE(window.disjoint());
+  samples.clear();
+  window.take_held(window.cumulative_ack(), samples);
+  ASSERT_EQ(93u, samples.size());
+  for (size_t i = 0; i < samples.size(); ++i) {
+    EXPECT_EQ(SequenceNumber(8 + i), samples[i].header_.sequence_);
+  }
+  EXPECT_FALSE(window.has_held());
+
+  window.hold(102, make_sample(102));
+  window.clear_held();
+  EXPECT_FALSE(window.has_held());
+}
@@ -0,0 +1,58 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/RtpsUdpInst.h>
+
+#include <ace/Configuration.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  size_t load_receive_batch_size(const ACE_TCHAR* value)
+  {
+    ACE_Configuration_Heap cf;
+    cf.open();
+    ACE_Configuration_Section_Key sect;
+    cf.open_section(cf.root_section(), ACE_TEXT("rtps"), 1, sect);
+    cf.set_string_value(sect, ACE_TEXT("receive_batch_size"), value);
+
+    RcHandle<RtpsUdpInst> inst = make_rch<RtpsUdpInst>("rtps");
+    EXPECT_EQ(0, inst->load(cf, sect));
+    return inst->receive_batch_size_;
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpInst, receive_batch_size)
+{
+  const size_t max = RtpsUdpInst::MAX_RECEIVE_BATCH_SIZE;
+  EXPECT_EQ(1u, load_receive_batch_size(ACE_TEXT("1")));
+  EXPECT_EQ(32u, load_receive_batch_size(ACE_TEXT("32")));
+  EXPECT_EQ(max, load_receive_batch_size(ACE_TEXT("64")));
+  EXPECT_EQ(max, load_receive_batch_size(ACE_TEXT("100000")));
+  EXPECT_EQ(max, load_receive_batch_size(ACE_TEXT("-1")));
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpInst, nak_repair_options)
+{
+  {
+    RcHandle<RtpsUdpInst> inst = make_rch<RtpsUdpInst>("rtps");
+    EXPECT_EQ(0u, inst->nak_multicast_threshold_);
+    EXPECT_TRUE(inst->nak_suppression_duration_.is_zero());
+  }
+
+  ACE_Configuration_Heap cf;
+  cf.open();
+  ACE_Configuration_Section_Key sect;
+  cf.open_section(cf.root_section(), ACE_TEXT("rtps"), 1, sect);
+  cf.set_string_value(sect, ACE_TEXT("nak_multicast_threshold"), ACE_TEXT("3"));
+  cf.set_string_value(sect, ACE_TEXT("nak_suppression_duration"), ACE_TEXT("250"));
+
+  RcHandle<RtpsUdpInst> inst = make_rch<RtpsUdpInst>("rtps");
+  EXPECT_EQ(0, inst->load(cf, sect));
+  EXPECT_EQ(3u, inst->nak_multicast_threshold_);
+  EXPECT_EQ(TimeDuration::from_msec(250), inst->nak_suppression_duration_);
+}
@@ -0,0 +1,104 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/RtpsUdpSendStrategy.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  typedef RtpsUdpSendStrategy::BatchSendVec BatchSendVec;
+
+  void coalesce(const size_t bytes[], size_t count, bool gso, BatchSendVec& sends,
+                size_t blocks_each = 2)
+  {
+    const OPENDDS_VECTOR(size_t) b(bytes, bytes + count);
+    const OPENDDS_VECTOR(size_t) blocks(count, blocks_each);
+    RtpsUdpSendStrategy::coalesce_batch(b, blocks, gso, sends);
+  }
+
+  void expect_send(const RtpsUdpSendStrategy::BatchSend& send,
+                   size_t first, size_t count, size_t segment_size)
+  {
+    EXPECT_EQ(first, send.first_);
+    EXPECT_EQ(count, send.count_);
+    EXPECT_EQ(segment_size, send.segment_size_);
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpSendStrategy, coalesce_same_size)
+{
+  const size_t bytes[] = {100, 100, 100, 100};
+  BatchSendVec sends;
+  coalesce(bytes, 4, true, sends);
+  ASSERT_EQ(1u, sends.size());
+  expect_send(sends[0], 0, 4, 100);
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpSendStrategy, coalesce_shorter_last)
+{
+  // Only the last segment may be shorter and nothing may be longer than
+  // the first.
+  const size_t bytes[] = {100, 100, 60, 100, 200, 200};
+  BatchSendVec sends;
+  coalesce(bytes, 6, true, sends);
+  ASSERT_EQ(3u, sends.size());
+  expect_send(sends[0], 0, 3, 100);
+  expect_send(sends[1], 3, 1, 0);
+  expect_send(sends[2], 4, 2, 200);
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpSendStrategy, coalesce_limits)
+{
+  const size_t max_segments = RtpsUdpSendStrategy::MAX_GSO_SEGMENTS;
+
+  // Segment count
+  OPENDDS_VECTOR(size_t) bytes(max_segments + 1, 10);
+  OPENDDS_VECTOR(size_t) blocks(max_segments + 1, 1);
+  BatchSendVec sends;
+  RtpsUdpSendStrategy::coalesce_batch(bytes, blocks, true, sends);
+  ASSERT_EQ(2u, sends.size());
+  expect_send(sends[0], 0, max_segments, 10);
+  expect_send(sends[1], max_segments, 1, 0);
+
+  // Total size of a UDP datagram
+  const size_t udp_max = TransportSendStrategy::UDP_MAX_MESSAGE_SIZE;
+  const size_t big[] = {udp_max / 2, udp_max / 2, udp_max / 2};
+  sends.clear();
+  coalesce(big, 3, true, sends);
+  ASSERT_EQ(2u, sends.size());
+  expect_send(sends[0], 0, 2, udp_max / 2);
+  expect_send(sends[1], 2, 1, 0);
+
+  // Blocks in one send
+  const size_t max_blocks = MAX_SEND_BLOCKS;
+  const size_t small[] = {10, 10, 10};
+  sends.clear();
+  coalesce(small, 3, true, sends, max_blocks / 2);
+  ASSERT_EQ(2u, sends.size());
+  expect_send(sends[0], 0, 2, 10);
+  expect_send(sends[1], 2, 1, 0);
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpSendStrategy, coalesce_without_gso)
+{
+  // The fallback when UDP_SEGMENT isn't available or the kernel rejected
+  // it: one datagram per message, all of which still go to one sendmmsg.
+  const size_t bytes[] = {100, 100, 60};
+  BatchSendVec sends;
+  coalesce(bytes, 3, false, sends);
+  ASSERT_EQ(3u, sends.size());
+  for (size_t i = 0; i < sends.size(); ++i) {
+    expect_send(sends[i], i, 1, 0);
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_RtpsUdpSendStrategy, coalesce_empty)
+{
+  BatchSendVec sends;
+  RtpsUdpSendStrategy::coalesce_batch(OPENDDS_VECTOR(size_t)(), OPENDDS_VECTOR(size_t)(), true, sends);
+  EXPECT_TRUE(sends.empty());
+}
@@ -0,0 +1,280 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_SAFETY_PROFILE
+
+#include <dds/DCPS/transport/shmem/ShmemRing.h>
+
+#ifdef OPENDDS_SHMEM_RING
+
+#include <gtest/gtest.h>
+
+#include <ace/Message_Block.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  const ACE_UINT32 capacity = ShmemRing::MIN_CAPACITY;
+  // Four of these fill all but 64 bytes of the ring.
+  const size_t data_size = 1000;
+
+  // Stands in for a ring in shared memory, the ring's semaphore is
+  // process-shared but works within one process too.
+  class Ring {
+  public:
+    Ring()
+      : mem_(ShmemRing::allocation_size(capacity) / sizeof(ACE_UINT64) + 1)
+      , ring_(new (&mem_[0]) ShmemRing)
+      , reader_(0)
+    {
+      EXPECT_TRUE(ring_->init(capacity, 0));
+      writer_.attach(ring_);
+      reader_ = new ShmemRingReader(ring_, ShmemPeerPool_rch());
+    }
+
+    ~Ring()
+    {
+      if (reader_) {
+        reader_->detach();
+      }
+      ring_->fini();
+    }
+
+    bool write(char fill)
+    {
+      ShmemRingRecord* const record = writer_.reserve(data_size);
+      if (!record) {
+        return false;
+      }
+      std::memset(record->data(), fill, data_size);
+      writer_.publish();
+      return true;
+    }
+
+    /// The next record as a data block, or 0
+    ACE_Data_Block* read(char expected_fill)
+    {
+      ShmemRingRecord* const record = reader_->next();
+      if (!record) {
+        return 0;
+      }
+      EXPECT_EQ(0u, record->flags_ & ShmemRingRecord::Padding);
+      EXPECT_LE(data_size, record->data_size());
+      for (size_t i = 0; i < data_size; ++i) {
+        if (record->data()[i] != expected_fill) {
+          ADD_FAILURE() << "unexpected data at " << i;
+          break;
+        }
+      }
+      return reader_->data_block(*record);
+    }
+
+    ACE_UINT32 head() const { return ring_->head_.load(); }
+    ACE_UINT32 tail() const { return ring_->tail_.load(); }
+
+    std::vector<ACE_UINT64> mem_;
+    ShmemRing* ring_;
+    ShmemRingWriter writer_;
+    ShmemRingReader* reader_;
+  };
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, write_read_release)
+{
+  Ring ring;
+  EXPECT_FALSE(ring.read(0));
+
+  ASSERT_TRUE(ring.write('a'));
+  ASSERT_TRUE(ring.write('b'));
+  const ACE_UINT32 record_size = ShmemRingRecord::record_size(data_size);
+  EXPECT_EQ(2 * record_size, ring.head());
+
+  ACE_Data_Block* const a = ring.read('a');
+  ACE_Data_Block* const b = ring.read('b');
+  ASSERT_TRUE(a);
+  ASSERT_TRUE(b);
+  EXPECT_FALSE(ring.read(0));
+  EXPECT_EQ(0u, ring.tail());
+
+  // Records released out of order are only freed once the ones before them
+  // are.
+  b->release();
+  EXPECT_EQ(0u, ring.tail());
+  a->release();
+  EXPECT_EQ(2 * record_size, ring.tail());
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, wraparound)
+{
+  Ring ring;
+  const ACE_UINT32 record_size = ShmemRingRecord::record_size(data_size);
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(ring.write('a'));
+    ring.read('a')->release();
+  }
+  ASSERT_TRUE(ring.write('b'));
+  EXPECT_EQ(4 * record_size, ring.head());
+
+  // The next record doesn't fit before the end of the ring, so it's
+  // preceded by padding and starts at the beginning of the ring.
+  ASSERT_TRUE(ring.write('c'));
+  EXPECT_EQ(capacity + record_size, ring.head());
+
+  ACE_Data_Block* const b = ring.read('b');
+  ACE_Data_Block* const c = ring.read('c');
+  ASSERT_TRUE(b);
+  ASSERT_TRUE(c);
+  EXPECT_EQ(ring.ring_->data(), c->base() - sizeof(ShmemRingRecord));
+  b->release();
+  c->release();
+  EXPECT_EQ(ring.head(), ring.tail());
+
+  // Positions keep counting past the capacity.
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(ring.write('d'));
+    ring.read('d')->release();
+  }
+  EXPECT_EQ(ring.head(), ring.tail());
+  EXPECT_LT(capacity, ring.tail());
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, full)
+{
+  Ring ring;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.write('a'));
+  }
+  // Nothing was released, so there's no space.
+  EXPECT_FALSE(ring.write('b'));
+
+  // Reading doesn't make space, releasing does.
+  ACE_Data_Block* const a = ring.read('a');
+  ASSERT_TRUE(a);
+  EXPECT_FALSE(ring.write('b'));
+  a->release();
+  EXPECT_TRUE(ring.write('b'));
+
+  // A record that can never fit is told apart from a full ring.
+  EXPECT_TRUE(ring.writer_.fits(data_size));
+  EXPECT_FALSE(ring.writer_.fits(capacity));
+  EXPECT_FALSE(ring.writer_.reserve(capacity));
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, release_wakes_writer)
+{
+  Ring ring;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.write('a'));
+  }
+  ACE_Data_Block* const a = ring.read('a');
+  ASSERT_TRUE(a);
+
+  // The writer blocks on the ring's semaphore until the reader releases
+  // the record.
+  ASSERT_FALSE(ring.write('b'));
+  bool written = false;
+  std::thread writer([&] {
+    written = ring.writer_.wait_for_space(10) && ring.write('b');
+  });
+  ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  a->release();
+  writer.join();
+  EXPECT_TRUE(written);
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, stop_wakes_writer)
+{
+  Ring ring;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.write('a'));
+  }
+  ASSERT_FALSE(ring.write('b'));
+
+  bool waited = true;
+  std::thread writer([&] { waited = ring.writer_.wait_for_space(0); });
+  ACE_OS::sleep(ACE_Time_Value(0, 100000));
+  ring.writer_.stop();
+  writer.join();
+  EXPECT_FALSE(waited);
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, wait_without_full_ring)
+{
+  Ring ring;
+  // Nothing failed to fit, so there's nothing to wait for.
+  EXPECT_TRUE(ring.writer_.wait_for_space(0));
+  ASSERT_TRUE(ring.write('a'));
+  EXPECT_TRUE(ring.writer_.wait_for_space(0));
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, spin_adapts)
+{
+  ShmemRingSpin spin(8);
+  EXPECT_EQ(8u, spin.limit());
+
+  // Polling that finds nothing halves the limit each time.
+  size_t spins = 0;
+  while (spin.spin()) {
+    ++spins;
+  }
+  EXPECT_EQ(8u, spins);
+  EXPECT_EQ(4u, spin.limit());
+  while (spin.spin()) {}
+  EXPECT_EQ(2u, spin.limit());
+
+  // Polling that finds work doubles it, up to the maximum.
+  EXPECT_TRUE(spin.spin());
+  spin.found();
+  EXPECT_EQ(4u, spin.limit());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(spin.spin());
+    spin.found();
+  }
+  EXPECT_EQ(8u, spin.limit());
+
+  // Work found without polling doesn't change it.
+  spin.found();
+  EXPECT_EQ(8u, spin.limit());
+
+  // The limit doesn't drop below one.
+  for (int i = 0; i < 5; ++i) {
+    while (spin.spin()) {}
+  }
+  EXPECT_EQ(1u, spin.limit());
+  EXPECT_TRUE(spin.spin());
+  spin.found();
+  EXPECT_EQ(2u, spin.limit());
+
+  // Without spinning the thread blocks right away.
+  ShmemRingSpin none(0);
+  EXPECT_FALSE(none.spin());
+  none.found();
+  EXPECT_FALSE(none.spin());
+}
+
+TEST(dds_DCPS_transport_shmem_ShmemRing, detach)
+{
+  Ring ring;
+  ASSERT_TRUE(ring.write('a'));
+  ACE_Data_Block* const a = ring.read('a');
+  ASSERT_TRUE(a);
+
+  // Once the reader is detached the data block stays usable but releasing
+  // it doesn't touch the ring.  The reader deletes itself then.
+  ring.reader_->detach();
+  ring.reader_ = 0;
+  EXPECT_EQ('a', a->base()[0]);
+  a->release();
+  EXPECT_EQ(0u, ring.tail());
+}
+
+#endif
+#endif
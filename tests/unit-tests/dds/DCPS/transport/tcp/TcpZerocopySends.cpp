@@ -0,0 +1,119 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_SAFETY_PROFILE
+
+#include <dds/DCPS/transport/tcp/TcpZerocopySends.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  const ACE_HANDLE FIRST = 10;
+  const ACE_HANDLE SECOND = 11;
+
+  void send(TcpZerocopySends& sends, ACE_Message_Block& packet, size_t count)
+  {
+    for (size_t i = 0; i < count; ++i) {
+      sends.sent(&packet);
+    }
+  }
+}
+
+TEST(dds_DCPS_transport_tcp_TcpZerocopySends, completed)
+{
+  ACE_Message_Block packet(64);
+  {
+    TcpZerocopySends sends;
+    sends.open(FIRST);
+    send(sends, packet, 5);
+    EXPECT_EQ(5u, sends.pending());
+    EXPECT_EQ(6, packet.reference_count());
+
+    sends.completed(1, 2);
+    EXPECT_EQ(3u, sends.pending());
+    EXPECT_EQ(4, packet.reference_count());
+
+    // Completions may be reported more than once.
+    sends.completed(0, 2);
+    EXPECT_EQ(2u, sends.pending());
+    sends.completed(0, 100);
+    EXPECT_EQ(0u, sends.pending());
+    EXPECT_EQ(1, packet.reference_count());
+
+    send(sends, packet, 2);
+  }
+  EXPECT_EQ(1, packet.reference_count());
+}
+
+TEST(dds_DCPS_transport_tcp_TcpZerocopySends, completed_wrapped)
+{
+  ACE_Message_Block packet(64);
+  TcpZerocopySends sends;
+  sends.open(FIRST);
+  send(sends, packet, 3);
+
+  // A range that wraps around covers the ids from the start of it.
+  sends.completed(0xfffffffe, 1);
+  EXPECT_EQ(1u, sends.pending());
+  sends.completed(0xffffffff, 2);
+  EXPECT_EQ(0u, sends.pending());
+}
+
+TEST(dds_DCPS_transport_tcp_TcpZerocopySends, reconnect)
+{
+  ACE_Message_Block packet(64);
+  TcpZerocopySends sends;
+  sends.open(FIRST);
+  send(sends, packet, 3);
+
+  // The old socket may still be sending, so its packets are held until it
+  // is closed.
+  sends.open(SECOND);
+  EXPECT_EQ(SECOND, sends.handle());
+  EXPECT_EQ(0u, sends.pending());
+  EXPECT_EQ(3u, sends.retired());
+  EXPECT_EQ(4, packet.reference_count());
+
+  // Ids start over on the new socket.
+  send(sends, packet, 2);
+  sends.completed(0, 0);
+  EXPECT_EQ(1u, sends.pending());
+  EXPECT_EQ(3u, sends.retired());
+
+  sends.closed(FIRST);
+  EXPECT_EQ(0u, sends.retired());
+  EXPECT_EQ(1u, sends.pending());
+  EXPECT_EQ(2, packet.reference_count());
+
+  sends.closed(SECOND);
+  EXPECT_EQ(ACE_INVALID_HANDLE, sends.handle());
+  EXPECT_EQ(0u, sends.pending());
+  EXPECT_EQ(1, packet.reference_count());
+}
+
+TEST(dds_DCPS_transport_tcp_TcpZerocopySends, reused_handle)
+{
+  ACE_Message_Block packet(64);
+  TcpZerocopySends sends;
+  sends.open(FIRST);
+  send(sends, packet, 2);
+  sends.open(SECOND);
+  send(sends, packet, 1);
+
+  // Getting the old handle back means it was closed.
+  sends.open(FIRST);
+  EXPECT_EQ(1u, sends.retired());
+  EXPECT_EQ(0u, sends.pending());
+  EXPECT_EQ(2, packet.reference_count());
+
+  sends.release_all();
+  EXPECT_EQ(ACE_INVALID_HANDLE, sends.handle());
+  EXPECT_EQ(0u, sends.retired());
+  EXPECT_EQ(1, packet.reference_count());
+}
+
+#endif